@@ -0,0 +1,214 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using NUnit.Framework;
+
+namespace VisualGameStudio.Tests.Native;
+
+/// <summary>
+/// HEADLESS proof of the deterministic physics mode. The physics world needs no window, so each test builds a pile of
+/// circles and boxes on a static ground through the exported API, advances it with StepFixed and compares
+/// Framework_Physics_GetStateChecksum — the per-step divergence check lockstep and replays rely on:
+///   * the same scene reached through a different insertion history (filler bodies created then destroyed between the real
+///     ones, shapes and positions assigned in reverse, the ground configured last) must land on the same checksum, which
+///     pins stable body ordering over the hash map, the broadphase tree and the SoA body slots;
+///   * four separate piles stepped on one thread and on four workers must agree on the checksum AND on the exact sequence of
+///     enter/stay callbacks, which pins the deterministic merge of parallel narrowphase and island results and the main-thread
+///     dispatch order. Callback bodies are recorded relative to the first handle of each build.
+/// The checksum hashes each body's rank in handle order rather than the raw handle, so a second world built later in the
+/// same process compares equal. [NonParallelizable] because the physics world is global; every test clears it, resets the
+/// callbacks and the thread count in a finally and GC.KeepAlive's its delegates.
+/// Self-Ignores when the DLL isn't staged or predates the exports.
+/// </summary>
+[TestFixture]
+[NonParallelizable]
+public class PhysicsDeterminismTests
+{
+    private const string DLL = "VisualGameStudioEngine.dll";
+    private const CallingConvention CC = CallingConvention.Cdecl;
+
+    private const int BODY_STATIC = 0;
+    private const int BODY_DYNAMIC = 1;
+    private const int Steps = 240;
+
+    [UnmanagedFunctionPointer(CC)] private delegate void CollisionCb(int bodyA, int bodyB, float normalX, float normalY, float depth);
+
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_SetGravity(float gx, float gy);
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_SetDeterministic([MarshalAs(UnmanagedType.I1)] bool enabled);
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_StepFixed(int steps);
+    [DllImport(DLL, CallingConvention = CC)] private static extern ulong Framework_Physics_GetStateChecksum();
+    [DllImport(DLL, CallingConvention = CC)] private static extern int Framework_Physics_CreateBody(int bodyType, float x, float y);
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_DestroyBody(int bodyHandle);
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_DestroyAllBodies();
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_SetBodyPosition(int bodyHandle, float x, float y);
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_SetBodyCircle(int bodyHandle, float radius);
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_SetBodyBox(int bodyHandle, float width, float height);
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_SetThreadCount(int threads);
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_SetCollisionEnterCallback(CollisionCb callback);
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_SetCollisionStayCallback(CollisionCb callback);
+
+    private readonly struct BodySpec
+    {
+        public readonly float X, Y, Size;
+        public readonly bool Circle;
+        public BodySpec(float x, float y, float size, bool circle) { X = x; Y = y; Size = size; Circle = circle; }
+    }
+
+    // A fixed LCG so the scene is identical on every run and machine
+    private static List<BodySpec> Scene(int count)
+    {
+        var specs = new List<BodySpec>(count);
+        uint seed = 12345;
+        float Next() { seed = seed * 1664525u + 1013904223u; return (seed >> 8) / 16777216f; }
+        for (int i = 0; i < count; i++)
+        {
+            float x = 100f + Next() * 600f;
+            float y = 700f - (i / 8) * 22f - Next() * 6f;
+            float size = 6f + Next() * 6f;
+            specs.Add(new BodySpec(x, y, size, i % 3 == 0));
+        }
+        return specs;
+    }
+
+    private static void Shape(int handle, BodySpec s)
+    {
+        if (s.Circle) Framework_Physics_SetBodyCircle(handle, s.Size);
+        else Framework_Physics_SetBodyBox(handle, s.Size * 2f, s.Size * 1.5f);
+    }
+
+    // Returns the first handle so callers can record bodies relative to it
+    private static int BuildInOrder(List<BodySpec> specs, int piles = 1)
+    {
+        Framework_Physics_DestroyAllBodies();
+        int first = -1;
+        for (int p = 0; p < piles; p++)
+        {
+            float ox = p * 900f;
+            int ground = Framework_Physics_CreateBody(BODY_STATIC, ox + 400f, 760f);
+            Framework_Physics_SetBodyBox(ground, 800f, 40f);
+            if (first < 0) first = ground;
+            foreach (var s in specs) Shape(Framework_Physics_CreateBody(BODY_DYNAMIC, ox + s.X, s.Y), s);
+        }
+        return first;
+    }
+
+    // Same bodies in the same handle order, but a different history for every container the step walks
+    private static void BuildShuffled(List<BodySpec> specs)
+    {
+        Framework_Physics_DestroyAllBodies();
+        int ground = Framework_Physics_CreateBody(BODY_STATIC, 0f, 0f);
+        var handles = new List<int>(specs.Count);
+        var fillers = new List<int>();
+        foreach (var _ in specs)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                int f = Framework_Physics_CreateBody(BODY_DYNAMIC, -1000f - k * 50f, 0f);
+                Framework_Physics_SetBodyCircle(f, 4f);
+                fillers.Add(f);
+            }
+            handles.Add(Framework_Physics_CreateBody(BODY_DYNAMIC, 0f, 0f));
+        }
+        for (int i = specs.Count - 1; i >= 0; i--)
+        {
+            Framework_Physics_SetBodyPosition(handles[i], specs[i].X, specs[i].Y);
+            Shape(handles[i], specs[i]);
+        }
+        Framework_Physics_SetBodyPosition(ground, 400f, 760f);
+        Framework_Physics_SetBodyBox(ground, 800f, 40f);
+        foreach (int f in fillers) Framework_Physics_DestroyBody(f);
+    }
+
+    private static bool EnsureAvailable()
+    {
+        try { Framework_Physics_DestroyAllBodies(); Framework_Physics_GetStateChecksum(); return true; }
+        catch (DllNotFoundException) { Assert.Ignore($"{DLL} not staged next to the test binary; refresh IDE\\ first."); return false; }
+        catch (EntryPointNotFoundException) { Assert.Ignore($"{DLL} predates the deterministic physics exports; refresh IDE\\ first."); return false; }
+    }
+
+    [Test]
+    public void Same_scene_in_two_insertion_orders_steps_to_the_same_checksum()
+    {
+        if (!EnsureAvailable()) return;
+        var specs = Scene(80);
+        try
+        {
+            Framework_Physics_SetGravity(0f, 980f);
+            Framework_Physics_SetDeterministic(true);
+
+            BuildInOrder(specs);
+            ulong built = Framework_Physics_GetStateChecksum();
+            Framework_Physics_StepFixed(Steps);
+            ulong inOrder = Framework_Physics_GetStateChecksum();
+
+            BuildShuffled(specs);
+            ulong rebuilt = Framework_Physics_GetStateChecksum();
+            Framework_Physics_StepFixed(Steps);
+            ulong shuffled = Framework_Physics_GetStateChecksum();
+
+            Assert.Multiple(() =>
+            {
+                Assert.That(rebuilt, Is.EqualTo(built), "both builds start from the same state");
+                Assert.That(inOrder, Is.Not.EqualTo(built), "the pile actually moved during the steps");
+                Assert.That(shuffled, Is.EqualTo(inOrder), "insertion history must not change the simulated result");
+            });
+        }
+        finally
+        {
+            Framework_Physics_DestroyAllBodies();
+            Framework_Physics_SetDeterministic(false);
+        }
+    }
+
+    private static (ulong checksum, List<(int kind, int a, int b)> events) RunPiles(List<BodySpec> specs, int threads)
+    {
+        var events = new List<(int kind, int a, int b)>();
+        int first = 0;
+        CollisionCb onEnter = (a, b, nx, ny, depth) => events.Add((0, a - first, b - first));
+        CollisionCb onStay = (a, b, nx, ny, depth) => events.Add((1, a - first, b - first));
+        try
+        {
+            Framework_Physics_SetThreadCount(threads);
+            Framework_Physics_SetCollisionEnterCallback(onEnter);
+            Framework_Physics_SetCollisionStayCallback(onStay);
+            first = BuildInOrder(specs, piles: 4);
+            Framework_Physics_StepFixed(Steps);
+            return (Framework_Physics_GetStateChecksum(), events);
+        }
+        finally
+        {
+            Framework_Physics_SetCollisionEnterCallback(null);
+            Framework_Physics_SetCollisionStayCallback(null);
+            GC.KeepAlive(onEnter);
+            GC.KeepAlive(onStay);
+        }
+    }
+
+    [Test]
+    public void One_and_four_threads_step_to_the_same_checksum_and_callback_order()
+    {
+        if (!EnsureAvailable()) return;
+        var specs = Scene(80);
+        try
+        {
+            Framework_Physics_SetGravity(0f, 980f);
+            Framework_Physics_SetDeterministic(true);
+
+            var single = RunPiles(specs, 1);
+            var pooled = RunPiles(specs, 4);
+
+            Assert.Multiple(() =>
+            {
+                Assert.That(single.events.Count, Is.GreaterThan(0), "the piles produced contact callbacks");
+                Assert.That(pooled.checksum, Is.EqualTo(single.checksum), "worker count must not change the simulated result");
+                Assert.That(pooled.events, Is.EqualTo(single.events), "enter/stay callbacks fire in the same order on any worker count");
+            });
+        }
+        finally
+        {
+            Framework_Physics_SetThreadCount(1);
+            Framework_Physics_DestroyAllBodies();
+            Framework_Physics_SetDeterministic(false);
+        }
+    }
+}
@@ -0,0 +1,178 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using NUnit.Framework;
+
+namespace VisualGameStudio.Tests.Native;
+
+/// <summary>
+/// HEADLESS proof of in-memory world snapshots for rollback. A deterministic physics pile is the workload, because
+/// Framework_Physics_GetStateChecksum gives an exact oracle for "the world came back":
+///   * capture, step N, restore, step N again — both runs must reach the same checksum, so restore brings back everything
+///     the step reads (bodies, manifolds for warm starting, sleep state) and rebuilds the derived state consistently;
+///   * a chain full → delta → delta-of-delta restores each link to the checksum it was captured at, in any order;
+///   * a delta whose base was recaptured is rejected — Restore returns false and it can no longer serve as a base — instead
+///     of silently applying its runs to the wrong bytes.
+/// [NonParallelizable] because snapshots cover the global world; every test destroys its snapshots and bodies in a finally.
+/// Self-Ignores when the DLL isn't staged or predates the exports.
+/// </summary>
+[TestFixture]
+[NonParallelizable]
+public class WorldSnapshotTests
+{
+    private const string DLL = "VisualGameStudioEngine.dll";
+    private const CallingConvention CC = CallingConvention.Cdecl;
+
+    private const int BODY_STATIC = 0;
+    private const int BODY_DYNAMIC = 1;
+    private const int Steps = 120;
+
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_SetGravity(float gx, float gy);
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_SetDeterministic([MarshalAs(UnmanagedType.I1)] bool enabled);
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_StepFixed(int steps);
+    [DllImport(DLL, CallingConvention = CC)] private static extern ulong Framework_Physics_GetStateChecksum();
+    [DllImport(DLL, CallingConvention = CC)] private static extern int Framework_Physics_CreateBody(int bodyType, float x, float y);
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_DestroyAllBodies();
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_SetBodyCircle(int bodyHandle, float radius);
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Physics_SetBodyBox(int bodyHandle, float width, float height);
+
+    [DllImport(DLL, CallingConvention = CC)] private static extern int Framework_Snapshot_Create(int reserveBytes);
+    [DllImport(DLL, CallingConvention = CC)] private static extern void Framework_Snapshot_Destroy(int snapshotId);
+    [DllImport(DLL, CallingConvention = CC)] [return: MarshalAs(UnmanagedType.I1)] private static extern bool Framework_Snapshot_Capture(int snapshotId);
+    [DllImport(DLL, CallingConvention = CC)] [return: MarshalAs(UnmanagedType.I1)] private static extern bool Framework_Snapshot_CaptureDelta(int snapshotId, int baseSnapshotId);
+    [DllImport(DLL, CallingConvention = CC)] [return: MarshalAs(UnmanagedType.I1)] private static extern bool Framework_Snapshot_Restore(int snapshotId);
+    [DllImport(DLL, CallingConvention = CC)] [return: MarshalAs(UnmanagedType.I1)] private static extern bool Framework_Snapshot_IsDelta(int snapshotId);
+
+    private readonly List<int> _snapshots = new();
+
+    private int NewSnapshot()
+    {
+        int id = Framework_Snapshot_Create(64 * 1024);
+        _snapshots.Add(id);
+        return id;
+    }
+
+    // A fixed LCG pile on a static ground; the same world on every run and machine
+    private static void BuildPile()
+    {
+        Framework_Physics_DestroyAllBodies();
+        int ground = Framework_Physics_CreateBody(BODY_STATIC, 400f, 760f);
+        Framework_Physics_SetBodyBox(ground, 800f, 40f);
+        uint seed = 12345;
+        float Next() { seed = seed * 1664525u + 1013904223u; return (seed >> 8) / 16777216f; }
+        for (int i = 0; i < 80; i++)
+        {
+            float x = 100f + Next() * 600f;
+            float y = 700f - (i / 8) * 22f - Next() * 6f;
+            float size = 6f + Next() * 6f;
+            int h = Framework_Physics_CreateBody(BODY_DYNAMIC, x, y);
+            if (i % 3 == 0) Framework_Physics_SetBodyCircle(h, size);
+            else Framework_Physics_SetBodyBox(h, size * 2f, size * 1.5f);
+        }
+    }
+
+    private bool EnsureAvailable()
+    {
+        try { Framework_Physics_DestroyAllBodies(); Framework_Snapshot_Destroy(Framework_Snapshot_Create(0)); return true; }
+        catch (DllNotFoundException) { Assert.Ignore($"{DLL} not staged next to the test binary; refresh IDE\\ first."); return false; }
+        catch (EntryPointNotFoundException) { Assert.Ignore($"{DLL} predates the world snapshot exports; refresh IDE\\ first."); return false; }
+    }
+
+    [SetUp]
+    public void SetUp()
+    {
+        if (!EnsureAvailable()) return;
+        Framework_Physics_SetGravity(0f, 980f);
+        Framework_Physics_SetDeterministic(true);
+        BuildPile();
+        Framework_Physics_StepFixed(30);  // Let contacts form so warm starting and manifolds are part of the captured state
+    }
+
+    [TearDown]
+    public void TearDown()
+    {
+        try
+        {
+            foreach (int id in _snapshots) Framework_Snapshot_Destroy(id);
+            Framework_Physics_DestroyAllBodies();
+            Framework_Physics_SetDeterministic(false);
+        }
+        catch (DllNotFoundException) { }
+        catch (EntryPointNotFoundException) { }
+        _snapshots.Clear();
+    }
+
+    [Test]
+    public void Restore_then_step_reaches_the_same_checksum_as_the_first_run()
+    {
+        int snap = NewSnapshot();
+        Assert.That(Framework_Snapshot_Capture(snap), Is.True);
+        ulong captured = Framework_Physics_GetStateChecksum();
+
+        Framework_Physics_StepFixed(Steps);
+        ulong firstRun = Framework_Physics_GetStateChecksum();
+
+        bool restored = Framework_Snapshot_Restore(snap);
+        ulong afterRestore = Framework_Physics_GetStateChecksum();
+        Framework_Physics_StepFixed(Steps);
+        ulong secondRun = Framework_Physics_GetStateChecksum();
+
+        Assert.Multiple(() =>
+        {
+            Assert.That(restored, Is.True, "restore of a full snapshot succeeds");
+            Assert.That(firstRun, Is.Not.EqualTo(captured), "the pile actually moved during the steps");
+            Assert.That(afterRestore, Is.EqualTo(captured), "restore brings back the captured state");
+            Assert.That(secondRun, Is.EqualTo(firstRun), "stepping from the restored state replays the first run exactly");
+        });
+    }
+
+    [Test]
+    public void Delta_chain_restores_every_link()
+    {
+        int full = NewSnapshot(), delta1 = NewSnapshot(), delta2 = NewSnapshot();
+
+        Assert.That(Framework_Snapshot_Capture(full), Is.True);
+        ulong c0 = Framework_Physics_GetStateChecksum();
+        Framework_Physics_StepFixed(10);
+        Assert.That(Framework_Snapshot_CaptureDelta(delta1, full), Is.True);
+        ulong c1 = Framework_Physics_GetStateChecksum();
+        Framework_Physics_StepFixed(10);
+        Assert.That(Framework_Snapshot_CaptureDelta(delta2, delta1), Is.True);
+        ulong c2 = Framework_Physics_GetStateChecksum();
+        Framework_Physics_StepFixed(10);
+
+        Assert.Multiple(() =>
+        {
+            Assert.That(Framework_Snapshot_IsDelta(full), Is.False);
+            Assert.That(Framework_Snapshot_IsDelta(delta1), Is.True);
+            Assert.That(Framework_Snapshot_IsDelta(delta2), Is.True);
+
+            Assert.That(Framework_Snapshot_Restore(delta2), Is.True, "delta of a delta expands through both bases");
+            Assert.That(Framework_Physics_GetStateChecksum(), Is.EqualTo(c2));
+            Assert.That(Framework_Snapshot_Restore(full), Is.True);
+            Assert.That(Framework_Physics_GetStateChecksum(), Is.EqualTo(c0));
+            Assert.That(Framework_Snapshot_Restore(delta1), Is.True);
+            Assert.That(Framework_Physics_GetStateChecksum(), Is.EqualTo(c1));
+        });
+    }
+
+    [Test]
+    public void Delta_is_rejected_once_its_base_is_recaptured()
+    {
+        int baseSnap = NewSnapshot(), delta = NewSnapshot(), next = NewSnapshot();
+
+        Assert.That(Framework_Snapshot_Capture(baseSnap), Is.True);
+        Framework_Physics_StepFixed(10);
+        Assert.That(Framework_Snapshot_CaptureDelta(delta, baseSnap), Is.True);
+        Framework_Physics_StepFixed(10);
+        ulong beforeRecapture = Framework_Physics_GetStateChecksum();
+        Assert.That(Framework_Snapshot_Capture(baseSnap), Is.True);
+
+        Assert.Multiple(() =>
+        {
+            Assert.That(Framework_Snapshot_Restore(delta), Is.False, "the delta's runs no longer match its base's bytes");
+            Assert.That(Framework_Physics_GetStateChecksum(), Is.EqualTo(beforeRecapture), "a rejected restore leaves the world alone");
+            Assert.That(Framework_Snapshot_CaptureDelta(next, delta), Is.False, "a stale delta cannot serve as a base either");
+        });
+    }
+}
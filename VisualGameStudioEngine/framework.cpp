@@ -6,6 +6,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
+#include <list>
 #include <queue>
 #include <array>
 #include <algorithm>
@@ -16,6 +17,14 @@
 #include <fstream>
 #include <functional>
 #include <random>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <type_traits>
+#include <xmmintrin.h>
 
 // ============================================================================
 // GLOBAL ENGINE STATE
@@ -33,6 +42,36 @@ namespace {
     // Fixed timestep
     double g_fixedStep = 1.0 / 60.0;
     double g_accum = 0.0;
+    int g_fixedMaxSteps = 8;             // Per frame; time beyond this is dropped (spiral-of-death guard)
+    int g_fixedStepsThisFrame = 0;
+    double g_fixedDroppedTime = 0.0;     // Simulated time discarded by the guard since start
+    int g_fixedSystems = 0;              // FIXED_SYSTEM_* bits the engine loop drives
+    SceneUpdateFixedFn g_fixedUpdateCallback = nullptr;
+    bool g_fixedInterpolate = false;
+
+    // The engine runs fixed steps itself once it has something to drive;
+    // otherwise callers poll Framework_StepFixed as before
+    bool FixedLoopActive() { return g_fixedSystems != 0 || g_fixedUpdateCallback != nullptr; }
+
+    // How far the render frame sits between the last fixed step and the next one
+    float FixedAlphaInternal() {
+        if (g_fixedStep <= 0.0) return 1.0f;
+        double a = g_accum / g_fixedStep;
+        return (float)(a < 0.0 ? 0.0 : (a > 1.0 ? 1.0 : a));
+    }
+
+    // Blends two angles in degrees along the shorter arc, so 350 -> 10 passes through 0
+    float LerpAngle(float a, float b, float t) {
+        float diff = fmodf(b - a + 540.0f, 360.0f) - 180.0f;
+        return a + diff * t;
+    }
+
+    void FixedDropSurplus() {
+        if (g_accum < g_fixedStep) return;
+        double surplus = floor(g_accum / g_fixedStep) * g_fixedStep;
+        g_fixedDroppedTime += surplus;
+        g_accum -= surplus;
+    }
 
     // Asset root path
     char g_assetRoot[FW_PATH_MAX] = "";
@@ -114,6 +153,138 @@ namespace {
     bool g_debugDrawStats = true;
 }
 
+// ============================================================================
+// HEADLESS MODE
+// ============================================================================
+// Without a window there is no GL context, so every path that reaches rlgl
+// is skipped. Images and fonts are still decoded on the CPU so texture sizes
+// and glyph metrics stay available to layout, collision and gameplay code.
+// Time advances by a fixed simulated step per Framework_Update, so headless
+// runs are frame-rate independent and reproducible.
+namespace {
+    bool   g_headless = false;
+    int    g_headlessWidth = 0;
+    int    g_headlessHeight = 0;
+    float  g_headlessFrameTime = 1.0f / 60.0f;  // Simulated seconds per Framework_Update
+    double g_headlessTime = 0.0;                // Simulated seconds since Framework_Initialize
+    std::chrono::steady_clock::time_point g_headlessEpoch;
+
+    // Wall clock for profiling; raylib's GetTime needs the window's timer
+    double WallTime_Internal() {
+        if (!g_headless) return GetTime();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - g_headlessEpoch).count();
+    }
+
+    // Logical size of the internal canvas; 0 while the canvas is off
+    int g_canvasWidth = 0;
+    int g_canvasHeight = 0;
+
+    int WindowWidth_Internal() { return g_headless ? g_headlessWidth : GetScreenWidth(); }
+    int WindowHeight_Internal() { return g_headless ? g_headlessHeight : GetScreenHeight(); }
+
+    // The size game code draws in: the canvas's logical size when it is on, else the window
+    int ScreenWidth_Internal() { return g_canvasWidth > 0 ? g_canvasWidth : WindowWidth_Internal(); }
+    int ScreenHeight_Internal() { return g_canvasHeight > 0 ? g_canvasHeight : WindowHeight_Internal(); }
+
+    // Headless textures carry size/format only (id stays 0)
+    bool TextureLoaded_Internal(const Texture2D& t) {
+        return g_headless ? (t.width > 0 && t.height > 0) : (t.id != 0);
+    }
+
+    Texture2D LoadTextureFromImage_Internal(const Image& img) {
+        if (!g_headless) return LoadTextureFromImage(img);
+        Texture2D t{};
+        t.width = img.width;
+        t.height = img.height;
+        t.mipmaps = img.mipmaps;
+        t.format = img.format;
+        return t;
+    }
+
+    Texture2D LoadTexture_Internal(const char* path) {
+        if (!g_headless) return LoadTexture(path);
+        Image img = LoadImage(path);
+        Texture2D t = LoadTextureFromImage_Internal(img);
+        UnloadImage(img);
+        return t;
+    }
+
+    RenderTexture2D LoadRenderTexture_Internal(int width, int height) {
+        if (!g_headless) return LoadRenderTexture(width, height);
+        RenderTexture2D rt{};
+        rt.texture.width = width;
+        rt.texture.height = height;
+        rt.texture.mipmaps = 1;
+        rt.texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+        return rt;
+    }
+
+    // Same steps as LoadFontEx for TTF/OTF, minus the atlas upload
+    Font LoadFontEx_Internal(const char* path, int fontSize, int* codepoints, int codepointCount) {
+        if (!g_headless) return LoadFontEx(path, fontSize, codepoints, codepointCount);
+        Font font{};
+        int dataSize = 0;
+        unsigned char* data = LoadFileData(path, &dataSize);
+        if (!data) return font;
+
+        font.baseSize = fontSize;
+        font.glyphCount = (codepointCount > 0) ? codepointCount : 95;
+        font.glyphPadding = 4;
+        font.glyphs = LoadFontData(data, dataSize, fontSize, codepoints, font.glyphCount, FONT_DEFAULT);
+        UnloadFileData(data);
+        if (!font.glyphs) {
+            font.glyphCount = 0;
+            return font;
+        }
+
+        Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, fontSize, font.glyphPadding, 0);
+        font.texture = LoadTextureFromImage_Internal(atlas);
+        UnloadImage(atlas);
+        return font;
+    }
+
+    bool FontLoaded_Internal(const Font& f) {
+        return g_headless ? (f.glyphCount > 0) : (f.texture.id != 0);
+    }
+
+    void UnloadFont_Internal(Font font) {
+        if (!g_headless) { UnloadFont(font); return; }
+        UnloadFontData(font.glyphs, font.glyphCount);
+        MemFree(font.recs);
+    }
+
+    Shader LoadShader_Internal(const char* vsFileName, const char* fsFileName) {
+        if (g_headless) return Shader{};
+        return LoadShader(vsFileName, fsFileName);
+    }
+
+    Shader LoadShaderFromMemory_Internal(const char* vsCode, const char* fsCode) {
+        if (g_headless) return Shader{};
+        return LoadShaderFromMemory(vsCode, fsCode);
+    }
+
+    // raylib's default font is built by InitWindow; headless falls back to its
+    // 10px cell metrics (about 0.6 em per glyph) so text layout stays stable
+    Vector2 MeasureTextEx_Internal(Font font, const char* text, float fontSize, float spacing) {
+        if (!g_headless || font.glyphs != nullptr) return MeasureTextEx(font, text, fontSize, spacing);
+        if (!text || !text[0]) return Vector2{ 0, 0 };
+        int longest = 0, current = 0, lines = 1;
+        for (const char* c = text; *c; c++) {
+            if (*c == '\n') { lines++; current = 0; continue; }
+            if ((*c & 0xC0) == 0x80) continue;  // UTF-8 continuation byte
+            if (++current > longest) longest = current;
+        }
+        float width = longest * fontSize * 0.6f + (longest > 0 ? (longest - 1) * spacing : 0.0f);
+        return Vector2{ width, fontSize * lines };
+    }
+
+    int MeasureText_Internal(const char* text, int fontSize) {
+        if (!g_headless) return MeasureText(text, fontSize);
+        int spacing = fontSize / 10;
+        return (int)MeasureTextEx_Internal(GetFontDefault(), text, (float)fontSize, (float)spacing).x;
+    }
+}
+
 // ============================================================================
 // SOUND CACHE
 // ============================================================================
@@ -166,14 +337,14 @@ namespace {
             return it->second;
         }
 
-        Texture2D t = LoadTexture(path.c_str());
+        Texture2D t = LoadTexture_Internal(path.c_str());
         int h = g_nextTexHandle++;
 
         TexEntry e;
         e.tex = t;
         e.refCount = 1;
         e.path = path;
-        e.valid = (t.id != 0);
+        e.valid = TextureLoaded_Internal(t);
         g_texByHandle[h] = e;
         g_handleByTexPath[path] = h;
         return h;
@@ -207,6 +378,8 @@ namespace {
         bool        valid = false;
     };
 
+    void TextLayout_ForgetFont(const GlyphInfo* glyphs);  // TEXT LAYOUT CACHE
+
     std::unordered_map<int, FontEntry> g_fontByHandle;
     std::unordered_map<std::string, int> g_handleByFontKey;
     int g_nextFontHandle = 1;
@@ -224,14 +397,14 @@ namespace {
         }
 
         std::string path = ResolveAssetPath(cpath);
-        Font f = LoadFontEx(path.c_str(), size, nullptr, 0);
+        Font f = LoadFontEx_Internal(path.c_str(), size, nullptr, 0);
         int h = g_nextFontHandle++;
 
         FontEntry e;
         e.font = f;
         e.refCount = 1;
         e.key = key;
-        e.valid = (f.texture.id != 0);
+        e.valid = FontLoaded_Internal(f);
         g_fontByHandle[h] = e;
         g_handleByFontKey[key] = h;
         return h;
@@ -241,7 +414,10 @@ namespace {
         auto it = g_fontByHandle.find(h);
         if (it == g_fontByHandle.end()) return;
         if (--it->second.refCount <= 0) {
-            if (it->second.valid) UnloadFont(it->second.font);
+            if (it->second.valid) {
+                TextLayout_ForgetFont(it->second.font.glyphs);
+                UnloadFont_Internal(it->second.font);
+            }
             g_handleByFontKey.erase(it->second.key);
             g_fontByHandle.erase(it);
         }
@@ -312,6 +488,1122 @@ namespace {
     }
 }
 
+// ============================================================================
+// RENDER STATISTICS (rlgl submission tracking)
+// ============================================================================
+// raylib exposes no hook into rlgl's internal batch, so every engine draw path
+// reports what it submits here and we mirror rlgl's batching rules: a texture
+// or primitive (lines/triangles/quads) change inside a batch starts a new draw
+// call, while shader/target/mode switches, a full vertex buffer or too many
+// draws flush the whole batch.
+namespace {
+    constexpr int RSTAT_BATCH_MAX_VERTICES = 8192 * 4;   // RL_DEFAULT_BATCH_BUFFER_ELEMENTS quads
+    constexpr int RSTAT_BATCH_MAX_DRAWS = 256;           // RL_DEFAULT_BATCH_DRAWCALLS
+    constexpr unsigned int RSTAT_DEFAULT_TEXTURE = 0;    // Shapes use rlgl's default white texture
+    constexpr int RSTAT_CIRCLE_SEGMENTS = 36;            // DrawCircle's fixed tessellation
+
+    struct RenderCounters {
+        int drawCalls = 0;
+        int batches = 0;          // rlDrawRenderBatch flushes that actually submitted vertices
+        int textureSwaps = 0;
+        int shaderSwitches = 0;
+        int targetSwitches = 0;
+        int vertices = 0;
+        int triangles = 0;
+        int quads = 0;            // Textured quads (sprites, tiles, glyphs, particles)
+    };
+
+    struct RenderStatsState {
+        RenderCounters frame;
+        RenderCounters subsystems[RENDER_SUBSYSTEM_COUNT];
+        std::unordered_map<int, RenderCounters> layers;
+
+        // Completed-frame snapshot read by the exports
+        RenderCounters lastFrame;
+        RenderCounters lastSubsystems[RENDER_SUBSYSTEM_COUNT];
+        std::unordered_map<int, RenderCounters> lastLayers;
+        std::vector<int> lastLayerIds;
+
+        // Mirror of rlgl's active batch
+        unsigned int boundTexture = RSTAT_DEFAULT_TEXTURE;
+        int boundMode = RL_QUADS;  // Primitive of the pending draw call
+        unsigned int boundShader = 0;
+        unsigned int boundTarget = 0;
+        int pendingVertices = 0;   // Vertices in the current draw call
+        int batchVertices = 0;     // Vertices in the whole batch
+        int batchDraws = 0;
+        int runSubsystem = RENDER_SUBSYSTEM_USER;  // Owner of the pending draw call
+        int runLayer = 0;
+
+        // Attribution for incoming submissions
+        int subsystem = RENDER_SUBSYSTEM_USER;
+        int layer = 0;
+    };
+    RenderStatsState g_renderStats;
+
+    void RenderStats_CloseDrawCall() {
+        RenderStatsState& rs = g_renderStats;
+        if (rs.pendingVertices <= 0) return;
+        rs.frame.drawCalls++;
+        rs.subsystems[rs.runSubsystem].drawCalls++;
+        rs.layers[rs.runLayer].drawCalls++;
+        rs.batchDraws++;
+        rs.pendingVertices = 0;
+    }
+
+    // Equivalent of rlDrawRenderBatch(): submits every pending draw call
+    void RenderStats_Flush() {
+        RenderStatsState& rs = g_renderStats;
+        RenderStats_CloseDrawCall();
+        if (rs.batchVertices > 0) rs.frame.batches++;
+        rs.batchVertices = 0;
+        rs.batchDraws = 0;
+        rs.boundTexture = RSTAT_DEFAULT_TEXTURE;
+        rs.boundMode = RL_QUADS;
+    }
+
+    // 'mode' is the rlBegin primitive (RL_LINES, RL_TRIANGLES or RL_QUADS); like a texture
+    // change, switching it inside a batch starts a new draw call
+    void RenderStats_Submit(unsigned int textureId, int mode, int vertices, int triangles, int quads) {
+        RenderStatsState& rs = g_renderStats;
+        if (vertices <= 0) return;
+
+        bool textureChange = textureId != rs.boundTexture;
+        if (textureChange || mode != rs.boundMode) {
+            RenderStats_CloseDrawCall();
+            if (rs.batchDraws >= RSTAT_BATCH_MAX_DRAWS) RenderStats_Flush();
+            rs.boundTexture = textureId;
+            rs.boundMode = mode;
+            if (textureChange) {
+                rs.frame.textureSwaps++;
+                rs.subsystems[rs.subsystem].textureSwaps++;
+                rs.layers[rs.layer].textureSwaps++;
+            }
+        }
+        if (rs.batchVertices + vertices > RSTAT_BATCH_MAX_VERTICES) {
+            RenderStats_Flush();
+            rs.boundTexture = textureId;
+            rs.boundMode = mode;
+        }
+        if (rs.pendingVertices == 0) {
+            rs.runSubsystem = rs.subsystem;
+            rs.runLayer = rs.layer;
+        }
+
+        rs.pendingVertices += vertices;
+        rs.batchVertices += vertices;
+
+        RenderCounters* targets[3] = { &rs.frame, &rs.subsystems[rs.subsystem], &rs.layers[rs.layer] };
+        for (RenderCounters* c : targets) {
+            c->vertices += vertices;
+            c->triangles += triangles;
+            c->quads += quads;
+        }
+    }
+
+    void RenderStats_Quads(unsigned int textureId, int count) {
+        RenderStats_Submit(textureId, RL_QUADS, count * 4, count * 2, count);
+    }
+
+    void RenderStats_Quad(unsigned int textureId) {
+        RenderStats_Quads(textureId, 1);
+    }
+
+    // Untextured geometry (rectangles, lines, circles...) on the default texture. raylib's
+    // shapes module draws fills as RL_QUADS and outlines as RL_LINES
+    void RenderStats_Shape(int mode, int vertices, int triangles) {
+        RenderStats_Submit(RSTAT_DEFAULT_TEXTURE, mode, vertices, triangles, 0);
+    }
+
+    void RenderStats_Circle() {
+        RenderStats_Shape(RL_QUADS, RSTAT_CIRCLE_SEGMENTS * 2, RSTAT_CIRCLE_SEGMENTS);
+    }
+
+    // One glyph quad per drawn codepoint; like DrawTextEx, UTF-8 sequences count once and
+    // spaces, tabs and newlines draw nothing
+    void RenderStats_Text(unsigned int fontTextureId, const char* text) {
+        if (!text) return;
+        int glyphs = 0;
+        for (const char* c = text; *c;) {
+            int size = 0;
+            int cp = GetCodepointNext(c, &size);
+            if (cp != ' ' && cp != '\n' && cp != '\t') glyphs++;
+            c += size > 0 ? size : 1;
+        }
+        RenderStats_Quads(fontTextureId, glyphs);
+    }
+
+    void RenderStats_Shader(unsigned int shaderId) {
+        RenderStatsState& rs = g_renderStats;
+        if (shaderId == rs.boundShader) return;  // rlSetShader only flushes on an actual change
+        RenderStats_Flush();
+        rs.boundShader = shaderId;
+        rs.frame.shaderSwitches++;
+        rs.subsystems[rs.subsystem].shaderSwitches++;
+        rs.layers[rs.layer].shaderSwitches++;
+    }
+
+    void RenderStats_Target(unsigned int framebufferId) {
+        RenderStatsState& rs = g_renderStats;
+        RenderStats_Flush();
+        if (framebufferId == rs.boundTarget) return;
+        rs.boundTarget = framebufferId;
+        rs.frame.targetSwitches++;
+        rs.subsystems[rs.subsystem].targetSwitches++;
+        rs.layers[rs.layer].targetSwitches++;
+    }
+
+    void RenderStats_ResetFrame() {
+        RenderStatsState& rs = g_renderStats;
+        rs.frame = RenderCounters{};
+        for (auto& c : rs.subsystems) c = RenderCounters{};
+        for (auto& kv : rs.layers) kv.second = RenderCounters{};  // Keep buckets, avoid per-frame allocs
+        rs.pendingVertices = 0;
+        rs.batchVertices = 0;
+        rs.batchDraws = 0;
+        rs.boundTexture = RSTAT_DEFAULT_TEXTURE;
+        rs.boundShader = 0;
+        rs.boundTarget = 0;
+    }
+
+    void RenderStats_BeginFrame() {
+        RenderStats_ResetFrame();
+    }
+
+    // Called right before EndDrawing(), which flushes the final batch
+    void RenderStats_EndFrame() {
+        RenderStatsState& rs = g_renderStats;
+        RenderStats_Flush();
+        rs.lastFrame = rs.frame;
+        for (int i = 0; i < RENDER_SUBSYSTEM_COUNT; i++) rs.lastSubsystems[i] = rs.subsystems[i];
+        rs.lastLayers.clear();
+        rs.lastLayerIds.clear();
+        for (const auto& kv : rs.layers) {
+            if (kv.second.vertices == 0 && kv.second.drawCalls == 0) continue;
+            rs.lastLayers[kv.first] = kv.second;
+            rs.lastLayerIds.push_back(kv.first);
+        }
+        std::sort(rs.lastLayerIds.begin(), rs.lastLayerIds.end());
+    }
+
+    // Attributes submissions to a subsystem (and optionally a layer) for its lifetime
+    struct RenderStatsScope {
+        int prevSubsystem;
+        int prevLayer;
+        RenderStatsScope(int subsystem, int layer = 0)
+            : prevSubsystem(g_renderStats.subsystem), prevLayer(g_renderStats.layer) {
+            g_renderStats.subsystem = subsystem;
+            g_renderStats.layer = layer;
+        }
+        ~RenderStatsScope() {
+            g_renderStats.subsystem = prevSubsystem;
+            g_renderStats.layer = prevLayer;
+        }
+    };
+
+    void RenderStats_SetLayer(int layer) {
+        g_renderStats.layer = layer;
+    }
+}
+
+// ============================================================================
+// FRAME RENDER LIST
+// ============================================================================
+// Between Framework_RenderList_Begin and _End the engine's 2D draw paths append
+// their quads here instead of streaming them into rlgl. Every item carries a
+// (layer, order, material) key and the list is sorted once at End, so scenes
+// that interleave sprites, tiles, particles, trails, skeletons, batches and UI
+// by layer only break the rlgl batch where the material actually changes.
+// Items with equal layer and order are order-independent and get grouped by
+// material; paths whose internal order matters open a RenderListOrderedScope.
+namespace {
+    constexpr int RENDER_QUADS_PER_CHUNK = 1024;
+
+    struct RenderListVertex { float x, y, u, v; Color color; };
+
+    struct RenderListItem {
+        int layer;
+        int order;
+        int sequence;          // 0 = free to regroup, ordered scopes hand out increasing values
+        int blend;
+        unsigned int texId;
+        int subsystem;         // Render stats attribution at submit
+        int firstVertex;
+        int quads;
+    };
+
+    struct RenderListState {
+        bool capturing = false;
+        int layer = 0;
+        int order = 0;
+        int blend = BLEND_ALPHA;
+        int orderedDepth = 0;
+        int nextSequence = 1;
+        std::vector<RenderListVertex> verts;
+        std::vector<RenderListItem> items;
+        std::vector<int> sorted;
+        int lastItems = 0;
+        int lastRuns = 0;      // Material runs submitted by the last End
+    };
+    RenderListState g_renderList;
+
+    // Items appended while at least one scope is open keep their submission order
+    struct RenderListOrderedScope {
+        RenderListOrderedScope() { g_renderList.orderedDepth++; }
+        ~RenderListOrderedScope() { g_renderList.orderedDepth--; }
+    };
+
+    void RenderList_CloseItem(unsigned int texId, int firstVertex) {
+        RenderListState& rl = g_renderList;
+        int quads = ((int)rl.verts.size() - firstVertex) / 4;
+        if (quads <= 0) return;
+
+        bool ordered = rl.orderedDepth > 0;
+        if (!rl.items.empty()) {
+            RenderListItem& prev = rl.items.back();
+            bool sameRun = ordered ? (prev.sequence == rl.nextSequence - 1 && prev.sequence != 0) : prev.sequence == 0;
+            if (sameRun && prev.firstVertex + prev.quads * 4 == firstVertex && prev.layer == rl.layer &&
+                prev.order == rl.order && prev.blend == rl.blend && prev.texId == texId &&
+                prev.subsystem == g_renderStats.subsystem) {
+                prev.quads += quads;
+                return;
+            }
+        }
+        int sequence = ordered ? rl.nextSequence++ : 0;
+        rl.items.push_back({ rl.layer, rl.order, sequence, rl.blend, texId, g_renderStats.subsystem, firstVertex, quads });
+    }
+
+    // Writes quads as TL, BL, BR, TR vertices, either into the render list while capturing or
+    // straight into rlgl in chunks that fit the batch. 'quads' is the expected count, used for
+    // batch-limit checks; writing fewer is fine.
+    class QuadStream {
+    public:
+        QuadStream(unsigned int texId, int quads)
+            : texId_(texId), remaining_(quads > 0 ? quads : 1), capturing_(g_renderList.capturing),
+              firstVertex_((int)g_renderList.verts.size()) {}
+
+        ~QuadStream() {
+            if (capturing_) RenderList_CloseItem(texId_, firstVertex_);
+            else if (chunkVertices_ > 0) EndChunk();
+        }
+
+        void Vertex(float x, float y, float u, float v, Color c) {
+            if (capturing_) {
+                g_renderList.verts.push_back({ x, y, u, v, c });
+                return;
+            }
+            if (chunkVertices_ == 0) {
+                rlCheckRenderBatchLimit(4 * std::min(remaining_, RENDER_QUADS_PER_CHUNK));
+                rlSetTexture(texId_);
+                rlBegin(RL_QUADS);
+                rlNormal3f(0.0f, 0.0f, 1.0f);
+            }
+            rlColor4ub(c.r, c.g, c.b, c.a);
+            rlTexCoord2f(u, v);
+            rlVertex2f(x, y);
+            if (++chunkVertices_ == 4 * RENDER_QUADS_PER_CHUNK) EndChunk();
+        }
+
+        // Axis-aligned quad
+        void Quad(float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, Color c) {
+            Vertex(x0, y0, u0, v0, c);
+            Vertex(x0, y1, u0, v1, c);
+            Vertex(x1, y1, u1, v1, c);
+            Vertex(x1, y0, u1, v0, c);
+        }
+
+    private:
+        void EndChunk() {
+            rlEnd();
+            RenderStats_Quads(texId_, chunkVertices_ / 4);
+            remaining_ = std::max(remaining_ - chunkVertices_ / 4, 1);
+            chunkVertices_ = 0;
+        }
+
+        unsigned int texId_;
+        int remaining_;
+        bool capturing_;
+        int firstVertex_;
+        int chunkVertices_ = 0;
+    };
+
+    // DrawTexturePro into a stream: same origin/rotation handling, negative source width or
+    // height flips
+    void StreamTextureQuad(QuadStream& qs, const Texture2D& tex, Rectangle src, Rectangle dst,
+                           Vector2 origin, float rotation, Color tint) {
+        if (tex.width <= 0 || tex.height <= 0) return;
+        bool flipX = false;
+        if (src.width < 0) { flipX = true; src.width = -src.width; }
+        if (src.height < 0) src.y -= src.height;
+        if (dst.width < 0) dst.width = -dst.width;
+        if (dst.height < 0) dst.height = -dst.height;
+
+        Vector2 tl, tr, bl, br;
+        if (rotation == 0.0f) {
+            float x = dst.x - origin.x, y = dst.y - origin.y;
+            tl = { x, y };
+            tr = { x + dst.width, y };
+            bl = { x, y + dst.height };
+            br = { x + dst.width, y + dst.height };
+        } else {
+            float s = sinf(rotation * DEG2RAD), c = cosf(rotation * DEG2RAD);
+            float dx = -origin.x, dy = -origin.y;
+            tl = { dst.x + dx * c - dy * s, dst.y + dx * s + dy * c };
+            tr = { dst.x + (dx + dst.width) * c - dy * s, dst.y + (dx + dst.width) * s + dy * c };
+            bl = { dst.x + dx * c - (dy + dst.height) * s, dst.y + dx * s + (dy + dst.height) * c };
+            br = { dst.x + (dx + dst.width) * c - (dy + dst.height) * s, dst.y + (dx + dst.width) * s + (dy + dst.height) * c };
+        }
+
+        float w = (float)tex.width, h = (float)tex.height;
+        float u0 = src.x / w, u1 = (src.x + src.width) / w;
+        float v0 = src.y / h, v1 = (src.y + src.height) / h;
+        if (flipX) std::swap(u0, u1);
+        qs.Vertex(tl.x, tl.y, u0, v0, tint);
+        qs.Vertex(bl.x, bl.y, u0, v1, tint);
+        qs.Vertex(br.x, br.y, u1, v1, tint);
+        qs.Vertex(tr.x, tr.y, u1, v0, tint);
+    }
+
+    void DrawTextureQuad(const Texture2D& tex, Rectangle src, Rectangle dst, Vector2 origin, float rotation, Color tint) {
+        if (tex.id == 0) return;
+        QuadStream qs(tex.id, 1);
+        StreamTextureQuad(qs, tex, src, dst, origin, rotation, tint);
+    }
+
+    // UV of the shapes texture's solid texel, for untextured quads on the shapes texture
+    Vector2 ShapesTextureUV() {
+        Texture2D tex = GetShapesTexture();
+        Rectangle rec = GetShapesTextureRectangle();
+        if (tex.id == 0 || tex.width <= 0 || tex.height <= 0) return { 0.0f, 0.0f };
+        return { (rec.x + rec.width * 0.5f) / tex.width, (rec.y + rec.height * 0.5f) / tex.height };
+    }
+
+    // Line of the given thickness as one quad, so lines share the triangle stream's material
+    void StreamLineQuad(QuadStream& qs, Vector2 a, Vector2 b, float thick, Color c, Vector2 uv) {
+        float dx = b.x - a.x, dy = b.y - a.y;
+        float len = sqrtf(dx * dx + dy * dy);
+        if (len <= 0.0f) return;
+        float nx = -dy / len * thick * 0.5f, ny = dx / len * thick * 0.5f;
+        qs.Vertex(a.x - nx, a.y - ny, uv.x, uv.y, c);
+        qs.Vertex(a.x + nx, a.y + ny, uv.x, uv.y, c);
+        qs.Vertex(b.x + nx, b.y + ny, uv.x, uv.y, c);
+        qs.Vertex(b.x - nx, b.y - ny, uv.x, uv.y, c);
+    }
+
+    // Blend mode for the draws that follow: part of the material key while capturing
+    void RenderList_BeginBlend(int mode) {
+        if (g_renderList.capturing) g_renderList.blend = mode;
+        else { RenderStats_Flush(); BeginBlendMode(mode); }
+    }
+
+    void RenderList_EndBlend() {
+        if (g_renderList.capturing) g_renderList.blend = BLEND_ALPHA;
+        else { RenderStats_Flush(); EndBlendMode(); }
+    }
+
+    // Sort once by (layer, order, sequence, blend, texture) and stream runs of equal material
+    void RenderList_Submit() {
+        RenderListState& rl = g_renderList;
+        rl.sorted.resize(rl.items.size());
+        for (int i = 0; i < (int)rl.items.size(); i++) rl.sorted[i] = i;
+        std::stable_sort(rl.sorted.begin(), rl.sorted.end(), [&rl](int ia, int ib) {
+            const RenderListItem& a = rl.items[ia];
+            const RenderListItem& b = rl.items[ib];
+            if (a.layer != b.layer) return a.layer < b.layer;
+            if (a.order != b.order) return a.order < b.order;
+            if (a.sequence != b.sequence) return a.sequence < b.sequence;
+            if (a.blend != b.blend) return a.blend < b.blend;
+            return a.texId < b.texId;
+        });
+
+        int prevSubsystem = g_renderStats.subsystem, prevLayer = g_renderStats.layer;
+        int blend = BLEND_ALPHA;
+        const RenderListItem* last = nullptr;
+        for (int index : rl.sorted) {
+            const RenderListItem& item = rl.items[index];
+            if (!last || item.blend != last->blend || item.texId != last->texId) rl.lastRuns++;
+            if (item.blend != blend) {
+                RenderStats_Flush();
+                if (blend != BLEND_ALPHA) EndBlendMode();
+                if (item.blend != BLEND_ALPHA) BeginBlendMode(item.blend);
+                blend = item.blend;
+            }
+            g_renderStats.subsystem = item.subsystem;
+            g_renderStats.layer = item.layer;
+
+            QuadStream qs(item.texId, item.quads);
+            const RenderListVertex* v = &rl.verts[item.firstVertex];
+            for (int i = 0; i < item.quads * 4; i++) qs.Vertex(v[i].x, v[i].y, v[i].u, v[i].v, v[i].color);
+            last = &item;
+        }
+        if (blend != BLEND_ALPHA) {
+            RenderStats_Flush();
+            EndBlendMode();
+        }
+        rlSetTexture(0);
+        g_renderStats.subsystem = prevSubsystem;
+        g_renderStats.layer = prevLayer;
+    }
+
+    // The list records no camera, render target, scissor, shader or user blend mode, so every
+    // change of those submits what was captured under the old state and keeps capturing.
+    // Sorting therefore only regroups draws between two such changes.
+    void RenderList_Flush() {
+        RenderListState& rl = g_renderList;
+        if (!rl.capturing || rl.items.empty()) return;
+        rl.lastItems += (int)rl.items.size();
+        RenderList_Submit();
+        rl.verts.clear();
+        rl.items.clear();
+    }
+
+    void RenderList_Finish() {
+        RenderListState& rl = g_renderList;
+        if (!rl.capturing) return;
+        RenderList_Flush();
+        rl.capturing = false;
+        rl.layer = 0;
+        rl.order = 0;
+        rl.blend = BLEND_ALPHA;
+    }
+}
+
+// ============================================================================
+// INTERNAL CANVAS
+// ============================================================================
+// With the canvas on, each frame is drawn into an offscreen target of logical
+// size x resolution scale and upscaled to the window at EndDrawing. Game code
+// keeps drawing in logical coordinates: the target's projection maps the
+// logical rect onto however many pixels the current scale allows, and the
+// mouse is remapped through raylib's mouse offset/scale. Dynamic resolution
+// moves the scale inside [minScale, maxScale] and renders into a sub-rect of a
+// target allocated at maxScale, so scale changes never reallocate.
+namespace {
+    struct CanvasState {
+        bool enabled = false;
+        int fixedWidth = 0, fixedHeight = 0;   // Virtual resolution, 0 = follow the window
+        float scale = 1.0f;                    // Resolution scale applied to the logical size
+        int upscale = CANVAS_UPSCALE_LINEAR;
+        Color letterbox = BLACK;
+
+        RenderTexture2D target{};
+        int pixelWidth = 0, pixelHeight = 0;   // Region of the target rendered this frame
+        int filter = -1;                       // Texture filter currently set on the target
+        bool bound = false;                    // Frame is being drawn into the canvas
+        Rectangle dest{ 0, 0, 0, 0 };          // Where the canvas lands in the window
+        double frameStart = 0.0;
+
+        // Dynamic resolution
+        bool dynamic = false;
+        float budgetMs = 16.6f;
+        float minScale = 0.5f, maxScale = 1.0f;
+        float intervalMs = 0.0f;               // Smoothed frame interval (includes pacing)
+        float workMs = 0.0f;                   // Smoothed begin-to-present time
+        int cooldown = 0;
+    };
+    CanvasState g_canvas;
+
+    constexpr float CANVAS_SCALE_STEP = 0.1f;
+    constexpr int   CANVAS_SCALE_COOLDOWN = 30;   // Frames between dynamic scale changes
+    constexpr float CANVAS_SMOOTHING = 0.1f;
+
+    void Canvas_Layout() {
+        CanvasState& c = g_canvas;
+        int ww = WindowWidth_Internal(), wh = WindowHeight_Internal();
+        g_canvasWidth = c.fixedWidth > 0 ? c.fixedWidth : std::max(ww, 1);
+        g_canvasHeight = c.fixedHeight > 0 ? c.fixedHeight : std::max(wh, 1);
+        c.pixelWidth = std::max(1, (int)(g_canvasWidth * c.scale + 0.5f));
+        c.pixelHeight = std::max(1, (int)(g_canvasHeight * c.scale + 0.5f));
+
+        // Integer mode scales by whole multiples of the rendered pixels (falling back to a
+        // plain fit when even 1x does not fit); the others keep aspect and fit the window
+        float fit = std::min((float)ww / c.pixelWidth, (float)wh / c.pixelHeight);
+        if (c.upscale == CANVAS_UPSCALE_INTEGER && fit >= 1.0f) fit = floorf(fit);
+        c.dest.width = c.pixelWidth * fit;
+        c.dest.height = c.pixelHeight * fit;
+        c.dest.x = floorf((ww - c.dest.width) * 0.5f);
+        c.dest.y = floorf((wh - c.dest.height) * 0.5f);
+
+        if (g_headless || c.dest.width <= 0.0f || c.dest.height <= 0.0f) return;
+        SetMouseOffset(-(int)c.dest.x, -(int)c.dest.y);
+        SetMouseScale(g_canvasWidth / c.dest.width, g_canvasHeight / c.dest.height);
+    }
+
+    void Canvas_EnsureTarget() {
+        CanvasState& c = g_canvas;
+        float top = c.dynamic ? std::max(c.maxScale, c.scale) : c.scale;
+        int needW = std::max(c.pixelWidth, (int)(g_canvasWidth * top + 0.5f));
+        int needH = std::max(c.pixelHeight, (int)(g_canvasHeight * top + 0.5f));
+        bool fits = c.target.id != 0 && c.target.texture.width >= needW && c.target.texture.height >= needH;
+        bool exact = c.target.texture.width == needW && c.target.texture.height == needH;
+        if (!fits || (!c.dynamic && !exact)) {
+            if (c.target.id != 0) UnloadRenderTexture(c.target);
+            c.target = LoadRenderTexture(needW, needH);
+            c.filter = -1;
+        }
+        int filter = (c.upscale == CANVAS_UPSCALE_LINEAR) ? TEXTURE_FILTER_BILINEAR : TEXTURE_FILTER_POINT;
+        if (filter != c.filter) {
+            SetTextureFilter(c.target.texture, filter);
+            c.filter = filter;
+        }
+    }
+
+    // Bind the canvas with a projection over the logical rect, rendering into the
+    // bottom-left pixelWidth x pixelHeight of the target
+    void Canvas_Bind() {
+        CanvasState& c = g_canvas;
+        BeginTextureMode(c.target);
+        rlViewport(0, 0, c.pixelWidth, c.pixelHeight);
+        rlMatrixMode(RL_PROJECTION);
+        rlLoadIdentity();
+        rlOrtho(0, g_canvasWidth, g_canvasHeight, 0, 0.0, 1.0);
+        rlMatrixMode(RL_MODELVIEW);
+        rlLoadIdentity();
+    }
+
+    void Canvas_BeginFrame() {
+        CanvasState& c = g_canvas;
+        if (!c.enabled) return;
+        Canvas_Layout();
+        if (g_headless) return;
+        Canvas_EnsureTarget();
+        c.frameStart = GetTime();
+        RenderStats_Target(c.target.id);
+        Canvas_Bind();
+        c.bound = true;
+    }
+
+    // Engine passes that render into their own targets return to the canvas, not the window
+    void Canvas_EndTextureMode() {
+        RenderList_Flush();
+        EndTextureMode();
+        if (g_canvas.bound) {
+            RenderStats_Target(g_canvas.target.id);
+            Canvas_Bind();
+        } else {
+            RenderStats_Target(0);
+        }
+    }
+
+    void Canvas_UpdateDynamic() {
+        CanvasState& c = g_canvas;
+        float interval = GetFrameTime() * 1000.0f;
+        float work = (float)((GetTime() - c.frameStart) * 1000.0);
+        c.intervalMs = c.intervalMs <= 0.0f ? interval : c.intervalMs + (interval - c.intervalMs) * CANVAS_SMOOTHING;
+        c.workMs = c.workMs <= 0.0f ? work : c.workMs + (work - c.workMs) * CANVAS_SMOOTHING;
+        if (c.cooldown > 0) { c.cooldown--; return; }
+
+        // Missed frames lower the scale; frame pacing hides headroom in the interval,
+        // so the scale only climbs back when the measured work is well under budget
+        float next = c.scale;
+        if (c.intervalMs > c.budgetMs * 1.05f) next = std::max(c.minScale, c.scale - CANVAS_SCALE_STEP);
+        else if (c.workMs < c.budgetMs * 0.6f) next = std::min(c.maxScale, c.scale + CANVAS_SCALE_STEP);
+        if (next != c.scale) {
+            c.scale = next;
+            c.cooldown = CANVAS_SCALE_COOLDOWN;
+        }
+    }
+
+    void Canvas_Release() {
+        CanvasState& c = g_canvas;
+        if (c.target.id != 0) UnloadRenderTexture(c.target);
+        c.target = RenderTexture2D{};
+        c.filter = -1;
+        g_canvasWidth = g_canvasHeight = 0;
+        if (!g_headless) {
+            SetMouseOffset(0, 0);
+            SetMouseScale(1.0f, 1.0f);
+        }
+    }
+
+    void Canvas_Present() {
+        CanvasState& c = g_canvas;
+        if (!c.bound) return;
+        c.bound = false;
+        EndTextureMode();
+        RenderStats_Target(0);
+
+        ClearBackground(c.letterbox);
+        Rectangle src = { 0, 0, (float)c.pixelWidth, -(float)c.pixelHeight };
+        RenderStats_Quad(c.target.texture.id);
+        DrawTexturePro(c.target.texture, src, c.dest, Vector2{ 0, 0 }, 0.0f, WHITE);
+        if (!c.enabled) {
+            // Disabled during this frame; the quad above samples the target, so submit it first
+            rlDrawRenderBatchActive();
+            RenderStats_Flush();
+            Canvas_Release();
+            return;
+        }
+        if (c.dynamic) Canvas_UpdateDynamic();
+    }
+}
+
+// ============================================================================
+// TEXT LAYOUT CACHE
+// ============================================================================
+// Laying out a string walks every codepoint, looks up its glyph and sums the
+// advances, and UI labels and dialogue re-lay out the same strings every frame.
+// Layouts are cached by (font, size, spacing, wrap width, text) with LRU
+// eviction; a cached layout draws as a single textured quad run.
+namespace {
+    const int   TEXT_LAYOUT_DEFAULT_CAPACITY = 256;
+    const float TEXT_LINE_SPACING = 2.0f;        // raylib's default textLineSpacing
+    const float TEXT_FALLBACK_ADVANCE = 0.6f;    // Em advance when the font has no glyph data (headless default font)
+
+    struct TextLayoutGlyph {
+        float x, y, w, h;        // Destination quad relative to the layout origin
+        float u0, v0, u1, v1;
+    };
+
+    struct TextLayout {
+        // Key fields (the hash only selects the slot)
+        const GlyphInfo* fontGlyphs = nullptr;
+        unsigned int fontTexture = 0;
+        float fontSize = 0.0f;
+        float spacing = 0.0f;
+        float wrapWidth = 0.0f;
+        std::string text;
+
+        float width = 0.0f;
+        float height = 0.0f;
+        std::vector<int> lineStarts;      // Byte offset where each line begins
+        std::vector<float> lineWidths;
+        std::vector<TextLayoutGlyph> glyphs;  // Visible glyphs only (no spaces/tabs)
+        std::list<uint64_t>::iterator lru;
+    };
+
+    std::unordered_map<uint64_t, TextLayout> g_textLayouts;
+    std::list<uint64_t> g_textLayoutLru;     // Front = most recently used
+    int g_textLayoutCapacity = TEXT_LAYOUT_DEFAULT_CAPACITY;
+    unsigned long long g_textLayoutHits = 0;
+    unsigned long long g_textLayoutMisses = 0;
+
+    uint64_t TextLayoutKey(const Font& font, const char* text, float fontSize, float spacing, float wrapWidth) {
+        uint64_t h = 1469598103934665603ull;  // FNV-1a
+        auto mix = [&h](const void* data, size_t n) {
+            const unsigned char* b = (const unsigned char*)data;
+            for (size_t i = 0; i < n; i++) { h ^= b[i]; h *= 1099511628211ull; }
+        };
+        mix(&font.glyphs, sizeof(font.glyphs));
+        mix(&font.texture.id, sizeof(font.texture.id));
+        mix(&fontSize, sizeof(fontSize));
+        mix(&spacing, sizeof(spacing));
+        mix(&wrapWidth, sizeof(wrapWidth));
+        mix(text, strlen(text));
+        return h;
+    }
+
+    // Mirrors DrawTextEx/MeasureTextEx placement, plus word wrapping at wrapWidth (0 = none)
+    void BuildTextLayout(TextLayout& L, const Font& font) {
+        L.glyphs.clear();
+        L.lineStarts.assign(1, 0);
+        L.lineWidths.clear();
+        L.width = L.height = 0.0f;
+        if (L.text.empty()) return;
+
+        bool hasGlyphs = font.glyphs != nullptr && font.recs != nullptr && font.baseSize > 0;
+        float scale = hasGlyphs ? L.fontSize / (float)font.baseSize : 1.0f;
+        float pad = hasGlyphs ? (float)font.glyphPadding : 0.0f;
+        float texW = font.texture.width > 0 ? (float)font.texture.width : 1.0f;
+        float texH = font.texture.height > 0 ? (float)font.texture.height : 1.0f;
+        float lineAdvance = L.fontSize + TEXT_LINE_SPACING;
+
+        float penX = 0.0f, penY = 0.0f;
+        int spaceByte = -1;          // Last break opportunity on the current line
+        size_t spaceGlyph = 0;
+        float spacePenX = 0.0f, wordStartX = 0.0f;
+
+        auto endLine = [&](float pen) {
+            float w = pen > 0.0f ? pen - L.spacing : 0.0f;
+            L.lineWidths.push_back(w);
+            if (w > L.width) L.width = w;
+        };
+
+        const char* text = L.text.c_str();
+        int len = (int)L.text.size();
+        int i = 0;
+        while (i < len) {
+            int cpSize = 0;
+            int cp = GetCodepointNext(text + i, &cpSize);
+            if (cpSize <= 0) cpSize = 1;
+
+            if (cp == '\n') {
+                endLine(penX);
+                penX = 0.0f;
+                penY += lineAdvance;
+                i += cpSize;
+                L.lineStarts.push_back(i);
+                spaceByte = -1;
+                continue;
+            }
+
+            int index = hasGlyphs ? GetGlyphIndex(font, cp) : 0;
+            float advance = L.fontSize * TEXT_FALLBACK_ADVANCE;
+            if (hasGlyphs) {
+                advance = (font.glyphs[index].advanceX != 0 ? (float)font.glyphs[index].advanceX : font.recs[index].width) * scale;
+            }
+
+            if (L.wrapWidth > 0.0f && cp != ' ' && penX > 0.0f && penX + advance > L.wrapWidth) {
+                if (spaceByte >= 0) {
+                    // Move the partial word after the last space down to a new line
+                    endLine(spacePenX);
+                    for (size_t g = spaceGlyph; g < L.glyphs.size(); g++) {
+                        L.glyphs[g].x -= wordStartX;
+                        L.glyphs[g].y += lineAdvance;
+                    }
+                    penX -= wordStartX;
+                    L.lineStarts.push_back(spaceByte + 1);
+                } else {
+                    // A single word wider than the wrap width breaks mid-word
+                    endLine(penX);
+                    penX = 0.0f;
+                    L.lineStarts.push_back(i);
+                }
+                penY += lineAdvance;
+                spaceByte = -1;
+            }
+
+            if (cp == ' ') {
+                spaceByte = i;
+                spaceGlyph = L.glyphs.size();
+                spacePenX = penX;
+                wordStartX = penX + advance + L.spacing;
+            } else if (cp != '\t' && hasGlyphs) {
+                const Rectangle& r = font.recs[index];
+                TextLayoutGlyph g;
+                g.x = penX + (font.glyphs[index].offsetX - pad) * scale;
+                g.y = penY + (font.glyphs[index].offsetY - pad) * scale;
+                g.w = (r.width + 2.0f * pad) * scale;
+                g.h = (r.height + 2.0f * pad) * scale;
+                g.u0 = (r.x - pad) / texW;
+                g.v0 = (r.y - pad) / texH;
+                g.u1 = (r.x + r.width + pad) / texW;
+                g.v1 = (r.y + r.height + pad) / texH;
+                L.glyphs.push_back(g);
+            }
+
+            penX += advance + L.spacing;
+            i += cpSize;
+        }
+        endLine(penX);
+
+        int lines = (int)L.lineWidths.size();
+        L.height = lines * L.fontSize + (lines - 1) * TEXT_LINE_SPACING;
+    }
+
+    const TextLayout& GetTextLayout(const Font& font, const char* text, float fontSize, float spacing, float wrapWidth) {
+        if (!text) text = "";
+        uint64_t key = TextLayoutKey(font, text, fontSize, spacing, wrapWidth);
+
+        auto it = g_textLayouts.find(key);
+        if (it != g_textLayouts.end()) {
+            TextLayout& L = it->second;
+            g_textLayoutLru.splice(g_textLayoutLru.begin(), g_textLayoutLru, L.lru);
+            if (L.fontGlyphs == font.glyphs && L.fontTexture == font.texture.id && L.fontSize == fontSize &&
+                L.spacing == spacing && L.wrapWidth == wrapWidth && L.text == text) {
+                g_textLayoutHits++;
+                return L;
+            }
+            // Hash collision: the slot is rebuilt for the new request below
+        } else {
+            while (!g_textLayoutLru.empty() && (int)g_textLayouts.size() >= g_textLayoutCapacity) {
+                g_textLayouts.erase(g_textLayoutLru.back());
+                g_textLayoutLru.pop_back();
+            }
+            it = g_textLayouts.emplace(key, TextLayout{}).first;
+            g_textLayoutLru.push_front(key);
+            it->second.lru = g_textLayoutLru.begin();
+        }
+
+        g_textLayoutMisses++;
+        TextLayout& L = it->second;
+        L.fontGlyphs = font.glyphs;
+        L.fontTexture = font.texture.id;
+        L.fontSize = fontSize;
+        L.spacing = spacing;
+        L.wrapWidth = wrapWidth;
+        L.text = text;
+        BuildTextLayout(L, font);
+        return L;
+    }
+
+    void DrawTextLayout(const TextLayout& L, const Font& font, Vector2 pos, Color tint) {
+        {
+            QuadStream qs(font.texture.id, (int)L.glyphs.size());
+            for (const TextLayoutGlyph& g : L.glyphs) {
+                float x = pos.x + g.x, y = pos.y + g.y;
+                qs.Quad(x, y, x + g.w, y + g.h, g.u0, g.v0, g.u1, g.v1, tint);
+            }
+        }
+        rlSetTexture(0);
+    }
+
+    void TextLayout_ForgetFont(const GlyphInfo* glyphs) {
+        for (auto it = g_textLayouts.begin(); it != g_textLayouts.end();) {
+            if (it->second.fontGlyphs == glyphs) {
+                g_textLayoutLru.erase(it->second.lru);
+                it = g_textLayouts.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void TextLayout_Clear() {
+        g_textLayouts.clear();
+        g_textLayoutLru.clear();
+    }
+}
+
+// ============================================================================
+// DEBUG DRAW STREAMS
+// ============================================================================
+// Debug primitives live in fixed-capacity typed arrays sized once up front, and
+// text is copied into a byte arena, so submitting thousands of shapes a frame
+// allocates nothing. Everything is decomposed into lines and triangles at submit
+// and drawn as one shapes-texture quad stream plus one font stream. Expired
+// entries are compacted in place with a single stable sweep per flush.
+namespace {
+    const int DEBUG_DEFAULT_LINES = 16384;
+    const int DEBUG_DEFAULT_TRIANGLES = 8192;
+    const int DEBUG_DEFAULT_TEXTS = 1024;
+    const int DEBUG_DEFAULT_TEXT_BYTES = 32768;
+    const int DEBUG_MAX_GRIDS = 8;
+    const double DEBUG_FOREVER = 1e300;
+
+    struct DebugLine { Vector2 a, b; Color color; int category; double expireAt; };
+    struct DebugTriangle { Vector2 a, b, c; Color color; int category; double expireAt; };
+    struct DebugText { Vector2 pos; Color color; int category; int offset, length; double expireAt; };
+    struct DebugGrid { float cellSize; Color color; int category; double expireAt; };
+
+    // Fixed-capacity array: Push hands out the next slot or fails and counts the drop
+    template <typename T>
+    struct DebugPool {
+        std::vector<T> items;
+        int count = 0;
+        int dropped = 0;
+
+        void Reserve(int capacity) {
+            items.resize(capacity > 0 ? capacity : 0);
+            if (count > (int)items.size()) count = (int)items.size();
+        }
+        T* Push() {
+            if (count >= (int)items.size()) { dropped++; return nullptr; }
+            return &items[count++];
+        }
+        // Keeps survivors in submission order
+        template <typename Keep>
+        void Compact(Keep keep) {
+            int w = 0;
+            for (int r = 0; r < count; r++) {
+                if (!keep(items[r])) continue;
+                if (w != r) items[w] = items[r];
+                w++;
+            }
+            count = w;
+        }
+    };
+
+    struct DebugDrawState {
+        bool initialized = false;
+        DebugPool<DebugLine> lines;
+        DebugPool<DebugTriangle> triangles;
+        DebugPool<DebugText> texts;
+        DebugPool<DebugGrid> grids;
+        std::vector<char> arena;          // Text bytes, NUL-terminated per entry
+        std::vector<char> arenaScratch;   // Compaction target, swapped with arena
+        int arenaUsed = 0;
+        int arenaDropped = 0;
+        unsigned int categoryMask = 0xFFFFFFFFu;
+        int category = 0;                 // Category for new primitives
+        float duration = 0.0f;            // Seconds new primitives stay, 0 = until the next flush
+    };
+    DebugDrawState g_debugDraw;
+
+    void DebugDraw_Init() {
+        DebugDrawState& d = g_debugDraw;
+        if (d.initialized) return;
+        d.lines.Reserve(DEBUG_DEFAULT_LINES);
+        d.triangles.Reserve(DEBUG_DEFAULT_TRIANGLES);
+        d.texts.Reserve(DEBUG_DEFAULT_TEXTS);
+        d.grids.Reserve(DEBUG_MAX_GRIDS);
+        d.arena.resize(DEBUG_DEFAULT_TEXT_BYTES);
+        d.arenaScratch.resize(DEBUG_DEFAULT_TEXT_BYTES);
+        d.initialized = true;
+    }
+
+    // 0 means "gone at the next flush"; persistent mode overrides at flush time
+    double DebugDraw_ExpireAt() {
+        float duration = g_debugDraw.duration;
+        if (duration < 0.0f) return DEBUG_FOREVER;
+        return duration > 0.0f ? WallTime_Internal() + duration : 0.0;
+    }
+
+    void DebugDraw_PushLine(Vector2 a, Vector2 b, Color color) {
+        DebugDraw_Init();
+        DebugLine* l = g_debugDraw.lines.Push();
+        if (l) *l = { a, b, color, g_debugDraw.category, DebugDraw_ExpireAt() };
+    }
+
+    void DebugDraw_PushTriangle(Vector2 a, Vector2 b, Vector2 c, Color color) {
+        DebugDraw_Init();
+        DebugTriangle* t = g_debugDraw.triangles.Push();
+        if (t) *t = { a, b, c, color, g_debugDraw.category, DebugDraw_ExpireAt() };
+    }
+
+    void DebugDraw_PushCircle(Vector2 center, float radius, Color color, bool filled) {
+        if (radius <= 0.0f) return;
+        float step = 2.0f * PI / RSTAT_CIRCLE_SEGMENTS;
+        Vector2 prev = { center.x + radius, center.y };
+        for (int i = 1; i <= RSTAT_CIRCLE_SEGMENTS; i++) {
+            Vector2 next = { center.x + cosf(step * i) * radius, center.y + sinf(step * i) * radius };
+            if (filled) DebugDraw_PushTriangle(center, next, prev, color);
+            else DebugDraw_PushLine(prev, next, color);
+            prev = next;
+        }
+    }
+
+    void DebugDraw_PushText(Vector2 pos, const char* text, Color color) {
+        DebugDraw_Init();
+        DebugDrawState& d = g_debugDraw;
+        int len = (int)strlen(text);
+        if (d.arenaUsed + len + 1 > (int)d.arena.size()) { d.arenaDropped++; return; }
+        DebugText* t = d.texts.Push();
+        if (!t) return;
+        memcpy(d.arena.data() + d.arenaUsed, text, len + 1);
+        *t = { pos, color, d.category, d.arenaUsed, len, DebugDraw_ExpireAt() };
+        d.arenaUsed += len + 1;
+    }
+
+    void DebugDraw_PushGrid(float cellSize, Color color) {
+        if (cellSize <= 0.0f) return;
+        DebugDraw_Init();
+        DebugGrid* g = g_debugDraw.grids.Push();
+        if (g) *g = { cellSize, color, g_debugDraw.category, DebugDraw_ExpireAt() };
+    }
+
+    bool DebugDraw_CategoryVisible(int category) {
+        return category < 0 || category >= 32 || (g_debugDraw.categoryMask & (1u << category)) != 0;
+    }
+
+    // Same glyph placement as DrawText(text, x, y, 10, color)
+    int DebugDraw_StreamText(QuadStream& qs, const Font& font, const char* text, int len, Vector2 pos, Color c) {
+        if (!font.glyphs || !font.recs || font.baseSize <= 0) return 0;
+        const float fontSize = 10.0f, spacing = 1.0f;
+        float scale = fontSize / (float)font.baseSize;
+        float pad = (float)font.glyphPadding;
+        float texW = font.texture.width > 0 ? (float)font.texture.width : 1.0f;
+        float texH = font.texture.height > 0 ? (float)font.texture.height : 1.0f;
+        float penX = 0.0f, penY = 0.0f;
+        int glyphs = 0;
+        for (int i = 0; i < len;) {
+            int cpSize = 0;
+            int cp = GetCodepointNext(text + i, &cpSize);
+            if (cpSize <= 0) cpSize = 1;
+            i += cpSize;
+            if (cp == '\n') { penX = 0.0f; penY += fontSize + TEXT_LINE_SPACING; continue; }
+
+            int index = GetGlyphIndex(font, cp);
+            const Rectangle& r = font.recs[index];
+            if (cp != ' ' && cp != '\t') {
+                float x = pos.x + penX + (font.glyphs[index].offsetX - pad) * scale;
+                float y = pos.y + penY + (font.glyphs[index].offsetY - pad) * scale;
+                qs.Quad(x, y, x + (r.width + 2.0f * pad) * scale, y + (r.height + 2.0f * pad) * scale,
+                        (r.x - pad) / texW, (r.y - pad) / texH, (r.x + r.width + pad) / texW, (r.y + r.height + pad) / texH, c);
+                glyphs++;
+            }
+            penX += (font.glyphs[index].advanceX != 0 ? (float)font.glyphs[index].advanceX : r.width) * scale + spacing;
+        }
+        return glyphs;
+    }
+
+    void DebugDraw_Render() {
+        DebugDrawState& d = g_debugDraw;
+        if (!d.initialized) return;
+
+        int lineQuads = d.lines.count;
+        for (int i = 0; i < d.grids.count; i++) {
+            const DebugGrid& g = d.grids.items[i];
+            lineQuads += (int)(ScreenWidth_Internal() / g.cellSize) + (int)(ScreenHeight_Internal() / g.cellSize) + 2;
+        }
+        {
+            QuadStream qs(GetShapesTexture().id, d.triangles.count + lineQuads);
+            Vector2 uv = ShapesTextureUV();
+            for (int i = 0; i < d.triangles.count; i++) {
+                const DebugTriangle& t = d.triangles.items[i];
+                if (!DebugDraw_CategoryVisible(t.category)) continue;
+                qs.Vertex(t.a.x, t.a.y, uv.x, uv.y, t.color);
+                qs.Vertex(t.b.x, t.b.y, uv.x, uv.y, t.color);
+                qs.Vertex(t.c.x, t.c.y, uv.x, uv.y, t.color);
+                qs.Vertex(t.c.x, t.c.y, uv.x, uv.y, t.color);
+            }
+            for (int i = 0; i < d.grids.count; i++) {
+                const DebugGrid& g = d.grids.items[i];
+                if (!DebugDraw_CategoryVisible(g.category)) continue;
+                float w = (float)ScreenWidth_Internal(), h = (float)ScreenHeight_Internal();
+                for (float x = 0; x < w; x += g.cellSize) StreamLineQuad(qs, { x, 0 }, { x, h }, 1.0f, g.color, uv);
+                for (float y = 0; y < h; y += g.cellSize) StreamLineQuad(qs, { 0, y }, { w, y }, 1.0f, g.color, uv);
+            }
+            for (int i = 0; i < d.lines.count; i++) {
+                const DebugLine& l = d.lines.items[i];
+                if (!DebugDraw_CategoryVisible(l.category)) continue;
+                StreamLineQuad(qs, l.a, l.b, 1.0f, l.color, uv);
+            }
+        }
+        if (d.texts.count > 0) {
+            Font font = GetFontDefault();
+            QuadStream qs(font.texture.id, d.arenaUsed);
+            for (int i = 0; i < d.texts.count; i++) {
+                const DebugText& t = d.texts.items[i];
+                if (!DebugDraw_CategoryVisible(t.category)) continue;
+                DebugDraw_StreamText(qs, font, d.arena.data() + t.offset, t.length, t.pos, t.color);
+            }
+        }
+        rlSetTexture(0);
+    }
+
+    void DebugDraw_Clear() {
+        DebugDrawState& d = g_debugDraw;
+        d.lines.count = d.triangles.count = d.texts.count = d.grids.count = 0;
+        d.lines.dropped = d.triangles.dropped = d.texts.dropped = d.grids.dropped = 0;
+        d.arenaUsed = 0;
+        d.arenaDropped = 0;
+    }
+
+    // Drops everything whose lifetime ended; surviving text is repacked into the scratch arena
+    void DebugDraw_Expire() {
+        DebugDrawState& d = g_debugDraw;
+        if (!d.initialized) return;
+        double now = WallTime_Internal();
+        auto alive = [now](const auto& p) { return p.expireAt > now; };
+        d.lines.Compact(alive);
+        d.triangles.Compact(alive);
+        d.grids.Compact(alive);
+        d.texts.Compact(alive);
+
+        int used = 0;
+        for (int i = 0; i < d.texts.count; i++) {
+            DebugText& t = d.texts.items[i];
+            memcpy(d.arenaScratch.data() + used, d.arena.data() + t.offset, t.length + 1);
+            t.offset = used;
+            used += t.length + 1;
+        }
+        d.arena.swap(d.arenaScratch);
+        d.arenaUsed = used;
+    }
+
+    void DebugDraw_SetCapacity(int lines, int triangles, int texts, int textBytes) {
+        DebugDraw_Init();
+        DebugDrawState& d = g_debugDraw;
+        DebugDraw_Clear();
+        d.lines.Reserve(lines);
+        d.triangles.Reserve(triangles);
+        d.texts.Reserve(texts);
+        d.arena.assign(textBytes > 0 ? textBytes : 0, 0);
+        d.arenaScratch.assign(d.arena.size(), 0);
+    }
+}
+
 // ============================================================================
 // ECS CORE
 // ============================================================================
@@ -547,6 +1839,7 @@ namespace {
     int g_nextEntityId = 1;
     std::unordered_set<Entity> g_entities;
     std::unordered_map<Entity, Transform2D> g_transform2D;
+    std::unordered_map<Entity, Transform2D> g_transformPrev;  // As of the start of the last fixed step
     std::unordered_map<Entity, Sprite2D> g_sprite2D;
     std::unordered_map<Entity, NameComponent> g_name;
     std::unordered_map<Entity, TagComponent> g_tag;
@@ -613,6 +1906,7 @@ namespace {
         RemoveFromParent(e);
         g_entities.erase(e);
         g_transform2D.erase(e);
+        g_transformPrev.erase(e);
         g_sprite2D.erase(e);
         g_name.erase(e);
         g_tag.erase(e);
@@ -625,6 +1919,7 @@ namespace {
     void EcsClearAllInternal() {
         g_entities.clear();
         g_transform2D.clear();
+        g_transformPrev.clear();
         g_sprite2D.clear();
         g_name.clear();
         g_tag.clear();
@@ -680,6 +1975,43 @@ namespace {
         return scale;
     }
 
+    void EcsSnapshotTransforms() {
+        for (const auto& kv : g_transform2D) g_transformPrev[kv.first] = kv.second;
+    }
+
+    // World transform with every local transform blended from its previous fixed-step
+    // state by the interpolation alpha; plain world transform when interpolation is off
+    void GetRenderTransformInternal(Entity e, Vector2& pos, float& rot, Vector2& scale) {
+        pos = Vector2{ 0, 0 }; rot = 0.0f; scale = Vector2{ 1, 1 };
+        auto tIt = g_transform2D.find(e);
+        if (tIt == g_transform2D.end()) return;
+
+        Transform2D t = tIt->second;
+        if (g_fixedInterpolate) {
+            auto pIt = g_transformPrev.find(e);
+            if (pIt != g_transformPrev.end()) {
+                const Transform2D& p = pIt->second;
+                float a = FixedAlphaInternal();
+                t.position.x = p.position.x + (t.position.x - p.position.x) * a;
+                t.position.y = p.position.y + (t.position.y - p.position.y) * a;
+                t.rotation = LerpAngle(p.rotation, t.rotation, a);
+                t.scale.x = p.scale.x + (t.scale.x - p.scale.x) * a;
+                t.scale.y = p.scale.y + (t.scale.y - p.scale.y) * a;
+            }
+        }
+        pos = t.position; rot = t.rotation; scale = t.scale;
+
+        auto hIt = g_hierarchy.find(e);
+        if (hIt != g_hierarchy.end() && hIt->second.parent != -1) {
+            Vector2 pp, ps;
+            float pr;
+            GetRenderTransformInternal(hIt->second.parent, pp, pr, ps);
+            pos.x += pp.x; pos.y += pp.y;
+            rot += pr;
+            scale.x *= ps.x; scale.y *= ps.y;
+        }
+    }
+
     bool IsActiveInHierarchyInternal(Entity e) {
         auto enIt = g_enabled.find(e);
         if (enIt != g_enabled.end() && !enIt->second.enabled) return false;
@@ -740,14 +2072,16 @@ namespace {
                 return a.layer < b.layer;
             });
 
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_SPRITES);
+        int listLayer = g_renderList.layer;
         for (auto& it : items) {
             Sprite2D* sp = it.sprite;
             const Texture2D* tex = GetTextureH_Internal(sp->textureHandle);
             if (!tex) continue;
 
-            Vector2 worldPos = GetWorldPositionInternal(it.entity);
-            float worldRot = GetWorldRotationInternal(it.entity);
-            Vector2 worldScale = GetWorldScaleInternal(it.entity);
+            Vector2 worldPos, worldScale;
+            float worldRot;
+            GetRenderTransformInternal(it.entity, worldPos, worldRot, worldScale);
 
             Rectangle src = sp->source;
 
@@ -763,8 +2097,11 @@ namespace {
 
             Vector2 origin{ dst.width * 0.5f, dst.height * 0.5f };
 
-            DrawTexturePro(*tex, src, dst, origin, worldRot, sp->tint);
+            RenderStats_SetLayer(it.layer);
+            g_renderList.layer = it.layer;
+            DrawTextureQuad(*tex, src, dst, origin, worldRot, sp->tint);
         }
+        g_renderList.layer = listLayer;
     }
 }
 
@@ -860,10 +2197,10 @@ namespace {
     // Initialize render texture for transitions if needed
     void EnsureTransitionRenderTexture() {
         if (!g_sceneManager.renderTextureValid) {
-            int w = GetScreenWidth();
-            int h = GetScreenHeight();
+            int w = ScreenWidth_Internal();
+            int h = ScreenHeight_Internal();
             if (w > 0 && h > 0) {
-                g_sceneManager.transitionRenderTexture = LoadRenderTexture(w, h);
+                g_sceneManager.transitionRenderTexture = LoadRenderTexture_Internal(w, h);
                 g_sceneManager.renderTextureValid = true;
             }
         }
@@ -913,20 +2250,121 @@ namespace {
     int g_nextPrefabHandle = 1;
 }
 
-// Forward declarations
-extern "C" void Framework_UpdateAllMusic();
-extern "C" void Framework_ResourcesShutdown();
-
 // ============================================================================
-// ENGINE STATE & LIFECYCLE
+// WORLD SNAPSHOT STREAM
 // ============================================================================
-extern "C" {
+namespace {
+    // Byte stream behind in-memory world snapshots. One list of Io calls both writes the state
+    // and, on a loading archive, reads it back in the same order. Writing appends to the
+    // caller's vector, so a buffer captured every frame keeps its capacity
+    class SnapshotArchive {
+    public:
+        SnapshotArchive(std::vector<uint8_t>& buffer, bool loading) : buf_(buffer), loading_(loading) {
+            if (!loading_) buf_.clear();
+        }
+
+        bool Loading() const { return loading_; }
+        bool Ok() const { return ok_; }
+        bool AtEnd() const { return pos_ == buf_.size(); }
+
+        void Bytes(void* data, size_t n) {
+            if (!loading_) {
+                const uint8_t* p = (const uint8_t*)data;
+                buf_.insert(buf_.end(), p, p + n);
+                return;
+            }
+            if (!ok_ || n > buf_.size() - pos_) { ok_ = false; return; }
+            memcpy(data, buf_.data() + pos_, n);
+            pos_ += n;
+        }
 
-    bool Framework_Initialize(int width, int height, const char* title) {
-        InitWindow(width, height, title);
-        SetTargetFPS(60);
-        g_engineState = ENGINE_RUNNING;
-        g_frameCount = 0;
+        template <typename T>
+        void Io(T& value) {
+            static_assert(std::is_trivially_copyable<T>::value, "snapshot fields must be plain data");
+            Bytes(&value, sizeof(T));
+        }
+
+        template <typename T>
+        void Io(std::vector<T>& v) {
+            uint32_t n = (uint32_t)v.size();
+            Io(n);
+            if (loading_) {
+                if (!ok_ || (size_t)n * sizeof(T) > buf_.size() - pos_) { ok_ = false; return; }
+                v.resize(n);
+            }
+            if (n) Bytes(v.data(), n * sizeof(T));
+        }
+
+        template <typename K, typename H, typename E, typename A>
+        void Io(std::unordered_set<K, H, E, A>& s) {
+            uint32_t n = (uint32_t)s.size();
+            Io(n);
+            if (!loading_) {
+                for (K k : s) Io(k);
+                return;
+            }
+            s.clear();
+            s.reserve(n);
+            for (uint32_t i = 0; i < n && ok_; i++) { K k; Io(k); s.insert(k); }
+        }
+
+        template <typename K, typename V, typename H, typename E, typename A>
+        void Io(std::unordered_map<K, V, H, E, A>& m) {
+            IoMap(m, [](SnapshotArchive& ar, V& v) { ar.Io(v); });
+        }
+
+        // Maps whose values are not plain data; 'fields' does the Io calls for one value
+        template <typename Map, typename Fields>
+        void IoMap(Map& m, Fields fields) {
+            uint32_t n = (uint32_t)m.size();
+            Io(n);
+            if (!loading_) {
+                for (auto& kv : m) {
+                    typename Map::key_type k = kv.first;
+                    Io(k);
+                    fields(*this, kv.second);
+                }
+                return;
+            }
+            m.clear();
+            m.reserve(n);
+            for (uint32_t i = 0; i < n && ok_; i++) {
+                typename Map::key_type k;
+                Io(k);
+                fields(*this, m[k]);
+            }
+        }
+
+    private:
+        std::vector<uint8_t>& buf_;
+        size_t pos_ = 0;
+        bool loading_;
+        bool ok_ = true;
+    };
+}
+
+// Forward declarations
+extern "C" void Framework_UpdateAllMusic();
+namespace { void Recording_CaptureFrame(); }
+extern "C" void Framework_ResourcesShutdown();
+
+// ============================================================================
+// ENGINE STATE & LIFECYCLE
+// ============================================================================
+extern "C" {
+
+    bool Framework_Initialize(int width, int height, const char* title) {
+        if (g_headless) {
+            g_headlessWidth = width;
+            g_headlessHeight = height;
+            g_headlessTime = 0.0;
+            g_headlessEpoch = std::chrono::steady_clock::now();
+        } else {
+            InitWindow(width, height, title);
+            SetTargetFPS(60);
+        }
+        g_engineState = ENGINE_RUNNING;
+        g_frameCount = 0;
         g_timeScale = 1.0f;
         g_accum = 0.0;
 
@@ -939,30 +2377,77 @@ extern "C" {
         return true;
     }
 
+    // Fixed-step systems driven by the engine loop (defined with their subsystems)
+    void Framework_Ecs_UpdateVelocities(float dt);
+    void Framework_Physics_SyncToEntities();
+    static void Physics_StepOnce(float h);
+
+    static void FixedLoop_RunStep() {
+        if (g_fixedInterpolate) EcsSnapshotTransforms();
+        if (g_fixedUpdateCallback) g_fixedUpdateCallback(g_fixedStep);
+        if (auto sc = TopScene(); sc && sc->cb.onUpdateFixed) sc->cb.onUpdateFixed(g_fixedStep);
+        if (g_fixedSystems & FIXED_SYSTEM_ECS_VELOCITIES) Framework_Ecs_UpdateVelocities((float)g_fixedStep);
+        if (g_fixedSystems & FIXED_SYSTEM_PHYSICS) {
+            Physics_StepOnce((float)g_fixedStep);
+            Framework_Physics_SyncToEntities();
+        }
+    }
+
     void Framework_Update() {
         if (g_engineState == ENGINE_STOPPED) return;
 
         g_frameCount++;
 
-        BeginDrawing();
+        // Headless frames are not paced; the simulated clock advances a fixed step
+        if (g_headless) g_headlessTime += g_headlessFrameTime;
+
+        // Engine-driven fixed steps run before drawing so the frame renders the newest state,
+        // blended by the interpolation alpha
+        bool fixedLoop = FixedLoopActive();
+        if (fixedLoop) {
+            g_fixedStepsThisFrame = 0;
+            if (g_engineState == ENGINE_RUNNING) {
+                g_accum += (double)Framework_GetFrameTime() * g_timeScale;
+                while (g_accum >= g_fixedStep && g_fixedStepsThisFrame < g_fixedMaxSteps) {
+                    g_accum -= g_fixedStep;
+                    g_fixedStepsThisFrame++;
+                    FixedLoop_RunStep();
+                }
+                FixedDropSurplus();
+            }
+        }
+
+        if (!g_headless) BeginDrawing();
+        RenderStats_BeginFrame();
+        Canvas_BeginFrame();
 
         if (userDrawCallback != nullptr) {
             userDrawCallback();
         }
 
-        EndDrawing();
+        RenderList_Finish();
+        Canvas_Present();
+        RenderStats_EndFrame();
+        if (!g_headless) {
+            Recording_CaptureFrame();
+            EndDrawing();
+        }
 
         if (!g_audioPaused) {
             Framework_UpdateAllMusic();
         }
 
-        // Only accumulate time if not paused
-        if (g_engineState == ENGINE_RUNNING) {
-            g_accum += (double)GetFrameTime() * g_timeScale;
+        // Polled mode: time accrues after the draw and Framework_StepFixed consumes it
+        if (!fixedLoop) {
+            g_fixedStepsThisFrame = 0;
+            if (g_engineState == ENGINE_RUNNING) {
+                g_accum += (double)Framework_GetFrameTime() * g_timeScale;
+            }
         }
     }
 
     bool Framework_ShouldClose() {
+        if (g_headless) return g_engineState == ENGINE_QUITTING;
         return WindowShouldClose() || g_engineState == ENGINE_QUITTING;
     }
 
@@ -982,12 +2467,14 @@ extern "C" {
     void Framework_Effects_Shutdown();
     void Framework_Skeleton_DestroyAll();
     void Framework_Cmd_Shutdown();
+    void Framework_Physics_SetThreadCount(int threads);
 
     void Framework_Shutdown() {
         g_engineState = ENGINE_STOPPED;
 
         // Clean up all systems before shutting down
         Framework_Physics_DestroyAllBodies();  // Clear physics bodies
+        Framework_Physics_SetThreadCount(1);   // Join physics workers
         Framework_UI_DestroyAll();             // Clear UI elements
         Framework_Timer_CancelAll();           // Cancel all timers
         Framework_Tween_KillAll();             // Kill all tweens
@@ -1002,11 +2489,14 @@ extern "C" {
         Framework_Effects_Shutdown();          // Shutdown effects
         Framework_Skeleton_DestroyAll();       // Destroy all skeletons
         Framework_Cmd_Shutdown();              // Shutdown command console
+        Framework_EndRecording();              // Flush and close any recording
+        g_canvas.enabled = false;
+        Canvas_Release();                      // Release the internal canvas
 
         // Clear resources and ECS last
         Framework_ResourcesShutdown();
         EcsClearAllInternal();
-        CloseWindow();
+        if (!g_headless) CloseWindow();
     }
 
     int Framework_GetState() {
@@ -1033,6 +2523,20 @@ extern "C" {
         return g_engineState == ENGINE_PAUSED;
     }
 
+    void Framework_SetHeadless(bool headless) {
+        // The window/GL context can't be swapped out from under a running engine
+        if (g_engineState != ENGINE_STOPPED) return;
+        g_headless = headless;
+    }
+
+    bool Framework_IsHeadless() {
+        return g_headless;
+    }
+
+    void Framework_SetHeadlessFrameTime(float seconds) {
+        if (seconds > 0.0f) g_headlessFrameTime = seconds;
+    }
+
     // ========================================================================
     // DRAW CONTROL
     // ========================================================================
@@ -1040,23 +2544,98 @@ extern "C" {
         userDrawCallback = callback;
     }
 
-    void Framework_BeginDrawing() { BeginDrawing(); }
-    void Framework_EndDrawing() { EndDrawing(); }
+    void Framework_BeginDrawing() { if (!g_headless) BeginDrawing(); RenderStats_BeginFrame(); Canvas_BeginFrame(); }
+    void Framework_EndDrawing() {
+        RenderList_Finish();
+        Canvas_Present();
+        RenderStats_EndFrame();
+        if (g_headless) return;
+        Recording_CaptureFrame();
+        EndDrawing();
+    }
+
+    // Internal canvas
+    void Framework_Canvas_Enable(bool enabled) {
+        if (enabled == g_canvas.enabled) return;
+        g_canvas.enabled = enabled;
+        if (enabled) Canvas_Layout();
+        else if (!g_canvas.bound) Canvas_Release();  // A bound canvas is released by Canvas_Present
+    }
+
+    bool Framework_Canvas_IsEnabled() { return g_canvas.enabled; }
+
+    void Framework_Canvas_SetResolution(int width, int height) {
+        g_canvas.fixedWidth = width > 0 ? width : 0;
+        g_canvas.fixedHeight = height > 0 ? height : 0;
+        if (g_canvas.enabled) Canvas_Layout();
+    }
+
+    void Framework_Canvas_SetScale(float scale) {
+        CanvasState& c = g_canvas;
+        c.scale = scale < 0.1f ? 0.1f : (scale > 4.0f ? 4.0f : scale);
+        if (c.dynamic) c.scale = std::max(c.minScale, std::min(c.scale, c.maxScale));
+        if (c.enabled) Canvas_Layout();
+    }
+
+    float Framework_Canvas_GetScale() { return g_canvas.scale; }
+
+    void Framework_Canvas_SetUpscale(int mode) {
+        if (mode < CANVAS_UPSCALE_INTEGER || mode > CANVAS_UPSCALE_LINEAR) return;
+        g_canvas.upscale = mode;
+        if (g_canvas.enabled) Canvas_Layout();
+    }
+
+    int Framework_Canvas_GetUpscale() { return g_canvas.upscale; }
+
+    void Framework_Canvas_SetLetterboxColor(unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        g_canvas.letterbox = Color{ r, g, b, a };
+    }
+
+    void Framework_Canvas_SetDynamic(bool enabled, float budgetMs, float minScale, float maxScale) {
+        CanvasState& c = g_canvas;
+        c.dynamic = enabled;
+        if (budgetMs > 0.0f) c.budgetMs = budgetMs;
+        c.minScale = std::max(0.1f, std::min(minScale, maxScale));
+        c.maxScale = std::min(4.0f, std::max(minScale, maxScale));
+        if (enabled) c.scale = std::max(c.minScale, std::min(c.scale, c.maxScale));
+        c.intervalMs = c.workMs = 0.0f;
+        c.cooldown = 0;
+    }
+
+    bool Framework_Canvas_IsDynamic() { return g_canvas.dynamic; }
+    int Framework_Canvas_GetWidth() { return g_canvas.enabled ? g_canvasWidth : WindowWidth_Internal(); }
+    int Framework_Canvas_GetHeight() { return g_canvas.enabled ? g_canvasHeight : WindowHeight_Internal(); }
+    int Framework_Canvas_GetPixelWidth() { return g_canvas.enabled ? g_canvas.pixelWidth : WindowWidth_Internal(); }
+    int Framework_Canvas_GetPixelHeight() { return g_canvas.enabled ? g_canvas.pixelHeight : WindowHeight_Internal(); }
+
+    // Window coordinates (e.g. touch points) to canvas logical coordinates
+    Vector2 Framework_Canvas_WindowToCanvas(float x, float y) {
+        const CanvasState& c = g_canvas;
+        if (!c.enabled || c.dest.width <= 0.0f || c.dest.height <= 0.0f) return Vector2{ x, y };
+        return Vector2{ (x - c.dest.x) * g_canvasWidth / c.dest.width, (y - c.dest.y) * g_canvasHeight / c.dest.height };
+    }
 
     void Framework_ClearBackground(unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         Color color = { r, g, b, a };
+        RenderList_Flush();
+        RenderStats_Flush();
         ClearBackground(color);
     }
 
     void Framework_DrawText(const char* text, int x, int y, int fontSize,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         Color color = { r, g, b, a };
+        RenderStats_Text(GetFontDefault().texture.id, text);
         DrawText(text, x, y, fontSize, color);
     }
 
     void Framework_DrawRectangle(int x, int y, int w, int h,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         Color color = { r, g, b, a };
+        RenderStats_Shape(RL_QUADS, 4, 2);
         DrawRectangle(x, y, w, h, color);
     }
 
@@ -1064,30 +2643,50 @@ extern "C" {
     // TIMING
     // ========================================================================
     void   Framework_SetTargetFPS(int fps) { SetTargetFPS(fps); }
-    float  Framework_GetFrameTime() { return GetFrameTime(); }
-    float  Framework_GetDeltaTime() { return GetFrameTime() * g_timeScale; }
-    double Framework_GetTime() { return GetTime(); }
-    int    Framework_GetFPS() { return GetFPS(); }
+    float  Framework_GetFrameTime() { return g_headless ? g_headlessFrameTime : GetFrameTime(); }
+    float  Framework_GetDeltaTime() { return Framework_GetFrameTime() * g_timeScale; }
+    double Framework_GetTime() { return g_headless ? g_headlessTime : GetTime(); }
+    int    Framework_GetFPS() { return g_headless ? (int)(1.0f / g_headlessFrameTime + 0.5f) : GetFPS(); }
     unsigned long long Framework_GetFrameCount() { return g_frameCount; }
 
     void  Framework_SetTimeScale(float scale) { g_timeScale = scale < 0.0f ? 0.0f : scale; }
     float Framework_GetTimeScale() { return g_timeScale; }
 
-    void   Framework_SetFixedStep(double seconds) { g_fixedStep = seconds; }
-    void   Framework_ResetFixedClock() { g_accum = 0.0; }
+    void   Framework_SetFixedStep(double seconds) { if (seconds > 0.0) g_fixedStep = seconds; }
+    void   Framework_ResetFixedClock() { g_accum = 0.0; g_fixedDroppedTime = 0.0; }
 
     bool Framework_StepFixed() {
         if (g_engineState != ENGINE_RUNNING) return false;
-        if (g_accum >= g_fixedStep) {
-            g_accum -= g_fixedStep;
-            return true;
+        if (g_accum < g_fixedStep) return false;
+        if (g_fixedStepsThisFrame >= g_fixedMaxSteps) {
+            FixedDropSurplus();
+            return false;
         }
-        return false;
+        g_accum -= g_fixedStep;
+        g_fixedStepsThisFrame++;
+        if (g_fixedInterpolate) EcsSnapshotTransforms();
+        return true;
     }
 
     double Framework_GetFixedStep() { return g_fixedStep; }
     double Framework_GetAccumulator() { return g_accum; }
 
+    void   Framework_SetFixedMaxSteps(int maxSteps) { g_fixedMaxSteps = maxSteps < 1 ? 1 : maxSteps; }
+    int    Framework_GetFixedMaxSteps() { return g_fixedMaxSteps; }
+    int    Framework_GetFixedStepsThisFrame() { return g_fixedStepsThisFrame; }
+    double Framework_GetFixedDroppedTime() { return g_fixedDroppedTime; }
+
+    void   Framework_SetFixedSystems(int systems) { g_fixedSystems = systems; }
+    int    Framework_GetFixedSystems() { return g_fixedSystems; }
+    void   Framework_SetFixedUpdateCallback(SceneUpdateFixedFn callback) { g_fixedUpdateCallback = callback; }
+
+    void   Framework_SetInterpolation(bool enabled) {
+        if (enabled && !g_fixedInterpolate) EcsSnapshotTransforms();
+        g_fixedInterpolate = enabled;
+    }
+    bool   Framework_IsInterpolationEnabled() { return g_fixedInterpolate; }
+    float  Framework_GetFixedAlpha() { return FixedAlphaInternal(); }
+
     // ========================================================================
     // INPUT - KEYBOARD
     // ========================================================================
@@ -1111,18 +2710,18 @@ extern "C" {
     bool    Framework_IsMouseButtonUp(int b) { return IsMouseButtonUp(b); }
     Vector2 Framework_GetMousePosition() { return GetMousePosition(); }
     Vector2 Framework_GetMouseDelta() { return GetMouseDelta(); }
-    void    Framework_SetMousePosition(int x, int y) { SetMousePosition(x, y); }
+    void    Framework_SetMousePosition(int x, int y) { if (g_headless) return; SetMousePosition(x, y); }
     void    Framework_SetMouseOffset(int ox, int oy) { SetMouseOffset(ox, oy); }
     void    Framework_SetMouseScale(float sx, float sy) { SetMouseScale(sx, sy); }
     float   Framework_GetMouseWheelMove() { return GetMouseWheelMove(); }
     Vector2 Framework_GetMouseWheelMoveV() { return GetMouseWheelMoveV(); }
     void    Framework_SetMouseCursor(int cursor) { SetMouseCursor(cursor); }
 
-    void Framework_ShowCursor() { ShowCursor(); }
-    void Framework_HideCursor() { HideCursor(); }
+    void Framework_ShowCursor() { if (g_headless) return; ShowCursor(); }
+    void Framework_HideCursor() { if (g_headless) return; HideCursor(); }
     bool Framework_IsCursorHidden() { return IsCursorHidden(); }
-    void Framework_EnableCursor() { EnableCursor(); }
-    void Framework_DisableCursor() { DisableCursor(); }
+    void Framework_EnableCursor() { if (g_headless) return; EnableCursor(); }
+    void Framework_DisableCursor() { if (g_headless) return; DisableCursor(); }
     bool Framework_IsCursorOnScreen() { return IsCursorOnScreen(); }
 
     // ========================================================================
@@ -1130,36 +2729,50 @@ extern "C" {
     // ========================================================================
     void Framework_DrawPixel(int x, int y,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
+        RenderStats_Shape(RL_QUADS, 4, 2);
         DrawPixel(x, y, Color{ r, g, b, a });
     }
 
     void Framework_DrawLine(int x0, int y0, int x1, int y1,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
+        RenderStats_Shape(RL_LINES, 2, 0);
         DrawLine(x0, y0, x1, y1, Color{ r, g, b, a });
     }
 
     void Framework_DrawCircle(int cx, int cy, float radius,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
+        RenderStats_Circle();
         DrawCircle(cx, cy, radius, Color{ r, g, b, a });
     }
 
     void Framework_DrawCircleLines(int cx, int cy, float radius,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
+        RenderStats_Shape(RL_LINES, RSTAT_CIRCLE_SEGMENTS * 2, 0);
         DrawCircleLines(cx, cy, radius, Color{ r, g, b, a });
     }
 
     void Framework_DrawRectangleLines(int x, int y, int w, int h,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
+        RenderStats_Shape(RL_LINES, 8, 0);
         DrawRectangleLines(x, y, w, h, Color{ r, g, b, a });
     }
 
     void Framework_DrawTriangle(int x1, int y1, int x2, int y2, int x3, int y3,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
+        RenderStats_Shape(RL_QUADS, 3, 1);
         DrawTriangle(Vector2{ (float)x1, (float)y1 }, Vector2{ (float)x2, (float)y2 }, Vector2{ (float)x3, (float)y3 }, Color{ r, g, b, a });
     }
 
     void Framework_DrawTriangleLines(int x1, int y1, int x2, int y2, int x3, int y3,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
+        RenderStats_Shape(RL_LINES, 6, 0);
         DrawTriangleLines(Vector2{ (float)x1, (float)y1 }, Vector2{ (float)x2, (float)y2 }, Vector2{ (float)x3, (float)y3 }, Color{ r, g, b, a });
     }
 
@@ -1185,55 +2798,67 @@ extern "C" {
     // ========================================================================
     Texture2D Framework_LoadTexture(const char* fileName) {
         std::string path = ResolveAssetPath(fileName);
-        return LoadTexture(path.c_str());
+        return LoadTexture_Internal(path.c_str());
     }
 
     void Framework_UnloadTexture(Texture2D texture) { UnloadTexture(texture); }
     bool Framework_IsTextureValid(Texture2D texture) { return IsTextureValid(texture); }
 
-    void Framework_UpdateTexture(Texture2D texture, const void* pixels) { UpdateTexture(texture, pixels); }
-    void Framework_UpdateTextureRec(Texture2D texture, Rectangle rec, const void* pixels) { UpdateTextureRec(texture, rec, pixels); }
-    void Framework_GenTextureMipmaps(Texture2D* texture) { GenTextureMipmaps(texture); }
-    void Framework_SetTextureFilter(Texture2D texture, int filter) { SetTextureFilter(texture, filter); }
-    void Framework_SetTextureWrap(Texture2D texture, int wrap) { SetTextureWrap(texture, wrap); }
+    void Framework_UpdateTexture(Texture2D texture, const void* pixels) { if (g_headless) return; UpdateTexture(texture, pixels); }
+    void Framework_UpdateTextureRec(Texture2D texture, Rectangle rec, const void* pixels) { if (g_headless) return; UpdateTextureRec(texture, rec, pixels); }
+    void Framework_GenTextureMipmaps(Texture2D* texture) { if (g_headless) return; GenTextureMipmaps(texture); }
+    void Framework_SetTextureFilter(Texture2D texture, int filter) { if (g_headless) return; SetTextureFilter(texture, filter); }
+    void Framework_SetTextureWrap(Texture2D texture, int wrap) { if (g_headless) return; SetTextureWrap(texture, wrap); }
 
     void Framework_DrawTexture(Texture2D texture, int posX, int posY,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
+        RenderStats_Quad(texture.id);
         DrawTexture(texture, posX, posY, Color{ r, g, b, a });
     }
 
     void Framework_DrawTextureV(Texture2D texture, Vector2 position,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
+        RenderStats_Quad(texture.id);
         DrawTextureV(texture, position, Color{ r, g, b, a });
     }
 
     void Framework_DrawTextureEx(Texture2D texture, Vector2 position, float rotation, float scale,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
+        RenderStats_Quad(texture.id);
         DrawTextureEx(texture, position, rotation, scale, Color{ r, g, b, a });
     }
 
     void Framework_DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
+        RenderStats_Quad(texture.id);
         DrawTextureRec(texture, source, position, Color{ r, g, b, a });
     }
 
     void Framework_DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin,
         float rotation, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
+        RenderStats_Quad(texture.id);
         DrawTexturePro(texture, source, dest, origin, rotation, Color{ r, g, b, a });
     }
 
     void Framework_DrawTextureNPatch(Texture2D texture, NPatchInfo nPatchInfo, Rectangle dest, Vector2 origin,
         float rotation, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
+        RenderStats_Quads(texture.id, 9);
         DrawTextureNPatch(texture, nPatchInfo, dest, origin, rotation, Color{ r, g, b, a });
     }
 
-    RenderTexture2D Framework_LoadRenderTexture(int width, int height) { return LoadRenderTexture(width, height); }
+    RenderTexture2D Framework_LoadRenderTexture(int width, int height) { return LoadRenderTexture_Internal(width, height); }
     void Framework_UnloadRenderTexture(RenderTexture2D target) { UnloadRenderTexture(target); }
     bool Framework_IsRenderTextureValid(RenderTexture2D target) { return IsRenderTextureValid(target); }
-    void Framework_BeginTextureMode(RenderTexture2D rt) { BeginTextureMode(rt); }
-    void Framework_EndTextureMode() { EndTextureMode(); }
-    void Framework_BeginMode2D(Camera2D cam) { BeginMode2D(cam); }
-    void Framework_EndMode2D() { EndMode2D(); }
+    void Framework_BeginTextureMode(RenderTexture2D rt) { if (g_headless) return; RenderList_Flush(); RenderStats_Target(rt.id); BeginTextureMode(rt); }
+    void Framework_EndTextureMode() { if (g_headless) return; Canvas_EndTextureMode(); }
+    void Framework_BeginMode2D(Camera2D cam) { if (g_headless) return; RenderList_Flush(); RenderStats_Flush(); BeginMode2D(cam); }
+    void Framework_EndMode2D() { if (g_headless) return; RenderList_Flush(); RenderStats_Flush(); EndMode2D(); }
 
     Image Framework_LoadImage(const char* fileName) {
         std::string path = ResolveAssetPath(fileName);
@@ -1368,10 +2993,10 @@ extern "C" {
     void Framework_ImageDraw(Image* dst, Image src, Rectangle srcRec, Rectangle dstRec, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { Color tint = { r, g, b, a }; ImageDraw(dst, src, srcRec, dstRec, tint); }
 
     // ==== TEXTURE GPU ROUND-TRIPS + FONT-IMAGE (raylib 5.5 passthrough — Batch 3d) ====
-    Texture2D Framework_LoadTextureFromImage(Image image) { return LoadTextureFromImage(image); }
+    Texture2D Framework_LoadTextureFromImage(Image image) { return LoadTextureFromImage_Internal(image); }
     TextureCubemap Framework_LoadTextureCubemap(Image image, int layout) { return LoadTextureCubemap(image, layout); }
-    Image Framework_LoadImageFromTexture(Texture2D texture) { return LoadImageFromTexture(texture); }
-    Image Framework_LoadImageFromScreen(void) { return LoadImageFromScreen(); }
+    Image Framework_LoadImageFromTexture(Texture2D texture) { if (g_headless) return Image{}; return LoadImageFromTexture(texture); }
+    Image Framework_LoadImageFromScreen(void) { if (g_headless) return Image{}; return LoadImageFromScreen(); }
     Image Framework_ImageText(const char* text, int fontSize, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { Color c = { r, g, b, a }; return ImageText(text, fontSize, c); }
     Image Framework_ImageTextEx(Font font, const char* text, float fontSize, float spacing, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { Color c = { r, g, b, a }; return ImageTextEx(font, text, fontSize, spacing, c); }
     void Framework_ImageDrawText(Image* dst, const char* text, int posX, int posY, int fontSize, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { Color c = { r, g, b, a }; ImageDrawText(dst, text, posX, posY, fontSize, c); }
@@ -1380,13 +3005,15 @@ extern "C" {
 
     Font Framework_LoadFontEx(const char* fileName, int fontSize, int* glyphs, int glyphCount) {
         std::string path = ResolveAssetPath(fileName);
-        return LoadFontEx(path.c_str(), fontSize, glyphs, glyphCount);
+        return LoadFontEx_Internal(path.c_str(), fontSize, glyphs, glyphCount);
     }
 
-    void Framework_UnloadFont(Font font) { UnloadFont(font); }
+    void Framework_UnloadFont(Font font) { TextLayout_ForgetFont(font.glyphs); UnloadFont_Internal(font); }
 
     void Framework_DrawTextEx(Font font, const char* text, Vector2 pos, float fontSize, float spacing,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
+        RenderStats_Text(font.texture.id, text);
         DrawTextEx(font, text, pos, fontSize, spacing, Color{ r, g, b, a });
     }
 
@@ -1405,8 +3032,8 @@ extern "C" {
         return r;
     }
 
-    void Framework_DrawFPS(int x, int y) { DrawFPS(x, y); }
-    void Framework_DrawGrid(int slices, float spacing) { DrawGrid(slices, spacing); }
+    void Framework_DrawFPS(int x, int y) { if (g_headless) return; DrawFPS(x, y); }
+    void Framework_DrawGrid(int slices, float spacing) { if (g_headless) return; DrawGrid(slices, spacing); }
 
     // ========================================================================
     // CAMERA 2D (Managed)
@@ -1453,10 +3080,16 @@ extern "C" {
             Vector2 pos = GetWorldPositionInternal(g_cameraFollowEntity);
             g_camera.target = pos;
         }
+        if (g_headless) return;
+        RenderList_Flush();
+        RenderStats_Flush();
         BeginMode2D(g_camera);
     }
 
     void Framework_Camera_EndMode() {
+        if (g_headless) return;
+        RenderList_Flush();
+        RenderStats_Flush();
         EndMode2D();
     }
 
@@ -1698,12 +3331,13 @@ extern "C" {
     }
 
     void Framework_Camera_DrawFlash() {
+        if (g_headless) return;
         if (g_camState.flashTimer <= 0) return;
 
         float alpha = g_camState.flashTimer / g_camState.flashDuration;
         unsigned char a = (unsigned char)(g_camState.flashA * alpha);
 
-        DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(),
+        DrawRectangle(0, 0, ScreenWidth_Internal(), ScreenHeight_Internal(),
             Color{ g_camState.flashR, g_camState.flashG, g_camState.flashB, a });
     }
 
@@ -1816,8 +3450,8 @@ extern "C" {
         // Apply bounds constraints
         if (g_camState.boundsEnabled) {
             // Calculate visible area in world coords
-            float viewW = (float)GetScreenWidth() / g_camera.zoom;
-            float viewH = (float)GetScreenHeight() / g_camera.zoom;
+            float viewW = (float)ScreenWidth_Internal() / g_camera.zoom;
+            float viewH = (float)ScreenHeight_Internal() / g_camera.zoom;
             float halfW = viewW / 2.0f;
             float halfH = viewH / 2.0f;
 
@@ -1875,7 +3509,7 @@ extern "C" {
     // Reset camera to defaults
     void Framework_Camera_Reset() {
         g_camera.target = Vector2{ 0, 0 };
-        g_camera.offset = Vector2{ (float)GetScreenWidth() / 2.0f, (float)GetScreenHeight() / 2.0f };
+        g_camera.offset = Vector2{ (float)ScreenWidth_Internal() / 2.0f, (float)ScreenHeight_Internal() / 2.0f };
         g_camera.rotation = 0;
         g_camera.zoom = 1.0f;
         g_cameraFollowEntity = -1;
@@ -2046,8 +3680,8 @@ extern "C" {
     // wraps InitWindow + camera/timing setup; Framework_Shutdown wraps CloseWindow after tearing systems down). A raw
     // consumer calls Framework_InitWindow / Framework_CloseWindow directly and owns the window lifecycle itself.
     void  Framework_InitWindow(int width, int height, const char* title) { InitWindow(width, height, title); }
-    void  Framework_CloseWindow(void) { CloseWindow(); }
-    bool  Framework_WindowShouldClose(void) { return WindowShouldClose(); }
+    void  Framework_CloseWindow(void) { if (g_headless) return; CloseWindow(); }
+    bool  Framework_WindowShouldClose(void) { return g_headless ? false : WindowShouldClose(); }
     bool  Framework_IsWindowReady(void) { return IsWindowReady(); }
     bool  Framework_IsWindowFullscreen(void) { return IsWindowFullscreen(); }
     bool  Framework_IsWindowHidden(void) { return IsWindowHidden(); }
@@ -2056,18 +3690,18 @@ extern "C" {
     bool  Framework_IsWindowFocused(void) { return IsWindowFocused(); }
     bool  Framework_IsWindowResized(void) { return IsWindowResized(); }
     bool  Framework_IsWindowState(unsigned int flag) { return IsWindowState(flag); }
-    void  Framework_SetWindowState(unsigned int flags) { SetWindowState(flags); }
-    void  Framework_ClearWindowState(unsigned int flags) { ClearWindowState(flags); }
-    void  Framework_MaximizeWindow(void) { MaximizeWindow(); }
-    void  Framework_MinimizeWindow(void) { MinimizeWindow(); }
-    void  Framework_RestoreWindow(void) { RestoreWindow(); }
-    void  Framework_SetWindowIcon(Image image) { SetWindowIcon(image); }
-    void  Framework_SetWindowIcons(Image* images, int count) { SetWindowIcons(images, count); }
-    void  Framework_SetWindowPosition(int x, int y) { SetWindowPosition(x, y); }
-    void  Framework_SetWindowMonitor(int monitor) { SetWindowMonitor(monitor); }
-    void  Framework_SetWindowMaxSize(int width, int height) { SetWindowMaxSize(width, height); }
-    void  Framework_SetWindowOpacity(float opacity) { SetWindowOpacity(opacity); }
-    void  Framework_SetWindowFocused(void) { SetWindowFocused(); }
+    void  Framework_SetWindowState(unsigned int flags) { if (g_headless) return; SetWindowState(flags); }
+    void  Framework_ClearWindowState(unsigned int flags) { if (g_headless) return; ClearWindowState(flags); }
+    void  Framework_MaximizeWindow(void) { if (g_headless) return; MaximizeWindow(); }
+    void  Framework_MinimizeWindow(void) { if (g_headless) return; MinimizeWindow(); }
+    void  Framework_RestoreWindow(void) { if (g_headless) return; RestoreWindow(); }
+    void  Framework_SetWindowIcon(Image image) { if (g_headless) return; SetWindowIcon(image); }
+    void  Framework_SetWindowIcons(Image* images, int count) { if (g_headless) return; SetWindowIcons(images, count); }
+    void  Framework_SetWindowPosition(int x, int y) { if (g_headless) return; SetWindowPosition(x, y); }
+    void  Framework_SetWindowMonitor(int monitor) { if (g_headless) return; SetWindowMonitor(monitor); }
+    void  Framework_SetWindowMaxSize(int width, int height) { if (g_headless) return; SetWindowMaxSize(width, height); }
+    void  Framework_SetWindowOpacity(float opacity) { if (g_headless) return; SetWindowOpacity(opacity); }
+    void  Framework_SetWindowFocused(void) { if (g_headless) return; SetWindowFocused(); }
     void* Framework_GetWindowHandle(void) { return GetWindowHandle(); }
 
     // ==== RAW RCORE PARITY — Window/monitor query & clipboard (raylib 5.5 passthrough, Batch core-C2) ====
@@ -2082,7 +3716,7 @@ extern "C" {
     Vector2     Framework_GetWindowPosition(void) { return GetWindowPosition(); }
     Vector2     Framework_GetWindowScaleDPI(void) { return GetWindowScaleDPI(); }
     const char* Framework_GetMonitorName(int monitor) { return GetMonitorName(monitor); }
-    void        Framework_SetClipboardText(const char* text) { SetClipboardText(text); }
+    void        Framework_SetClipboardText(const char* text) { if (g_headless) return; SetClipboardText(text); }
     const char* Framework_GetClipboardText(void) { return GetClipboardText(); }
     Image       Framework_GetClipboardImage(void) { return GetClipboardImage(); }
     void        Framework_EnableEventWaiting(void) { EnableEventWaiting(); }
@@ -2120,25 +3754,37 @@ extern "C" {
 
     // ==== RAW RCORE PARITY — Shader management (raylib 5.5 passthrough, Batch core-C4) ====
     // 1:1 forwarders. GetShaderLocation + UnloadShader already forwarded above. Shader/Matrix/Texture2D pass by value.
-    Shader Framework_LoadShader(const char* vsFileName, const char* fsFileName) { return LoadShader(vsFileName, fsFileName); }
-    Shader Framework_LoadShaderFromMemory(const char* vsCode, const char* fsCode) { return LoadShaderFromMemory(vsCode, fsCode); }
+    Shader Framework_LoadShader(const char* vsFileName, const char* fsFileName) { return LoadShader_Internal(vsFileName, fsFileName); }
+    Shader Framework_LoadShaderFromMemory(const char* vsCode, const char* fsCode) { return LoadShaderFromMemory_Internal(vsCode, fsCode); }
     bool   Framework_IsShaderValid(Shader shader) { return IsShaderValid(shader); }
     int    Framework_GetShaderLocationAttrib(Shader shader, const char* attribName) { return GetShaderLocationAttrib(shader, attribName); }
-    void   Framework_SetShaderValue(Shader shader, int locIndex, const void* value, int uniformType) { SetShaderValue(shader, locIndex, value, uniformType); }
-    void   Framework_SetShaderValueV(Shader shader, int locIndex, const void* value, int uniformType, int count) { SetShaderValueV(shader, locIndex, value, uniformType, count); }
-    void   Framework_SetShaderValueMatrix(Shader shader, int locIndex, Matrix mat) { SetShaderValueMatrix(shader, locIndex, mat); }
-    void   Framework_SetShaderValueTexture(Shader shader, int locIndex, Texture2D texture) { SetShaderValueTexture(shader, locIndex, texture); }
+    void   Framework_SetShaderValue(Shader shader, int locIndex, const void* value, int uniformType) { if (g_headless) return; SetShaderValue(shader, locIndex, value, uniformType); }
+    void   Framework_SetShaderValueV(Shader shader, int locIndex, const void* value, int uniformType, int count) { if (g_headless) return; SetShaderValueV(shader, locIndex, value, uniformType, count); }
+    void   Framework_SetShaderValueMatrix(Shader shader, int locIndex, Matrix mat) { if (g_headless) return; SetShaderValueMatrix(shader, locIndex, mat); }
+    void   Framework_SetShaderValueTexture(Shader shader, int locIndex, Texture2D texture) { if (g_headless) return; SetShaderValueTexture(shader, locIndex, texture); }
 
     // ==== RAW RCORE PARITY — Drawing modes & VR simulator (raylib 5.5 passthrough, Batch core-C3) ====
     // 1:1 forwarders. Camera3D/VrStereoConfig/VrDeviceInfo pass by value; LoadVrStereoConfig returns VrStereoConfig by value.
-    void            Framework_BeginMode3D(Camera3D camera) { BeginMode3D(camera); }
-    void            Framework_EndMode3D() { EndMode3D(); }
-    void            Framework_BeginBlendMode(int mode) { BeginBlendMode(mode); }
-    void            Framework_EndBlendMode() { EndBlendMode(); }
-    void            Framework_BeginScissorMode(int x, int y, int width, int height) { BeginScissorMode(x, y, width, height); }
-    void            Framework_EndScissorMode() { EndScissorMode(); }
-    void            Framework_BeginVrStereoMode(VrStereoConfig config) { BeginVrStereoMode(config); }
-    void            Framework_EndVrStereoMode() { EndVrStereoMode(); }
+    void            Framework_BeginMode3D(Camera3D camera) { if (g_headless) return; RenderList_Flush(); BeginMode3D(camera); }
+    void            Framework_EndMode3D() { if (g_headless) return; RenderList_Flush(); EndMode3D(); }
+    void            Framework_BeginBlendMode(int mode) { if (g_headless) return; RenderList_Flush(); RenderStats_Flush(); BeginBlendMode(mode); }
+    void            Framework_EndBlendMode() { if (g_headless) return; RenderList_Flush(); RenderStats_Flush(); EndBlendMode(); }
+    void            Framework_BeginScissorMode(int x, int y, int width, int height) {
+        if (g_headless) return;
+        RenderList_Flush();
+        RenderStats_Flush();
+        if (g_canvas.bound) {
+            // Logical rect to the canvas's pixel region (raylib flips y against the full target)
+            float sx = (float)g_canvas.pixelWidth / g_canvasWidth, sy = (float)g_canvas.pixelHeight / g_canvasHeight;
+            int offsetY = g_canvas.target.texture.height - g_canvas.pixelHeight;
+            BeginScissorMode((int)(x * sx), (int)(y * sy) + offsetY, (int)(width * sx), (int)(height * sy));
+            return;
+        }
+        BeginScissorMode(x, y, width, height);
+    }
+    void            Framework_EndScissorMode() { if (g_headless) return; RenderList_Flush(); RenderStats_Flush(); EndScissorMode(); }
+    void            Framework_BeginVrStereoMode(VrStereoConfig config) { if (g_headless) return; RenderList_Flush(); BeginVrStereoMode(config); }
+    void            Framework_EndVrStereoMode() { if (g_headless) return; RenderList_Flush(); EndVrStereoMode(); }
     VrStereoConfig  Framework_LoadVrStereoConfig(VrDeviceInfo device) { return LoadVrStereoConfig(device); }
     void            Framework_UnloadVrStereoConfig(VrStereoConfig config) { UnloadVrStereoConfig(config); }
 
@@ -2195,26 +3841,26 @@ extern "C" {
 
     // ==== RAW rmodels PARITY — Basic 3D shapes drawing (raylib 5.5 passthrough, Batch models-shapes) ====
     // 1:1 forwarders. Color reconstructed from r,g,b,a bytes; Vector3/Vector2/Ray by value; const Vector3* array passthrough.
-    void Framework_DrawLine3D(Vector3 startPos, Vector3 endPos, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawLine3D(startPos, endPos, Color{r, g, b, a}); }
-    void Framework_DrawPoint3D(Vector3 position, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawPoint3D(position, Color{r, g, b, a}); }
-    void Framework_DrawCircle3D(Vector3 center, float radius, Vector3 rotationAxis, float rotationAngle, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawCircle3D(center, radius, rotationAxis, rotationAngle, Color{r, g, b, a}); }
-    void Framework_DrawTriangle3D(Vector3 v1, Vector3 v2, Vector3 v3, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawTriangle3D(v1, v2, v3, Color{r, g, b, a}); }
-    void Framework_DrawTriangleStrip3D(const Vector3* points, int pointCount, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawTriangleStrip3D(points, pointCount, Color{r, g, b, a}); }
-    void Framework_DrawCube(Vector3 position, float width, float height, float length, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawCube(position, width, height, length, Color{r, g, b, a}); }
-    void Framework_DrawCubeV(Vector3 position, Vector3 size, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawCubeV(position, size, Color{r, g, b, a}); }
-    void Framework_DrawCubeWires(Vector3 position, float width, float height, float length, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawCubeWires(position, width, height, length, Color{r, g, b, a}); }
-    void Framework_DrawCubeWiresV(Vector3 position, Vector3 size, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawCubeWiresV(position, size, Color{r, g, b, a}); }
-    void Framework_DrawSphere(Vector3 centerPos, float radius, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawSphere(centerPos, radius, Color{r, g, b, a}); }
-    void Framework_DrawSphereEx(Vector3 centerPos, float radius, int rings, int slices, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawSphereEx(centerPos, radius, rings, slices, Color{r, g, b, a}); }
-    void Framework_DrawSphereWires(Vector3 centerPos, float radius, int rings, int slices, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawSphereWires(centerPos, radius, rings, slices, Color{r, g, b, a}); }
-    void Framework_DrawCylinder(Vector3 position, float radiusTop, float radiusBottom, float height, int slices, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawCylinder(position, radiusTop, radiusBottom, height, slices, Color{r, g, b, a}); }
-    void Framework_DrawCylinderEx(Vector3 startPos, Vector3 endPos, float startRadius, float endRadius, int sides, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawCylinderEx(startPos, endPos, startRadius, endRadius, sides, Color{r, g, b, a}); }
-    void Framework_DrawCylinderWires(Vector3 position, float radiusTop, float radiusBottom, float height, int slices, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawCylinderWires(position, radiusTop, radiusBottom, height, slices, Color{r, g, b, a}); }
-    void Framework_DrawCylinderWiresEx(Vector3 startPos, Vector3 endPos, float startRadius, float endRadius, int sides, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawCylinderWiresEx(startPos, endPos, startRadius, endRadius, sides, Color{r, g, b, a}); }
-    void Framework_DrawCapsule(Vector3 startPos, Vector3 endPos, float radius, int slices, int rings, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawCapsule(startPos, endPos, radius, slices, rings, Color{r, g, b, a}); }
-    void Framework_DrawCapsuleWires(Vector3 startPos, Vector3 endPos, float radius, int slices, int rings, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawCapsuleWires(startPos, endPos, radius, slices, rings, Color{r, g, b, a}); }
-    void Framework_DrawPlane(Vector3 centerPos, Vector2 size, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawPlane(centerPos, size, Color{r, g, b, a}); }
-    void Framework_DrawRay(Ray ray, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawRay(ray, Color{r, g, b, a}); }
+    void Framework_DrawLine3D(Vector3 startPos, Vector3 endPos, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawLine3D(startPos, endPos, Color{r, g, b, a}); }
+    void Framework_DrawPoint3D(Vector3 position, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawPoint3D(position, Color{r, g, b, a}); }
+    void Framework_DrawCircle3D(Vector3 center, float radius, Vector3 rotationAxis, float rotationAngle, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawCircle3D(center, radius, rotationAxis, rotationAngle, Color{r, g, b, a}); }
+    void Framework_DrawTriangle3D(Vector3 v1, Vector3 v2, Vector3 v3, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawTriangle3D(v1, v2, v3, Color{r, g, b, a}); }
+    void Framework_DrawTriangleStrip3D(const Vector3* points, int pointCount, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawTriangleStrip3D(points, pointCount, Color{r, g, b, a}); }
+    void Framework_DrawCube(Vector3 position, float width, float height, float length, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawCube(position, width, height, length, Color{r, g, b, a}); }
+    void Framework_DrawCubeV(Vector3 position, Vector3 size, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawCubeV(position, size, Color{r, g, b, a}); }
+    void Framework_DrawCubeWires(Vector3 position, float width, float height, float length, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawCubeWires(position, width, height, length, Color{r, g, b, a}); }
+    void Framework_DrawCubeWiresV(Vector3 position, Vector3 size, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawCubeWiresV(position, size, Color{r, g, b, a}); }
+    void Framework_DrawSphere(Vector3 centerPos, float radius, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawSphere(centerPos, radius, Color{r, g, b, a}); }
+    void Framework_DrawSphereEx(Vector3 centerPos, float radius, int rings, int slices, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawSphereEx(centerPos, radius, rings, slices, Color{r, g, b, a}); }
+    void Framework_DrawSphereWires(Vector3 centerPos, float radius, int rings, int slices, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawSphereWires(centerPos, radius, rings, slices, Color{r, g, b, a}); }
+    void Framework_DrawCylinder(Vector3 position, float radiusTop, float radiusBottom, float height, int slices, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawCylinder(position, radiusTop, radiusBottom, height, slices, Color{r, g, b, a}); }
+    void Framework_DrawCylinderEx(Vector3 startPos, Vector3 endPos, float startRadius, float endRadius, int sides, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawCylinderEx(startPos, endPos, startRadius, endRadius, sides, Color{r, g, b, a}); }
+    void Framework_DrawCylinderWires(Vector3 position, float radiusTop, float radiusBottom, float height, int slices, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawCylinderWires(position, radiusTop, radiusBottom, height, slices, Color{r, g, b, a}); }
+    void Framework_DrawCylinderWiresEx(Vector3 startPos, Vector3 endPos, float startRadius, float endRadius, int sides, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawCylinderWiresEx(startPos, endPos, startRadius, endRadius, sides, Color{r, g, b, a}); }
+    void Framework_DrawCapsule(Vector3 startPos, Vector3 endPos, float radius, int slices, int rings, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawCapsule(startPos, endPos, radius, slices, rings, Color{r, g, b, a}); }
+    void Framework_DrawCapsuleWires(Vector3 startPos, Vector3 endPos, float radius, int slices, int rings, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawCapsuleWires(startPos, endPos, radius, slices, rings, Color{r, g, b, a}); }
+    void Framework_DrawPlane(Vector3 centerPos, Vector2 size, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawPlane(centerPos, size, Color{r, g, b, a}); }
+    void Framework_DrawRay(Ray ray, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawRay(ray, Color{r, g, b, a}); }
 
     // ==== RAW rmodels PARITY — Mesh generation & management (raylib 5.5 passthrough, Batch models-mesh) ====
     // 1:1 forwarders. Mesh/Image/Ray/Matrix by value; Mesh* mutate-in-place for UploadMesh/GenMeshTangents; const void* and
@@ -2248,16 +3894,16 @@ extern "C" {
     bool Framework_IsModelValid(Model model) { return IsModelValid(model); }
     void Framework_UnloadModel(Model model) { UnloadModel(model); }
     BoundingBox Framework_GetModelBoundingBox(Model model) { return GetModelBoundingBox(model); }
-    void Framework_DrawModel(Model model, Vector3 position, float scale, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawModel(model, position, scale, Color{r, g, b, a}); }
-    void Framework_DrawModelEx(Model model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawModelEx(model, position, rotationAxis, rotationAngle, scale, Color{r, g, b, a}); }
-    void Framework_DrawModelWires(Model model, Vector3 position, float scale, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawModelWires(model, position, scale, Color{r, g, b, a}); }
-    void Framework_DrawModelWiresEx(Model model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawModelWiresEx(model, position, rotationAxis, rotationAngle, scale, Color{r, g, b, a}); }
-    void Framework_DrawModelPoints(Model model, Vector3 position, float scale, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawModelPoints(model, position, scale, Color{r, g, b, a}); }
-    void Framework_DrawModelPointsEx(Model model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawModelPointsEx(model, position, rotationAxis, rotationAngle, scale, Color{r, g, b, a}); }
-    void Framework_DrawBoundingBox(BoundingBox box, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawBoundingBox(box, Color{r, g, b, a}); }
-    void Framework_DrawBillboard(Camera camera, Texture2D texture, Vector3 position, float scale, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawBillboard(camera, texture, position, scale, Color{r, g, b, a}); }
-    void Framework_DrawBillboardRec(Camera camera, Texture2D texture, Rectangle source, Vector3 position, Vector2 size, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawBillboardRec(camera, texture, source, position, size, Color{r, g, b, a}); }
-    void Framework_DrawBillboardPro(Camera camera, Texture2D texture, Rectangle source, Vector3 position, Vector3 up, Vector2 size, Vector2 origin, float rotation, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { DrawBillboardPro(camera, texture, source, position, up, size, origin, rotation, Color{r, g, b, a}); }
+    void Framework_DrawModel(Model model, Vector3 position, float scale, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawModel(model, position, scale, Color{r, g, b, a}); }
+    void Framework_DrawModelEx(Model model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawModelEx(model, position, rotationAxis, rotationAngle, scale, Color{r, g, b, a}); }
+    void Framework_DrawModelWires(Model model, Vector3 position, float scale, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawModelWires(model, position, scale, Color{r, g, b, a}); }
+    void Framework_DrawModelWiresEx(Model model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawModelWiresEx(model, position, rotationAxis, rotationAngle, scale, Color{r, g, b, a}); }
+    void Framework_DrawModelPoints(Model model, Vector3 position, float scale, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawModelPoints(model, position, scale, Color{r, g, b, a}); }
+    void Framework_DrawModelPointsEx(Model model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawModelPointsEx(model, position, rotationAxis, rotationAngle, scale, Color{r, g, b, a}); }
+    void Framework_DrawBoundingBox(BoundingBox box, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawBoundingBox(box, Color{r, g, b, a}); }
+    void Framework_DrawBillboard(Camera camera, Texture2D texture, Vector3 position, float scale, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawBillboard(camera, texture, position, scale, Color{r, g, b, a}); }
+    void Framework_DrawBillboardRec(Camera camera, Texture2D texture, Rectangle source, Vector3 position, Vector2 size, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawBillboardRec(camera, texture, source, position, size, Color{r, g, b, a}); }
+    void Framework_DrawBillboardPro(Camera camera, Texture2D texture, Rectangle source, Vector3 position, Vector3 up, Vector2 size, Vector2 origin, float rotation, unsigned char r, unsigned char g, unsigned char b, unsigned char a) { if (g_headless) return; DrawBillboardPro(camera, texture, source, position, up, size, origin, rotation, Color{r, g, b, a}); }
 
     // ==== RAW rmodels PARITY — Materials + material-drawn meshes (raylib 5.5 passthrough, Batch models-materials) ====
     // 1:1 forwarders. Material/MaterialMap/Mesh/Texture2D/Matrix by value; Material*/Model* and const Matrix* passthrough.
@@ -2268,14 +3914,14 @@ extern "C" {
     void Framework_UnloadMaterial(Material material) { UnloadMaterial(material); }
     void Framework_SetMaterialTexture(Material* material, int mapType, Texture2D texture) { SetMaterialTexture(material, mapType, texture); }
     void Framework_SetModelMeshMaterial(Model* model, int meshId, int materialId) { SetModelMeshMaterial(model, meshId, materialId); }
-    void Framework_DrawMesh(Mesh mesh, Material material, Matrix transform) { DrawMesh(mesh, material, transform); }
-    void Framework_DrawMeshInstanced(Mesh mesh, Material material, const Matrix* transforms, int instances) { DrawMeshInstanced(mesh, material, transforms, instances); }
+    void Framework_DrawMesh(Mesh mesh, Material material, Matrix transform) { if (g_headless) return; DrawMesh(mesh, material, transform); }
+    void Framework_DrawMeshInstanced(Mesh mesh, Material material, const Matrix* transforms, int instances) { if (g_headless) return; DrawMeshInstanced(mesh, material, transforms, instances); }
 
     // ==== RAW rmodels PARITY — Model animations (raylib 5.5 passthrough, Batch models-animations) — CLOSES rmodels ====
     // 1:1 forwarders. Model/ModelAnimation by value; ModelAnimation* array passthrough. Update* need a real animated model.
     ModelAnimation* Framework_LoadModelAnimations(const char* fileName, int* animCount) { return LoadModelAnimations(fileName, animCount); }
-    void Framework_UpdateModelAnimation(Model model, ModelAnimation anim, int frame) { UpdateModelAnimation(model, anim, frame); }
-    void Framework_UpdateModelAnimationBones(Model model, ModelAnimation anim, int frame) { UpdateModelAnimationBones(model, anim, frame); }
+    void Framework_UpdateModelAnimation(Model model, ModelAnimation anim, int frame) { if (g_headless) return; UpdateModelAnimation(model, anim, frame); }
+    void Framework_UpdateModelAnimationBones(Model model, ModelAnimation anim, int frame) { if (g_headless) return; UpdateModelAnimationBones(model, anim, frame); }
     void Framework_UnloadModelAnimation(ModelAnimation anim) { UnloadModelAnimation(anim); }
     void Framework_UnloadModelAnimations(ModelAnimation* animations, int animCount) { UnloadModelAnimations(animations, animCount); }
     bool Framework_IsModelAnimationValid(Model model, ModelAnimation anim) { return IsModelAnimationValid(model, anim); }
@@ -2408,30 +4054,35 @@ extern "C" {
     Shader Framework_LoadShaderF(const char* vsPath, const char* fsPath) {
         std::string vs = vsPath ? ResolveAssetPath(vsPath) : "";
         std::string fs = fsPath ? ResolveAssetPath(fsPath) : "";
-        return LoadShader(vs.empty() ? nullptr : vs.c_str(), fs.empty() ? nullptr : fs.c_str());
+        return LoadShader_Internal(vs.empty() ? nullptr : vs.c_str(), fs.empty() ? nullptr : fs.c_str());
     }
 
     void   Framework_UnloadShader(Shader sh) { UnloadShader(sh); }
-    void   Framework_BeginShaderMode(Shader sh) { BeginShaderMode(sh); }
-    void   Framework_EndShaderMode() { EndShaderMode(); }
+    void   Framework_BeginShaderMode(Shader sh) { if (g_headless) return; RenderList_Flush(); RenderStats_Shader(sh.id); BeginShaderMode(sh); }
+    void   Framework_EndShaderMode() { if (g_headless) return; RenderList_Flush(); RenderStats_Shader(0); EndShaderMode(); }
     int    Framework_GetShaderLocation(Shader sh, const char* name) { return GetShaderLocation(sh, name); }
 
     void Framework_SetShaderValue1f(Shader sh, int loc, float v) {
+        if (g_headless) return;
         SetShaderValue(sh, loc, &v, SHADER_UNIFORM_FLOAT);
     }
     void Framework_SetShaderValue2f(Shader sh, int loc, float x, float y) {
+        if (g_headless) return;
         float a[2]{ x, y };
         SetShaderValue(sh, loc, a, SHADER_UNIFORM_VEC2);
     }
     void Framework_SetShaderValue3f(Shader sh, int loc, float x, float y, float z) {
+        if (g_headless) return;
         float a[3]{ x, y, z };
         SetShaderValue(sh, loc, a, SHADER_UNIFORM_VEC3);
     }
     void Framework_SetShaderValue4f(Shader sh, int loc, float x, float y, float z, float w) {
+        if (g_headless) return;
         float a[4]{ x, y, z, w };
         SetShaderValue(sh, loc, a, SHADER_UNIFORM_VEC4);
     }
     void Framework_SetShaderValue1i(Shader sh, int loc, int v) {
+        if (g_headless) return;
         SetShaderValue(sh, loc, &v, SHADER_UNIFORM_INT);
     }
 
@@ -2456,32 +4107,47 @@ extern "C" {
 
     void Framework_DrawTextureH(int handle, int x, int y,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         const Texture2D* tex = GetTextureH_Internal(handle);
-        if (tex) DrawTexture(*tex, x, y, Color{ r, g, b, a });
+        if (!tex) return;
+        RenderStats_Quad(tex->id);
+        DrawTexture(*tex, x, y, Color{ r, g, b, a });
     }
 
     void Framework_DrawTextureVH(int handle, Vector2 pos,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         const Texture2D* tex = GetTextureH_Internal(handle);
-        if (tex) DrawTextureV(*tex, pos, Color{ r, g, b, a });
+        if (!tex) return;
+        RenderStats_Quad(tex->id);
+        DrawTextureV(*tex, pos, Color{ r, g, b, a });
     }
 
     void Framework_DrawTextureExH(int handle, Vector2 pos, float rotation, float scale,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         const Texture2D* tex = GetTextureH_Internal(handle);
-        if (tex) DrawTextureEx(*tex, pos, rotation, scale, Color{ r, g, b, a });
+        if (!tex) return;
+        RenderStats_Quad(tex->id);
+        DrawTextureEx(*tex, pos, rotation, scale, Color{ r, g, b, a });
     }
 
     void Framework_DrawTextureRecH(int handle, Rectangle src, Vector2 pos,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         const Texture2D* tex = GetTextureH_Internal(handle);
-        if (tex) DrawTextureRec(*tex, src, pos, Color{ r, g, b, a });
+        if (!tex) return;
+        RenderStats_Quad(tex->id);
+        DrawTextureRec(*tex, src, pos, Color{ r, g, b, a });
     }
 
     void Framework_DrawTextureProH(int handle, Rectangle src, Rectangle dst, Vector2 origin, float rotation,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         const Texture2D* tex = GetTextureH_Internal(handle);
-        if (tex) DrawTexturePro(*tex, src, dst, origin, rotation, Color{ r, g, b, a });
+        if (!tex) return;
+        RenderStats_Quad(tex->id);
+        DrawTexturePro(*tex, src, dst, origin, rotation, Color{ r, g, b, a });
     }
 
     int Framework_GetTextureWidth(int handle) {
@@ -2500,10 +4166,221 @@ extern "C" {
 
     void Framework_DrawTextExH(int handle, const char* text, Vector2 pos, float fontSize, float spacing,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         const Font* f = GetFontH_Internal(handle);
-        if (f) DrawTextEx(*f, text, pos, fontSize, spacing, Color{ r, g, b, a });
+        if (!f) return;
+        RenderStats_Text(f->texture.id, text);
+        DrawTextEx(*f, text, pos, fontSize, spacing, Color{ r, g, b, a });
+    }
+
+    // ========================================================================
+    // PACKED COMMAND BUFFER
+    // ========================================================================
+    // Each command is a little-endian header { uint16 opcode, uint16 size } followed by its
+    // arguments; 'size' covers the header, so unknown opcodes can be stepped over. Shapes,
+    // textures and text go through QuadStream, so consecutive draws that share a texture
+    // become one rlgl batch (or one render-list item while capturing).
+    static int g_cmdErrorOffset = -1;
+    static std::string g_cmdText;
+
+    struct CommandReader {
+        const unsigned char* p;
+        int size;
+        int pos;
+        bool Float(float& v) { return Read(&v, 4); }
+        bool Int(int& v) { return Read(&v, 4); }
+        bool Rgba(Color& c) { return Read(&c, 4); }
+        bool Read(void* dst, int n) {
+            if (pos + n > size) return false;
+            memcpy(dst, p + pos, n);
+            pos += n;
+            return true;
+        }
+    };
+
+    static void Cmd_SolidQuad(QuadStream& qs, Vector2 tl, Vector2 bl, Vector2 br, Vector2 tr, Color c, Vector2 uv) {
+        qs.Vertex(tl.x, tl.y, uv.x, uv.y, c);
+        qs.Vertex(bl.x, bl.y, uv.x, uv.y, c);
+        qs.Vertex(br.x, br.y, uv.x, uv.y, c);
+        qs.Vertex(tr.x, tr.y, uv.x, uv.y, c);
+    }
+
+    static void Cmd_Rect(float x, float y, float w, float h, Color c) {
+        if (w <= 0 || h <= 0 || c.a == 0) return;
+        QuadStream qs(GetShapesTexture().id, 1);
+        Vector2 uv = ShapesTextureUV();
+        Cmd_SolidQuad(qs, { x, y }, { x, y + h }, { x + w, y + h }, { x + w, y }, c, uv);
+    }
+
+    // Same edge split as DrawRectangleLinesEx
+    static void Cmd_RectLines(float x, float y, float w, float h, float thick, Color c) {
+        if (thick <= 0 || w <= 0 || h <= 0 || c.a == 0) return;
+        if (thick > w || thick > h) thick = (w >= h) ? h / 2 : w / 2;
+        QuadStream qs(GetShapesTexture().id, 4);
+        Vector2 uv = ShapesTextureUV();
+        const Rectangle edges[4] = { { x, y, w, thick }, { x, y - thick + h, w, thick },
+                                     { x, y + thick, thick, h - thick * 2 }, { x - thick + w, y + thick, thick, h - thick * 2 } };
+        for (const Rectangle& e : edges) {
+            if (e.width <= 0 || e.height <= 0) continue;
+            Cmd_SolidQuad(qs, { e.x, e.y }, { e.x, e.y + e.height }, { e.x + e.width, e.y + e.height },
+                          { e.x + e.width, e.y }, c, uv);
+        }
+    }
+
+    static void Cmd_Line(float x1, float y1, float x2, float y2, float thick, Color c) {
+        if ((x1 == x2 && y1 == y2) || thick <= 0.0f || c.a == 0) return;
+        QuadStream qs(GetShapesTexture().id, 1);
+        StreamLineQuad(qs, { x1, y1 }, { x2, y2 }, thick, c, ShapesTextureUV());
+    }
+
+    // Triangle fan as degenerate quads, same segment count the render stats assume
+    static void Cmd_Circle(float cx, float cy, float radius, Color c) {
+        if (radius <= 0.0f || c.a == 0) return;
+        QuadStream qs(GetShapesTexture().id, RSTAT_CIRCLE_SEGMENTS);
+        Vector2 uv = ShapesTextureUV();
+        float step = 2.0f * PI / RSTAT_CIRCLE_SEGMENTS;
+        Vector2 prev = { cx + radius, cy };
+        for (int i = 1; i <= RSTAT_CIRCLE_SEGMENTS; i++) {
+            Vector2 next = { cx + cosf(step * i) * radius, cy + sinf(step * i) * radius };
+            Cmd_SolidQuad(qs, { cx, cy }, next, prev, prev, c, uv);
+            prev = next;
+        }
+    }
+
+    int Framework_SubmitCommands(const unsigned char* buffer, int byteCount) {
+        g_cmdErrorOffset = -1;
+        if (!buffer || byteCount <= 0) return 0;
+
+        // CMD_BLEND lasts until the end of the buffer, not into the caller's draws
+        const int savedBlend = g_renderList.blend;
+        bool blendSet = false;
+
+        int executed = 0;
+        int offset = 0;
+        while (offset < byteCount) {
+            if (byteCount - offset < 4) { g_cmdErrorOffset = offset; break; }
+            unsigned short op = 0, size = 0;
+            memcpy(&op, buffer + offset, 2);
+            memcpy(&size, buffer + offset + 2, 2);
+            if (size < 4 || size > byteCount - offset) { g_cmdErrorOffset = offset; break; }
+
+            CommandReader r{ buffer + offset, size, 4 };
+            bool ok = true;
+            switch (op) {
+            case CMD_CLEAR: {
+                Color c;
+                ok = r.Rgba(c);
+                if (ok && !g_headless) { RenderList_Flush(); RenderStats_Flush(); ClearBackground(c); }
+                break;
+            }
+            case CMD_RECT: {
+                float x, y, w, h; Color c;
+                ok = r.Float(x) && r.Float(y) && r.Float(w) && r.Float(h) && r.Rgba(c);
+                if (ok && !g_headless) Cmd_Rect(x, y, w, h, c);
+                break;
+            }
+            case CMD_RECT_LINES: {
+                float x, y, w, h, thick; Color c;
+                ok = r.Float(x) && r.Float(y) && r.Float(w) && r.Float(h) && r.Float(thick) && r.Rgba(c);
+                if (ok && !g_headless) Cmd_RectLines(x, y, w, h, thick, c);
+                break;
+            }
+            case CMD_LINE: {
+                float x1, y1, x2, y2, thick; Color c;
+                ok = r.Float(x1) && r.Float(y1) && r.Float(x2) && r.Float(y2) && r.Float(thick) && r.Rgba(c);
+                if (ok && !g_headless) Cmd_Line(x1, y1, x2, y2, thick, c);
+                break;
+            }
+            case CMD_CIRCLE: {
+                float x, y, radius; Color c;
+                ok = r.Float(x) && r.Float(y) && r.Float(radius) && r.Rgba(c);
+                if (ok && !g_headless) Cmd_Circle(x, y, radius, c);
+                break;
+            }
+            case CMD_TEXTURE: {
+                int handle; Rectangle src, dst; Vector2 origin; float rotation; Color c;
+                ok = r.Int(handle) && r.Read(&src, 16) && r.Read(&dst, 16) && r.Read(&origin, 8) &&
+                     r.Float(rotation) && r.Rgba(c);
+                if (ok && !g_headless) {
+                    const Texture2D* tex = GetTextureH_Internal(handle);
+                    if (tex) DrawTextureQuad(*tex, src, dst, origin, rotation, c);
+                }
+                break;
+            }
+            case CMD_TEXT: {
+                int fontHandle; float x, y, fontSize, spacing; Color c;
+                ok = r.Int(fontHandle) && r.Float(x) && r.Float(y) && r.Float(fontSize) && r.Float(spacing) && r.Rgba(c);
+                if (ok && !g_headless) {
+                    const Font* font = fontHandle < 0 ? nullptr : GetFontH_Internal(fontHandle);
+                    Font def;
+                    if (!font) { def = GetFontDefault(); font = &def; }
+                    // Text runs to the end of the command; a trailing NUL is allowed
+                    const char* s = (const char*)r.p + r.pos;
+                    int n = r.size - r.pos;
+                    while (n > 0 && s[n - 1] == '\0') n--;
+                    g_cmdText.assign(s, n);
+                    if (!g_cmdText.empty()) {
+                        const TextLayout& L = GetTextLayout(*font, g_cmdText.c_str(), fontSize, spacing, 0);
+                        DrawTextLayout(L, *font, { x, y }, c);
+                    }
+                }
+                break;
+            }
+            case CMD_SET_LAYER: {
+                int layer, order;
+                ok = r.Int(layer) && r.Int(order);
+                if (ok) Framework_RenderList_SetLayer(layer, order);
+                break;
+            }
+            case CMD_BLEND: {
+                int mode;
+                ok = r.Int(mode);
+                if (ok && !g_headless) {
+                    if (mode < 0) RenderList_EndBlend();
+                    else RenderList_BeginBlend(mode);
+                    blendSet = mode >= 0;
+                }
+                break;
+            }
+            // Camera and scissor apply to the GPU right away; quads captured before them
+            // must be submitted under the state they were recorded with
+            case CMD_BEGIN_2D: {
+                Camera2D cam;
+                ok = r.Float(cam.offset.x) && r.Float(cam.offset.y) && r.Float(cam.target.x) && r.Float(cam.target.y) &&
+                     r.Float(cam.rotation) && r.Float(cam.zoom);
+                if (ok) { RenderList_Flush(); Framework_BeginMode2D(cam); }
+                break;
+            }
+            case CMD_END_2D:
+                RenderList_Flush();
+                Framework_EndMode2D();
+                break;
+            case CMD_SCISSOR: {
+                int x, y, w, h;
+                ok = r.Int(x) && r.Int(y) && r.Int(w) && r.Int(h);
+                if (ok) { RenderList_Flush(); Framework_BeginScissorMode(x, y, w, h); }
+                break;
+            }
+            case CMD_END_SCISSOR:
+                RenderList_Flush();
+                Framework_EndScissorMode();
+                break;
+            default:
+                // Unknown opcode: skip it so newer buffers still play on older engines
+                break;
+            }
+            if (!ok) { g_cmdErrorOffset = offset; break; }
+            executed++;
+            offset += size;
+        }
+        if (g_renderList.capturing) g_renderList.blend = savedBlend;
+        else if (blendSet) RenderList_EndBlend();
+        rlSetTexture(0);
+        return executed;
     }
 
+    int Framework_GetCommandError() { return g_cmdErrorOffset; }
+
     // ========================================================================
     // SCENE SYSTEM
     // ========================================================================
@@ -2573,7 +4450,7 @@ extern "C" {
             sc->cb.onUpdateFrame(dt);
         }
 
-        if (auto sc = TopScene(); sc && sc->cb.onDraw) {
+        if (auto sc = TopScene(); sc && sc->cb.onDraw && !g_headless) {
             sc->cb.onDraw();
         }
     }
@@ -2803,10 +4680,11 @@ extern "C" {
     }
 
     void Framework_Scene_Draw() {
+        if (g_headless) return;
         if (g_sceneManager.transitionState == TRANS_STATE_NONE) return;
 
-        int screenWidth = GetScreenWidth();
-        int screenHeight = GetScreenHeight();
+        int screenWidth = ScreenWidth_Internal();
+        int screenHeight = ScreenHeight_Internal();
         float progress = Framework_Scene_GetTransitionProgress();
 
         // For transition OUT, progress goes 0->1 (fade in the effect)
@@ -3234,6 +5112,29 @@ extern "C" {
         return GetWorldScaleInternal(entity);
     }
 
+    Vector2 Framework_Ecs_GetRenderPosition(int entity) {
+        if (!EcsIsAlive(entity)) return Vector2{ 0, 0 };
+        Vector2 pos, scale;
+        float rot;
+        GetRenderTransformInternal(entity, pos, rot, scale);
+        return pos;
+    }
+
+    float Framework_Ecs_GetRenderRotation(int entity) {
+        if (!EcsIsAlive(entity)) return 0.0f;
+        Vector2 pos, scale;
+        float rot;
+        GetRenderTransformInternal(entity, pos, rot, scale);
+        return rot;
+    }
+
+    // Snap the interpolation source to the current transform (after teleports); -1 = all
+    void Framework_Ecs_ResetInterpolation(int entity) {
+        if (entity < 0) { EcsSnapshotTransforms(); return; }
+        auto it = g_transform2D.find(entity);
+        if (it != g_transform2D.end()) g_transformPrev[entity] = it->second;
+    }
+
     // ========================================================================
     // ECS - VELOCITY2D COMPONENT
     // ========================================================================
@@ -3370,6 +5271,7 @@ extern "C" {
     }
 
     void Framework_Ecs_DrawSprites() {
+        if (g_headless) return;
         EcsDrawSpritesInternal();
     }
 
@@ -3802,7 +5704,9 @@ extern "C" {
     }
 
     void Framework_Debug_Render() {
+        if (g_headless) return;
         if (!g_debugEnabled) return;
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_DEBUG);
 
         // Draw entity bounds
         if (g_debugDrawBounds) {
@@ -3810,6 +5714,7 @@ extern "C" {
                 if (!IsActiveInHierarchyInternal(kv.first)) continue;
                 Rectangle bounds = GetBoxColliderWorldBoundsInternal(kv.first);
                 Color col = kv.second.isTrigger ? Color{ 0, 255, 0, 128 } : Color{ 255, 255, 0, 128 };
+                RenderStats_Shape(RL_QUADS, 16, 8);
                 DrawRectangleLinesEx(bounds, 1.0f, col);
             }
         }
@@ -3820,6 +5725,7 @@ extern "C" {
                 if (kv.second.parent == -1) continue;
                 Vector2 childPos = GetWorldPositionInternal(kv.first);
                 Vector2 parentPos = GetWorldPositionInternal(kv.second.parent);
+                RenderStats_Shape(RL_LINES, 2, 0);
                 DrawLineV(childPos, parentPos, Color{ 128, 128, 255, 200 });
             }
         }
@@ -3830,15 +5736,19 @@ extern "C" {
             char buf[128];
 
             snprintf(buf, sizeof(buf), "FPS: %d", GetFPS());
+            RenderStats_Text(GetFontDefault().texture.id, buf);
             DrawText(buf, 10, y, 16, WHITE); y += 18;
 
             snprintf(buf, sizeof(buf), "Entities: %d", (int)g_entities.size());
+            RenderStats_Text(GetFontDefault().texture.id, buf);
             DrawText(buf, 10, y, 16, WHITE); y += 18;
 
             snprintf(buf, sizeof(buf), "Sprites: %d", (int)g_sprite2D.size());
+            RenderStats_Text(GetFontDefault().texture.id, buf);
             DrawText(buf, 10, y, 16, WHITE); y += 18;
 
             snprintf(buf, sizeof(buf), "Frame: %llu", g_frameCount);
+            RenderStats_Text(GetFontDefault().texture.id, buf);
             DrawText(buf, 10, y, 16, WHITE); y += 18;
 
             const char* stateStr = "UNKNOWN";
@@ -3849,6 +5759,7 @@ extern "C" {
                 case ENGINE_QUITTING: stateStr = "QUITTING"; break;
             }
             snprintf(buf, sizeof(buf), "State: %s", stateStr);
+            RenderStats_Text(GetFontDefault().texture.id, buf);
             DrawText(buf, 10, y, 16, WHITE);
         }
     }
@@ -3870,23 +5781,12 @@ extern "C" {
         Color color;
     };
 
-    struct DebugShape {
-        enum Type { LINE, RECT, RECT_FILLED, CIRCLE, CIRCLE_FILLED, POINT, ARROW, TEXT, GRID, CROSS };
-        Type type;
-        float x1, y1, x2, y2;
-        float size;
-        Color color;
-        std::string text;
-    };
-
     // Performance state
     static std::vector<float> g_frameTimeHistory;
     static int g_perfSampleCount = 60;
     static int g_totalFrameCount = 0;
     static float g_currentFrameTime = 0;
     static double g_frameStartTime = 0;
-    static int g_drawCallCount = 0;
-    static int g_triangleCount = 0;
 
     // Profiling scopes
     static std::unordered_map<std::string, PerfScope> g_perfScopes;
@@ -3913,10 +5813,9 @@ extern "C" {
     static int g_consoleMaxLines = 50;
     static std::vector<ConsoleLine> g_consoleLines;
 
-    // Debug drawing
+    // Debug drawing (primitives live in g_debugDraw)
     static bool g_debugDrawEnabled = false;
     static bool g_debugDrawPersistent = false;
-    static std::vector<DebugShape> g_debugShapes;
 
     // Debug overlay flags
     static bool g_showFPS = true;
@@ -3932,7 +5831,7 @@ extern "C" {
 
     // Frame timing
     float Framework_Perf_GetFPS() {
-        return (float)GetFPS();
+        return (float)Framework_GetFPS();
     }
 
     float Framework_Perf_GetFrameTime() {
@@ -3975,18 +5874,87 @@ extern "C" {
 
     // Draw call tracking
     int Framework_Perf_GetDrawCalls() {
-        return g_drawCallCount;
+        return g_renderStats.lastFrame.drawCalls;
     }
 
     int Framework_Perf_GetTriangleCount() {
-        return g_triangleCount;
+        return g_renderStats.lastFrame.triangles;
     }
 
     void Framework_Perf_ResetDrawStats() {
-        g_drawCallCount = 0;
-        g_triangleCount = 0;
+        RenderStats_ResetFrame();
+    }
+
+    // Render statistics (last completed frame)
+    int Framework_RenderStats_GetDrawCalls() { return g_renderStats.lastFrame.drawCalls; }
+    int Framework_RenderStats_GetBatchFlushes() { return g_renderStats.lastFrame.batches; }
+    int Framework_RenderStats_GetTextureSwaps() { return g_renderStats.lastFrame.textureSwaps; }
+    int Framework_RenderStats_GetShaderSwitches() { return g_renderStats.lastFrame.shaderSwitches; }
+    int Framework_RenderStats_GetTargetSwitches() { return g_renderStats.lastFrame.targetSwitches; }
+    int Framework_RenderStats_GetVertexCount() { return g_renderStats.lastFrame.vertices; }
+    int Framework_RenderStats_GetQuadCount() { return g_renderStats.lastFrame.quads; }
+
+    int Framework_RenderStats_GetSubsystemDrawCalls(int subsystem) {
+        if (subsystem < 0 || subsystem >= RENDER_SUBSYSTEM_COUNT) return 0;
+        return g_renderStats.lastSubsystems[subsystem].drawCalls;
+    }
+
+    int Framework_RenderStats_GetSubsystemVertices(int subsystem) {
+        if (subsystem < 0 || subsystem >= RENDER_SUBSYSTEM_COUNT) return 0;
+        return g_renderStats.lastSubsystems[subsystem].vertices;
+    }
+
+    int Framework_RenderStats_GetSubsystemTextureSwaps(int subsystem) {
+        if (subsystem < 0 || subsystem >= RENDER_SUBSYSTEM_COUNT) return 0;
+        return g_renderStats.lastSubsystems[subsystem].textureSwaps;
+    }
+
+    int Framework_RenderStats_GetLayerCount() {
+        return (int)g_renderStats.lastLayerIds.size();
+    }
+
+    int Framework_RenderStats_GetLayerId(int index) {
+        if (index < 0 || index >= (int)g_renderStats.lastLayerIds.size()) return 0;
+        return g_renderStats.lastLayerIds[index];
+    }
+
+    int Framework_RenderStats_GetLayerDrawCalls(int layer) {
+        auto it = g_renderStats.lastLayers.find(layer);
+        return (it != g_renderStats.lastLayers.end()) ? it->second.drawCalls : 0;
+    }
+
+    int Framework_RenderStats_GetLayerVertices(int layer) {
+        auto it = g_renderStats.lastLayers.find(layer);
+        return (it != g_renderStats.lastLayers.end()) ? it->second.vertices : 0;
+    }
+
+    int Framework_RenderStats_GetLayerTextureSwaps(int layer) {
+        auto it = g_renderStats.lastLayers.find(layer);
+        return (it != g_renderStats.lastLayers.end()) ? it->second.textureSwaps : 0;
+    }
+
+    // Frame render list
+    void Framework_RenderList_Begin() {
+        if (g_headless) return;
+        RenderList_Finish();
+        RenderStats_Flush();
+        g_renderList.capturing = true;
+        g_renderList.nextSequence = 1;
+        g_renderList.lastItems = 0;
+        g_renderList.lastRuns = 0;
+    }
+
+    void Framework_RenderList_End() { RenderList_Finish(); }
+
+    void Framework_RenderList_SetLayer(int layer, int order) {
+        g_renderList.layer = layer;
+        g_renderList.order = order;
     }
 
+    bool Framework_RenderList_IsCapturing() { return g_renderList.capturing; }
+    int Framework_RenderList_GetLastItemCount() { return g_renderList.lastItems; }
+    int Framework_RenderList_GetLastRunCount() { return g_renderList.lastRuns; }
+
     // Memory tracking
     int Framework_Perf_GetEntityCount() {
         return (int)g_entities.size();
@@ -4019,7 +5987,7 @@ extern "C" {
         if (!name) return;
         g_scopeStack.push_back(name);
         g_perfScopes[name].name = name;
-        g_perfScopes[name].startTime = GetTime();
+        g_perfScopes[name].startTime = WallTime_Internal();
     }
 
     void Framework_Perf_EndScope() {
@@ -4029,7 +5997,7 @@ extern "C" {
 
         auto it = g_perfScopes.find(name);
         if (it != g_perfScopes.end()) {
-            double elapsed = (GetTime() - it->second.startTime) * 1000.0;  // Convert to ms
+            double elapsed = (WallTime_Internal() - it->second.startTime) * 1000.0;  // Convert to ms
             it->second.lastTime = elapsed;
             it->second.totalTime += elapsed;
             it->second.callCount++;
@@ -4076,10 +6044,14 @@ extern "C" {
     }
 
     void Framework_Perf_DrawGraph() {
+        if (g_headless) return;
         if (!g_perfGraphEnabled || g_frameTimeHistory.empty()) return;
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_DEBUG);
 
         // Background
+        RenderStats_Shape(RL_QUADS, 4, 2);
         DrawRectangle((int)g_perfGraphX, (int)g_perfGraphY, (int)g_perfGraphWidth, (int)g_perfGraphHeight, Color{ 0, 0, 0, 180 });
+        RenderStats_Shape(RL_QUADS, 16, 8);
         DrawRectangleLinesEx(Rectangle{ g_perfGraphX, g_perfGraphY, g_perfGraphWidth, g_perfGraphHeight }, 1, Color{ 100, 100, 100, 255 });
 
         // Find max frame time for scaling
@@ -4102,16 +6074,19 @@ extern "C" {
             if (t > 16.67f) col = YELLOW;
             if (t > 33.33f) col = RED;
 
+            RenderStats_Shape(RL_QUADS, 4, 2);
             DrawRectangle((int)x, (int)y, (int)barWidth - 1, (int)height, col);
         }
 
         // Draw 60 FPS line
         float targetY = g_perfGraphY + g_perfGraphHeight - (16.67f / maxTime) * g_perfGraphHeight;
+        RenderStats_Shape(RL_LINES, 2, 0);
         DrawLine((int)g_perfGraphX, (int)targetY, (int)(g_perfGraphX + g_perfGraphWidth), (int)targetY, Color{ 0, 255, 0, 128 });
 
         // Labels
         char buf[64];
         snprintf(buf, sizeof(buf), "%.1f ms", g_currentFrameTime);
+        RenderStats_Text(GetFontDefault().texture.id, buf);
         DrawText(buf, (int)g_perfGraphX + 2, (int)g_perfGraphY + 2, 10, WHITE);
     }
 
@@ -4226,10 +6201,14 @@ extern "C" {
     }
 
     void Framework_Console_Draw() {
+        if (g_headless) return;
         if (!g_consoleEnabled) return;
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_DEBUG);
 
         // Background
+        RenderStats_Shape(RL_QUADS, 4, 2);
         DrawRectangle((int)g_consoleX, (int)g_consoleY, (int)g_consoleWidth, (int)g_consoleHeight, Color{ 0, 0, 0, 200 });
+        RenderStats_Shape(RL_QUADS, 16, 8);
         DrawRectangleLinesEx(Rectangle{ g_consoleX, g_consoleY, g_consoleWidth, g_consoleHeight }, 1, Color{ 100, 100, 100, 255 });
 
         // Draw lines from bottom up
@@ -4239,6 +6218,7 @@ extern "C" {
 
         float y = g_consoleY + g_consoleHeight - lineHeight - 2;
         for (int i = (int)g_consoleLines.size() - 1; i >= startLine && y > g_consoleY; i--) {
+            RenderStats_Text(GetFontDefault().texture.id, g_consoleLines[i].text.c_str());
             DrawText(g_consoleLines[i].text.c_str(), (int)g_consoleX + 4, (int)y, 10, g_consoleLines[i].color);
             y -= lineHeight;
         }
@@ -4247,102 +6227,74 @@ extern "C" {
     // Debug drawing
     void Framework_DebugDraw_Line(float x1, float y1, float x2, float y2, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
         if (!g_debugDrawEnabled) return;
-        DebugShape shape;
-        shape.type = DebugShape::LINE;
-        shape.x1 = x1; shape.y1 = y1;
-        shape.x2 = x2; shape.y2 = y2;
-        shape.color = Color{ r, g, b, a };
-        g_debugShapes.push_back(shape);
+        DebugDraw_PushLine({ x1, y1 }, { x2, y2 }, Color{ r, g, b, a });
     }
 
+    // Edges run half a pixel inside, like DrawRectangleLinesEx with thickness 1
     void Framework_DebugDraw_Rect(float x, float y, float w, float h, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
         if (!g_debugDrawEnabled) return;
-        DebugShape shape;
-        shape.type = DebugShape::RECT;
-        shape.x1 = x; shape.y1 = y;
-        shape.x2 = w; shape.y2 = h;
-        shape.color = Color{ r, g, b, a };
-        g_debugShapes.push_back(shape);
+        Color color{ r, g, b, a };
+        float x0 = x + 0.5f, y0 = y + 0.5f, x1 = x + w - 0.5f, y1 = y + h - 0.5f;
+        DebugDraw_PushLine({ x, y0 }, { x + w, y0 }, color);
+        DebugDraw_PushLine({ x, y1 }, { x + w, y1 }, color);
+        DebugDraw_PushLine({ x0, y + 1 }, { x0, y + h - 1 }, color);
+        DebugDraw_PushLine({ x1, y + 1 }, { x1, y + h - 1 }, color);
     }
 
     void Framework_DebugDraw_RectFilled(float x, float y, float w, float h, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
-        if (!g_debugDrawEnabled) return;
-        DebugShape shape;
-        shape.type = DebugShape::RECT_FILLED;
-        shape.x1 = x; shape.y1 = y;
-        shape.x2 = w; shape.y2 = h;
-        shape.color = Color{ r, g, b, a };
-        g_debugShapes.push_back(shape);
+        if (!g_debugDrawEnabled || w <= 0 || h <= 0) return;
+        Color color{ r, g, b, a };
+        DebugDraw_PushTriangle({ x, y }, { x, y + h }, { x + w, y + h }, color);
+        DebugDraw_PushTriangle({ x, y }, { x + w, y + h }, { x + w, y }, color);
     }
 
     void Framework_DebugDraw_Circle(float x, float y, float radius, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
         if (!g_debugDrawEnabled) return;
-        DebugShape shape;
-        shape.type = DebugShape::CIRCLE;
-        shape.x1 = x; shape.y1 = y;
-        shape.size = radius;
-        shape.color = Color{ r, g, b, a };
-        g_debugShapes.push_back(shape);
+        DebugDraw_PushCircle({ x, y }, radius, Color{ r, g, b, a }, false);
     }
 
     void Framework_DebugDraw_CircleFilled(float x, float y, float radius, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
         if (!g_debugDrawEnabled) return;
-        DebugShape shape;
-        shape.type = DebugShape::CIRCLE_FILLED;
-        shape.x1 = x; shape.y1 = y;
-        shape.size = radius;
-        shape.color = Color{ r, g, b, a };
-        g_debugShapes.push_back(shape);
+        DebugDraw_PushCircle({ x, y }, radius, Color{ r, g, b, a }, true);
     }
 
     void Framework_DebugDraw_Point(float x, float y, float size, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
         if (!g_debugDrawEnabled) return;
-        DebugShape shape;
-        shape.type = DebugShape::POINT;
-        shape.x1 = x; shape.y1 = y;
-        shape.size = size;
-        shape.color = Color{ r, g, b, a };
-        g_debugShapes.push_back(shape);
+        DebugDraw_PushCircle({ x, y }, size, Color{ r, g, b, a }, true);
     }
 
     void Framework_DebugDraw_Arrow(float x1, float y1, float x2, float y2, float headSize, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
         if (!g_debugDrawEnabled) return;
-        DebugShape shape;
-        shape.type = DebugShape::ARROW;
-        shape.x1 = x1; shape.y1 = y1;
-        shape.x2 = x2; shape.y2 = y2;
-        shape.size = headSize;
-        shape.color = Color{ r, g, b, a };
-        g_debugShapes.push_back(shape);
+        Color color{ r, g, b, a };
+        DebugDraw_PushLine({ x1, y1 }, { x2, y2 }, color);
+        float dx = x2 - x1;
+        float dy = y2 - y1;
+        float len = sqrtf(dx * dx + dy * dy);
+        if (len > 0) {
+            dx /= len; dy /= len;
+            float px = -dy, py = dx;  // Perpendicular
+            float ax = x2 - dx * headSize;
+            float ay = y2 - dy * headSize;
+            DebugDraw_PushLine({ x2, y2 }, { ax + px * headSize * 0.5f, ay + py * headSize * 0.5f }, color);
+            DebugDraw_PushLine({ x2, y2 }, { ax - px * headSize * 0.5f, ay - py * headSize * 0.5f }, color);
+        }
     }
 
     void Framework_DebugDraw_Text(float x, float y, const char* text, unsigned char r, unsigned char g, unsigned char b) {
         if (!g_debugDrawEnabled || !text) return;
-        DebugShape shape;
-        shape.type = DebugShape::TEXT;
-        shape.x1 = x; shape.y1 = y;
-        shape.text = text;
-        shape.color = Color{ r, g, b, 255 };
-        g_debugShapes.push_back(shape);
+        DebugDraw_PushText({ x, y }, text, Color{ r, g, b, 255 });
     }
 
     void Framework_DebugDraw_Grid(float cellSize, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
         if (!g_debugDrawEnabled) return;
-        DebugShape shape;
-        shape.type = DebugShape::GRID;
-        shape.size = cellSize;
-        shape.color = Color{ r, g, b, a };
-        g_debugShapes.push_back(shape);
+        DebugDraw_PushGrid(cellSize, Color{ r, g, b, a });
     }
 
     void Framework_DebugDraw_Cross(float x, float y, float size, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
         if (!g_debugDrawEnabled) return;
-        DebugShape shape;
-        shape.type = DebugShape::CROSS;
-        shape.x1 = x; shape.y1 = y;
-        shape.size = size;
-        shape.color = Color{ r, g, b, a };
-        g_debugShapes.push_back(shape);
+        Color color{ r, g, b, a };
+        DebugDraw_PushLine({ x - size, y }, { x + size, y }, color);
+        DebugDraw_PushLine({ x, y - size }, { x, y + size }, color);
     }
 
     void Framework_DebugDraw_SetEnabled(bool enabled) {
@@ -4358,71 +6310,46 @@ extern "C" {
     }
 
     void Framework_DebugDraw_Clear() {
-        g_debugShapes.clear();
+        DebugDraw_Clear();
     }
 
-    void Framework_DebugDraw_Flush() {
-        if (!g_debugDrawEnabled) return;
+    void Framework_DebugDraw_SetCategory(int category) { g_debugDraw.category = category; }
+    int  Framework_DebugDraw_GetCategory() { return g_debugDraw.category; }
 
-        for (auto& shape : g_debugShapes) {
-            switch (shape.type) {
-                case DebugShape::LINE:
-                    DrawLineV(Vector2{ shape.x1, shape.y1 }, Vector2{ shape.x2, shape.y2 }, shape.color);
-                    break;
-                case DebugShape::RECT:
-                    DrawRectangleLinesEx(Rectangle{ shape.x1, shape.y1, shape.x2, shape.y2 }, 1, shape.color);
-                    break;
-                case DebugShape::RECT_FILLED:
-                    DrawRectangle((int)shape.x1, (int)shape.y1, (int)shape.x2, (int)shape.y2, shape.color);
-                    break;
-                case DebugShape::CIRCLE:
-                    DrawCircleLines((int)shape.x1, (int)shape.y1, shape.size, shape.color);
-                    break;
-                case DebugShape::CIRCLE_FILLED:
-                    DrawCircle((int)shape.x1, (int)shape.y1, shape.size, shape.color);
-                    break;
-                case DebugShape::POINT:
-                    DrawCircle((int)shape.x1, (int)shape.y1, shape.size, shape.color);
-                    break;
-                case DebugShape::ARROW: {
-                    DrawLineV(Vector2{ shape.x1, shape.y1 }, Vector2{ shape.x2, shape.y2 }, shape.color);
-                    // Draw arrow head
-                    float dx = shape.x2 - shape.x1;
-                    float dy = shape.y2 - shape.y1;
-                    float len = sqrtf(dx * dx + dy * dy);
-                    if (len > 0) {
-                        dx /= len; dy /= len;
-                        float px = -dy, py = dx;  // Perpendicular
-                        float ax = shape.x2 - dx * shape.size;
-                        float ay = shape.y2 - dy * shape.size;
-                        DrawLineV(Vector2{ shape.x2, shape.y2 }, Vector2{ ax + px * shape.size * 0.5f, ay + py * shape.size * 0.5f }, shape.color);
-                        DrawLineV(Vector2{ shape.x2, shape.y2 }, Vector2{ ax - px * shape.size * 0.5f, ay - py * shape.size * 0.5f }, shape.color);
-                    }
-                    break;
-                }
-                case DebugShape::TEXT:
-                    DrawText(shape.text.c_str(), (int)shape.x1, (int)shape.y1, 10, shape.color);
-                    break;
-                case DebugShape::GRID: {
-                    int screenW = GetScreenWidth();
-                    int screenH = GetScreenHeight();
-                    for (float x = 0; x < screenW; x += shape.size) {
-                        DrawLine((int)x, 0, (int)x, screenH, shape.color);
-                    }
-                    for (float y = 0; y < screenH; y += shape.size) {
-                        DrawLine(0, (int)y, screenW, (int)y, shape.color);
-                    }
-                    break;
-                }
-                case DebugShape::CROSS:
-                    DrawLine((int)(shape.x1 - shape.size), (int)shape.y1, (int)(shape.x1 + shape.size), (int)shape.y1, shape.color);
-                    DrawLine((int)shape.x1, (int)(shape.y1 - shape.size), (int)shape.x1, (int)(shape.y1 + shape.size), shape.color);
-                    break;
-            }
+    void Framework_DebugDraw_SetCategoryEnabled(int category, bool enabled) {
+        if (category < 0 || category >= 32) return;
+        if (enabled) g_debugDraw.categoryMask |= (1u << category);
+        else g_debugDraw.categoryMask &= ~(1u << category);
+    }
+
+    bool Framework_DebugDraw_IsCategoryEnabled(int category) {
+        return DebugDraw_CategoryVisible(category);
+    }
+
+    void Framework_DebugDraw_SetDuration(float seconds) { g_debugDraw.duration = seconds; }
+    float Framework_DebugDraw_GetDuration() { return g_debugDraw.duration; }
+
+    void Framework_DebugDraw_SetCapacity(int lines, int triangles, int texts, int textBytes) {
+        DebugDraw_SetCapacity(lines, triangles, texts, textBytes);
+    }
+
+    int Framework_DebugDraw_GetLineCount() { return g_debugDraw.lines.count; }
+    int Framework_DebugDraw_GetTriangleCount() { return g_debugDraw.triangles.count; }
+    int Framework_DebugDraw_GetTextCount() { return g_debugDraw.texts.count; }
+
+    int Framework_DebugDraw_GetDroppedCount() {
+        const DebugDrawState& d = g_debugDraw;
+        return d.lines.dropped + d.triangles.dropped + d.texts.dropped + d.grids.dropped + d.arenaDropped;
+    }
+
+    void Framework_DebugDraw_Flush() {
+        if (!g_headless && g_debugDrawEnabled) {
+            RenderStatsScope statsScope(RENDER_SUBSYSTEM_DEBUG);
+            DebugDraw_Render();
         }
 
         if (!g_debugDrawPersistent) {
-            g_debugShapes.clear();
+            DebugDraw_Expire();
         }
     }
 
@@ -4446,12 +6373,12 @@ extern "C" {
 
     // Frame profiling
     void Framework_Perf_BeginFrame() {
-        g_frameStartTime = GetTime();
+        g_frameStartTime = WallTime_Internal();
         Framework_Perf_ResetDrawStats();
     }
 
     void Framework_Perf_EndFrame() {
-        g_currentFrameTime = (float)((GetTime() - g_frameStartTime) * 1000.0);
+        g_currentFrameTime = (float)((WallTime_Internal() - g_frameStartTime) * 1000.0);
         g_totalFrameCount++;
 
         // Add to history
@@ -4522,10 +6449,7 @@ extern "C" {
     static int g_nextAsyncRequestId = 1;
     static int g_maxConcurrentLoads = 4;
 
-    // Render stats
-    static int g_batchCount = 0;
-    static int g_spritesRendered = 0;
-    static int g_textureSwaps = 0;
+    // Render stats (counters live in g_renderStats)
     static bool g_autoBatching = true;
 
     // Performance warnings
@@ -4920,9 +6844,9 @@ extern "C" {
     }
 
     // Batch Rendering Statistics
-    int Framework_Render_GetBatchCount() { return g_batchCount; }
-    int Framework_Render_GetSpritesRendered() { return g_spritesRendered; }
-    int Framework_Render_GetTextureSwaps() { return g_textureSwaps; }
+    int Framework_Render_GetBatchCount() { return g_renderStats.lastFrame.batches; }
+    int Framework_Render_GetSpritesRendered() { return g_renderStats.lastFrame.quads; }
+    int Framework_Render_GetTextureSwaps() { return g_renderStats.lastFrame.textureSwaps; }
     void Framework_Render_SetAutoBatching(bool enabled) { g_autoBatching = enabled; }
     bool Framework_Render_IsAutoBatching() { return g_autoBatching; }
 
@@ -5903,6 +7827,7 @@ extern "C" {
     }
 
     void Framework_Ecs_DrawTilemap(int entity) {
+        if (g_headless) return;
         auto tmIt = g_tilemap.find(entity);
         if (tmIt == g_tilemap.end()) return;
 
@@ -5924,6 +7849,8 @@ extern "C" {
 
         const Texture2D& tex = texIt->second.tex;
 
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_TILEMAPS);
+        QuadStream qs(tex.id, tm.mapWidth * tm.mapHeight);
         for (int y = 0; y < tm.mapHeight; y++) {
             for (int x = 0; x < tm.mapWidth; x++) {
                 int tileIdx = tm.tiles[y * tm.mapWidth + x];
@@ -5933,9 +7860,8 @@ extern "C" {
                 int srcY = (tileIdx / ts.columns) * ts.tileHeight;
 
                 Rectangle src = { (float)srcX, (float)srcY, (float)ts.tileWidth, (float)ts.tileHeight };
-                Vector2 pos = { offsetX + x * ts.tileWidth, offsetY + y * ts.tileHeight };
-
-                DrawTextureRec(tex, src, pos, WHITE);
+                Rectangle dst = { offsetX + x * ts.tileWidth, offsetY + y * ts.tileHeight, src.width, src.height };
+                StreamTextureQuad(qs, tex, src, dst, Vector2{ 0, 0 }, 0.0f, WHITE);
             }
         }
     }
@@ -6584,39 +8510,187 @@ extern "C" {
         }
     }
 
+    // Particles are streamed straight into rlgl: every emitter sharing a texture
+    // and blend mode goes out as one run of quads, and untextured particles use
+    // a prebuilt circle sprite instead of a tessellated DrawCircle fan.
+    namespace {
+        const int PARTICLE_CIRCLE_SPRITE_SIZE = 64;
+
+        Texture2D g_particleCircleTex{};
+
+        const Texture2D& ParticleCircleTexture() {
+            if (g_particleCircleTex.id != 0) return g_particleCircleTex;
+
+            const int n = PARTICLE_CIRCLE_SPRITE_SIZE;
+            Image img = GenImageColor(n, n, BLANK);
+            Color* px = (Color*)img.data;
+            float c = n * 0.5f;
+            for (int y = 0; y < n; y++) {
+                for (int x = 0; x < n; x++) {
+                    float dx = x + 0.5f - c;
+                    float dy = y + 0.5f - c;
+                    float a = c - sqrtf(dx * dx + dy * dy);  // One-pixel antialiased edge
+                    a = a < 0.0f ? 0.0f : (a > 1.0f ? 1.0f : a);
+                    px[y * n + x] = Color{ 255, 255, 255, (unsigned char)(a * 255.0f) };
+                }
+            }
+            g_particleCircleTex = LoadTextureFromImage(img);
+            UnloadImage(img);
+            GenTextureMipmaps(&g_particleCircleTex);
+            SetTextureFilter(g_particleCircleTex, TEXTURE_FILTER_TRILINEAR);
+            return g_particleCircleTex;
+        }
+
+        struct ParticleDrawScratch {
+            std::vector<const Particle*> items, itemsAlt;
+            std::vector<uint32_t> keys, keysAlt;
+        };
+        ParticleDrawScratch g_particleScratch;
+
+        // Order-preserving map from float to unsigned so negatives sort first
+        uint32_t ParticleSortKey(float f) {
+            uint32_t u;
+            memcpy(&u, &f, sizeof(u));
+            return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+        }
+
+        // LSD radix sort, 8 bits per pass; a pass is skipped when every key shares that digit
+        void RadixSortParticles(ParticleDrawScratch& s) {
+            size_t n = s.items.size();
+            if (n < 2) return;
+            s.keysAlt.resize(n);
+            s.itemsAlt.resize(n);
+            for (int shift = 0; shift < 32; shift += 8) {
+                size_t counts[256] = {};
+                for (size_t i = 0; i < n; i++) counts[(s.keys[i] >> shift) & 0xFF]++;
+                if (counts[(s.keys[0] >> shift) & 0xFF] == n) continue;
+
+                size_t offset = 0;
+                for (int b = 0; b < 256; b++) {
+                    size_t c = counts[b];
+                    counts[b] = offset;
+                    offset += c;
+                }
+                for (size_t i = 0; i < n; i++) {
+                    size_t dst = counts[(s.keys[i] >> shift) & 0xFF]++;
+                    s.keysAlt[dst] = s.keys[i];
+                    s.itemsAlt[dst] = s.items[i];
+                }
+                s.keys.swap(s.keysAlt);
+                s.items.swap(s.itemsAlt);
+            }
+        }
+
+        // Collects the live particles of one emitter into scratch.items in draw order
+        void GatherParticles(const ParticleEmitterComponent& pe, float emitX, float emitY) {
+            auto& s = g_particleScratch;
+            s.items.clear();
+            s.keys.clear();
+            for (const auto& p : pe.particles) {
+                if (!p.active) continue;
+                s.items.push_back(&p);
+                if (pe.sortMode == PARTICLE_SORT_AGE) {
+                    s.keys.push_back(ParticleSortKey(-(p.maxLife - p.life)));
+                } else if (pe.sortMode == PARTICLE_SORT_DISTANCE) {
+                    float dx = p.x - emitX;
+                    float dy = p.y - emitY;
+                    s.keys.push_back(ParticleSortKey(-(dx * dx + dy * dy)));
+                }
+            }
+            if (pe.sortMode == PARTICLE_SORT_AGE || pe.sortMode == PARTICLE_SORT_DISTANCE) {
+                RadixSortParticles(s);
+            }
+        }
+
+        void StreamParticleQuads(const ParticleEmitterComponent& pe, unsigned int texId,
+                                 float u0, float v0, float u1, float v1) {
+            const auto& items = g_particleScratch.items;
+            QuadStream qs(texId, (int)items.size());
+            for (const Particle* pp : items) {
+                const Particle& p = *pp;
+                float t = 1.0f - (p.life / p.maxLife);
+                Color c{ LerpByte(pe.colorStart.r, pe.colorEnd.r, t),
+                         LerpByte(pe.colorStart.g, pe.colorEnd.g, t),
+                         LerpByte(pe.colorStart.b, pe.colorEnd.b, t),
+                         LerpByte(pe.colorStart.a, pe.colorEnd.a, t) };
+                float h = p.size * 0.5f;
+                qs.Quad(p.x - h, p.y - h, p.x + h, p.y + h, u0, v0, u1, v1, c);
+            }
+        }
+
+        int ParticleBlendToRaylib(int blendMode) {
+            switch (blendMode) {
+                case PARTICLE_BLEND_ADDITIVE: return BLEND_ADDITIVE;
+                case PARTICLE_BLEND_MULTIPLY: return BLEND_MULTIPLIED;
+                default: return BLEND_ALPHA;
+            }
+        }
+    }
+
     void Framework_Particles_Draw() {
+        if (g_headless) return;
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_PARTICLES);
+
+        struct EmitterDraw {
+            const ParticleEmitterComponent* pe;
+            const Texture2D* tex;   // Circle sprite when the emitter has no usable texture
+            bool textured;
+            int blend;
+            float emitX, emitY;
+        };
+        std::vector<EmitterDraw> draws;
+        draws.reserve(g_particleEmitter.size());
+
         for (auto& kv : g_particleEmitter) {
             if (!EcsIsAlive(kv.first)) continue;
-            ParticleEmitterComponent& pe = kv.second;
+            const ParticleEmitterComponent& pe = kv.second;
 
-            // Get texture if available
-            Texture2D* tex = nullptr;
+            EmitterDraw d{ &pe, nullptr, false, ParticleBlendToRaylib(pe.blendMode), 0.0f, 0.0f };
             auto texIt = g_texByHandle.find(pe.textureHandle);
-            if (texIt != g_texByHandle.end() && texIt->second.valid) {
-                tex = &texIt->second.tex;
+            if (texIt != g_texByHandle.end() && texIt->second.valid &&
+                pe.sourceRect.width > 0 && pe.sourceRect.height > 0) {
+                d.tex = &texIt->second.tex;
+                d.textured = true;
+            } else {
+                d.tex = &ParticleCircleTexture();
             }
+            auto trIt = g_transform2D.find(kv.first);
+            if (trIt != g_transform2D.end()) {
+                d.emitX = trIt->second.position.x;
+                d.emitY = trIt->second.position.y;
+            }
+            draws.push_back(d);
+        }
 
-            for (const auto& p : pe.particles) {
-                if (!p.active) continue;
+        // Group by blend mode, then texture, so each group is one uninterrupted quad stream
+        std::stable_sort(draws.begin(), draws.end(), [](const EmitterDraw& a, const EmitterDraw& b) {
+            if (a.blend != b.blend) return a.blend < b.blend;
+            return a.tex->id < b.tex->id;
+        });
 
-                // Calculate color
-                float t = 1.0f - (p.life / p.maxLife);
-                Color c;
-                c.r = LerpByte(pe.colorStart.r, pe.colorEnd.r, t);
-                c.g = LerpByte(pe.colorStart.g, pe.colorEnd.g, t);
-                c.b = LerpByte(pe.colorStart.b, pe.colorEnd.b, t);
-                c.a = LerpByte(pe.colorStart.a, pe.colorEnd.a, t);
-
-                if (tex && pe.sourceRect.width > 0 && pe.sourceRect.height > 0) {
-                    // Draw textured particle
-                    Rectangle dest = { p.x - p.size/2, p.y - p.size/2, p.size, p.size };
-                    DrawTexturePro(*tex, pe.sourceRect, dest, {0, 0}, 0, c);
-                } else {
-                    // Draw as circle
-                    DrawCircle((int)p.x, (int)p.y, p.size/2, c);
-                }
+        int currentBlend = BLEND_ALPHA;
+        for (const auto& d : draws) {
+            if (d.blend != currentBlend) {
+                RenderList_BeginBlend(d.blend);
+                currentBlend = d.blend;
+            }
+
+            GatherParticles(*d.pe, d.emitX, d.emitY);
+            if (g_particleScratch.items.empty()) continue;
+
+            float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+            if (d.textured) {
+                const Rectangle& src = d.pe->sourceRect;
+                u0 = src.x / (float)d.tex->width;
+                v0 = src.y / (float)d.tex->height;
+                u1 = (src.x + src.width) / (float)d.tex->width;
+                v1 = (src.y + src.height) / (float)d.tex->height;
             }
+            StreamParticleQuads(*d.pe, d.tex->id, u0, v0, u1, v1);
         }
+        rlSetTexture(0);
+
+        if (currentBlend != BLEND_ALPHA) RenderList_EndBlend();
     }
 
     // ========================================================================
@@ -7008,6 +9082,22 @@ extern "C" {
         bool enabled = true;
         bool valid = true;
 
+        // Container layout (UI_LAYOUT_*): children are placed by the container and their own
+        // x/y/anchor are ignored. Grid and wrap containers fit their height only.
+        int layoutMode = UI_LAYOUT_NONE;
+        int layoutAlign = UI_LAYOUT_ALIGN_START;
+        int layoutColumns = 0;                   // Grid: 0 = as many as fit the width
+        float layoutSpacing = 0.0f;
+        float layoutCellW = 0, layoutCellH = 0;  // Grid: 0 = largest visible child
+        bool layoutFit = false;                  // Resize to the arranged content
+        bool layoutDirty = false;                // Queued in g_uiLayoutQueue
+        float contentW = 0, contentH = 0;        // Measurement cached by the last arrange
+        float layoutX = 0, layoutY = 0;          // Offset inside a layout parent
+
+        // Resolved screen position (UI_RefreshLayout) and place in the owning root's member list
+        float screenX = 0, screenY = 0;
+        int cacheRoot = -1, memberIndex = -1;
+
         // Callbacks (stored as function pointers)
         UICallback onClick = nullptr;
         UICallback onHover = nullptr;
@@ -7021,31 +9111,100 @@ extern "C" {
     static int g_uiFocusedId = -1;
     static int g_uiHoveredId = -1;
 
-    // Helper: Get computed position based on anchor
-    // depth parameter prevents infinite recursion on circular parent chains
-    static Vector2 UI_GetAnchoredPosition(const UIElement& el, int depth = 0) {
-        constexpr int MAX_UI_DEPTH = 32;  // Prevent stack overflow on circular parents
+    // Retained draw cache: every root element (no valid parent) owns a prebuilt quad list for its
+    // whole subtree, split into one segment per layer so layering across roots is preserved.
+    // Roots are rebuilt only when something in their subtree is marked dirty.
+    struct UIVertex { float x, y, u, v; Color color; };
+    struct UIRun { unsigned int texId; int firstVertex; int quads; };
+    struct UISegment { int firstRun = 0; int runCount = 0; };
+    struct UIMember { int id; int parentIndex; int subtreeEnd; };  // Pre-order; a subtree is [index, subtreeEnd)
+
+    struct UIRootCache {
+        bool dirty = true;
+        std::vector<UIMember> members;
+        std::vector<int> layers;                            // Distinct member layers, ascending
+        std::vector<UIVertex> verts;
+        std::vector<UIRun> runs;
+        std::vector<UISegment> segments;                    // One per entry in layers
+        std::vector<std::pair<int, unsigned int>> textures; // Texture handle -> GL id baked into runs
+        std::vector<std::pair<int, unsigned int>> fonts;    // Font handle -> atlas GL id baked into runs
+        unsigned int shapesTex = 0;
+    };
+
+    struct UIDrawEntry { int layer; int root; int segment; };
 
-        float baseX = el.x;
-        float baseY = el.y;
+    static std::unordered_map<int, UIRootCache> g_uiRootCaches;
+    static std::vector<UIDrawEntry> g_uiDrawOrder;   // Sorted by layer, then root id
+    static std::vector<int> g_uiHitOrder;            // Topmost first: layer desc, then area asc
+    static bool g_uiOrderDirty = true;               // Element created/destroyed, parent or layer changed
+    static bool g_uiHitOrderDirty = true;            // Element size changed
+    static bool g_uiLayoutDirty = true;              // Any position, size, anchor or parent changed
+    static bool g_uiLayoutFull = true;               // Re-resolve every screen rect, not just g_uiPositionDirty
+    static std::vector<int> g_uiPositionDirty;       // Elements whose subtree screen rects are stale
+    static std::vector<int> g_uiLayoutQueue;         // Containers waiting to be arranged
+    static int g_uiLayoutScreenW = 0, g_uiLayoutScreenH = 0;
+    static int g_uiLayoutPasses = 0;
 
-        // Get parent bounds or screen bounds
-        float parentX = 0, parentY = 0;
-        float parentW = (float)GetScreenWidth();
-        float parentH = (float)GetScreenHeight();
+    // Hit-test grid over the cached screen rects. Each cell lists elements in hit order (rank);
+    // elements covering too many cells go to a shared oversize list merged in at query time.
+    struct UIGridItem { int rank; int id; };
+    static constexpr float UI_GRID_CELL = 64.0f;
+    static constexpr int UI_GRID_MAX_CELLS = 256;
+    static std::unordered_map<long long, std::vector<UIGridItem>> g_uiGrid;
+    static std::vector<UIGridItem> g_uiGridOversize;
+    static std::vector<UIElement*> g_uiLayoutScratch;
+    static int g_uiCacheRebuilds = 0;
 
-        if (el.parent >= 0 && depth < MAX_UI_DEPTH) {
-            auto pit = g_uiElements.find(el.parent);
-            if (pit != g_uiElements.end() && pit->second.valid) {
-                Vector2 ppos = UI_GetAnchoredPosition(pit->second, depth + 1);
-                parentX = ppos.x;
-                parentY = ppos.y;
-                parentW = pit->second.width;
-                parentH = pit->second.height;
-            }
+    static int UI_FindRoot(const UIElement& el) {
+        constexpr int MAX_UI_DEPTH = 32;
+        const UIElement* cur = &el;
+        for (int depth = 0; depth < MAX_UI_DEPTH && cur->parent >= 0; depth++) {
+            auto pit = g_uiElements.find(cur->parent);
+            if (pit == g_uiElements.end() || !pit->second.valid) break;
+            cur = &pit->second;
         }
+        return cur->id;
+    }
 
-        float anchorX = parentX, anchorY = parentY;
+    // Flag the cached output containing this element for rebuild
+    static void UI_MarkDirty(const UIElement& el) {
+        auto cit = g_uiRootCaches.find(UI_FindRoot(el));
+        if (cit != g_uiRootCaches.end()) cit->second.dirty = true;
+        else g_uiOrderDirty = true;
+    }
+
+    // Flag a move/resize: the element's cache plus its subtree's screen rects and the hit-test grid
+    static void UI_MarkLayoutDirty(const UIElement& el) {
+        UI_MarkDirty(el);
+        g_uiPositionDirty.push_back(el.id);
+        g_uiLayoutDirty = true;
+    }
+
+    // Queue a container to re-arrange its children before the next hit-test or draw
+    static void UI_QueueLayout(UIElement& el) {
+        if (el.layoutMode == UI_LAYOUT_NONE || el.layoutDirty) return;
+        el.layoutDirty = true;
+        g_uiLayoutQueue.push_back(el.id);
+        g_uiLayoutDirty = true;
+    }
+
+    // A child's size, visibility or membership changed: its layout parent must re-arrange
+    static void UI_QueueParentLayout(const UIElement& el) {
+        if (el.parent < 0) return;
+        auto pit = g_uiElements.find(el.parent);
+        if (pit != g_uiElements.end() && pit->second.valid) UI_QueueLayout(pit->second);
+    }
+
+    // Forward declaration (defined after the layout engine below)
+    static void UI_RefreshLayout();
+
+    static void UI_InvalidateAll() {
+        for (auto& kv : g_uiRootCaches) kv.second.dirty = true;
+    }
+
+    // Helper: Place an element relative to its parent's (or the screen's) rectangle
+    static Vector2 UI_ResolveAnchor(const UIElement& el, float parentX, float parentY, float parentW, float parentH) {
+        float anchorX = parentX, anchorY = parentY;
         switch (el.anchor) {
             case UI_ANCHOR_TOP_LEFT:      anchorX = parentX; anchorY = parentY; break;
             case UI_ANCHOR_TOP_CENTER:    anchorX = parentX + parentW/2 - el.width/2; anchorY = parentY; break;
@@ -7057,8 +9216,7 @@ extern "C" {
             case UI_ANCHOR_BOTTOM_CENTER: anchorX = parentX + parentW/2 - el.width/2; anchorY = parentY + parentH - el.height; break;
             case UI_ANCHOR_BOTTOM_RIGHT:  anchorX = parentX + parentW - el.width; anchorY = parentY + parentH - el.height; break;
         }
-
-        return { anchorX + baseX, anchorY + baseY };
+        return { anchorX + el.x, anchorY + el.y };
     }
 
     // Helper: Point in rect
@@ -7066,15 +9224,6 @@ extern "C" {
         return px >= rx && px <= rx + rw && py >= ry && py <= ry + rh;
     }
 
-    // Helper: Draw rounded rectangle
-    static void UI_DrawRoundedRect(float x, float y, float w, float h, float radius, Color color) {
-        if (radius <= 0) {
-            DrawRectangle((int)x, (int)y, (int)w, (int)h, color);
-        } else {
-            DrawRectangleRounded({x, y, w, h}, radius / (w < h ? w : h), 8, color);
-        }
-    }
-
     // Helper: Get font by handle (for UI)
     static Font UI_GetFontByHandle(int handle) {
         auto it = g_fontByHandle.find(handle);
@@ -7084,10 +9233,127 @@ extern "C" {
         return GetFontDefault();
     }
 
-    // Helper: Draw text with alignment
-    static void UI_DrawAlignedText(const char* text, float x, float y, float w, float h, int fontH, float fontSize, int align, Color color) {
+    // Cache builders: mirror the raylib shape/texture/text calls the UI used to issue directly,
+    // but append quads to a root's vertex list instead. Triangles become degenerate quads.
+    static unsigned int g_uiShapesTex = 0;
+    static float g_uiShapesU = 0.0f, g_uiShapesV = 0.0f;
+
+    static void UI_AddDependency(std::vector<std::pair<int, unsigned int>>& deps, int handle, unsigned int glId) {
+        for (const auto& d : deps) if (d.first == handle && d.second == glId) return;
+        deps.push_back({ handle, glId });
+    }
+
+    static void UI_PushQuad(UIRootCache& c, unsigned int texId, const UIVertex (&q)[4]) {
+        if (c.runs.size() > (size_t)c.segments.back().firstRun && c.runs.back().texId == texId) {
+            c.runs.back().quads++;
+        } else {
+            c.runs.push_back({ texId, (int)c.verts.size(), 1 });
+            c.segments.back().runCount++;
+        }
+        c.verts.insert(c.verts.end(), q, q + 4);
+    }
+
+    // Corners in TL, BL, BR, TR order (counter-clockwise on screen)
+    static void UI_PushSolidQuad(UIRootCache& c, Vector2 tl, Vector2 bl, Vector2 br, Vector2 tr, Color color) {
+        if (color.a == 0) return;
+        float u = g_uiShapesU, v = g_uiShapesV;
+        UIVertex q[4] = { { tl.x, tl.y, u, v, color }, { bl.x, bl.y, u, v, color },
+                          { br.x, br.y, u, v, color }, { tr.x, tr.y, u, v, color } };
+        UI_PushQuad(c, g_uiShapesTex, q);
+    }
+
+    static void UI_PushRect(UIRootCache& c, float x, float y, float w, float h, Color color) {
+        if (w <= 0 || h <= 0) return;
+        UI_PushSolidQuad(c, { x, y }, { x, y + h }, { x + w, y + h }, { x + w, y }, color);
+    }
+
+    static void UI_PushTriangle(UIRootCache& c, Vector2 a, Vector2 b, Vector2 d, Color color) {
+        float cross = (b.x - a.x) * (d.y - a.y) - (b.y - a.y) * (d.x - a.x);
+        if (cross > 0) std::swap(b, d);
+        UI_PushSolidQuad(c, a, b, d, d, color);
+    }
+
+    // Helper: Rounded rectangle (same radius rule and segment count as DrawRectangleRounded)
+    static void UI_PushRoundedRect(UIRootCache& c, float x, float y, float w, float h, float radius, Color color) {
+        if (radius <= 0 || w < 1 || h < 1) {
+            UI_PushRect(c, (float)(int)x, (float)(int)y, (float)(int)w, (float)(int)h, color);
+            return;
+        }
+        constexpr int CORNER_SEGMENTS = 8;
+        float r = std::min(radius, std::min(w, h)) / 2.0f;
+        UI_PushRect(c, x, y + r, w, h - 2 * r, color);
+        UI_PushRect(c, x + r, y, w - 2 * r, r, color);
+        UI_PushRect(c, x + r, y + h - r, w - 2 * r, r, color);
+
+        const Vector2 centers[4] = { { x + r, y + r }, { x + w - r, y + r }, { x + w - r, y + h - r }, { x + r, y + h - r } };
+        const float startAngles[4] = { 180.0f, 270.0f, 0.0f, 90.0f };
+        float step = 90.0f / CORNER_SEGMENTS * DEG2RAD;
+        for (int k = 0; k < 4; k++) {
+            float angle = startAngles[k] * DEG2RAD;
+            Vector2 prev = { centers[k].x + cosf(angle) * r, centers[k].y + sinf(angle) * r };
+            for (int i = 0; i < CORNER_SEGMENTS; i++) {
+                angle += step;
+                Vector2 next = { centers[k].x + cosf(angle) * r, centers[k].y + sinf(angle) * r };
+                UI_PushTriangle(c, centers[k], prev, next, color);
+                prev = next;
+            }
+        }
+    }
+
+    // Helper: Outline (same edge split as DrawRectangleLinesEx)
+    static void UI_PushRectLines(UIRootCache& c, float x, float y, float w, float h, float thick, Color color) {
+        if (thick <= 0) return;
+        if (thick > w || thick > h) thick = (w >= h) ? h / 2 : w / 2;
+        UI_PushRect(c, x, y, w, thick, color);
+        UI_PushRect(c, x, y - thick + h, w, thick, color);
+        UI_PushRect(c, x, y + thick, thick, h - thick * 2, color);
+        UI_PushRect(c, x - thick + w, y + thick, thick, h - thick * 2, color);
+    }
+
+    // Helper: One pixel wide line between pixel centers
+    static void UI_PushLine(UIRootCache& c, float x0, float y0, float x1, float y1, Color color) {
+        x0 += 0.5f; y0 += 0.5f; x1 += 0.5f; y1 += 0.5f;
+        float dx = x1 - x0, dy = y1 - y0;
+        float len = sqrtf(dx * dx + dy * dy);
+        if (len <= 0.0f) return;
+        float nx = -dy / len * 0.5f, ny = dx / len * 0.5f;
+        UI_PushTriangle(c, { x0 - nx, y0 - ny }, { x0 + nx, y0 + ny }, { x1 + nx, y1 + ny }, color);
+        UI_PushTriangle(c, { x0 - nx, y0 - ny }, { x1 + nx, y1 + ny }, { x1 - nx, y1 - ny }, color);
+    }
+
+    static void UI_PushCircle(UIRootCache& c, float cx, float cy, float radius, Color color) {
+        constexpr int CIRCLE_SEGMENTS = 36;
+        float step = 2.0f * PI / CIRCLE_SEGMENTS;
+        Vector2 center = { cx, cy };
+        Vector2 prev = { cx + radius, cy };
+        for (int i = 1; i <= CIRCLE_SEGMENTS; i++) {
+            Vector2 next = { cx + cosf(step * i) * radius, cy + sinf(step * i) * radius };
+            UI_PushTriangle(c, center, prev, next, color);
+            prev = next;
+        }
+    }
+
+    // Helper: Textured quad (DrawTexturePro without origin/rotation, negative source size flips)
+    static void UI_PushTexture(UIRootCache& c, const Texture2D& tex, Rectangle src, Rectangle dest, Color tint) {
+        if (tex.width <= 0 || tex.height <= 0 || tint.a == 0) return;
+        bool flipX = src.width < 0, flipY = src.height < 0;
+        if (flipX) src.width = -src.width;
+        if (flipY) src.height = -src.height;
+        float u0 = src.x / tex.width, u1 = (src.x + src.width) / tex.width;
+        float v0 = src.y / tex.height, v1 = (src.y + src.height) / tex.height;
+        if (flipX) std::swap(u0, u1);
+        if (flipY) std::swap(v0, v1);
+        float x0 = dest.x, y0 = dest.y, x1 = dest.x + dest.width, y1 = dest.y + dest.height;
+        UIVertex q[4] = { { x0, y0, u0, v0, tint }, { x0, y1, u0, v1, tint },
+                          { x1, y1, u1, v1, tint }, { x1, y0, u1, v0, tint } };
+        UI_PushQuad(c, tex.id, q);
+    }
+
+    // Helper: Text with alignment
+    static void UI_PushAlignedText(UIRootCache& c, const char* text, float x, float y, float w, float h, int fontH, float fontSize, int align, Color color) {
         Font font = UI_GetFontByHandle(fontH);
-        Vector2 textSize = MeasureTextEx(font, text, fontSize, 1);
+        const TextLayout& layout = GetTextLayout(font, text, fontSize, 1, 0);
+        Vector2 textSize = { layout.width, layout.height };
 
         float tx = x, ty = y;
         switch (align) {
@@ -7102,7 +9368,14 @@ extern "C" {
             case UI_ANCHOR_BOTTOM_RIGHT:  tx = x + w - textSize.x; ty = y + h - textSize.y; break;
         }
 
-        DrawTextEx(font, text, {tx, ty}, fontSize, 1, color);
+        if (layout.glyphs.empty() || color.a == 0) return;
+        UI_AddDependency(c.fonts, fontH, font.texture.id);
+        for (const TextLayoutGlyph& g : layout.glyphs) {
+            float gx = tx + g.x, gy = ty + g.y;
+            UIVertex q[4] = { { gx, gy, g.u0, g.v0, color }, { gx, gy + g.h, g.u0, g.v1, color },
+                              { gx + g.w, gy + g.h, g.u1, g.v1, color }, { gx + g.w, gy, g.u1, g.v0, color } };
+            UI_PushQuad(c, font.texture.id, q);
+        }
     }
 
     // Create functions
@@ -7116,11 +9389,12 @@ extern "C" {
         el.borderWidth = 0;
 
         // Auto-size based on text
-        Vector2 textSize = MeasureTextEx(GetFontDefault(), el.text.c_str(), el.fontSize, 1);
+        Vector2 textSize = MeasureTextEx_Internal(GetFontDefault(), el.text.c_str(), el.fontSize, 1);
         el.width = textSize.x + el.padding[0] + el.padding[2];
         el.height = textSize.y + el.padding[1] + el.padding[3];
 
         g_uiElements[el.id] = el;
+        g_uiOrderDirty = true;
         return el.id;
     }
 
@@ -7138,6 +9412,7 @@ extern "C" {
         el.cornerRadius = 4.0f;
 
         g_uiElements[el.id] = el;
+        g_uiOrderDirty = true;
         return el.id;
     }
 
@@ -7152,6 +9427,7 @@ extern "C" {
         el.cornerRadius = 8.0f;
 
         g_uiElements[el.id] = el;
+        g_uiOrderDirty = true;
         return el.id;
     }
 
@@ -7169,6 +9445,7 @@ extern "C" {
         el.cornerRadius = 4.0f;
 
         g_uiElements[el.id] = el;
+        g_uiOrderDirty = true;
         return el.id;
     }
 
@@ -7187,6 +9464,7 @@ extern "C" {
         el.cornerRadius = 4.0f;
 
         g_uiElements[el.id] = el;
+        g_uiOrderDirty = true;
         return el.id;
     }
 
@@ -7204,6 +9482,7 @@ extern "C" {
         el.textAlign = UI_ANCHOR_CENTER_LEFT;
 
         g_uiElements[el.id] = el;
+        g_uiOrderDirty = true;
         return el.id;
     }
 
@@ -7219,6 +9498,7 @@ extern "C" {
         el.cornerRadius = 4.0f;
 
         g_uiElements[el.id] = el;
+        g_uiOrderDirty = true;
         return el.id;
     }
 
@@ -7233,14 +9513,17 @@ extern "C" {
         el.bgColor = {0, 0, 0, 0};
 
         g_uiElements[el.id] = el;
+        g_uiOrderDirty = true;
         return el.id;
     }
 
     void Framework_UI_Destroy(int elementId) {
         auto it = g_uiElements.find(elementId);
         if (it != g_uiElements.end()) {
+            UI_QueueParentLayout(it->second);
             it->second.valid = false;
             g_uiElements.erase(it);
+            g_uiOrderDirty = true;
         }
         if (g_uiFocusedId == elementId) g_uiFocusedId = -1;
         if (g_uiHoveredId == elementId) g_uiHoveredId = -1;
@@ -7248,6 +9531,14 @@ extern "C" {
 
     void Framework_UI_DestroyAll() {
         g_uiElements.clear();
+        g_uiRootCaches.clear();
+        g_uiDrawOrder.clear();
+        g_uiHitOrder.clear();
+        g_uiGrid.clear();
+        g_uiGridOversize.clear();
+        g_uiLayoutQueue.clear();
+        g_uiPositionDirty.clear();
+        g_uiOrderDirty = true;
         g_uiFocusedId = -1;
         g_uiHoveredId = -1;
     }
@@ -7260,22 +9551,33 @@ extern "C" {
     // Property setters - Common
     void Framework_UI_SetPosition(int elementId, float x, float y) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.x = x; it->second.y = y; }
+        if (it != g_uiElements.end()) { it->second.x = x; it->second.y = y; UI_MarkLayoutDirty(it->second); }
     }
 
     void Framework_UI_SetSize(int elementId, float width, float height) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.width = width; it->second.height = height; }
+        if (it != g_uiElements.end()) {
+            it->second.width = width;
+            it->second.height = height;
+            UI_MarkLayoutDirty(it->second);
+            UI_QueueLayout(it->second);
+            UI_QueueParentLayout(it->second);
+            g_uiHitOrderDirty = true;
+        }
     }
 
     void Framework_UI_SetAnchor(int elementId, int anchor) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.anchor = anchor; }
+        if (it != g_uiElements.end()) { it->second.anchor = anchor; UI_MarkLayoutDirty(it->second); }
     }
 
     void Framework_UI_SetVisible(int elementId, bool visible) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.visible = visible; }
+        if (it != g_uiElements.end()) {
+            it->second.visible = visible;
+            UI_MarkDirty(it->second);
+            UI_QueueParentLayout(it->second);  // Hidden children take no space in a container
+        }
     }
 
     void Framework_UI_SetEnabled(int elementId, bool enabled) {
@@ -7283,17 +9585,23 @@ extern "C" {
         if (it != g_uiElements.end()) {
             it->second.enabled = enabled;
             it->second.state = enabled ? UI_STATE_NORMAL : UI_STATE_DISABLED;
+            UI_MarkDirty(it->second);
         }
     }
 
     void Framework_UI_SetParent(int elementId, int parentId) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.parent = parentId; }
+        if (it != g_uiElements.end()) {
+            UI_QueueParentLayout(it->second);
+            it->second.parent = parentId;
+            UI_QueueParentLayout(it->second);
+            g_uiOrderDirty = true;
+        }
     }
 
     void Framework_UI_SetLayer(int elementId, int layer) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.layer = layer; }
+        if (it != g_uiElements.end()) { it->second.layer = layer; g_uiOrderDirty = true; }
     }
 
     float Framework_UI_GetX(int elementId) {
@@ -7307,11 +9615,13 @@ extern "C" {
     }
 
     float Framework_UI_GetWidth(int elementId) {
+        if (!g_uiLayoutQueue.empty()) UI_RefreshLayout();  // Fit-to-content containers may resize
         auto it = g_uiElements.find(elementId);
         return (it != g_uiElements.end()) ? it->second.width : 0;
     }
 
     float Framework_UI_GetHeight(int elementId) {
+        if (!g_uiLayoutQueue.empty()) UI_RefreshLayout();
         auto it = g_uiElements.find(elementId);
         return (it != g_uiElements.end()) ? it->second.height : 0;
     }
@@ -7339,7 +9649,7 @@ extern "C" {
     // Property setters - Text/Font
     void Framework_UI_SetText(int elementId, const char* text) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.text = text ? text : ""; }
+        if (it != g_uiElements.end()) { it->second.text = text ? text : ""; UI_MarkDirty(it->second); }
     }
 
     const char* Framework_UI_GetText(int elementId) {
@@ -7349,58 +9659,58 @@ extern "C" {
 
     void Framework_UI_SetFont(int elementId, int fontHandle) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.fontHandle = fontHandle; }
+        if (it != g_uiElements.end()) { it->second.fontHandle = fontHandle; UI_MarkDirty(it->second); }
     }
 
     void Framework_UI_SetFontSize(int elementId, float size) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.fontSize = size; }
+        if (it != g_uiElements.end()) { it->second.fontSize = size; UI_MarkDirty(it->second); }
     }
 
     void Framework_UI_SetTextColor(int elementId, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.textColor = {r, g, b, a}; }
+        if (it != g_uiElements.end()) { it->second.textColor = {r, g, b, a}; UI_MarkDirty(it->second); }
     }
 
     void Framework_UI_SetTextAlign(int elementId, int anchor) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.textAlign = anchor; }
+        if (it != g_uiElements.end()) { it->second.textAlign = anchor; UI_MarkDirty(it->second); }
     }
 
     // Property setters - Colors
     void Framework_UI_SetBackgroundColor(int elementId, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.bgColor = {r, g, b, a}; }
+        if (it != g_uiElements.end()) { it->second.bgColor = {r, g, b, a}; UI_MarkDirty(it->second); }
     }
 
     void Framework_UI_SetBorderColor(int elementId, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.borderColor = {r, g, b, a}; }
+        if (it != g_uiElements.end()) { it->second.borderColor = {r, g, b, a}; UI_MarkDirty(it->second); }
     }
 
     void Framework_UI_SetHoverColor(int elementId, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.hoverColor = {r, g, b, a}; }
+        if (it != g_uiElements.end()) { it->second.hoverColor = {r, g, b, a}; UI_MarkDirty(it->second); }
     }
 
     void Framework_UI_SetPressedColor(int elementId, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.pressedColor = {r, g, b, a}; }
+        if (it != g_uiElements.end()) { it->second.pressedColor = {r, g, b, a}; UI_MarkDirty(it->second); }
     }
 
     void Framework_UI_SetDisabledColor(int elementId, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.disabledColor = {r, g, b, a}; }
+        if (it != g_uiElements.end()) { it->second.disabledColor = {r, g, b, a}; UI_MarkDirty(it->second); }
     }
 
     void Framework_UI_SetBorderWidth(int elementId, float width) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.borderWidth = width; }
+        if (it != g_uiElements.end()) { it->second.borderWidth = width; UI_MarkDirty(it->second); }
     }
 
     void Framework_UI_SetCornerRadius(int elementId, float radius) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.cornerRadius = radius; }
+        if (it != g_uiElements.end()) { it->second.cornerRadius = radius; UI_MarkDirty(it->second); }
     }
 
     void Framework_UI_SetPadding(int elementId, float left, float top, float right, float bottom) {
@@ -7410,6 +9720,8 @@ extern "C" {
             it->second.padding[1] = top;
             it->second.padding[2] = right;
             it->second.padding[3] = bottom;
+            UI_MarkDirty(it->second);
+            UI_QueueLayout(it->second);
         }
     }
 
@@ -7419,6 +9731,7 @@ extern "C" {
         if (it != g_uiElements.end()) {
             float clamped = fmaxf(it->second.minValue, fminf(it->second.maxValue, value));
             it->second.value = clamped;
+            UI_MarkDirty(it->second);
         }
     }
 
@@ -7432,6 +9745,7 @@ extern "C" {
         if (it != g_uiElements.end()) {
             it->second.minValue = minVal;
             it->second.maxValue = maxVal;
+            UI_MarkDirty(it->second);
         }
     }
 
@@ -7440,6 +9754,7 @@ extern "C" {
         if (it != g_uiElements.end()) {
             it->second.checked = checked;
             it->second.value = checked ? 1.0f : 0.0f;
+            UI_MarkDirty(it->second);
         }
     }
 
@@ -7451,7 +9766,7 @@ extern "C" {
     // Property setters - TextInput specific
     void Framework_UI_SetPlaceholder(int elementId, const char* text) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.placeholder = text ? text : ""; }
+        if (it != g_uiElements.end()) { it->second.placeholder = text ? text : ""; UI_MarkDirty(it->second); }
     }
 
     void Framework_UI_SetMaxLength(int elementId, int maxLength) {
@@ -7461,13 +9776,14 @@ extern "C" {
 
     void Framework_UI_SetPasswordMode(int elementId, bool isPassword) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.passwordMode = isPassword; }
+        if (it != g_uiElements.end()) { it->second.passwordMode = isPassword; UI_MarkDirty(it->second); }
     }
 
     void Framework_UI_SetCursorPosition(int elementId, int position) {
         auto it = g_uiElements.find(elementId);
         if (it != g_uiElements.end()) {
             it->second.cursorPos = std::max(0, std::min(position, (int)it->second.text.length()));
+            UI_MarkDirty(it->second);
         }
     }
 
@@ -7479,17 +9795,17 @@ extern "C" {
     // Property setters - Image specific
     void Framework_UI_SetTexture(int elementId, int textureHandle) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.textureHandle = textureHandle; }
+        if (it != g_uiElements.end()) { it->second.textureHandle = textureHandle; UI_MarkDirty(it->second); }
     }
 
     void Framework_UI_SetSourceRect(int elementId, float srcX, float srcY, float srcW, float srcH) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.sourceRect = {srcX, srcY, srcW, srcH}; }
+        if (it != g_uiElements.end()) { it->second.sourceRect = {srcX, srcY, srcW, srcH}; UI_MarkDirty(it->second); }
     }
 
     void Framework_UI_SetTint(int elementId, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
         auto it = g_uiElements.find(elementId);
-        if (it != g_uiElements.end()) { it->second.tint = {r, g, b, a}; }
+        if (it != g_uiElements.end()) { it->second.tint = {r, g, b, a}; UI_MarkDirty(it->second); }
     }
 
     // Callbacks
@@ -7513,6 +9829,346 @@ extern "C" {
         if (it != g_uiElements.end()) { it->second.onTextChanged = callback; }
     }
 
+    // Rebuild root membership, per-root layer lists and the persistent draw/hit orders.
+    // Only structural edits (create, destroy, parent, layer) or size changes get here.
+    static void UI_RefreshOrder() {
+        if (g_uiOrderDirty) {
+            std::vector<int> ids;
+            ids.reserve(g_uiElements.size());
+            for (auto& kv : g_uiElements) {
+                if (kv.second.valid) ids.push_back(kv.first);
+            }
+            std::sort(ids.begin(), ids.end());
+
+            std::unordered_map<int, std::vector<int>> children;
+            std::vector<int> roots;
+            for (int id : ids) {
+                const UIElement& el = g_uiElements.find(id)->second;
+                auto pit = (el.parent >= 0 && el.parent != id) ? g_uiElements.find(el.parent) : g_uiElements.end();
+                if (pit != g_uiElements.end() && pit->second.valid) children[el.parent].push_back(id);
+                else roots.push_back(id);
+            }
+
+            std::unordered_map<int, UIRootCache> caches;
+            g_uiDrawOrder.clear();
+            std::vector<std::pair<int, int>> stack;
+            for (int root : roots) {
+                UIRootCache& c = caches[root];
+                auto old = g_uiRootCaches.find(root);
+                if (old != g_uiRootCaches.end()) c = std::move(old->second);  // Keep vertex capacity
+                c.dirty = true;
+                c.members.clear();
+                c.layers.clear();
+
+                stack.assign(1, { root, -1 });
+                while (!stack.empty()) {
+                    auto [id, parentIndex] = stack.back();
+                    stack.pop_back();
+                    int index = (int)c.members.size();
+                    UIElement& el = g_uiElements.find(id)->second;
+                    c.members.push_back({ id, parentIndex, index + 1 });
+                    c.layers.push_back(el.layer);
+                    el.cacheRoot = root;
+                    el.memberIndex = index;
+                    auto ch = children.find(id);
+                    if (ch != children.end()) {
+                        for (auto rit = ch->second.rbegin(); rit != ch->second.rend(); ++rit) stack.push_back({ *rit, index });
+                    }
+                }
+                for (int i = (int)c.members.size() - 1; i > 0; i--) {
+                    UIMember& parent = c.members[c.members[i].parentIndex];
+                    parent.subtreeEnd = std::max(parent.subtreeEnd, c.members[i].subtreeEnd);
+                }
+                std::sort(c.layers.begin(), c.layers.end());
+                c.layers.erase(std::unique(c.layers.begin(), c.layers.end()), c.layers.end());
+                for (int seg = 0; seg < (int)c.layers.size(); seg++) g_uiDrawOrder.push_back({ c.layers[seg], root, seg });
+            }
+            g_uiRootCaches.swap(caches);
+            std::stable_sort(g_uiDrawOrder.begin(), g_uiDrawOrder.end(),
+                [](const UIDrawEntry& a, const UIDrawEntry& b) { return a.layer < b.layer; });
+
+            g_uiHitOrder = std::move(ids);
+            g_uiOrderDirty = false;
+            g_uiHitOrderDirty = true;
+            g_uiLayoutDirty = true;
+            g_uiLayoutFull = true;
+        }
+    }
+
+    static void UI_RefreshHitOrder() {
+        if (g_uiHitOrderDirty) {
+            std::stable_sort(g_uiHitOrder.begin(), g_uiHitOrder.end(), [](int a, int b) {
+                const UIElement& ea = g_uiElements.find(a)->second;
+                const UIElement& eb = g_uiElements.find(b)->second;
+                // First by layer (higher layer = on top = checked first)
+                if (ea.layer != eb.layer) return ea.layer > eb.layer;
+                // Then by area (smaller area = on top = checked first)
+                return ea.width * ea.height < eb.width * eb.height;
+            });
+            g_uiHitOrderDirty = false;
+            g_uiLayoutDirty = true;
+        }
+    }
+
+    static long long UI_GridKey(int cx, int cy) {
+        return ((long long)cx << 32) ^ (long long)(unsigned int)cy;
+    }
+
+    static int UI_Depth(const UIElement& el) {
+        constexpr int MAX_UI_DEPTH = 32;
+        int depth = 0;
+        const UIElement* cur = &el;
+        while (depth < MAX_UI_DEPTH && cur->parent >= 0) {
+            auto pit = g_uiElements.find(cur->parent);
+            if (pit == g_uiElements.end() || !pit->second.valid) break;
+            cur = &pit->second;
+            depth++;
+        }
+        return depth;
+    }
+
+    // Cross-axis offset of an item of size 'size' inside a slot of size 'slot'
+    static float UI_AlignOffset(int align, float slot, float size) {
+        if (align == UI_LAYOUT_ALIGN_CENTER) return (slot - size) * 0.5f;
+        if (align == UI_LAYOUT_ALIGN_END) return slot - size;
+        return 0.0f;
+    }
+
+    // Place a container's visible children (direct members only, found through the pre-order
+    // member list) and cache the content size. Child subtrees are not visited.
+    static void UI_ArrangeContainer(UIElement& el) {
+        auto cit = g_uiRootCaches.find(el.cacheRoot);
+        if (cit == g_uiRootCaches.end() || el.memberIndex < 0) return;
+        const UIRootCache& c = cit->second;
+
+        std::vector<UIElement*>& kids = g_uiLayoutScratch;
+        kids.clear();
+        int end = c.members[el.memberIndex].subtreeEnd;
+        for (int j = el.memberIndex + 1; j < end; j = c.members[j].subtreeEnd) {
+            auto it = g_uiElements.find(c.members[j].id);
+            if (it != g_uiElements.end() && it->second.valid && it->second.visible) kids.push_back(&it->second);
+        }
+
+        float pl = el.padding[0], pt = el.padding[1], pr = el.padding[2], pb = el.padding[3];
+        float innerW = el.width - pl - pr, innerH = el.height - pt - pb;
+        float sp = el.layoutSpacing;
+        float maxW = 0, maxH = 0;
+        for (UIElement* k : kids) { maxW = std::max(maxW, k->width); maxH = std::max(maxH, k->height); }
+
+        float contentW = 0, contentH = 0;
+        switch (el.layoutMode) {
+            case UI_LAYOUT_HORIZONTAL:
+            case UI_LAYOUT_VERTICAL: {
+                bool horizontal = el.layoutMode == UI_LAYOUT_HORIZONTAL;
+                float cross = horizontal ? (el.layoutFit ? maxH : innerH) : (el.layoutFit ? maxW : innerW);
+                float pen = 0;
+                for (UIElement* k : kids) {
+                    if (horizontal) {
+                        k->layoutX = pl + pen;
+                        k->layoutY = pt + UI_AlignOffset(el.layoutAlign, cross, k->height);
+                        pen += k->width + sp;
+                    } else {
+                        k->layoutX = pl + UI_AlignOffset(el.layoutAlign, cross, k->width);
+                        k->layoutY = pt + pen;
+                        pen += k->height + sp;
+                    }
+                }
+                float along = kids.empty() ? 0 : pen - sp;
+                contentW = horizontal ? along : maxW;
+                contentH = horizontal ? maxH : along;
+                break;
+            }
+
+            case UI_LAYOUT_GRID: {
+                float cellW = el.layoutCellW > 0 ? el.layoutCellW : maxW;
+                float cellH = el.layoutCellH > 0 ? el.layoutCellH : maxH;
+                int cols = el.layoutColumns;
+                if (cols <= 0) cols = (cellW + sp > 0) ? (int)((innerW + sp) / (cellW + sp)) : 1;
+                cols = std::max(1, cols);
+                int count = (int)kids.size();
+                for (int i = 0; i < count; i++) {
+                    UIElement* k = kids[i];
+                    int col = i % cols, row = i / cols;
+                    k->layoutX = pl + col * (cellW + sp) + UI_AlignOffset(el.layoutAlign, cellW, k->width);
+                    k->layoutY = pt + row * (cellH + sp) + UI_AlignOffset(el.layoutAlign, cellH, k->height);
+                }
+                int usedCols = std::min(cols, count), rows = (count + cols - 1) / cols;
+                contentW = usedCols > 0 ? usedCols * (cellW + sp) - sp : 0;
+                contentH = rows > 0 ? rows * (cellH + sp) - sp : 0;
+                break;
+            }
+
+            case UI_LAYOUT_WRAP: {
+                float x = 0, y = 0, rowH = 0;
+                size_t rowStart = 0;
+                auto finishRow = [&](size_t rowEnd) {
+                    for (size_t r = rowStart; r < rowEnd; r++) {
+                        kids[r]->layoutY = pt + y + UI_AlignOffset(el.layoutAlign, rowH, kids[r]->height);
+                    }
+                };
+                for (size_t i = 0; i < kids.size(); i++) {
+                    UIElement* k = kids[i];
+                    if (x > 0 && x + k->width > innerW) {
+                        finishRow(i);
+                        contentW = std::max(contentW, x - sp);
+                        x = 0;
+                        y += rowH + sp;
+                        rowH = 0;
+                        rowStart = i;
+                    }
+                    k->layoutX = pl + x;
+                    x += k->width + sp;
+                    rowH = std::max(rowH, k->height);
+                }
+                finishRow(kids.size());
+                if (!kids.empty()) {
+                    contentW = std::max(contentW, x - sp);
+                    contentH = y + rowH;
+                }
+                break;
+            }
+        }
+
+        el.contentW = contentW;
+        el.contentH = contentH;
+        g_uiLayoutPasses++;
+        UI_MarkLayoutDirty(el);
+
+        if (el.layoutFit) {
+            bool fitWidth = el.layoutMode == UI_LAYOUT_HORIZONTAL || el.layoutMode == UI_LAYOUT_VERTICAL ||
+                            (el.layoutMode == UI_LAYOUT_GRID && el.layoutColumns > 0);
+            float newW = fitWidth ? contentW + pl + pr : el.width;
+            float newH = contentH + pt + pb;
+            if (newW != el.width || newH != el.height) {
+                el.width = newW;
+                el.height = newH;
+                g_uiHitOrderDirty = true;
+                UI_QueueParentLayout(el);  // Our measured size feeds the parent's arrange
+            }
+        }
+    }
+
+    // Arrange queued containers deepest first, so a fit-to-content child is measured before
+    // the parent that stacks it. Parents re-queued by a size change run in a later round.
+    static void UI_ArrangeQueued() {
+        std::vector<std::pair<int, int>> batch;  // (depth, id)
+        while (!g_uiLayoutQueue.empty()) {
+            batch.clear();
+            for (int id : g_uiLayoutQueue) {
+                auto it = g_uiElements.find(id);
+                if (it != g_uiElements.end()) batch.push_back({ UI_Depth(it->second), id });
+            }
+            g_uiLayoutQueue.clear();
+            std::sort(batch.begin(), batch.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+            for (const auto& [depth, id] : batch) {
+                auto it = g_uiElements.find(id);
+                if (it == g_uiElements.end() || !it->second.layoutDirty) continue;
+                it->second.layoutDirty = false;
+                if (it->second.valid && it->second.layoutMode != UI_LAYOUT_NONE) UI_ArrangeContainer(it->second);
+            }
+        }
+    }
+
+    // Resolve screen rects for members [begin, end) of one root, parents before children
+    static void UI_ResolveRange(const UIRootCache& c, int begin, int end, float screenW, float screenH) {
+        std::vector<UIElement*>& resolved = g_uiLayoutScratch;
+        resolved.assign(end - begin, nullptr);
+        for (int i = begin; i < end; i++) {
+            auto it = g_uiElements.find(c.members[i].id);
+            if (it == g_uiElements.end()) continue;
+            UIElement& el = it->second;
+            resolved[i - begin] = &el;
+
+            int pi = c.members[i].parentIndex;
+            const UIElement* parent = nullptr;
+            if (pi >= begin) {
+                parent = resolved[pi - begin];
+            } else if (pi >= 0) {
+                auto pit = g_uiElements.find(c.members[pi].id);
+                if (pit != g_uiElements.end()) parent = &pit->second;
+            }
+
+            Vector2 pos;
+            if (!parent) pos = UI_ResolveAnchor(el, 0, 0, screenW, screenH);
+            else if (parent->layoutMode != UI_LAYOUT_NONE) pos = { parent->screenX + el.layoutX, parent->screenY + el.layoutY };
+            else pos = UI_ResolveAnchor(el, parent->screenX, parent->screenY, parent->width, parent->height);
+            el.screenX = pos.x;
+            el.screenY = pos.y;
+        }
+    }
+
+    // Arrange dirty containers, re-resolve only the stale subtrees' screen rects and rebuild the
+    // hit-test grid. Does nothing unless layout changed; hover and click read the cached rects.
+    static void UI_RefreshLayout() {
+        UI_RefreshOrder();
+
+        int screenW = ScreenWidth_Internal(), screenH = ScreenHeight_Internal();
+        if (screenW != g_uiLayoutScreenW || screenH != g_uiLayoutScreenH) {
+            g_uiLayoutScreenW = screenW;
+            g_uiLayoutScreenH = screenH;
+            g_uiLayoutDirty = true;
+            g_uiLayoutFull = true;
+            UI_InvalidateAll();  // Root anchors are relative to the screen
+        }
+        UI_ArrangeQueued();
+        UI_RefreshHitOrder();
+        if (!g_uiLayoutDirty) return;
+
+        if (g_uiLayoutFull) {
+            for (auto& [root, c] : g_uiRootCaches) UI_ResolveRange(c, 0, (int)c.members.size(), (float)screenW, (float)screenH);
+        } else {
+            for (int id : g_uiPositionDirty) {
+                auto it = g_uiElements.find(id);
+                if (it == g_uiElements.end() || it->second.memberIndex < 0) continue;
+                auto cit = g_uiRootCaches.find(it->second.cacheRoot);
+                if (cit == g_uiRootCaches.end()) continue;
+                int begin = it->second.memberIndex;
+                UI_ResolveRange(cit->second, begin, cit->second.members[begin].subtreeEnd, (float)screenW, (float)screenH);
+            }
+        }
+        g_uiPositionDirty.clear();
+        g_uiLayoutFull = false;
+
+        for (auto& kv : g_uiGrid) kv.second.clear();
+        g_uiGridOversize.clear();
+        for (int rank = 0; rank < (int)g_uiHitOrder.size(); rank++) {
+            auto it = g_uiElements.find(g_uiHitOrder[rank]);
+            if (it == g_uiElements.end()) continue;
+            const UIElement& el = it->second;
+            if (el.width < 0 || el.height < 0) continue;
+            int cx0 = (int)floorf(el.screenX / UI_GRID_CELL), cx1 = (int)floorf((el.screenX + el.width) / UI_GRID_CELL);
+            int cy0 = (int)floorf(el.screenY / UI_GRID_CELL), cy1 = (int)floorf((el.screenY + el.height) / UI_GRID_CELL);
+            if ((long long)(cx1 - cx0 + 1) * (cy1 - cy0 + 1) > UI_GRID_MAX_CELLS) {
+                g_uiGridOversize.push_back({ rank, el.id });
+                continue;
+            }
+            for (int cy = cy0; cy <= cy1; cy++) {
+                for (int cx = cx0; cx <= cx1; cx++) g_uiGrid[UI_GridKey(cx, cy)].push_back({ rank, el.id });
+            }
+        }
+        g_uiLayoutDirty = false;
+    }
+
+    // Topmost visible, enabled element under a point: walks one grid cell plus the oversize list
+    static int UI_HitTest(float px, float py) {
+        static const std::vector<UIGridItem> empty;
+        auto git = g_uiGrid.find(UI_GridKey((int)floorf(px / UI_GRID_CELL), (int)floorf(py / UI_GRID_CELL)));
+        const std::vector<UIGridItem>& cell = (git != g_uiGrid.end()) ? git->second : empty;
+        const std::vector<UIGridItem>& over = g_uiGridOversize;
+
+        size_t a = 0, b = 0;
+        while (a < cell.size() || b < over.size()) {
+            bool takeCell = b >= over.size() || (a < cell.size() && cell[a].rank < over[b].rank);
+            int id = takeCell ? cell[a++].id : over[b++].id;
+            auto it = g_uiElements.find(id);
+            if (it == g_uiElements.end()) continue;
+            const UIElement& el = it->second;
+            if (!el.valid || !el.visible || !el.enabled) continue;
+            if (UI_PointInRect(px, py, el.screenX, el.screenY, el.width, el.height)) return id;
+        }
+        return -1;
+    }
+
     // UI Update - Process input and states
     void Framework_UI_Update() {
         Vector2 mousePos = GetMousePosition();
@@ -7522,33 +10178,10 @@ extern "C" {
 
         int newHovered = -1;
 
-        // Collect and sort elements by layer (higher layers on top), then by area (smaller on top)
-        // This ensures children (usually smaller) are checked before parents at the same layer
-        std::vector<std::pair<int, UIElement*>> sortedElements;
-        for (auto& kv : g_uiElements) {
-            if (kv.second.valid && kv.second.visible && kv.second.enabled) {
-                sortedElements.push_back({kv.first, &kv.second});
-            }
-        }
-        std::sort(sortedElements.begin(), sortedElements.end(),
-            [](const auto& a, const auto& b) {
-                // First by layer (higher layer = on top = checked first)
-                if (a.second->layer != b.second->layer)
-                    return a.second->layer > b.second->layer;
-                // Then by area (smaller area = on top = checked first)
-                float areaA = a.second->width * a.second->height;
-                float areaB = b.second->width * b.second->height;
-                return areaA < areaB;
-            });
-
-        // Find topmost hovered element
-        for (auto& [id, el] : sortedElements) {
-            Vector2 pos = UI_GetAnchoredPosition(*el);
-            if (UI_PointInRect(mousePos.x, mousePos.y, pos.x, pos.y, el->width, el->height)) {
-                newHovered = id;
-                break;  // Topmost wins
-            }
-        }
+        // Topmost wins: the grid lists higher layers first, then smaller areas, so children
+        // (usually smaller) are checked before parents at the same layer
+        UI_RefreshLayout();
+        newHovered = UI_HitTest(mousePos.x, mousePos.y);
 
         // Update hover state
         if (newHovered != g_uiHoveredId) {
@@ -7556,6 +10189,7 @@ extern "C" {
                 auto it = g_uiElements.find(g_uiHoveredId);
                 if (it != g_uiElements.end() && it->second.state == UI_STATE_HOVERED) {
                     it->second.state = UI_STATE_NORMAL;
+                    UI_MarkDirty(it->second);
                 }
             }
             g_uiHoveredId = newHovered;
@@ -7563,6 +10197,7 @@ extern "C" {
                 auto it = g_uiElements.find(newHovered);
                 if (it != g_uiElements.end()) {
                     it->second.state = UI_STATE_HOVERED;
+                    UI_MarkDirty(it->second);
                     if (it->second.onHover) it->second.onHover(newHovered);
                 }
             }
@@ -7573,6 +10208,7 @@ extern "C" {
             auto it = g_uiElements.find(newHovered);
             if (it != g_uiElements.end()) {
                 it->second.state = UI_STATE_PRESSED;
+                UI_MarkDirty(it->second);
 
                 // Set focus for text inputs
                 if (it->second.type == UI_TEXTINPUT) {
@@ -7592,6 +10228,7 @@ extern "C" {
             auto it = g_uiElements.find(newHovered);
             if (it != g_uiElements.end() && it->second.state == UI_STATE_PRESSED) {
                 it->second.state = UI_STATE_HOVERED;
+                UI_MarkDirty(it->second);
 
                 // Handle click by type
                 switch (it->second.type) {
@@ -7610,12 +10247,12 @@ extern "C" {
         // Slider dragging
         for (auto& kv : g_uiElements) {
             if (kv.second.type == UI_SLIDER && kv.second.state == UI_STATE_PRESSED && mouseDown) {
-                Vector2 pos = UI_GetAnchoredPosition(kv.second);
-                float relX = mousePos.x - pos.x;
+                float relX = mousePos.x - kv.second.screenX;
                 float ratio = fmaxf(0, fminf(1, relX / kv.second.width));
                 float newValue = kv.second.minValue + ratio * (kv.second.maxValue - kv.second.minValue);
                 if (newValue != kv.second.value) {
                     kv.second.value = newValue;
+                    UI_MarkDirty(kv.second);
                     if (kv.second.onValueChanged) kv.second.onValueChanged(kv.first, newValue);
                 }
             }
@@ -7626,7 +10263,10 @@ extern "C" {
             auto it = g_uiElements.find(g_uiFocusedId);
             if (it != g_uiElements.end() && it->second.type == UI_TEXTINPUT) {
                 UIElement& el = it->second;
-                el.cursorBlinkTimer += GetFrameTime();
+                bool cursorShown = fmod(el.cursorBlinkTimer, 1.0f) < 0.5f;
+                int cursorBefore = el.cursorPos;
+                size_t lengthBefore = el.text.length();
+                el.cursorBlinkTimer += Framework_GetFrameTime();
 
                 // Handle character input
                 int key = GetCharPressed();
@@ -7653,150 +10293,225 @@ extern "C" {
                 if (IsKeyPressed(KEY_RIGHT) && el.cursorPos < (int)el.text.length()) el.cursorPos++;
                 if (IsKeyPressed(KEY_HOME)) el.cursorPos = 0;
                 if (IsKeyPressed(KEY_END)) el.cursorPos = (int)el.text.length();
+
+                // Typing always changes length or caret, the blink only every half second
+                if (cursorShown != (fmod(el.cursorBlinkTimer, 1.0f) < 0.5f) ||
+                    cursorBefore != el.cursorPos || lengthBefore != el.text.length()) {
+                    UI_MarkDirty(el);
+                }
             }
         }
     }
 
-    // Helper: Check if element and all ancestors are visible
-    static bool UI_IsEffectivelyVisible(const UIElement& el) {
-        if (!el.visible) return false;
-        if (el.parent >= 0) {
-            auto pit = g_uiElements.find(el.parent);
-            if (pit != g_uiElements.end()) {
-                return UI_IsEffectivelyVisible(pit->second);
+    // Append one element's quads to its root cache (was the immediate-mode body of UI_Draw)
+    static void UI_BuildElement(UIRootCache& c, const UIElement* el, Vector2 pos) {
+        float x = pos.x, y = pos.y, w = el->width, h = el->height;
+
+        Color bgColor = el->bgColor;
+        if (!el->enabled) bgColor = el->disabledColor;
+        else if (el->state == UI_STATE_PRESSED) bgColor = el->pressedColor;
+        else if (el->state == UI_STATE_HOVERED) bgColor = el->hoverColor;
+        else if (el->state == UI_STATE_FOCUSED) bgColor = el->bgColor;
+
+        switch (el->type) {
+            case UI_LABEL: {
+                if (bgColor.a > 0) UI_PushRoundedRect(c, x, y, w, h, el->cornerRadius, bgColor);
+                UI_PushAlignedText(c, el->text.c_str(), x + el->padding[0], y + el->padding[1],
+                    w - el->padding[0] - el->padding[2], h - el->padding[1] - el->padding[3],
+                    el->fontHandle, el->fontSize, el->textAlign, el->textColor);
+                break;
             }
-        }
-        return true;
-    }
 
-    // UI Draw
-    void Framework_UI_Draw() {
-        // Collect and sort elements by layer
-        std::vector<std::pair<int, UIElement*>> sortedElements;
-        for (auto& kv : g_uiElements) {
-            if (kv.second.valid && UI_IsEffectivelyVisible(kv.second)) {
-                sortedElements.push_back({kv.first, &kv.second});
+            case UI_BUTTON: {
+                UI_PushRoundedRect(c, x, y, w, h, el->cornerRadius, bgColor);
+                if (el->borderWidth > 0) UI_PushRectLines(c, x, y, w, h, el->borderWidth, el->borderColor);
+                UI_PushAlignedText(c, el->text.c_str(), x, y, w, h, el->fontHandle, el->fontSize, el->textAlign, el->textColor);
+                break;
             }
-        }
-        std::sort(sortedElements.begin(), sortedElements.end(),
-            [](const auto& a, const auto& b) { return a.second->layer < b.second->layer; });
 
-        for (auto& [id, el] : sortedElements) {
-            Vector2 pos = UI_GetAnchoredPosition(*el);
-            float x = pos.x, y = pos.y, w = el->width, h = el->height;
+            case UI_PANEL: {
+                UI_PushRoundedRect(c, x, y, w, h, el->cornerRadius, bgColor);
+                if (el->borderWidth > 0) UI_PushRectLines(c, x, y, w, h, el->borderWidth, el->borderColor);
+                break;
+            }
 
-            Color bgColor = el->bgColor;
-            if (!el->enabled) bgColor = el->disabledColor;
-            else if (el->state == UI_STATE_PRESSED) bgColor = el->pressedColor;
-            else if (el->state == UI_STATE_HOVERED) bgColor = el->hoverColor;
-            else if (el->state == UI_STATE_FOCUSED) bgColor = el->bgColor;
+            case UI_SLIDER: {
+                // Track background
+                UI_PushRoundedRect(c, x, y + h/2 - 4, w, 8, 4, el->bgColor);
+                // Filled portion
+                float ratio = (el->value - el->minValue) / (el->maxValue - el->minValue);
+                UI_PushRoundedRect(c, x, y + h/2 - 4, w * ratio, 8, 4, el->hoverColor);
+                // Handle
+                float handleX = x + w * ratio - 8;
+                UI_PushCircle(c, (float)(int)(handleX + 8), (float)(int)(y + h/2), 10, el->pressedColor);
+                break;
+            }
 
-            switch (el->type) {
-                case UI_LABEL: {
-                    if (bgColor.a > 0) UI_DrawRoundedRect(x, y, w, h, el->cornerRadius, bgColor);
-                    UI_DrawAlignedText(el->text.c_str(), x + el->padding[0], y + el->padding[1],
-                        w - el->padding[0] - el->padding[2], h - el->padding[1] - el->padding[3],
-                        el->fontHandle, el->fontSize, el->textAlign, el->textColor);
-                    break;
+            case UI_CHECKBOX: {
+                // Box
+                UI_PushRoundedRect(c, x, y, 24, 24, el->cornerRadius, bgColor);
+                UI_PushRectLines(c, x, y, 24, 24, el->borderWidth, el->borderColor);
+                // Checkmark
+                if (el->checked) {
+                    UI_PushLine(c, (float)(int)(x + 5), (float)(int)(y + 12), (float)(int)(x + 10), (float)(int)(y + 18), el->pressedColor);
+                    UI_PushLine(c, (float)(int)(x + 10), (float)(int)(y + 18), (float)(int)(x + 19), (float)(int)(y + 6), el->pressedColor);
                 }
-
-                case UI_BUTTON: {
-                    UI_DrawRoundedRect(x, y, w, h, el->cornerRadius, bgColor);
-                    if (el->borderWidth > 0) {
-                        DrawRectangleLinesEx({x, y, w, h}, el->borderWidth, el->borderColor);
-                    }
-                    UI_DrawAlignedText(el->text.c_str(), x, y, w, h, el->fontHandle, el->fontSize, el->textAlign, el->textColor);
-                    break;
+                // Label
+                if (!el->text.empty()) {
+                    UI_PushAlignedText(c, el->text.c_str(), x + 30, y, w, 24, el->fontHandle, el->fontSize, UI_ANCHOR_CENTER_LEFT, el->textColor);
                 }
+                break;
+            }
 
-                case UI_PANEL: {
-                    UI_DrawRoundedRect(x, y, w, h, el->cornerRadius, bgColor);
-                    if (el->borderWidth > 0) {
-                        DrawRectangleLinesEx({x, y, w, h}, el->borderWidth, el->borderColor);
-                    }
-                    break;
-                }
+            case UI_TEXTINPUT: {
+                Color borderCol = (el->state == UI_STATE_FOCUSED) ? el->hoverColor : el->borderColor;
+                UI_PushRoundedRect(c, x, y, w, h, el->cornerRadius, el->bgColor);
+                UI_PushRectLines(c, x, y, w, h, el->borderWidth, borderCol);
 
-                case UI_SLIDER: {
-                    // Track background
-                    UI_DrawRoundedRect(x, y + h/2 - 4, w, 8, 4, el->bgColor);
-                    // Filled portion
-                    float ratio = (el->value - el->minValue) / (el->maxValue - el->minValue);
-                    UI_DrawRoundedRect(x, y + h/2 - 4, w * ratio, 8, 4, el->hoverColor);
-                    // Handle
-                    float handleX = x + w * ratio - 8;
-                    DrawCircle((int)(handleX + 8), (int)(y + h/2), 10, el->pressedColor);
-                    break;
-                }
+                // Text or placeholder
+                const char* displayText = el->text.empty() ? el->placeholder.c_str() : el->text.c_str();
+                Color textCol = el->text.empty() ? Color{150, 150, 150, 255} : el->textColor;
 
-                case UI_CHECKBOX: {
-                    // Box
-                    UI_DrawRoundedRect(x, y, 24, 24, el->cornerRadius, bgColor);
-                    DrawRectangleLinesEx({x, y, 24, 24}, el->borderWidth, el->borderColor);
-                    // Checkmark
-                    if (el->checked) {
-                        DrawLine((int)(x + 5), (int)(y + 12), (int)(x + 10), (int)(y + 18), el->pressedColor);
-                        DrawLine((int)(x + 10), (int)(y + 18), (int)(x + 19), (int)(y + 6), el->pressedColor);
-                    }
-                    // Label
-                    if (!el->text.empty()) {
-                        UI_DrawAlignedText(el->text.c_str(), x + 30, y, w, 24, el->fontHandle, el->fontSize, UI_ANCHOR_CENTER_LEFT, el->textColor);
-                    }
-                    break;
+                std::string masked;
+                if (el->passwordMode && !el->text.empty()) {
+                    masked = std::string(el->text.length(), '*');
+                    displayText = masked.c_str();
                 }
 
-                case UI_TEXTINPUT: {
-                    Color borderCol = (el->state == UI_STATE_FOCUSED) ? el->hoverColor : el->borderColor;
-                    UI_DrawRoundedRect(x, y, w, h, el->cornerRadius, el->bgColor);
-                    DrawRectangleLinesEx({x, y, w, h}, el->borderWidth, borderCol);
+                UI_PushAlignedText(c, displayText, x + el->padding[0], y, w - el->padding[0] - el->padding[2], h, el->fontHandle, el->fontSize, el->textAlign, textCol);
 
-                    // Text or placeholder
-                    const char* displayText = el->text.empty() ? el->placeholder.c_str() : el->text.c_str();
-                    Color textCol = el->text.empty() ? Color{150, 150, 150, 255} : el->textColor;
-
-                    std::string masked = el->text;
-                    if (el->passwordMode && !el->text.empty()) {
-                        masked = std::string(el->text.length(), '*');
-                        displayText = masked.c_str();
-                    }
-
-                    UI_DrawAlignedText(displayText, x + el->padding[0], y, w - el->padding[0] - el->padding[2], h, el->fontHandle, el->fontSize, el->textAlign, textCol);
+                // Cursor (UI_Update marks the root dirty whenever the blink phase flips)
+                if (el->state == UI_STATE_FOCUSED && fmod(el->cursorBlinkTimer, 1.0f) < 0.5f) {
+                    Font font = UI_GetFontByHandle(el->fontHandle);
+                    std::string beforeCursor = el->passwordMode ? std::string(el->cursorPos, '*') : el->text.substr(0, el->cursorPos);
+                    Vector2 textSize = MeasureTextEx_Internal(font, beforeCursor.c_str(), el->fontSize, 1);
+                    float cursorX = (float)(int)(x + el->padding[0] + textSize.x);
+                    UI_PushLine(c, cursorX, (float)(int)(y + 4), cursorX, (float)(int)(y + h - 4), el->textColor);
+                }
+                break;
+            }
 
-                    // Cursor
-                    if (el->state == UI_STATE_FOCUSED && fmod(el->cursorBlinkTimer, 1.0f) < 0.5f) {
-                        Font font = UI_GetFontByHandle(el->fontHandle);
-                        std::string beforeCursor = el->passwordMode ? std::string(el->cursorPos, '*') : el->text.substr(0, el->cursorPos);
-                        Vector2 textSize = MeasureTextEx(font, beforeCursor.c_str(), el->fontSize, 1);
-                        float cursorX = x + el->padding[0] + textSize.x;
-                        DrawLine((int)cursorX, (int)(y + 4), (int)cursorX, (int)(y + h - 4), el->textColor);
-                    }
-                    break;
+            case UI_PROGRESSBAR: {
+                UI_PushRoundedRect(c, x, y, w, h, el->cornerRadius, el->bgColor);
+                float ratio = (el->value - el->minValue) / (el->maxValue - el->minValue);
+                if (ratio > 0) {
+                    UI_PushRoundedRect(c, x, y, w * ratio, h, el->cornerRadius, el->hoverColor);
                 }
+                if (el->borderWidth > 0) UI_PushRectLines(c, x, y, w, h, el->borderWidth, el->borderColor);
+                break;
+            }
 
-                case UI_PROGRESSBAR: {
-                    UI_DrawRoundedRect(x, y, w, h, el->cornerRadius, el->bgColor);
-                    float ratio = (el->value - el->minValue) / (el->maxValue - el->minValue);
-                    if (ratio > 0) {
-                        UI_DrawRoundedRect(x, y, w * ratio, h, el->cornerRadius, el->hoverColor);
-                    }
-                    if (el->borderWidth > 0) {
-                        DrawRectangleLinesEx({x, y, w, h}, el->borderWidth, el->borderColor);
-                    }
-                    break;
+            case UI_IMAGE: {
+                auto texIt = g_texByHandle.find(el->textureHandle);
+                if (texIt != g_texByHandle.end() && texIt->second.valid) {
+                    const Texture2D& tex = texIt->second.tex;
+                    Rectangle src = el->sourceRect;
+                    if (src.width <= 0) src = {0, 0, (float)tex.width, (float)tex.height};
+                    UI_AddDependency(c.textures, el->textureHandle, tex.id);
+                    UI_PushTexture(c, tex, src, {x, y, w, h}, el->tint);
+                } else {
+                    UI_AddDependency(c.textures, el->textureHandle, 0);
                 }
+                break;
+            }
+        }
+    }
 
-                case UI_IMAGE: {
-                    auto texIt = g_texByHandle.find(el->textureHandle);
-                    if (texIt != g_texByHandle.end() && texIt->second.valid) {
-                        Rectangle src = el->sourceRect;
-                        if (src.width <= 0) src = {0, 0, (float)texIt->second.tex.width, (float)texIt->second.tex.height};
-                        Rectangle dest = {x, y, w, h};
-                        DrawTexturePro(texIt->second.tex, src, dest, {0, 0}, 0, el->tint);
-                    }
-                    break;
+    struct UIBuildScratch {
+        std::vector<const UIElement*> elements;
+        std::vector<char> shown;
+    };
+    static UIBuildScratch g_uiBuildScratch;
+
+    static void UI_BuildRootCache(UIRootCache& c) {
+        c.verts.clear();
+        c.runs.clear();
+        c.segments.clear();
+        c.textures.clear();
+        c.fonts.clear();
+
+        Texture2D shapes = GetShapesTexture();
+        Rectangle shapesRec = GetShapesTextureRectangle();
+        g_uiShapesTex = shapes.id;
+        g_uiShapesU = shapes.width > 0 ? (shapesRec.x + shapesRec.width * 0.5f) / shapes.width : 0.0f;
+        g_uiShapesV = shapes.height > 0 ? (shapesRec.y + shapesRec.height * 0.5f) / shapes.height : 0.0f;
+        c.shapesTex = shapes.id;
+
+        // Resolve effective visibility top-down; members are in pre-order and screen
+        // positions were cached by UI_RefreshLayout
+        UIBuildScratch& sc = g_uiBuildScratch;
+        size_t n = c.members.size();
+        sc.elements.assign(n, nullptr);
+        sc.shown.assign(n, 0);
+        for (size_t i = 0; i < n; i++) {
+            auto it = g_uiElements.find(c.members[i].id);
+            if (it == g_uiElements.end()) continue;
+            const UIElement& el = it->second;
+            int pi = c.members[i].parentIndex;
+            sc.elements[i] = &el;
+            sc.shown[i] = el.valid && el.visible && (pi < 0 || sc.shown[pi]);
+        }
+
+        for (int layer : c.layers) {
+            c.segments.push_back({ (int)c.runs.size(), 0 });
+            for (size_t i = 0; i < n; i++) {
+                if (sc.shown[i] && sc.elements[i]->layer == layer) {
+                    UI_BuildElement(c, sc.elements[i], { sc.elements[i]->screenX, sc.elements[i]->screenY });
                 }
             }
         }
+
+        c.dirty = false;
+        g_uiCacheRebuilds++;
+    }
+
+    // Textures or fonts baked into the cache may have been unloaded or replaced since the build
+    static bool UI_CacheResourcesValid(const UIRootCache& c) {
+        if (c.shapesTex != GetShapesTexture().id) return false;
+        for (const auto& [handle, glId] : c.textures) {
+            auto it = g_texByHandle.find(handle);
+            unsigned int current = (it != g_texByHandle.end() && it->second.valid) ? it->second.tex.id : 0;
+            if (current != glId) return false;
+        }
+        for (const auto& [handle, glId] : c.fonts) {
+            if (UI_GetFontByHandle(handle).texture.id != glId) return false;
+        }
+        return true;
+    }
+
+    static void UI_DrawSegment(const UIRootCache& c, const UISegment& seg) {
+        for (int r = seg.firstRun; r < seg.firstRun + seg.runCount; r++) {
+            const UIRun& run = c.runs[r];
+            QuadStream qs(run.texId, run.quads);
+            const UIVertex* v = &c.verts[run.firstVertex];
+            for (int i = 0; i < 4 * run.quads; i++) qs.Vertex(v[i].x, v[i].y, v[i].u, v[i].v, v[i].color);
+        }
+    }
+
+    // UI Draw - replays each root's cached quads, rebuilding only dirty roots
+    void Framework_UI_Draw() {
+        if (g_headless) return;
+        UI_RefreshLayout();
+
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_UI);
+        RenderListOrderedScope orderedScope;
+        for (const UIDrawEntry& entry : g_uiDrawOrder) {
+            auto cit = g_uiRootCaches.find(entry.root);
+            if (cit == g_uiRootCaches.end()) continue;
+            UIRootCache& c = cit->second;
+            if (c.dirty || !UI_CacheResourcesValid(c)) UI_BuildRootCache(c);
+            RenderStats_SetLayer(entry.layer);
+            UI_DrawSegment(c, c.segments[entry.segment]);
+        }
+        rlSetTexture(0);
+    }
+
+    void Framework_UI_InvalidateCache() { UI_InvalidateAll(); }
+    int Framework_UI_GetCacheRebuilds() { return g_uiCacheRebuilds; }
+
+    int Framework_UI_GetElementAt(float x, float y) {
+        UI_RefreshLayout();
+        return UI_HitTest(x, y);
     }
 
     int Framework_UI_GetHovered() { return g_uiHoveredId; }
@@ -7805,12 +10520,12 @@ extern "C" {
     void Framework_UI_SetFocus(int elementId) {
         if (g_uiFocusedId >= 0) {
             auto it = g_uiElements.find(g_uiFocusedId);
-            if (it != g_uiElements.end()) it->second.state = UI_STATE_NORMAL;
+            if (it != g_uiElements.end()) { it->second.state = UI_STATE_NORMAL; UI_MarkDirty(it->second); }
         }
         g_uiFocusedId = elementId;
         if (elementId >= 0) {
             auto it = g_uiElements.find(elementId);
-            if (it != g_uiElements.end()) it->second.state = UI_STATE_FOCUSED;
+            if (it != g_uiElements.end()) { it->second.state = UI_STATE_FOCUSED; UI_MarkDirty(it->second); }
         }
     }
 
@@ -7830,6 +10545,7 @@ extern "C" {
             child->x = paddingX;
             child->y = currentY;
             currentY += child->height + spacing;
+            UI_MarkLayoutDirty(*child);
         }
     }
 
@@ -7846,38 +10562,123 @@ extern "C" {
             child->x = currentX;
             child->y = paddingY;
             currentX += child->width + spacing;
+            UI_MarkLayoutDirty(*child);
+        }
+    }
+
+    // Container layout
+    void Framework_UI_SetLayout(int elementId, int mode, float spacing) {
+        auto it = g_uiElements.find(elementId);
+        if (it == g_uiElements.end()) return;
+        UIElement& el = it->second;
+        bool wasContainer = el.layoutMode != UI_LAYOUT_NONE;
+        el.layoutMode = (mode >= UI_LAYOUT_HORIZONTAL && mode <= UI_LAYOUT_WRAP) ? mode : UI_LAYOUT_NONE;
+        el.layoutSpacing = spacing;
+        if (el.layoutMode != UI_LAYOUT_NONE) {
+            UI_QueueLayout(el);
+        } else if (wasContainer) {
+            el.contentW = el.contentH = 0;
+            UI_MarkLayoutDirty(el);  // Children go back to their own x/y/anchor
+        }
+    }
+
+    void Framework_UI_SetLayoutAlign(int elementId, int align) {
+        auto it = g_uiElements.find(elementId);
+        if (it != g_uiElements.end()) { it->second.layoutAlign = align; UI_QueueLayout(it->second); }
+    }
+
+    void Framework_UI_SetLayoutColumns(int elementId, int columns) {
+        auto it = g_uiElements.find(elementId);
+        if (it != g_uiElements.end()) { it->second.layoutColumns = std::max(0, columns); UI_QueueLayout(it->second); }
+    }
+
+    void Framework_UI_SetLayoutCellSize(int elementId, float width, float height) {
+        auto it = g_uiElements.find(elementId);
+        if (it != g_uiElements.end()) {
+            it->second.layoutCellW = width;
+            it->second.layoutCellH = height;
+            UI_QueueLayout(it->second);
         }
     }
 
+    void Framework_UI_SetLayoutFit(int elementId, bool fit) {
+        auto it = g_uiElements.find(elementId);
+        if (it != g_uiElements.end()) { it->second.layoutFit = fit; UI_QueueLayout(it->second); }
+    }
+
+    int Framework_UI_GetLayoutMode(int elementId) {
+        auto it = g_uiElements.find(elementId);
+        return (it != g_uiElements.end()) ? it->second.layoutMode : UI_LAYOUT_NONE;
+    }
+
+    float Framework_UI_GetContentWidth(int elementId) {
+        UI_RefreshLayout();
+        auto it = g_uiElements.find(elementId);
+        return (it != g_uiElements.end()) ? it->second.contentW : 0;
+    }
+
+    float Framework_UI_GetContentHeight(int elementId) {
+        UI_RefreshLayout();
+        auto it = g_uiElements.find(elementId);
+        return (it != g_uiElements.end()) ? it->second.contentH : 0;
+    }
+
+    int Framework_UI_GetLayoutPasses() { return g_uiLayoutPasses; }
+
     // ========================================================================
     // PHYSICS SYSTEM - 2D Rigid Body Physics Implementation
     // ========================================================================
+    // Strict IEEE evaluation for the whole simulation: no contraction into FMA and no
+    // reassociation, so the same inputs give bit-identical steps on every x64 build
+#if defined(_MSC_VER)
+#pragma float_control(precise, on, push)
+#pragma fp_contract(off)
+#endif
+
+    constexpr int PHYSICS_MAX_POLYGON_VERTS = 64;
+    constexpr int PHYSICS_SAT_MAX_VERTS = 8;  // Larger hulls use GJK/EPA in the narrowphase
+
+    // Linear state of every body, one slot per body in parallel arrays (see PHYSICS BODY STORE).
+    // Slot 0 is scratch for bodies outside the world, such as query probes; the world's bodies
+    // fill the slots after it with no gaps. Each array starts with the scratch slot's defaults.
+    struct PhysicsBody;
+    struct PhysicsBodyStore {
+        std::vector<float> x{ 0.0f }, y{ 0.0f };
+        std::vector<float> sweepX{ 0.0f }, sweepY{ 0.0f };  // Position before this step's update
+        std::vector<float> vx{ 0.0f }, vy{ 0.0f };
+        std::vector<float> forceX{ 0.0f }, forceY{ 0.0f };
+        std::vector<float> invMass{ 1.0f };                 // 1/mass, 0 for static
+        std::vector<float> gravityScale{ 1.0f };
+        std::vector<float> linearDamping{ 0.0f };
+        std::vector<PhysicsBody*> owner{ nullptr };
+
+        // Awake dynamic bodies hold slots [1, dynamicEnd), awake kinematic ones [dynamicEnd, moverEnd)
+        int dynamicEnd = 1, moverEnd = 1;
+        std::vector<PhysicsBody*> bound;  // Movers with an entity, checked for SyncToEntities
+    };
+    static PhysicsBodyStore g_physicsStore;
 
     // Physics body structure
     struct PhysicsBody {
         int handle = -1;
         int type = BODY_DYNAMIC;
         bool valid = true;
+        int slot = 0;  // Entry in g_physicsStore; 0 until the body joins the world
 
         // Transform
-        float x = 0, y = 0;
         float rotation = 0;  // radians
+        float sweepRotation = 0;  // Rotation before this step's position update
 
         // Dynamics
-        float vx = 0, vy = 0;
         float angularVelocity = 0;
-        float forceX = 0, forceY = 0;
         float torque = 0;
 
         // Properties
         float mass = 1.0f;
-        float invMass = 1.0f;  // 1/mass, 0 for static
         float inertia = 1.0f;
         float invInertia = 1.0f;
         float restitution = 0.2f;  // Bounciness
         float friction = 0.3f;
-        float gravityScale = 1.0f;
-        float linearDamping = 0.0f;
         float angularDamping = 0.0f;
         bool fixedRotation = false;
         bool sleepingAllowed = true;
@@ -7899,6 +10700,32 @@ extern "C" {
         // Entity binding
         int boundEntity = -1;
         int userData = 0;
+        bool syncQueued = false;  // Waiting in g_physicsSyncQueue
+
+        // Broadphase membership
+        int proxyId = -1;     // Leaf in the AABB tree
+        bool inSap = false;   // Entry in the sweep-and-prune list
+
+        // Sleeping
+        float sleepTime = 0;  // Seconds spent below the sleep velocity thresholds
+        int sleepIsland = -1; // Island this body went to sleep with
+        int islandIndex = -1; // Scratch index while islands are built
+
+        // Continuous collision
+        int ccdMode = PHYSICS_CCD_NONE;
+
+        // Position, velocity, force, inverse mass and the integration coefficients live in the store
+        float& X() const { return g_physicsStore.x[slot]; }
+        float& Y() const { return g_physicsStore.y[slot]; }
+        float& SweepX() const { return g_physicsStore.sweepX[slot]; }
+        float& SweepY() const { return g_physicsStore.sweepY[slot]; }
+        float& VX() const { return g_physicsStore.vx[slot]; }
+        float& VY() const { return g_physicsStore.vy[slot]; }
+        float& ForceX() const { return g_physicsStore.forceX[slot]; }
+        float& ForceY() const { return g_physicsStore.forceY[slot]; }
+        float& InvMass() const { return g_physicsStore.invMass[slot]; }
+        float& GravityScale() const { return g_physicsStore.gravityScale[slot]; }
+        float& LinearDamping() const { return g_physicsStore.linearDamping[slot]; }
     };
 
     // Physics world state
@@ -7906,6 +10733,7 @@ extern "C" {
 
     // Forward declaration for joint constraints (defined in Physics Joints section)
     static void ApplyJointConstraints(float dt);
+    static void Physics_UpdateSleep(float h);  // Physics Islands section
     static int g_physicsNextHandle = 1;
     static float g_gravityX = 0.0f;
     static float g_gravityY = 980.0f;  // Default gravity (pixels/s^2)
@@ -7914,6 +10742,27 @@ extern "C" {
     static bool g_physicsEnabled = true;
     static bool g_physicsDebugDraw = false;
 
+    // Deterministic mode: candidate pairs, solver contacts, joints and CCD sweeps run in
+    // handle order instead of tree/hash order, so the step depends only on world state
+    static bool g_physicsDeterministic = false;
+    static long long g_physicsStepCount = 0;
+
+    // Awake movers keep their place at the front of the store between steps (see PHYSICS BODY
+    // STORE); anything that creates, destroys, retypes, wakes, sleeps or binds a body raises the flag. Bound bodies that moved wait
+    // in the queue until SyncToEntities copies them to their transforms.
+    static bool g_physicsMoversDirty = true;
+    static std::vector<int> g_physicsSyncQueue;
+
+    // Sleeping: bodies that stay below both thresholds for g_timeToSleep seconds sleep
+    // together with everything they touch or are jointed to
+    static bool g_physicsSleepEnabled = true;
+    static float g_sleepLinearTolerance = 2.0f;             // Pixels per second
+    static float g_sleepAngularTolerance = 2.0f * DEG2RAD;  // Radians per second
+    static float g_timeToSleep = 0.5f;
+    static std::unordered_map<int, std::vector<int>> g_sleepingIslands;  // Island id -> body handles
+    static int g_nextSleepIslandId = 1;
+    static std::vector<std::pair<int, int>> g_physicsContactEdges;     // Touching non-trigger pairs this step
+
     // Collision callbacks
     static PhysicsCollisionCallback g_onCollisionEnter = nullptr;
     static PhysicsCollisionCallback g_onCollisionStay = nullptr;
@@ -7939,6 +10788,74 @@ extern "C" {
     // Entity-to-body mapping
     static std::unordered_map<int, int> g_entityToBody;
 
+    // Non-static and awake: the bodies that integrate, query the broadphase and keep islands awake
+    static bool Physics_IsAwakeMover(const PhysicsBody& body) {
+        return body.valid && body.type != BODY_STATIC && body.awake;
+    }
+
+    // Wakes the body and, if it fell asleep as part of an island, the rest of that island
+    static void Physics_WakeBody(PhysicsBody& body) {
+        body.sleepTime = 0;
+        if (body.awake) return;
+        body.awake = true;
+        g_physicsMoversDirty = true;
+        int island = body.sleepIsland;
+        body.sleepIsland = -1;
+        if (island < 0) return;
+        auto it = g_sleepingIslands.find(island);
+        if (it == g_sleepingIslands.end()) return;
+        for (int h : it->second) {
+            auto bodyIt = g_physicsBodies.find(h);
+            if (bodyIt == g_physicsBodies.end() || bodyIt->second.sleepIsland != island) continue;
+            bodyIt->second.awake = true;
+            bodyIt->second.sleepTime = 0;
+            bodyIt->second.sleepIsland = -1;
+        }
+        g_sleepingIslands.erase(it);
+    }
+
+    static void Physics_QueueSync(PhysicsBody& body) {
+        if (body.boundEntity < 0 || body.syncQueued) return;
+        body.syncQueued = true;
+        g_physicsSyncQueue.push_back(body.handle);
+    }
+
+    // Contact manifolds persist across steps keyed by body pair; points carry their
+    // accumulated impulses forward by feature id so the solver can warm start
+    struct PhysicsContactPoint {
+        float x = 0, y = 0;           // World position when the manifold was built
+        float depth = 0;              // Negative for speculative points not yet touching
+        unsigned int id = 0;          // Feature id, stable while the same edges touch
+        float normalImpulse = 0;      // Accumulated impulses
+        float tangentImpulse = 0;
+        float rAX = 0, rAY = 0, rBX = 0, rBY = 0;  // Offsets from each body's origin
+        float normalMass = 0, tangentMass = 0;
+        float velocityBias = 0;       // Target approach (speculative) or separation (bounce) speed
+    };
+
+    struct PhysicsManifold {
+        int bodyA = -1, bodyB = -1;   // bodyA < bodyB
+        float normalX = 0, normalY = 0;  // From A to B
+        int pointCount = 0;
+        PhysicsContactPoint points[2];
+        float friction = 0, restitution = 0;
+        float startAX = 0, startAY = 0, startBX = 0, startBY = 0;  // Body positions at build time
+        float startRotA = 0, startRotB = 0;
+        unsigned int stamp = 0;       // Step that last built it
+        bool solid = false;           // Neither side is a trigger
+        bool blockSolve = false;      // Two points solved together through K = [k11 k12; k12 k22]
+        float k11 = 0, k12 = 0, k22 = 0;
+        float invK11 = 0, invK12 = 0, invK22 = 0;
+
+        // Deepest point; negative when every point is speculative
+        float MaxDepth() const {
+            if (pointCount == 0) return 0;
+            float d = points[0].depth;
+            for (int i = 1; i < pointCount; i++) d = fmaxf(d, points[i].depth);
+            return d;
+        }
+    };
+
     // Physics helper functions
     namespace {
         float Physics_Dot(float ax, float ay, float bx, float by) {
@@ -7958,211 +10875,1784 @@ extern "C" {
             if (len > 0.0001f) { x /= len; y /= len; }
         }
 
+        // Shape center in world space for the body placed at (x, y, rotation); offsets turn with the body
+        void Physics_ShapeCenterAt(const PhysicsBody& body, float x, float y, float rotation, float& cx, float& cy) {
+            cx = x; cy = y;
+            if (body.shapeOffsetX == 0 && body.shapeOffsetY == 0) return;
+            float c = cosf(rotation), s = sinf(rotation);
+            cx += c * body.shapeOffsetX - s * body.shapeOffsetY;
+            cy += s * body.shapeOffsetX + c * body.shapeOffsetY;
+        }
+
+        void Physics_ShapeCenter(const PhysicsBody& body, float& cx, float& cy) {
+            Physics_ShapeCenterAt(body, body.X(), body.Y(), body.rotation, cx, cy);
+        }
+
+        // World-space outline of a box or polygon body, wound so the signed area is positive,
+        // with outward unit edge normals (edge i runs from vertex i to i + 1)
+        struct PhysicsPolygon {
+            int count = 0;
+            float x[PHYSICS_MAX_POLYGON_VERTS], y[PHYSICS_MAX_POLYGON_VERTS];
+            float nx[PHYSICS_MAX_POLYGON_VERTS], ny[PHYSICS_MAX_POLYGON_VERTS];
+        };
+
+        void Physics_BuildPolygonAt(const PhysicsBody& body, float x, float y, float rotation, PhysicsPolygon& poly) {
+            float c = cosf(rotation), s = sinf(rotation);
+            float ox = body.shapeOffsetX, oy = body.shapeOffsetY;
+            auto put = [&](float lx, float ly) {
+                lx += ox; ly += oy;
+                poly.x[poly.count] = x + c * lx - s * ly;
+                poly.y[poly.count] = y + s * lx + c * ly;
+                poly.count++;
+            };
+            poly.count = 0;
+            if (body.shapeType == SHAPE_POLYGON && body.polygonVerts.size() >= 6) {
+                for (size_t i = 0; i + 1 < body.polygonVerts.size(); i += 2) put(body.polygonVerts[i], body.polygonVerts[i + 1]);
+            } else {
+                float hw = body.shapeWidth / 2, hh = body.shapeHeight / 2;
+                put(-hw, -hh); put(hw, -hh); put(hw, hh); put(-hw, hh);
+            }
+            for (int i = 0; i < poly.count; i++) {
+                int j = (i + 1) % poly.count;
+                float ex = poly.x[j] - poly.x[i], ey = poly.y[j] - poly.y[i];
+                float len = Physics_Length(ex, ey);
+                poly.nx[i] = len > 0.0001f ? ey / len : 0.0f;
+                poly.ny[i] = len > 0.0001f ? -ex / len : 0.0f;
+            }
+        }
+
+        void Physics_BuildPolygon(const PhysicsBody& body, PhysicsPolygon& poly) {
+            Physics_BuildPolygonAt(body, body.X(), body.Y(), body.rotation, poly);
+        }
+
         // Get AABB bounds for a body
         void Physics_GetAABB(const PhysicsBody& body, float& minX, float& minY, float& maxX, float& maxY) {
             if (body.shapeType == SHAPE_CIRCLE) {
-                minX = body.x + body.shapeOffsetX - body.shapeRadius;
-                minY = body.y + body.shapeOffsetY - body.shapeRadius;
-                maxX = body.x + body.shapeOffsetX + body.shapeRadius;
-                maxY = body.y + body.shapeOffsetY + body.shapeRadius;
-            } else {  // BOX or POLYGON (use box bounds)
+                float cx, cy;
+                Physics_ShapeCenter(body, cx, cy);
+                minX = cx - body.shapeRadius;
+                minY = cy - body.shapeRadius;
+                maxX = cx + body.shapeRadius;
+                maxY = cy + body.shapeRadius;
+            } else if (body.shapeType == SHAPE_POLYGON && body.polygonVerts.size() >= 6) {
+                PhysicsPolygon poly;
+                Physics_BuildPolygon(body, poly);
+                minX = maxX = poly.x[0];
+                minY = maxY = poly.y[0];
+                for (int i = 1; i < poly.count; i++) {
+                    minX = fminf(minX, poly.x[i]); maxX = fmaxf(maxX, poly.x[i]);
+                    minY = fminf(minY, poly.y[i]); maxY = fmaxf(maxY, poly.y[i]);
+                }
+            } else {
+                float cx, cy;
+                Physics_ShapeCenter(body, cx, cy);
+                float c = fabsf(cosf(body.rotation)), s = fabsf(sinf(body.rotation));
                 float hw = body.shapeWidth / 2;
                 float hh = body.shapeHeight / 2;
-                minX = body.x + body.shapeOffsetX - hw;
-                minY = body.y + body.shapeOffsetY - hh;
-                maxX = body.x + body.shapeOffsetX + hw;
-                maxY = body.y + body.shapeOffsetY + hh;
+                float ex = c * hw + s * hh, ey = s * hw + c * hh;
+                minX = cx - ex;
+                minY = cy - ey;
+                maxX = cx + ex;
+                maxY = cy + ey;
             }
         }
 
-        // Circle vs Circle collision
-        bool Physics_CircleVsCircle(const PhysicsBody& a, const PhysicsBody& b,
-            float& normalX, float& normalY, float& depth) {
-            float ax = a.x + a.shapeOffsetX;
-            float ay = a.y + a.shapeOffsetY;
-            float bx = b.x + b.shapeOffsetX;
-            float by = b.y + b.shapeOffsetY;
+        // Narrowphase: every routine fills a manifold whose normal points from A to B, and each
+        // contact point carries a feature id so the solver can match it against last step's
+        // point and warm start it. Pairs closer than 'margin' get speculative points with
+        // negative depth.
+        void Physics_AddContact(PhysicsManifold& m, float x, float y, float depth, unsigned int id) {
+            PhysicsContactPoint& cp = m.points[m.pointCount++];
+            cp = PhysicsContactPoint();
+            cp.x = x; cp.y = y;
+            cp.depth = depth;
+            cp.id = id;
+        }
+
+        bool Physics_CollideCircles(const PhysicsBody& a, const PhysicsBody& b, PhysicsManifold& m, float margin) {
+            float ax, ay, bx, by;
+            Physics_ShapeCenter(a, ax, ay);
+            Physics_ShapeCenter(b, bx, by);
 
             float dx = bx - ax;
             float dy = by - ay;
             float dist = Physics_Length(dx, dy);
             float sumRadii = a.shapeRadius + b.shapeRadius;
 
-            if (dist >= sumRadii) return false;
+            if (dist >= sumRadii + margin) return false;
 
             if (dist > 0.0001f) {
-                normalX = dx / dist;
-                normalY = dy / dist;
+                m.normalX = dx / dist;
+                m.normalY = dy / dist;
             } else {
-                normalX = 1; normalY = 0;
+                m.normalX = 1; m.normalY = 0;
             }
-            depth = sumRadii - dist;
+            float depth = sumRadii - dist;
+
+            // Midway between the two surfaces
+            float offset = a.shapeRadius - depth * 0.5f;
+            Physics_AddContact(m, ax + m.normalX * offset, ay + m.normalY * offset, depth, 0);
             return true;
         }
 
-        // Box vs Box collision (AABB)
-        bool Physics_BoxVsBox(const PhysicsBody& a, const PhysicsBody& b,
+        // Circle against a convex outline: the face the center is furthest in front of decides,
+        // unless the center lies past one of that face's ends, where the vertex takes over.
+        // The normal points from the polygon to the circle; ids are face index or 0x80 | vertex.
+        bool Physics_CollideCirclePolygon(float cx, float cy, float radius, const PhysicsPolygon& poly,
+            float margin, PhysicsManifold& m) {
+            int face = 0;
+            float separation = -1e30f;
+            for (int i = 0; i < poly.count; i++) {
+                float s = Physics_Dot(poly.nx[i], poly.ny[i], cx - poly.x[i], cy - poly.y[i]);
+                if (s > radius + margin) return false;
+                if (s > separation) { separation = s; face = i; }
+            }
+
+            int v1 = face, v2 = (face + 1) % poly.count;
+            float x1 = poly.x[v1], y1 = poly.y[v1], x2 = poly.x[v2], y2 = poly.y[v2];
+            if (separation > 0.0001f) {
+                int vertex = -1;
+                if (Physics_Dot(cx - x1, cy - y1, x2 - x1, y2 - y1) <= 0) vertex = v1;
+                else if (Physics_Dot(cx - x2, cy - y2, x1 - x2, y1 - y2) <= 0) vertex = v2;
+                if (vertex >= 0) {
+                    float dx = cx - poly.x[vertex], dy = cy - poly.y[vertex];
+                    float dist = Physics_Length(dx, dy);
+                    if (dist > radius + margin || dist <= 0.0001f) return false;
+                    m.normalX = dx / dist;
+                    m.normalY = dy / dist;
+                    Physics_AddContact(m, poly.x[vertex], poly.y[vertex], radius - dist, 0x80u | (unsigned int)vertex);
+                    return true;
+                }
+            }
+
+            // Face region, or the center is inside: push out through the face
+            m.normalX = poly.nx[face];
+            m.normalY = poly.ny[face];
+            Physics_AddContact(m, cx - m.normalX * separation, cy - m.normalY * separation,
+                radius - separation, (unsigned int)face);
+            return true;
+        }
+
+        // Largest gap between p2 and any face of p1; the face index goes to 'edge'
+        float Physics_MaxSeparation(const PhysicsPolygon& p1, const PhysicsPolygon& p2, int& edge) {
+            float best = -1e30f;
+            edge = 0;
+            for (int i = 0; i < p1.count; i++) {
+                float minDot = 1e30f;
+                for (int j = 0; j < p2.count; j++) {
+                    minDot = fminf(minDot, Physics_Dot(p1.nx[i], p1.ny[i], p2.x[j] - p1.x[i], p2.y[j] - p1.y[i]));
+                }
+                if (minDot > best) { best = minDot; edge = i; }
+            }
+            return best;
+        }
+
+        struct PhysicsClipVertex {
+            float x, y;
+            unsigned int id;
+        };
+
+        // Keeps the part of the segment behind the plane dot(n, p) <= offset
+        int Physics_ClipSegment(PhysicsClipVertex out[2], const PhysicsClipVertex in[2],
+            float nx, float ny, float offset, unsigned int clipId) {
+            int count = 0;
+            float d0 = Physics_Dot(nx, ny, in[0].x, in[0].y) - offset;
+            float d1 = Physics_Dot(nx, ny, in[1].x, in[1].y) - offset;
+            if (d0 <= 0) out[count++] = in[0];
+            if (d1 <= 0) out[count++] = in[1];
+            if (d0 * d1 < 0 && count < 2) {
+                float t = d0 / (d0 - d1);
+                out[count].x = in[0].x + t * (in[1].x - in[0].x);
+                out[count].y = in[0].y + t * (in[1].y - in[0].y);
+                out[count].id = clipId;
+                count++;
+            }
+            return count;
+        }
+
+        // Clip the incident edge of 'inc' (the one facing against the reference face) to the
+        // reference face's side planes and keep the points within 'margin' of the face. 'flip'
+        // means the reference polygon is body B. Ids pack flip, reference face and the
+        // incident vertex (or 0x40 | reference vertex where a side plane cut the edge).
+        bool Physics_ClipPolygons(const PhysicsPolygon& ref, const PhysicsPolygon& inc, int refEdge,
+            bool flip, float margin, PhysicsManifold& m) {
+            int i1 = refEdge, i2 = (refEdge + 1) % ref.count;
+            float nx = ref.nx[i1], ny = ref.ny[i1];
+
+            int incEdge = 0;
+            float minDot = 1e30f;
+            for (int i = 0; i < inc.count; i++) {
+                float d = Physics_Dot(nx, ny, inc.nx[i], inc.ny[i]);
+                if (d < minDot) { minDot = d; incEdge = i; }
+            }
+            int j2 = (incEdge + 1) % inc.count;
+            PhysicsClipVertex incident[2] = {
+                { inc.x[incEdge], inc.y[incEdge], (unsigned int)incEdge },
+                { inc.x[j2], inc.y[j2], (unsigned int)j2 }
+            };
+
+            float tx = ref.x[i2] - ref.x[i1], ty = ref.y[i2] - ref.y[i1];
+            Physics_Normalize(tx, ty);
+            PhysicsClipVertex clip1[2], clip2[2];
+            if (Physics_ClipSegment(clip1, incident, -tx, -ty, -Physics_Dot(tx, ty, ref.x[i1], ref.y[i1]), 0x40u | (unsigned int)i1) < 2) return false;
+            if (Physics_ClipSegment(clip2, clip1, tx, ty, Physics_Dot(tx, ty, ref.x[i2], ref.y[i2]), 0x40u | (unsigned int)i2) < 2) return false;
+
+            m.normalX = flip ? -nx : nx;
+            m.normalY = flip ? -ny : ny;
+            float front = Physics_Dot(nx, ny, ref.x[i1], ref.y[i1]);
+            unsigned int base = (flip ? 0x10000u : 0u) | ((unsigned int)refEdge << 8);
+            for (int i = 0; i < 2; i++) {
+                float separation = Physics_Dot(nx, ny, clip2[i].x, clip2[i].y) - front;
+                if (separation > margin) continue;
+                // Midway between the incident point and the reference face
+                Physics_AddContact(m, clip2[i].x - nx * separation * 0.5f, clip2[i].y - ny * separation * 0.5f,
+                    -separation, base | clip2[i].id);
+            }
+            return m.pointCount > 0;
+        }
+
+        // SAT: the axis of least penetration (or largest gap) among both polygons' face
+        // normals; B's face wins only when clearly better so the choice does not flicker
+        bool Physics_CollidePolygonsSAT(const PhysicsPolygon& a, const PhysicsPolygon& b, float margin, PhysicsManifold& m) {
+            int edgeA, edgeB;
+            float separationA = Physics_MaxSeparation(a, b, edgeA);
+            if (separationA > margin) return false;
+            float separationB = Physics_MaxSeparation(b, a, edgeB);
+            if (separationB > margin) return false;
+
+            if (separationB > separationA + 0.05f) return Physics_ClipPolygons(b, a, edgeB, true, margin, m);
+            return Physics_ClipPolygons(a, b, edgeA, false, margin, m);
+        }
+
+        // Support point of the Minkowski difference (A grown by 'margin') - B in direction d
+        void Physics_MinkowskiSupport(const PhysicsPolygon& a, const PhysicsPolygon& b, float margin,
+            float dx, float dy, float& sx, float& sy) {
+            int ia = 0, ib = 0;
+            float bestA = -1e30f, bestB = -1e30f;
+            for (int i = 0; i < a.count; i++) {
+                float d = Physics_Dot(a.x[i], a.y[i], dx, dy);
+                if (d > bestA) { bestA = d; ia = i; }
+            }
+            for (int i = 0; i < b.count; i++) {
+                float d = -Physics_Dot(b.x[i], b.y[i], dx, dy);
+                if (d > bestB) { bestB = d; ib = i; }
+            }
+            float len = Physics_Length(dx, dy);
+            float grow = len > 0.0001f ? margin / len : 0.0f;
+            sx = a.x[ia] - b.x[ib] + dx * grow;
+            sy = a.y[ia] - b.y[ib] + dy * grow;
+        }
+
+        // GJK: true when the origin lies inside the Minkowski difference, leaving a triangle
+        // around it in 'simplex' (x,y triples) for EPA
+        bool Physics_GJK(const PhysicsPolygon& a, const PhysicsPolygon& b, float margin, float simplex[6]) {
+            float dx = b.x[0] - a.x[0], dy = b.y[0] - a.y[0];
+            if (fabsf(dx) < 0.0001f && fabsf(dy) < 0.0001f) dx = 1.0f;
+            int n = 0;
+            Physics_MinkowskiSupport(a, b, margin, dx, dy, simplex[0], simplex[1]);
+            n = 1;
+            dx = -simplex[0]; dy = -simplex[1];
+            for (int iter = 0; iter < 32; iter++) {
+                if (fabsf(dx) < 1e-6f && fabsf(dy) < 1e-6f) return false;  // Origin on the boundary
+                float px, py;
+                Physics_MinkowskiSupport(a, b, margin, dx, dy, px, py);
+                if (Physics_Dot(px, py, dx, dy) <= 0) return false;  // Can't get past the origin
+                simplex[n * 2] = px; simplex[n * 2 + 1] = py;
+                n++;
+
+                // Newest point is 'a' (last); reduce to the feature closest to the origin
+                float ax = simplex[(n - 1) * 2], ay = simplex[(n - 1) * 2 + 1];
+                if (n == 2) {
+                    float abx = simplex[0] - ax, aby = simplex[1] - ay;
+                    dx = -aby; dy = abx;
+                    if (Physics_Dot(dx, dy, -ax, -ay) < 0) { dx = -dx; dy = -dy; }
+                } else {
+                    float bx = simplex[2], by = simplex[3];
+                    float cx = simplex[0], cy = simplex[1];
+                    float abx = bx - ax, aby = by - ay, acx = cx - ax, acy = cy - ay;
+                    float abPerpX = -aby, abPerpY = abx;
+                    if (Physics_Dot(abPerpX, abPerpY, acx, acy) > 0) { abPerpX = -abPerpX; abPerpY = -abPerpY; }
+                    float acPerpX = -acy, acPerpY = acx;
+                    if (Physics_Dot(acPerpX, acPerpY, abx, aby) > 0) { acPerpX = -acPerpX; acPerpY = -acPerpY; }
+                    if (Physics_Dot(abPerpX, abPerpY, -ax, -ay) > 0) {
+                        // Drop c
+                        simplex[0] = bx; simplex[1] = by; simplex[2] = ax; simplex[3] = ay;
+                        n = 2; dx = abPerpX; dy = abPerpY;
+                    } else if (Physics_Dot(acPerpX, acPerpY, -ax, -ay) > 0) {
+                        // Drop b
+                        simplex[2] = ax; simplex[3] = ay;
+                        n = 2; dx = acPerpX; dy = acPerpY;
+                    } else {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        // EPA: grow the GJK triangle toward the Minkowski boundary until the closest edge stops
+        // moving; its normal is the separating direction (A to B) and its distance the depth
+        bool Physics_EPA(const PhysicsPolygon& a, const PhysicsPolygon& b, float margin, const float simplex[6],
             float& normalX, float& normalY, float& depth) {
-            float aMinX, aMinY, aMaxX, aMaxY;
-            float bMinX, bMinY, bMaxX, bMaxY;
-            Physics_GetAABB(a, aMinX, aMinY, aMaxX, aMaxY);
-            Physics_GetAABB(b, bMinX, bMinY, bMaxX, bMaxY);
+            const int maxVerts = 40;
+            float px[maxVerts], py[maxVerts];
+            int n = 3;
+            for (int i = 0; i < 3; i++) { px[i] = simplex[i * 2]; py[i] = simplex[i * 2 + 1]; }
+            float area = Physics_Cross(px[1] - px[0], py[1] - py[0], px[2] - px[0], py[2] - py[0]);
+            if (fabsf(area) < 1e-6f) return false;
+            if (area < 0) { std::swap(px[1], px[2]); std::swap(py[1], py[2]); }
+
+            for (int iter = 0; iter < 32; iter++) {
+                int edge = -1;
+                float best = 1e30f, bnx = 0, bny = 0;
+                for (int i = 0; i < n; i++) {
+                    int j = (i + 1) % n;
+                    float ex = px[j] - px[i], ey = py[j] - py[i];
+                    float len = Physics_Length(ex, ey);
+                    if (len < 1e-6f) continue;
+                    float enx = ey / len, eny = -ex / len;
+                    float d = Physics_Dot(enx, eny, px[i], py[i]);
+                    if (d < best) { best = d; edge = i; bnx = enx; bny = eny; }
+                }
+                if (edge < 0) return false;
 
-            float overlapX = fminf(aMaxX, bMaxX) - fmaxf(aMinX, bMinX);
-            float overlapY = fminf(aMaxY, bMaxY) - fmaxf(aMinY, bMinY);
+                float sx, sy;
+                Physics_MinkowskiSupport(a, b, margin, bnx, bny, sx, sy);
+                if (Physics_Dot(sx, sy, bnx, bny) - best < 0.01f || n == maxVerts) {
+                    normalX = bnx; normalY = bny;
+                    depth = best;
+                    return true;
+                }
+                for (int k = n; k > edge + 1; k--) { px[k] = px[k - 1]; py[k] = py[k - 1]; }
+                px[edge + 1] = sx; py[edge + 1] = sy;
+                n++;
+            }
+            return false;
+        }
 
-            if (overlapX <= 0 || overlapY <= 0) return false;
+        // GJK/EPA finds the axis for large hulls in about (n + m) work per iteration instead of
+        // SAT's n * m; the faces most aligned with it are then clipped exactly as SAT would
+        bool Physics_CollidePolygonsGJK(const PhysicsPolygon& a, const PhysicsPolygon& b, float margin, PhysicsManifold& m) {
+            float simplex[6];
+            if (!Physics_GJK(a, b, margin, simplex)) return false;
+            float nx, ny, depth;
+            if (!Physics_EPA(a, b, margin, simplex, nx, ny, depth)) return Physics_CollidePolygonsSAT(a, b, margin, m);
+
+            int refA = 0, refB = 0;
+            float alignA = -1e30f, alignB = -1e30f;
+            for (int i = 0; i < a.count; i++) {
+                float d = Physics_Dot(a.nx[i], a.ny[i], nx, ny);
+                if (d > alignA) { alignA = d; refA = i; }
+            }
+            for (int i = 0; i < b.count; i++) {
+                float d = -Physics_Dot(b.nx[i], b.ny[i], nx, ny);
+                if (d > alignB) { alignB = d; refB = i; }
+            }
+            if (alignB > alignA + 0.001f) return Physics_ClipPolygons(b, a, refB, true, margin, m);
+            return Physics_ClipPolygons(a, b, refA, false, margin, m);
+        }
+
+        // Build the manifold for a pair; false when they do not touch (Physics_Collide also
+        // drops pairs whose layers exclude each other)
+        bool Physics_CollideShapes(const PhysicsBody& a, const PhysicsBody& b, PhysicsManifold& m, float margin) {
+            m.pointCount = 0;
+            bool circleA = a.shapeType == SHAPE_CIRCLE;
+            bool circleB = b.shapeType == SHAPE_CIRCLE;
+            if (circleA && circleB) return Physics_CollideCircles(a, b, m, margin);
+
+            PhysicsPolygon polyA, polyB;
+            if (circleA || circleB) {
+                const PhysicsBody& circle = circleA ? a : b;
+                Physics_BuildPolygon(circleA ? b : a, polyA);
+                float cx, cy;
+                Physics_ShapeCenter(circle, cx, cy);
+                if (!Physics_CollideCirclePolygon(cx, cy, circle.shapeRadius, polyA, margin, m)) return false;
+                if (circleA) { m.normalX = -m.normalX; m.normalY = -m.normalY; }
+                return true;
+            }
 
-            if (overlapX < overlapY) {
-                normalX = (a.x < b.x) ? -1.0f : 1.0f;
-                normalY = 0;
-                depth = overlapX;
-            } else {
-                normalX = 0;
-                normalY = (a.y < b.y) ? -1.0f : 1.0f;
-                depth = overlapY;
+            Physics_BuildPolygon(a, polyA);
+            Physics_BuildPolygon(b, polyB);
+            if (polyA.count > PHYSICS_SAT_MAX_VERTS || polyB.count > PHYSICS_SAT_MAX_VERTS) {
+                return Physics_CollidePolygonsGJK(polyA, polyB, margin, m);
             }
-            return true;
+            return Physics_CollidePolygonsSAT(polyA, polyB, margin, m);
+        }
+
+        bool Physics_Collide(const PhysicsBody& a, const PhysicsBody& b, PhysicsManifold& m, float margin) {
+            m.pointCount = 0;
+            if (!(a.layer & b.mask) || !(b.layer & a.mask)) return false;
+            return Physics_CollideShapes(a, b, m, margin);
         }
 
-        // Circle vs Box collision
-        bool Physics_CircleVsBox(const PhysicsBody& circle, const PhysicsBody& box,
+        // Test collision between two bodies; the normal points from A to B
+        bool Physics_TestCollision(const PhysicsBody& a, const PhysicsBody& b,
             float& normalX, float& normalY, float& depth) {
-            float cx = circle.x + circle.shapeOffsetX;
-            float cy = circle.y + circle.shapeOffsetY;
+            PhysicsManifold m;
+            if (!Physics_Collide(a, b, m, 0.0f)) return false;
+            normalX = m.normalX;
+            normalY = m.normalY;
+            depth = m.MaxDepth();
+            return true;
+        }
 
-            float bMinX, bMinY, bMaxX, bMaxY;
-            Physics_GetAABB(box, bMinX, bMinY, bMaxX, bMaxY);
+        // Exact ray against one body's shape: the ray is p + t * d with unit d and 0 <= t <= maxT.
+        // A ray starting inside the shape does not hit it
+        bool Physics_RayCastBody(const PhysicsBody& body, float px, float py, float dx, float dy, float maxT,
+            float& t, float& normalX, float& normalY) {
+            if (body.shapeType == SHAPE_CIRCLE) {
+                float cx, cy;
+                Physics_ShapeCenter(body, cx, cy);
+                float sx = px - cx, sy = py - cy;
+                float b = Physics_Dot(sx, sy, dx, dy);
+                float c = Physics_Dot(sx, sy, sx, sy) - body.shapeRadius * body.shapeRadius;
+                if (c <= 0.0f) return false;
+                float disc = b * b - c;
+                if (disc < 0.0f) return false;
+                float hit = -b - sqrtf(disc);
+                if (hit < 0.0f || hit > maxT) return false;
+                t = hit;
+                normalX = (sx + dx * hit) / body.shapeRadius;
+                normalY = (sy + dy * hit) / body.shapeRadius;
+                return true;
+            }
 
-            // Find closest point on box to circle center
-            float closestX = fmaxf(bMinX, fminf(cx, bMaxX));
-            float closestY = fmaxf(bMinY, fminf(cy, bMaxY));
+            // Clip the segment against every edge's half-plane (Cyrus-Beck); the edge that
+            // last raised the entry distance is the one hit
+            PhysicsPolygon poly;
+            Physics_BuildPolygon(body, poly);
+            float lower = 0.0f, upper = maxT;
+            int index = -1;
+            for (int i = 0; i < poly.count; i++) {
+                float numer = Physics_Dot(poly.nx[i], poly.ny[i], poly.x[i] - px, poly.y[i] - py);
+                float denom = Physics_Dot(poly.nx[i], poly.ny[i], dx, dy);
+                if (denom == 0.0f) {
+                    if (numer < 0.0f) return false;
+                } else if (denom < 0.0f && numer < lower * denom) {
+                    lower = numer / denom;
+                    index = i;
+                } else if (denom > 0.0f && numer < upper * denom) {
+                    upper = numer / denom;
+                }
+                if (upper < lower) return false;
+            }
+            if (index < 0) return false;
+            t = lower;
+            normalX = poly.nx[index];
+            normalY = poly.ny[index];
+            return true;
+        }
+    }
 
-            float dx = cx - closestX;
-            float dy = cy - closestY;
-            float dist = Physics_Length(dx, dy);
+    // ========================================================================
+    // PHYSICS BROADPHASE
+    // ========================================================================
+    // Bodies live in a dynamic AABB tree with fattened leaves (or in a sweep-and-prune
+    // axis list), refreshed once per step. A leaf is only reinserted when its body
+    // leaves the fat box, and the narrowphase only sees pairs whose fat boxes overlap.
+    struct PhysicsAABB {
+        float minX = 0, minY = 0, maxX = 0, maxY = 0;
 
-            if (dist >= circle.shapeRadius) return false;
+        float Perimeter() const { return 2.0f * ((maxX - minX) + (maxY - minY)); }
+        bool Contains(const PhysicsAABB& o) const {
+            return minX <= o.minX && minY <= o.minY && o.maxX <= maxX && o.maxY <= maxY;
+        }
+        bool Overlaps(const PhysicsAABB& o) const {
+            return minX <= o.maxX && o.minX <= maxX && minY <= o.maxY && o.minY <= maxY;
+        }
+        static PhysicsAABB Combine(const PhysicsAABB& a, const PhysicsAABB& b) {
+            return { fminf(a.minX, b.minX), fminf(a.minY, b.minY), fmaxf(a.maxX, b.maxX), fmaxf(a.maxY, b.maxY) };
+        }
+    };
 
-            if (dist > 0.0001f) {
-                normalX = dx / dist;
-                normalY = dy / dist;
-            } else {
-                // Circle center is inside box
-                float toLeft = cx - bMinX;
-                float toRight = bMaxX - cx;
-                float toTop = cy - bMinY;
-                float toBottom = bMaxY - cy;
-                float minDist = fminf(fminf(toLeft, toRight), fminf(toTop, toBottom));
-                if (minDist == toLeft) { normalX = -1; normalY = 0; }
-                else if (minDist == toRight) { normalX = 1; normalY = 0; }
-                else if (minDist == toTop) { normalX = 0; normalY = -1; }
-                else { normalX = 0; normalY = 1; }
-            }
-            depth = circle.shapeRadius - dist;
+    // Box2D-style dynamic tree: leaves hold body handles, internal nodes the union of their
+    // children; inserts pick the cheapest sibling by perimeter and rotations keep it balanced
+    class PhysicsAABBTree {
+    public:
+        int CreateProxy(const PhysicsAABB& tight, int body, float margin) {
+            int id = AllocateNode();
+            Node& n = nodes_[id];
+            n.box = { tight.minX - margin, tight.minY - margin, tight.maxX + margin, tight.maxY + margin };
+            n.body = body;
+            n.height = 0;
+            InsertLeaf(id);
+            proxyCount_++;
+            return id;
+        }
+
+        void DestroyProxy(int id) {
+            if (id < 0 || id >= (int)nodes_.size()) return;
+            RemoveLeaf(id);
+            FreeNode(id);
+            proxyCount_--;
+        }
+
+        // Returns true when the leaf had to be reinserted
+        bool MoveProxy(int id, const PhysicsAABB& tight, float margin) {
+            if (nodes_[id].box.Contains(tight)) return false;
+            RemoveLeaf(id);
+            nodes_[id].box = { tight.minX - margin, tight.minY - margin, tight.maxX + margin, tight.maxY + margin };
+            InsertLeaf(id);
             return true;
         }
 
-        // Test collision between two bodies
-        bool Physics_TestCollision(const PhysicsBody& a, const PhysicsBody& b,
-            float& normalX, float& normalY, float& depth) {
-            // Check layer masks
-            if (!(a.layer & b.mask) || !(b.layer & a.mask)) return false;
+        const PhysicsAABB& GetFatAABB(int id) const { return nodes_[id].box; }
+
+        // Appends the body handle of every leaf whose fat box overlaps 'box'
+        void Query(const PhysicsAABB& box, std::vector<int>& out) {
+            if (root_ < 0) return;
+            stack_.clear();
+            stack_.push_back(root_);
+            while (!stack_.empty()) {
+                int id = stack_.back();
+                stack_.pop_back();
+                const Node& n = nodes_[id];
+                if (!n.box.Overlaps(box)) continue;
+                if (n.IsLeaf()) out.push_back(n.body);
+                else { stack_.push_back(n.child1); stack_.push_back(n.child2); }
+            }
+        }
+
+        // Visits every leaf whose fat box the segment p + t * d (0 <= t <= maxT) crosses. The
+        // callback returns the new maxT, so the closest hit so far clips the rest of the walk;
+        // returning 0 stops it
+        void RayCast(float px, float py, float dx, float dy, float maxT,
+            const std::function<float(int body, float maxT)>& visit) {
+            if (root_ < 0 || maxT <= 0) return;
+            stack_.clear();
+            stack_.push_back(root_);
+            while (!stack_.empty()) {
+                int id = stack_.back();
+                stack_.pop_back();
+                const Node& n = nodes_[id];
+                if (!RayOverlaps(n.box, px, py, dx, dy, maxT)) continue;
+                if (!n.IsLeaf()) { stack_.push_back(n.child1); stack_.push_back(n.child2); continue; }
+                maxT = visit(n.body, maxT);
+                if (maxT <= 0) return;
+            }
+        }
+
+        int GetHeight() const { return root_ >= 0 ? nodes_[root_].height : 0; }
+        int GetProxyCount() const { return proxyCount_; }
+
+        void Clear() {
+            nodes_.clear();
+            root_ = -1;
+            freeList_ = -1;
+            proxyCount_ = 0;
+        }
+
+    private:
+        struct Node {
+            PhysicsAABB box;
+            int parent = -1;   // Doubles as the free-list link
+            int child1 = -1;
+            int child2 = -1;
+            int height = -1;   // -1 = free, 0 = leaf
+            int body = -1;
+            bool IsLeaf() const { return child1 < 0; }
+        };
+
+        // Slab test of the segment against a box
+        static bool RayOverlaps(const PhysicsAABB& box, float px, float py, float dx, float dy, float maxT) {
+            float tmin = 0.0f, tmax = maxT;
+            if (fabsf(dx) > 1e-8f) {
+                float t1 = (box.minX - px) / dx, t2 = (box.maxX - px) / dx;
+                tmin = fmaxf(tmin, fminf(t1, t2));
+                tmax = fminf(tmax, fmaxf(t1, t2));
+            } else if (px < box.minX || px > box.maxX) return false;
+            if (fabsf(dy) > 1e-8f) {
+                float t1 = (box.minY - py) / dy, t2 = (box.maxY - py) / dy;
+                tmin = fmaxf(tmin, fminf(t1, t2));
+                tmax = fminf(tmax, fmaxf(t1, t2));
+            } else if (py < box.minY || py > box.maxY) return false;
+            return tmin <= tmax;
+        }
+
+        int AllocateNode() {
+            if (freeList_ < 0) {
+                nodes_.push_back(Node{});
+                freeList_ = (int)nodes_.size() - 1;
+                nodes_[freeList_].parent = -1;
+            }
+            int id = freeList_;
+            freeList_ = nodes_[id].parent;
+            nodes_[id] = Node{};
+            return id;
+        }
+
+        void FreeNode(int id) {
+            nodes_[id].parent = freeList_;
+            nodes_[id].height = -1;
+            freeList_ = id;
+        }
+
+        void InsertLeaf(int leaf) {
+            if (root_ < 0) {
+                root_ = leaf;
+                nodes_[leaf].parent = -1;
+                return;
+            }
+
+            // Descend towards the sibling that grows the total perimeter the least
+            PhysicsAABB leafBox = nodes_[leaf].box;
+            int index = root_;
+            while (!nodes_[index].IsLeaf()) {
+                const Node& n = nodes_[index];
+                float area = n.box.Perimeter();
+                float combined = PhysicsAABB::Combine(n.box, leafBox).Perimeter();
+                float cost = 2.0f * combined;
+                float inherited = 2.0f * (combined - area);
+
+                auto childCost = [&](int c) {
+                    float grown = PhysicsAABB::Combine(leafBox, nodes_[c].box).Perimeter();
+                    return nodes_[c].IsLeaf() ? grown + inherited : grown - nodes_[c].box.Perimeter() + inherited;
+                };
+                float cost1 = childCost(n.child1);
+                float cost2 = childCost(n.child2);
+                if (cost < cost1 && cost < cost2) break;
+                index = cost1 < cost2 ? n.child1 : n.child2;
+            }
+
+            int sibling = index;
+            int oldParent = nodes_[sibling].parent;
+            int newParent = AllocateNode();
+            nodes_[newParent].parent = oldParent;
+            nodes_[newParent].box = PhysicsAABB::Combine(leafBox, nodes_[sibling].box);
+            nodes_[newParent].height = nodes_[sibling].height + 1;
+            nodes_[newParent].child1 = sibling;
+            nodes_[newParent].child2 = leaf;
+            nodes_[sibling].parent = newParent;
+            nodes_[leaf].parent = newParent;
+            if (oldParent >= 0) {
+                if (nodes_[oldParent].child1 == sibling) nodes_[oldParent].child1 = newParent;
+                else nodes_[oldParent].child2 = newParent;
+            } else {
+                root_ = newParent;
+            }
+            Refit(nodes_[leaf].parent);
+        }
+
+        void RemoveLeaf(int leaf) {
+            if (leaf == root_) { root_ = -1; return; }
+            int parent = nodes_[leaf].parent;
+            int grandParent = nodes_[parent].parent;
+            int sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
 
-            if (a.shapeType == SHAPE_CIRCLE && b.shapeType == SHAPE_CIRCLE) {
-                return Physics_CircleVsCircle(a, b, normalX, normalY, depth);
-            } else if (a.shapeType == SHAPE_BOX && b.shapeType == SHAPE_BOX) {
-                return Physics_BoxVsBox(a, b, normalX, normalY, depth);
-            } else if (a.shapeType == SHAPE_CIRCLE && b.shapeType == SHAPE_BOX) {
-                return Physics_CircleVsBox(a, b, normalX, normalY, depth);
-            } else if (a.shapeType == SHAPE_BOX && b.shapeType == SHAPE_CIRCLE) {
-                bool result = Physics_CircleVsBox(b, a, normalX, normalY, depth);
-                normalX = -normalX; normalY = -normalY;
-                return result;
+            if (grandParent >= 0) {
+                if (nodes_[grandParent].child1 == parent) nodes_[grandParent].child1 = sibling;
+                else nodes_[grandParent].child2 = sibling;
+                nodes_[sibling].parent = grandParent;
+                FreeNode(parent);
+                Refit(grandParent);
+            } else {
+                root_ = sibling;
+                nodes_[sibling].parent = -1;
+                FreeNode(parent);
+            }
+        }
+
+        // Walks to the root fixing heights and boxes, rotating where a subtree is lopsided
+        void Refit(int index) {
+            while (index >= 0) {
+                index = Balance(index);
+                Node& n = nodes_[index];
+                n.height = 1 + std::max(nodes_[n.child1].height, nodes_[n.child2].height);
+                n.box = PhysicsAABB::Combine(nodes_[n.child1].box, nodes_[n.child2].box);
+                index = n.parent;
+            }
+        }
+
+        // AVL rotation as in b2DynamicTree::Balance; returns the subtree's new root
+        int Balance(int iA) {
+            Node& A = nodes_[iA];
+            if (A.IsLeaf() || A.height < 2) return iA;
+            int iB = A.child1, iC = A.child2;
+            int balance = nodes_[iC].height - nodes_[iB].height;
+            if (balance > 1) return Rotate(iA, iC, iB);
+            if (balance < -1) return Rotate(iA, iB, iC);
+            return iA;
+        }
+
+        // Promotes 'up' (a child of iA) above iA; 'other' is iA's remaining child
+        int Rotate(int iA, int up, int other) {
+            Node& A = nodes_[iA];
+            Node& U = nodes_[up];
+            int iF = U.child1, iG = U.child2;
+
+            U.child1 = iA;
+            U.parent = A.parent;
+            A.parent = up;
+            if (U.parent >= 0) {
+                if (nodes_[U.parent].child1 == iA) nodes_[U.parent].child1 = up;
+                else nodes_[U.parent].child2 = up;
+            } else {
+                root_ = up;
             }
-            // Polygon collision would go here - using AABB approximation
-            return Physics_BoxVsBox(a, b, normalX, normalY, depth);
+
+            // Keep the taller grandchild under 'up', move the shorter one under A
+            int keep = iF, move = iG;
+            if (nodes_[iF].height < nodes_[iG].height) { keep = iG; move = iF; }
+            U.child2 = keep;
+            if (A.child1 == up) A.child1 = move; else A.child2 = move;
+            nodes_[move].parent = iA;
+
+            A.box = PhysicsAABB::Combine(nodes_[other].box, nodes_[move].box);
+            A.height = 1 + std::max(nodes_[other].height, nodes_[move].height);
+            U.box = PhysicsAABB::Combine(A.box, nodes_[keep].box);
+            U.height = 1 + std::max(A.height, nodes_[keep].height);
+            return up;
         }
 
-        // Resolve collision between two bodies
-        void Physics_ResolveCollision(PhysicsBody& a, PhysicsBody& b,
-            float normalX, float normalY, float depth) {
-            // Skip triggers
-            if (a.isTrigger || b.isTrigger) return;
+        std::vector<Node> nodes_;
+        std::vector<int> stack_;
+        int root_ = -1;
+        int freeList_ = -1;
+        int proxyCount_ = 0;
+    };
+
+    struct PhysicsSapEntry {
+        PhysicsAABB box;
+        int body;
+    };
+
+    struct PhysicsBroadphaseState {
+        int mode = PHYSICS_BROADPHASE_TREE;
+        float margin = 4.0f;                      // Fat AABB padding in pixels
+        PhysicsAABBTree tree;
+        std::vector<PhysicsSapEntry> sap;         // Sorted by minX, kept across steps
+        std::vector<std::pair<int, int>> pairs;   // Candidate pairs for the current step
+        std::vector<int> hits;
+        int reinserted = 0;
+        double lastMs = 0.0;
+        bool queryDirty = true;                   // A body moved since queries last refit the tree
+        std::vector<std::pair<float, int>> rayHits;  // Query scratch: distance, body
+    };
+    static PhysicsBroadphaseState g_physicsBroadphase;
+
+    static PhysicsAABB Physics_BodyAABB(const PhysicsBody& body) {
+        PhysicsAABB box;
+        Physics_GetAABB(body, box.minX, box.minY, box.maxX, box.maxY);
+        return box;
+    }
+
+    static void Physics_RemoveProxy(PhysicsBody& body) {
+        if (body.proxyId >= 0) g_physicsBroadphase.tree.DestroyProxy(body.proxyId);
+        body.proxyId = -1;
+        body.inSap = false;
+    }
 
-            // Calculate inverse masses
-            float invMassA = (a.type == BODY_STATIC) ? 0 : a.invMass;
-            float invMassB = (b.type == BODY_STATIC) ? 0 : b.invMass;
-            float totalInvMass = invMassA + invMassB;
+    static void Physics_ResetBroadphase() {
+        g_physicsBroadphase.tree.Clear();
+        g_physicsBroadphase.sap.clear();
+        g_physicsBroadphase.pairs.clear();
+        g_physicsBroadphase.queryDirty = true;
+        for (auto& kv : g_physicsBodies) { kv.second.proxyId = -1; kv.second.inSap = false; }
+    }
 
-            if (totalInvMass == 0) return;  // Both static
+    // At least one side must be an awake mover; sleeping and static bodies never pair up
+    static bool Physics_PairCandidate(const PhysicsBody& a, const PhysicsBody& b) {
+        return Physics_IsAwakeMover(a) || Physics_IsAwakeMover(b);
+    }
 
-            // Separate bodies (positional correction)
-            float correctionPercent = 0.8f;
-            float slop = 0.01f;  // Small penetration allowed
-            float correction = fmaxf(depth - slop, 0.0f) / totalInvMass * correctionPercent;
+    // Gives every valid body a leaf whose fat box still holds it
+    static void Physics_SyncTreeProxies(PhysicsBroadphaseState& bp) {
+        for (auto& kv : g_physicsBodies) {
+            PhysicsBody& body = kv.second;
+            if (!body.valid) { if (body.proxyId >= 0) Physics_RemoveProxy(body); continue; }
+            PhysicsAABB tight = Physics_BodyAABB(body);
+            if (body.proxyId < 0) body.proxyId = bp.tree.CreateProxy(tight, kv.first, bp.margin);
+            else if (bp.tree.MoveProxy(body.proxyId, tight, bp.margin)) bp.reinserted++;
+        }
+    }
 
-            if (a.type != BODY_STATIC) {
-                a.x -= normalX * correction * invMassA;
-                a.y -= normalY * correction * invMassA;
+    // Queries go through the same tree in every broadphase mode. It is refit at most once
+    // between changes (a step, or a body created, moved or reshaped through the API), so a
+    // frame's worth of raycasts pays for the sync once
+    static PhysicsAABBTree& Physics_QueryTree() {
+        PhysicsBroadphaseState& bp = g_physicsBroadphase;
+        if (bp.queryDirty) {
+            int reinserted = bp.reinserted;
+            Physics_SyncTreeProxies(bp);
+            bp.reinserted = reinserted;
+            bp.queryDirty = false;
+        }
+        return bp.tree;
+    }
+
+    static void Physics_TreePairs(PhysicsBroadphaseState& bp) {
+        Physics_SyncTreeProxies(bp);
+
+        // Only awake movers query; two of them report their pair once, from the lower handle
+        for (auto& kv : g_physicsBodies) {
+            const PhysicsBody& a = kv.second;
+            if (!Physics_IsAwakeMover(a)) continue;
+            bp.hits.clear();
+            bp.tree.Query(bp.tree.GetFatAABB(a.proxyId), bp.hits);
+            for (int hB : bp.hits) {
+                if (hB == kv.first) continue;
+                const PhysicsBody& b = g_physicsBodies.find(hB)->second;
+                if (Physics_IsAwakeMover(b) && hB < kv.first) continue;
+                bp.pairs.push_back({ kv.first, hB });
+            }
+        }
+    }
+
+    // Incremental sort-and-sweep on x: last step's order is nearly sorted, so insertion sort is ~O(n)
+    static void Physics_SapPairs(PhysicsBroadphaseState& bp) {
+        size_t w = 0;
+        for (size_t r = 0; r < bp.sap.size(); r++) {
+            auto it = g_physicsBodies.find(bp.sap[r].body);
+            if (it == g_physicsBodies.end() || !it->second.valid) {
+                if (it != g_physicsBodies.end()) it->second.inSap = false;
+                continue;
             }
-            if (b.type != BODY_STATIC) {
-                b.x += normalX * correction * invMassB;
-                b.y += normalY * correction * invMassB;
+            PhysicsAABB tight = Physics_BodyAABB(it->second);
+            bp.sap[w].body = bp.sap[r].body;
+            bp.sap[w].box = { tight.minX - bp.margin, tight.minY - bp.margin, tight.maxX + bp.margin, tight.maxY + bp.margin };
+            w++;
+        }
+        bp.sap.resize(w);
+        for (auto& kv : g_physicsBodies) {
+            PhysicsBody& body = kv.second;
+            if (!body.valid || body.inSap) continue;
+            PhysicsAABB tight = Physics_BodyAABB(body);
+            bp.sap.push_back({ { tight.minX - bp.margin, tight.minY - bp.margin, tight.maxX + bp.margin, tight.maxY + bp.margin }, kv.first });
+            body.inSap = true;
+        }
+
+        for (size_t i = 1; i < bp.sap.size(); i++) {
+            PhysicsSapEntry e = bp.sap[i];
+            size_t j = i;
+            while (j > 0 && bp.sap[j - 1].box.minX > e.box.minX) { bp.sap[j] = bp.sap[j - 1]; j--; }
+            bp.sap[j] = e;
+        }
+
+        for (size_t i = 0; i < bp.sap.size(); i++) {
+            const PhysicsSapEntry& ei = bp.sap[i];
+            const PhysicsBody& a = g_physicsBodies.find(ei.body)->second;
+            for (size_t j = i + 1; j < bp.sap.size() && bp.sap[j].box.minX <= ei.box.maxX; j++) {
+                const PhysicsSapEntry& ej = bp.sap[j];
+                if (ej.box.minY > ei.box.maxY || ei.box.minY > ej.box.maxY) continue;
+                if (!Physics_PairCandidate(a, g_physicsBodies.find(ej.body)->second)) continue;
+                bp.pairs.push_back({ ei.body, ej.body });
             }
+        }
+    }
 
-            // Calculate relative velocity
-            float relVelX = b.vx - a.vx;
-            float relVelY = b.vy - a.vy;
-            float relVelNormal = Physics_Dot(relVelX, relVelY, normalX, normalY);
+    // Every body against every other, kept for comparison and benchmarking
+    static void Physics_BruteForcePairs(PhysicsBroadphaseState& bp) {
+        bp.sap.clear();
+        for (auto& kv : g_physicsBodies) {
+            if (!kv.second.valid) continue;
+            PhysicsAABB tight = Physics_BodyAABB(kv.second);
+            bp.sap.push_back({ { tight.minX - bp.margin, tight.minY - bp.margin, tight.maxX + bp.margin, tight.maxY + bp.margin }, kv.first });
+        }
+        for (size_t i = 0; i < bp.sap.size(); i++) {
+            const PhysicsBody& a = g_physicsBodies.find(bp.sap[i].body)->second;
+            for (size_t j = i + 1; j < bp.sap.size(); j++) {
+                if (!bp.sap[i].box.Overlaps(bp.sap[j].box)) continue;
+                if (Physics_PairCandidate(a, g_physicsBodies.find(bp.sap[j].body)->second)) bp.pairs.push_back({ bp.sap[i].body, bp.sap[j].body });
+            }
+        }
+    }
 
-            // Don't resolve if velocities are separating
-            if (relVelNormal > 0) return;
+    // Fills g_physicsBroadphase.pairs for this step
+    static void Physics_FindPairs() {
+        PhysicsBroadphaseState& bp = g_physicsBroadphase;
+        double start = WallTime_Internal();
+        bp.pairs.clear();
+        bp.reinserted = 0;
+        switch (bp.mode) {
+            case PHYSICS_BROADPHASE_SAP: Physics_SapPairs(bp); break;
+            case PHYSICS_BROADPHASE_BRUTE_FORCE: Physics_BruteForcePairs(bp); break;
+            default: Physics_TreePairs(bp); break;
+        }
+        if (g_physicsDeterministic) {
+            for (auto& pair : bp.pairs) if (pair.first > pair.second) std::swap(pair.first, pair.second);
+            std::sort(bp.pairs.begin(), bp.pairs.end());
+        }
+        bp.lastMs = (WallTime_Internal() - start) * 1000.0;
+    }
 
-            // Calculate restitution (bounce)
-            float e = fminf(a.restitution, b.restitution);
+    // ========================================================================
+    // PHYSICS BODY STORE - Slots, awake movers and integration
+    // ========================================================================
+    // Position, velocity, force and inverse mass are authoritative in g_physicsStore's arrays;
+    // a body reaches them through its slot, so the narrowphase, solver and joints read the same
+    // memory integration writes. Slots stay packed: a destroyed body's slot takes the last one.
+    // When g_physicsMoversDirty is raised the slots are reordered so the awake movers come
+    // first, dynamic ones ahead of kinematic ones. Integration then runs straight down the
+    // arrays four bodies per SSE instruction, in the same operation order as the scalar code,
+    // so results do not depend on how many bodies took the vector path. Statics and sleepers
+    // sit past moverEnd and cost nothing per step.
+
+    // Gives a body in the world its own slot, starting from the scratch slot's defaults
+    static void Physics_AttachSlot(PhysicsBody& body) {
+        PhysicsBodyStore& s = g_physicsStore;
+        body.slot = (int)s.owner.size();
+        s.x.push_back(0.0f); s.y.push_back(0.0f);
+        s.sweepX.push_back(0.0f); s.sweepY.push_back(0.0f);
+        s.vx.push_back(0.0f); s.vy.push_back(0.0f);
+        s.forceX.push_back(0.0f); s.forceY.push_back(0.0f);
+        s.invMass.push_back(1.0f);
+        s.gravityScale.push_back(1.0f);
+        s.linearDamping.push_back(0.0f);
+        s.owner.push_back(&body);
+        g_physicsMoversDirty = true;
+    }
+
+    // Copies slot 'from' over slot 'to' and repoints its owner
+    static void Physics_MoveSlot(int from, int to) {
+        PhysicsBodyStore& s = g_physicsStore;
+        s.x[to] = s.x[from]; s.y[to] = s.y[from];
+        s.sweepX[to] = s.sweepX[from]; s.sweepY[to] = s.sweepY[from];
+        s.vx[to] = s.vx[from]; s.vy[to] = s.vy[from];
+        s.forceX[to] = s.forceX[from]; s.forceY[to] = s.forceY[from];
+        s.invMass[to] = s.invMass[from];
+        s.gravityScale[to] = s.gravityScale[from];
+        s.linearDamping[to] = s.linearDamping[from];
+        s.owner[to] = s.owner[from];
+        s.owner[to]->slot = to;
+    }
+
+    // Frees a departing body's slot by moving the last slot into it
+    static void Physics_DetachSlot(PhysicsBody& body) {
+        PhysicsBodyStore& s = g_physicsStore;
+        int last = (int)s.owner.size() - 1;
+        if (body.slot <= 0 || body.slot > last || s.owner[body.slot] != &body) return;
+        if (body.slot != last) Physics_MoveSlot(last, body.slot);
+        s.x.pop_back(); s.y.pop_back();
+        s.sweepX.pop_back(); s.sweepY.pop_back();
+        s.vx.pop_back(); s.vy.pop_back();
+        s.forceX.pop_back(); s.forceY.pop_back();
+        s.invMass.pop_back();
+        s.gravityScale.pop_back();
+        s.linearDamping.pop_back();
+        s.owner.pop_back();
+        body.slot = 0;
+        g_physicsMoversDirty = true;
+    }
+
+    // Drops every world slot down to the scratch slot but keeps the arrays' capacity, so a
+    // snapshot restore or a rebuilt world refills them without reallocating
+    static void Physics_ClearSlots() {
+        PhysicsBodyStore& s = g_physicsStore;
+        s.x.resize(1); s.y.resize(1);
+        s.sweepX.resize(1); s.sweepY.resize(1);
+        s.vx.resize(1); s.vy.resize(1);
+        s.forceX.resize(1); s.forceY.resize(1);
+        s.invMass.resize(1);
+        s.gravityScale.resize(1);
+        s.linearDamping.resize(1);
+        s.owner.resize(1);
+        s.dynamicEnd = s.moverEnd = 1;
+        s.bound.clear();
+        g_physicsMoversDirty = true;
+    }
+
+    static void Physics_SwapSlots(int i, int j) {
+        PhysicsBodyStore& s = g_physicsStore;
+        std::swap(s.x[i], s.x[j]); std::swap(s.y[i], s.y[j]);
+        std::swap(s.sweepX[i], s.sweepX[j]); std::swap(s.sweepY[i], s.sweepY[j]);
+        std::swap(s.vx[i], s.vx[j]); std::swap(s.vy[i], s.vy[j]);
+        std::swap(s.forceX[i], s.forceX[j]); std::swap(s.forceY[i], s.forceY[j]);
+        std::swap(s.invMass[i], s.invMass[j]);
+        std::swap(s.gravityScale[i], s.gravityScale[j]);
+        std::swap(s.linearDamping[i], s.linearDamping[j]);
+        std::swap(s.owner[i], s.owner[j]);
+        s.owner[i]->slot = i;
+        s.owner[j]->slot = j;
+    }
+
+    // Moves awake dynamic bodies to the front of the slots, then awake kinematic ones
+    static void Physics_GatherMovers() {
+        PhysicsBodyStore& s = g_physicsStore;
+        int count = (int)s.owner.size();
+        int next = 1;
+        for (int i = 1; i < count; i++) {
+            const PhysicsBody& body = *s.owner[i];
+            if (!Physics_IsAwakeMover(body) || body.type != BODY_DYNAMIC) continue;
+            if (i != next) Physics_SwapSlots(i, next);
+            next++;
+        }
+        s.dynamicEnd = next;
+        for (int i = next; i < count; i++) {
+            if (!Physics_IsAwakeMover(*s.owner[i])) continue;
+            if (i != next) Physics_SwapSlots(i, next);
+            next++;
+        }
+        s.moverEnd = next;
+        s.bound.clear();
+        for (int i = 1; i < s.moverEnd; i++) {
+            if (s.owner[i]->boundEntity >= 0) s.bound.push_back(s.owner[i]);
+        }
+        g_physicsMoversDirty = false;
+    }
+
+    // Gravity, forces, torque and damping for the dynamic movers
+    static void Physics_IntegrateForces(float h) {
+        PhysicsBodyStore& s = g_physicsStore;
+        float* vx = s.vx.data();
+        float* vy = s.vy.data();
+        float* forceX = s.forceX.data();
+        float* forceY = s.forceY.data();
+        const float* invMass = s.invMass.data();
+        const float* gravityScale = s.gravityScale.data();
+        const float* linearDamping = s.linearDamping.data();
+
+        // v += g * scale * h; v += f * invMass * h; v *= 1 / (1 + damping * h)
+        const __m128 gx = _mm_set1_ps(g_gravityX), gy = _mm_set1_ps(g_gravityY);
+        const __m128 step = _mm_set1_ps(h), one = _mm_set1_ps(1.0f), zero = _mm_setzero_ps();
+        int i = 1;
+        for (; i + 4 <= s.dynamicEnd; i += 4) {
+            __m128 scale = _mm_loadu_ps(gravityScale + i);
+            __m128 im = _mm_loadu_ps(invMass + i);
+            __m128 damping = _mm_div_ps(one, _mm_add_ps(one, _mm_mul_ps(_mm_loadu_ps(linearDamping + i), step)));
+            __m128 x = _mm_add_ps(_mm_loadu_ps(vx + i), _mm_mul_ps(_mm_mul_ps(gx, scale), step));
+            __m128 y = _mm_add_ps(_mm_loadu_ps(vy + i), _mm_mul_ps(_mm_mul_ps(gy, scale), step));
+            x = _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(forceX + i), im), step));
+            y = _mm_add_ps(y, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(forceY + i), im), step));
+            _mm_storeu_ps(vx + i, _mm_mul_ps(x, damping));
+            _mm_storeu_ps(vy + i, _mm_mul_ps(y, damping));
+            _mm_storeu_ps(forceX + i, zero);
+            _mm_storeu_ps(forceY + i, zero);
+        }
+        for (; i < s.dynamicEnd; i++) {
+            float damping = 1.0f / (1.0f + linearDamping[i] * h);
+            vx[i] += g_gravityX * gravityScale[i] * h;
+            vy[i] += g_gravityY * gravityScale[i] * h;
+            vx[i] += forceX[i] * invMass[i] * h;
+            vy[i] += forceY[i] * invMass[i] * h;
+            vx[i] *= damping;
+            vy[i] *= damping;
+            forceX[i] = forceY[i] = 0;
+        }
+
+        for (int k = 1; k < s.dynamicEnd; k++) {
+            PhysicsBody& body = *s.owner[k];
+            if (!body.fixedRotation) {
+                body.angularVelocity += body.torque * body.invInertia * h;
+                body.torque = 0;
+            }
+            body.angularVelocity *= 1.0f / (1.0f + body.angularDamping * h);
+        }
+    }
+
+    // Moves every awake mover along its solved velocity, keeping the start pose for CCD
+    static void Physics_IntegratePositions(float h) {
+        PhysicsBodyStore& s = g_physicsStore;
+        float* x = s.x.data();
+        float* y = s.y.data();
+        float* sweepX = s.sweepX.data();
+        float* sweepY = s.sweepY.data();
+        const float* vx = s.vx.data();
+        const float* vy = s.vy.data();
+
+        const __m128 step = _mm_set1_ps(h);
+        int i = 1;
+        for (; i + 4 <= s.moverEnd; i += 4) {
+            __m128 px = _mm_loadu_ps(x + i), py = _mm_loadu_ps(y + i);
+            _mm_storeu_ps(sweepX + i, px);
+            _mm_storeu_ps(sweepY + i, py);
+            _mm_storeu_ps(x + i, _mm_add_ps(px, _mm_mul_ps(_mm_loadu_ps(vx + i), step)));
+            _mm_storeu_ps(y + i, _mm_add_ps(py, _mm_mul_ps(_mm_loadu_ps(vy + i), step)));
+        }
+        for (; i < s.moverEnd; i++) {
+            sweepX[i] = x[i];
+            sweepY[i] = y[i];
+            x[i] += vx[i] * h;
+            y[i] += vy[i] * h;
+        }
+
+        for (int k = 1; k < s.moverEnd; k++) {
+            PhysicsBody& body = *s.owner[k];
+            body.sweepRotation = body.rotation;
+            if (!body.fixedRotation) {
+                body.rotation += body.angularVelocity * h;
+            }
+        }
+    }
+
+    // Bound movers whose pose changed this step, for the next SyncToEntities
+    static void Physics_QueueMovedBodies() {
+        for (PhysicsBody* body : g_physicsStore.bound) {
+            if (body->X() != body->SweepX() || body->Y() != body->SweepY() || body->rotation != body->sweepRotation) {
+                Physics_QueueSync(*body);
+            }
+        }
+    }
 
-            // Calculate impulse scalar
-            float j = -(1 + e) * relVelNormal / totalInvMass;
+    // ========================================================================
+    // PHYSICS WORKERS - Thread pool for narrowphase and island solving
+    // ========================================================================
+    // The stepping thread always takes part, so one thread runs everything inline. Jobs hand
+    // out indices from an atomic cursor and each index writes only its own result slot or its
+    // own island, so the outcome never depends on which thread ran what.
+    struct PhysicsWorkerPool {
+        std::vector<std::thread> threads;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        const std::function<void(int)>* job = nullptr;  // Guarded by mutex, like everything below
+        int jobCount = 0;
+        int busy = 0;                 // Workers still inside the current job
+        unsigned int generation = 0;  // Bumped for every job
+        bool stopping = false;
+        std::atomic<int> next{ 0 };
+    };
+    static PhysicsWorkerPool g_physicsWorkers;
+    static int g_physicsThreadCount = 1;
+
+    #define PHYSICS_NARROWPHASE_CHUNK 32       // Candidate pairs per narrowphase job
+    #define PHYSICS_PARALLEL_MIN_CONTACTS 64   // Fewer solver contacts than this stay on one thread
+
+    static void Physics_WorkerMain(unsigned int seen) {
+        PhysicsWorkerPool& pool = g_physicsWorkers;
+        std::unique_lock<std::mutex> lock(pool.mutex);
+        for (;;) {
+            pool.wake.wait(lock, [&] { return pool.stopping || pool.generation != seen; });
+            if (pool.stopping) return;
+            seen = pool.generation;
+            const std::function<void(int)>& job = *pool.job;
+            int count = pool.jobCount;
+            lock.unlock();
+            for (int i = pool.next++; i < count; i = pool.next++) job(i);
+            lock.lock();
+            if (--pool.busy == 0) pool.done.notify_one();
+        }
+    }
+
+    // Runs job(0..count-1) across the pool and returns once every index has finished
+    static void Physics_ParallelFor(int count, const std::function<void(int)>& job) {
+        PhysicsWorkerPool& pool = g_physicsWorkers;
+        if (pool.threads.empty() || count < 2) {
+            for (int i = 0; i < count; i++) job(i);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            pool.job = &job;
+            pool.jobCount = count;
+            pool.next = 0;
+            pool.busy = (int)pool.threads.size();
+            pool.generation++;
+        }
+        pool.wake.notify_all();
+        for (int i = pool.next++; i < count; i = pool.next++) job(i);
+        std::unique_lock<std::mutex> lock(pool.mutex);
+        pool.done.wait(lock, [&] { return pool.busy == 0; });
+    }
+
+    static void Physics_StopWorkers() {
+        PhysicsWorkerPool& pool = g_physicsWorkers;
+        {
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            pool.stopping = true;
+        }
+        pool.wake.notify_all();
+        for (auto& thread : pool.threads) thread.join();
+        pool.threads.clear();
+        pool.stopping = false;
+    }
 
-            // Apply impulse
-            if (a.type != BODY_STATIC) {
-                a.vx -= j * invMassA * normalX;
-                a.vy -= j * invMassA * normalY;
+    // One slot per candidate pair, filled by the workers and merged in candidate order
+    struct PhysicsNarrowResult {
+        bool touching = false;
+        PhysicsManifold manifold;
+    };
+    static std::vector<PhysicsNarrowResult> g_physicsNarrowResults;
+
+    static void Physics_Narrowphase(float margin) {
+        const auto& pairs = g_physicsBroadphase.pairs;
+        int count = (int)pairs.size();
+        g_physicsNarrowResults.resize(count);
+        int chunks = (count + PHYSICS_NARROWPHASE_CHUNK - 1) / PHYSICS_NARROWPHASE_CHUNK;
+        Physics_ParallelFor(chunks, [&pairs, count, margin](int chunk) {
+            int end = std::min(count, (chunk + 1) * PHYSICS_NARROWPHASE_CHUNK);
+            for (int i = chunk * PHYSICS_NARROWPHASE_CHUNK; i < end; i++) {
+                PhysicsNarrowResult& result = g_physicsNarrowResults[i];
+                result.manifold = PhysicsManifold();
+                auto itA = g_physicsBodies.find(pairs[i].first);
+                auto itB = g_physicsBodies.find(pairs[i].second);
+                if (itA == g_physicsBodies.end() || itB == g_physicsBodies.end()) { result.touching = false; continue; }
+                const PhysicsBody* a = &itA->second;
+                const PhysicsBody* b = &itB->second;
+                if (pairs[i].first > pairs[i].second) std::swap(a, b);
+                // Triggers report overlap only, so they never get speculative points
+                float pairMargin = (a->isTrigger || b->isTrigger) ? 0.0f : margin;
+                result.touching = Physics_Collide(*a, *b, result.manifold, pairMargin);
             }
-            if (b.type != BODY_STATIC) {
-                b.vx += j * invMassB * normalX;
-                b.vy += j * invMassB * normalY;
+        });
+    }
+
+    // ========================================================================
+    // PHYSICS CONTACTS - Persistent manifolds and sequential impulses
+    // ========================================================================
+    // Each step the narrowphase rebuilds the manifold of every touching pair and copies the
+    // accumulated impulses of matching feature ids from the previous step. The velocity
+    // solver starts from those impulses, clamps the running totals (normal >= 0, friction
+    // inside the cone) over g_velocityIterations passes, and after positions integrate a
+    // separate pass pushes remaining overlap out over g_positionIterations, so correction
+    // never feeds energy back into velocities.
+
+    static std::unordered_map<long long, PhysicsManifold> g_physicsManifolds;
+    static unsigned int g_physicsStepStamp = 0;
+    static bool g_physicsWarmStarting = true;
+    static float g_contactBaumgarte = 0.2f;          // Fraction of overlap removed per position pass
+    static float g_contactLinearSlop = 0.5f;         // Overlap in pixels left alone to keep contacts steady
+    static float g_contactMaxCorrection = 8.0f;      // Largest push per position pass in pixels
+    static float g_restitutionThreshold = 100.0f;    // Approach speed in pixels/s below which nothing bounces
+
+    struct PhysicsSolverContact {
+        PhysicsManifold* m;
+        PhysicsBody* a;
+        PhysicsBody* b;
+        float invMassA, invMassB, invInertiaA, invInertiaB;
+    };
+    static std::vector<PhysicsSolverContact> g_physicsSolverContacts;
+    static int g_physicsContactPointCount = 0;
+
+    // Solver islands: contacts grouped by the bodies they push. Bodies that take no impulse
+    // (static, kinematic) never link islands, so islands share nothing they write and can be
+    // solved at the same time with the same result as one sequential pass.
+    static std::vector<int> g_solverIslandStart;  // Offsets into g_physicsSolverContacts, plus the end
+    static std::vector<PhysicsBody*> g_solverIslandBodies;
+    static std::vector<int> g_solverIslandParent;
+    static std::vector<int> g_solverIslandOf;     // Per contact: its body's root, then its island
+    static std::vector<int> g_solverIslandLabel;  // Per root body: island number
+    static std::vector<PhysicsSolverContact> g_solverIslandScratch;
+
+    static long long Physics_PairKey(int a, int b) {
+        return ((long long)a << 32) | (unsigned int)b;
+    }
+
+    // Kinematic bodies push but are never pushed
+    static float Physics_SolverInvMass(const PhysicsBody& body) {
+        return body.type == BODY_DYNAMIC ? body.InvMass() : 0.0f;
+    }
+
+    static float Physics_SolverInvInertia(const PhysicsBody& body) {
+        return (body.type == BODY_DYNAMIC && !body.fixedRotation) ? body.invInertia : 0.0f;
+    }
+
+    // Carry impulses over from last step's manifold for points with the same feature
+    static void Physics_MatchManifold(PhysicsManifold& fresh, const PhysicsManifold& old) {
+        if (!g_physicsWarmStarting) return;
+        for (int i = 0; i < fresh.pointCount; i++) {
+            for (int j = 0; j < old.pointCount; j++) {
+                if (old.points[j].id != fresh.points[i].id) continue;
+                fresh.points[i].normalImpulse = old.points[j].normalImpulse;
+                fresh.points[i].tangentImpulse = old.points[j].tangentImpulse;
+                break;
             }
+        }
+    }
 
-            // Friction impulse
-            float tangentX = relVelX - relVelNormal * normalX;
-            float tangentY = relVelY - relVelNormal * normalY;
-            float tangentLen = Physics_Length(tangentX, tangentY);
+    // Drops manifolds that stopped touching; pairs resting asleep keep theirs for waking
+    static void Physics_PruneManifolds() {
+        for (auto it = g_physicsManifolds.begin(); it != g_physicsManifolds.end();) {
+            const PhysicsManifold& m = it->second;
+            bool keep = false;
+            if (m.stamp == g_physicsStepStamp) {
+                keep = true;
+            } else {
+                auto itA = g_physicsBodies.find(m.bodyA);
+                auto itB = g_physicsBodies.find(m.bodyB);
+                keep = itA != g_physicsBodies.end() && itB != g_physicsBodies.end() &&
+                    !Physics_IsAwakeMover(itA->second) && !Physics_IsAwakeMover(itB->second);
+            }
+            if (keep) ++it;
+            else it = g_physicsManifolds.erase(it);
+        }
+    }
+
+    static std::vector<int> g_physicsWakeScratch;
+
+    // Wakes the sleepers touching or overlapping 'body' where it stands now. Static bodies are
+    // never asleep and never pair with sleepers, so removing or moving one must wake what
+    // rests on it (or what it lands on). Resting contacts always overlap in the tree, so the
+    // body's box against the tree as it stands finds them; this step's contact edges add the
+    // movers it touched. Costs nothing while nothing sleeps.
+    static void Physics_WakeNeighbors(const PhysicsBody& body) {
+        if (g_sleepingIslands.empty()) return;
+        for (const auto& edge : g_physicsContactEdges) {
+            int other = edge.first == body.handle ? edge.second : edge.second == body.handle ? edge.first : -1;
+            if (other < 0) continue;
+            auto it = g_physicsBodies.find(other);
+            if (it != g_physicsBodies.end() && !it->second.awake) Physics_WakeBody(it->second);
+        }
+        if (!body.valid) return;
+        std::vector<int>& hits = g_physicsWakeScratch;
+        hits.clear();
+        g_physicsBroadphase.tree.Query(Physics_BodyAABB(body), hits);
+        for (int h : hits) {
+            if (h == body.handle) continue;
+            auto it = g_physicsBodies.find(h);
+            if (it != g_physicsBodies.end() && !it->second.awake) Physics_WakeBody(it->second);
+        }
+    }
+
+    // Bodies that take no impulse are never written, since other islands may share them
+    static void Physics_ApplyContactImpulse(PhysicsSolverContact& c, const PhysicsContactPoint& cp, float px, float py) {
+        if (c.invMassA + c.invInertiaA > 0) {
+            c.a->VX() -= px * c.invMassA;
+            c.a->VY() -= py * c.invMassA;
+            c.a->angularVelocity -= c.invInertiaA * Physics_Cross(cp.rAX, cp.rAY, px, py);
+        }
+        if (c.invMassB + c.invInertiaB > 0) {
+            c.b->VX() += px * c.invMassB;
+            c.b->VY() += py * c.invMassB;
+            c.b->angularVelocity += c.invInertiaB * Physics_Cross(cp.rBX, cp.rBY, px, py);
+        }
+    }
+
+    // Velocity of B's contact point relative to A's
+    static void Physics_ContactRelativeVelocity(const PhysicsSolverContact& c, const PhysicsContactPoint& cp, float& dvx, float& dvy) {
+        const PhysicsBody& a = *c.a;
+        const PhysicsBody& b = *c.b;
+        dvx = b.VX() - b.angularVelocity * cp.rBY - a.VX() + a.angularVelocity * cp.rAY;
+        dvy = b.VY() + b.angularVelocity * cp.rBX - a.VY() - a.angularVelocity * cp.rAX;
+    }
+
+    // Effective masses and velocity targets, then the warm start. A speculative point may close
+    // its gap within the step; a fast approach bounces.
+    static void Physics_PrepareContacts(PhysicsSolverContact* contacts, int count, float h) {
+        for (int ci = 0; ci < count; ci++) {
+            PhysicsSolverContact& c = contacts[ci];
+            PhysicsManifold& m = *c.m;
+            float nx = m.normalX, ny = m.normalY;
+            float tx = ny, ty = -nx;
+            for (int i = 0; i < m.pointCount; i++) {
+                PhysicsContactPoint& cp = m.points[i];
+                cp.rAX = cp.x - c.a->X(); cp.rAY = cp.y - c.a->Y();
+                cp.rBX = cp.x - c.b->X(); cp.rBY = cp.y - c.b->Y();
+
+                float rnA = Physics_Cross(cp.rAX, cp.rAY, nx, ny);
+                float rnB = Physics_Cross(cp.rBX, cp.rBY, nx, ny);
+                float kNormal = c.invMassA + c.invMassB + c.invInertiaA * rnA * rnA + c.invInertiaB * rnB * rnB;
+                cp.normalMass = kNormal > 0 ? 1.0f / kNormal : 0.0f;
+
+                float rtA = Physics_Cross(cp.rAX, cp.rAY, tx, ty);
+                float rtB = Physics_Cross(cp.rBX, cp.rBY, tx, ty);
+                float kTangent = c.invMassA + c.invMassB + c.invInertiaA * rtA * rtA + c.invInertiaB * rtB * rtB;
+                cp.tangentMass = kTangent > 0 ? 1.0f / kTangent : 0.0f;
+
+                float dvx, dvy;
+                Physics_ContactRelativeVelocity(c, cp, dvx, dvy);
+                float vn = Physics_Dot(dvx, dvy, nx, ny);
+                cp.velocityBias = cp.depth < 0 ? cp.depth / h : 0.0f;
+                if (vn < -g_restitutionThreshold) cp.velocityBias = fmaxf(cp.velocityBias, -m.restitution * vn);
+            }
+
+            // Two points on one face fight each other through the shared rotation when solved one
+            // at a time; solve them as a pair unless K is too ill-conditioned to invert
+            m.blockSolve = false;
+            if (m.pointCount == 2) {
+                const PhysicsContactPoint& p1 = m.points[0];
+                const PhysicsContactPoint& p2 = m.points[1];
+                float rn1A = Physics_Cross(p1.rAX, p1.rAY, nx, ny), rn1B = Physics_Cross(p1.rBX, p1.rBY, nx, ny);
+                float rn2A = Physics_Cross(p2.rAX, p2.rAY, nx, ny), rn2B = Physics_Cross(p2.rBX, p2.rBY, nx, ny);
+                float mass = c.invMassA + c.invMassB;
+                m.k11 = mass + c.invInertiaA * rn1A * rn1A + c.invInertiaB * rn1B * rn1B;
+                m.k22 = mass + c.invInertiaA * rn2A * rn2A + c.invInertiaB * rn2B * rn2B;
+                m.k12 = mass + c.invInertiaA * rn1A * rn2A + c.invInertiaB * rn1B * rn2B;
+                float det = m.k11 * m.k22 - m.k12 * m.k12;
+                if (m.k11 * m.k11 < 1000.0f * det) {
+                    float invDet = 1.0f / det;
+                    m.invK11 = m.k22 * invDet;
+                    m.invK12 = -m.k12 * invDet;
+                    m.invK22 = m.k11 * invDet;
+                    m.blockSolve = true;
+                }
+            }
+        }
 
-            if (tangentLen > 0.0001f) {
-                tangentX /= tangentLen;
-                tangentY /= tangentLen;
+        // Warm start only once every bounce target has seen the undisturbed approach speed
+        for (int ci = 0; ci < count; ci++) {
+            PhysicsSolverContact& c = contacts[ci];
+            PhysicsManifold& m = *c.m;
+            float nx = m.normalX, ny = m.normalY;
+            float tx = ny, ty = -nx;
+            for (int i = 0; i < m.pointCount; i++) {
+                PhysicsContactPoint& cp = m.points[i];
+                if (!g_physicsWarmStarting) {
+                    cp.normalImpulse = cp.tangentImpulse = 0;
+                    continue;
+                }
+                Physics_ApplyContactImpulse(c, cp,
+                    cp.normalImpulse * nx + cp.tangentImpulse * tx,
+                    cp.normalImpulse * ny + cp.tangentImpulse * ty);
+            }
+        }
+    }
+
+    // Both normal impulses at once: the totals x >= 0 with K x + b = vn >= 0 and x . vn = 0.
+    // Try both points pushing, then each alone, then neither; take the first that holds.
+    static void Physics_SolveContactBlock(PhysicsSolverContact& c) {
+        PhysicsManifold& m = *c.m;
+        PhysicsContactPoint& p1 = m.points[0];
+        PhysicsContactPoint& p2 = m.points[1];
+        float nx = m.normalX, ny = m.normalY;
+        float dvx, dvy;
+        Physics_ContactRelativeVelocity(c, p1, dvx, dvy);
+        float vn1 = Physics_Dot(dvx, dvy, nx, ny);
+        Physics_ContactRelativeVelocity(c, p2, dvx, dvy);
+        float vn2 = Physics_Dot(dvx, dvy, nx, ny);
+
+        float a1 = p1.normalImpulse, a2 = p2.normalImpulse;
+        float b1 = vn1 - p1.velocityBias - (m.k11 * a1 + m.k12 * a2);
+        float b2 = vn2 - p2.velocityBias - (m.k12 * a1 + m.k22 * a2);
+
+        float x1 = -(m.invK11 * b1 + m.invK12 * b2);
+        float x2 = -(m.invK12 * b1 + m.invK22 * b2);
+        if (x1 < 0 || x2 < 0) {
+            x1 = -p1.normalMass * b1; x2 = 0;
+            if (x1 < 0 || m.k12 * x1 + b2 < 0) {
+                x1 = 0; x2 = -p2.normalMass * b2;
+                if (x2 < 0 || m.k12 * x2 + b1 < 0) {
+                    x1 = x2 = 0;
+                    if (b1 < 0 || b2 < 0) return;
+                }
+            }
+        }
 
-                float jt = -Physics_Dot(relVelX, relVelY, tangentX, tangentY) / totalInvMass;
-                float mu = sqrtf(a.friction * b.friction);  // Friction coefficient
+        float d1 = x1 - a1, d2 = x2 - a2;
+        Physics_ApplyContactImpulse(c, p1, d1 * nx, d1 * ny);
+        Physics_ApplyContactImpulse(c, p2, d2 * nx, d2 * ny);
+        p1.normalImpulse = x1;
+        p2.normalImpulse = x2;
+    }
 
-                // Clamp friction impulse
-                float maxFriction = fabsf(j) * mu;
-                jt = fmaxf(-maxFriction, fminf(maxFriction, jt));
+    // One sequential-impulse pass; friction first so the non-penetration impulse has the last word
+    static void Physics_SolveContactVelocities(PhysicsSolverContact* contacts, int count) {
+        for (int ci = 0; ci < count; ci++) {
+            PhysicsSolverContact& c = contacts[ci];
+            PhysicsManifold& m = *c.m;
+            float nx = m.normalX, ny = m.normalY;
+            float tx = ny, ty = -nx;
+            for (int i = 0; i < m.pointCount; i++) {
+                PhysicsContactPoint& cp = m.points[i];
+                float dvx, dvy;
+                Physics_ContactRelativeVelocity(c, cp, dvx, dvy);
 
-                if (a.type != BODY_STATIC) {
-                    a.vx -= jt * invMassA * tangentX;
-                    a.vy -= jt * invMassA * tangentY;
+                float maxFriction = m.friction * cp.normalImpulse;
+                float lambda = -cp.tangentMass * Physics_Dot(dvx, dvy, tx, ty);
+                float total = fmaxf(-maxFriction, fminf(maxFriction, cp.tangentImpulse + lambda));
+                lambda = total - cp.tangentImpulse;
+                cp.tangentImpulse = total;
+                Physics_ApplyContactImpulse(c, cp, lambda * tx, lambda * ty);
+            }
+            if (m.blockSolve) {
+                Physics_SolveContactBlock(c);
+                continue;
+            }
+            for (int i = 0; i < m.pointCount; i++) {
+                PhysicsContactPoint& cp = m.points[i];
+                float dvx, dvy;
+                Physics_ContactRelativeVelocity(c, cp, dvx, dvy);
+
+                float lambda = -cp.normalMass * (Physics_Dot(dvx, dvy, nx, ny) - cp.velocityBias);
+                float total = fmaxf(cp.normalImpulse + lambda, 0.0f);
+                lambda = total - cp.normalImpulse;
+                cp.normalImpulse = total;
+                Physics_ApplyContactImpulse(c, cp, lambda * nx, lambda * ny);
+            }
+        }
+    }
+
+    // One pass of overlap removal. The current depth is the build-time depth less how far the
+    // two anchors have moved apart along the (fixed) normal since, with each anchor carried
+    // along by its body's translation and rotation. A manifold's points are measured before
+    // any of them pushes so a flat face settles without picking up a tilt.
+    static void Physics_SolveContactPositions(PhysicsSolverContact* contacts, int count) {
+        for (int ci = 0; ci < count; ci++) {
+            PhysicsSolverContact& c = contacts[ci];
+            PhysicsManifold& m = *c.m;
+            float nx = m.normalX, ny = m.normalY;
+            float ca = cosf(c.a->rotation - m.startRotA), sa = sinf(c.a->rotation - m.startRotA);
+            float cb = cosf(c.b->rotation - m.startRotB), sb = sinf(c.b->rotation - m.startRotB);
+            float push[2] = { 0, 0 }, rnA[2] = { 0, 0 }, rnB[2] = { 0, 0 };
+            for (int i = 0; i < m.pointCount; i++) {
+                const PhysicsContactPoint& cp = m.points[i];
+                float rAX = ca * cp.rAX - sa * cp.rAY, rAY = sa * cp.rAX + ca * cp.rAY;
+                float rBX = cb * cp.rBX - sb * cp.rBY, rBY = sb * cp.rBX + cb * cp.rBY;
+                float moved = Physics_Dot(
+                    (c.b->X() - m.startBX) - (c.a->X() - m.startAX) + (rBX - cp.rBX) - (rAX - cp.rAX),
+                    (c.b->Y() - m.startBY) - (c.a->Y() - m.startAY) + (rBY - cp.rBY) - (rAY - cp.rAY),
+                    nx, ny);
+                float depth = cp.depth - moved;
+                float correction = fminf(g_contactBaumgarte * (depth - g_contactLinearSlop), g_contactMaxCorrection);
+                if (correction <= 0) continue;
+
+                rnA[i] = Physics_Cross(rAX, rAY, nx, ny);
+                rnB[i] = Physics_Cross(rBX, rBY, nx, ny);
+                float k = c.invMassA + c.invMassB + c.invInertiaA * rnA[i] * rnA[i] + c.invInertiaB * rnB[i] * rnB[i];
+                if (k > 0) push[i] = correction / k;
+            }
+            bool moveA = c.invMassA + c.invInertiaA > 0, moveB = c.invMassB + c.invInertiaB > 0;
+            for (int i = 0; i < m.pointCount; i++) {
+                if (push[i] <= 0) continue;
+                if (moveA) {
+                    c.a->X() -= nx * push[i] * c.invMassA;
+                    c.a->Y() -= ny * push[i] * c.invMassA;
+                    c.a->rotation -= c.invInertiaA * rnA[i] * push[i];
                 }
-                if (b.type != BODY_STATIC) {
-                    b.vx += jt * invMassB * tangentX;
-                    b.vy += jt * invMassB * tangentY;
+                if (moveB) {
+                    c.b->X() += nx * push[i] * c.invMassB;
+                    c.b->Y() += ny * push[i] * c.invMassB;
+                    c.b->rotation += c.invInertiaB * rnB[i] * push[i];
                 }
             }
         }
     }
 
+    static int Physics_SolverIslandFind(int i) {
+        while (g_solverIslandParent[i] != i) {
+            g_solverIslandParent[i] = g_solverIslandParent[g_solverIslandParent[i]];
+            i = g_solverIslandParent[i];
+        }
+        return i;
+    }
+
+    // Index of a body that takes impulses, or -1; islandIndex is free scratch until UpdateSleep
+    static int Physics_SolverIslandBody(PhysicsBody* body, float invMass, float invInertia) {
+        if (invMass + invInertia <= 0) return -1;
+        if (body->islandIndex < 0) {
+            body->islandIndex = (int)g_solverIslandBodies.size();
+            g_solverIslandBodies.push_back(body);
+            g_solverIslandParent.push_back(body->islandIndex);
+        }
+        return body->islandIndex;
+    }
+
+    // Regroups g_physicsSolverContacts island by island, keeping their relative order, and
+    // fills g_solverIslandStart. Islands are numbered by first contact, so the layout is as
+    // stable as the contact order itself. Small scenes and a single thread keep one range.
+    static void Physics_BuildSolverIslands() {
+        auto& contacts = g_physicsSolverContacts;
+        int count = (int)contacts.size();
+        g_solverIslandStart.assign(1, 0);
+        if (g_physicsThreadCount <= 1 || count < PHYSICS_PARALLEL_MIN_CONTACTS) {
+            if (count > 0) g_solverIslandStart.push_back(count);
+            return;
+        }
+
+        g_solverIslandBodies.clear();
+        g_solverIslandParent.clear();
+        g_solverIslandOf.resize(count);
+        for (int i = 0; i < count; i++) {
+            const PhysicsSolverContact& c = contacts[i];
+            int a = Physics_SolverIslandBody(c.a, c.invMassA, c.invInertiaA);
+            int b = Physics_SolverIslandBody(c.b, c.invMassB, c.invInertiaB);
+            if (a >= 0 && b >= 0) {
+                int ra = Physics_SolverIslandFind(a), rb = Physics_SolverIslandFind(b);
+                if (ra != rb) g_solverIslandParent[std::max(ra, rb)] = std::min(ra, rb);
+            }
+            g_solverIslandOf[i] = a >= 0 ? a : b;
+        }
+
+        for (PhysicsBody* body : g_solverIslandBodies) body->islandIndex = -1;
+
+        // Number islands by first contact, then count and scatter stably
+        int islands = 0;
+        g_solverIslandLabel.assign(g_solverIslandBodies.size(), -1);
+        for (int i = 0; i < count; i++) {
+            int& id = g_solverIslandLabel[Physics_SolverIslandFind(g_solverIslandOf[i])];
+            if (id < 0) id = islands++;
+            g_solverIslandOf[i] = id;
+        }
+        g_solverIslandStart.assign(islands + 1, 0);
+        for (int i = 0; i < count; i++) g_solverIslandStart[g_solverIslandOf[i] + 1]++;
+        for (int k = 0; k < islands; k++) g_solverIslandStart[k + 1] += g_solverIslandStart[k];
+        g_solverIslandLabel.assign(g_solverIslandStart.begin(), g_solverIslandStart.end() - 1);  // Write cursors
+        g_solverIslandScratch.resize(count);
+        for (int i = 0; i < count; i++) g_solverIslandScratch[g_solverIslandLabel[g_solverIslandOf[i]]++] = contacts[i];
+        contacts.swap(g_solverIslandScratch);
+    }
+
+    // Runs fn(contacts, count) once per solver island across the workers
+    static void Physics_ForEachSolverIsland(const std::function<void(PhysicsSolverContact*, int)>& fn) {
+        int islands = (int)g_solverIslandStart.size() - 1;
+        Physics_ParallelFor(islands, [&fn](int island) {
+            int begin = g_solverIslandStart[island];
+            fn(g_physicsSolverContacts.data() + begin, g_solverIslandStart[island + 1] - begin);
+        });
+    }
+
+    // ========================================================================
+    // PHYSICS CCD - Time of impact for fast bodies
+    // ========================================================================
+    // Bodies opted in with SetBodyContinuous have their motion over the step swept against
+    // whatever the tree finds along the way. Conservative advancement walks the sweep forward
+    // by separation / closing speed, which can never overshoot, until the shapes are within
+    // a fraction of the linear slop; the body is then stopped at that pose and next step's
+    // speculative contact removes the approach velocity. Bodies that move less than half
+    // their own size per step skip all of this, since discrete contacts cannot miss.
+
+    static int g_physicsContinuousHits = 0;           // Bodies stopped at a time of impact last step
+    static std::vector<int> g_physicsContinuousCandidates;
+    static std::vector<std::pair<int, PhysicsBody*>> g_physicsContinuousBodies;
+
+    // Distance from the body origin to the farthest point of its shape
+    static float Physics_ShapeExtent(const PhysicsBody& body) {
+        float offset = Physics_Length(body.shapeOffsetX, body.shapeOffsetY);
+        if (body.shapeType == SHAPE_CIRCLE) return offset + body.shapeRadius;
+        if (body.shapeType == SHAPE_POLYGON && body.polygonVerts.size() >= 6) {
+            float extent = 0;
+            for (size_t i = 0; i + 1 < body.polygonVerts.size(); i += 2) {
+                extent = fmaxf(extent, Physics_Length(body.polygonVerts[i] + body.shapeOffsetX, body.polygonVerts[i + 1] + body.shapeOffsetY));
+            }
+            return extent;
+        }
+        return offset + 0.5f * Physics_Length(body.shapeWidth, body.shapeHeight);
+    }
+
+    // Half the thinnest dimension of the shape
+    static float Physics_ShapeCore(const PhysicsBody& body) {
+        if (body.shapeType == SHAPE_CIRCLE) return body.shapeRadius;
+        return 0.5f * fminf(body.shapeWidth, body.shapeHeight);
+    }
+
+    // Pose at fraction t of this step's motion; bodies that did not integrate stay put
+    static void Physics_SweepPose(const PhysicsBody& body, float t, float& x, float& y, float& rotation) {
+        x = body.X(); y = body.Y(); rotation = body.rotation;
+        if (!Physics_IsAwakeMover(body)) return;
+        x = body.SweepX() + (body.X() - body.SweepX()) * t;
+        y = body.SweepY() + (body.Y() - body.SweepY()) * t;
+        rotation = body.sweepRotation + (body.rotation - body.sweepRotation) * t;
+    }
+
+    // Lower bound on the gap between the two shapes at fraction t (negative when overlapping),
+    // and the axis it was measured on, from A to B. Exact for circles against anything; for two
+    // polygons it is the best SAT axis
+    static float Physics_SweepSeparation(const PhysicsBody& a, const PhysicsBody& b, float t, float& nx, float& ny) {
+        float ax, ay, ar, bx, by, br;
+        Physics_SweepPose(a, t, ax, ay, ar);
+        Physics_SweepPose(b, t, bx, by, br);
+        bool circleA = a.shapeType == SHAPE_CIRCLE;
+        bool circleB = b.shapeType == SHAPE_CIRCLE;
+        if (circleA && circleB) {
+            float cax, cay, cbx, cby;
+            Physics_ShapeCenterAt(a, ax, ay, ar, cax, cay);
+            Physics_ShapeCenterAt(b, bx, by, br, cbx, cby);
+            float dist = Physics_Length(cbx - cax, cby - cay);
+            if (dist > 0.0001f) { nx = (cbx - cax) / dist; ny = (cby - cay) / dist; }
+            else { nx = 1; ny = 0; }
+            return dist - a.shapeRadius - b.shapeRadius;
+        }
+
+        PhysicsPolygon polyA, polyB;
+        if (circleA || circleB) {
+            const PhysicsBody& circle = circleA ? a : b;
+            float cx, cy;
+            if (circleA) { Physics_ShapeCenterAt(a, ax, ay, ar, cx, cy); Physics_BuildPolygonAt(b, bx, by, br, polyA); }
+            else { Physics_ShapeCenterAt(b, bx, by, br, cx, cy); Physics_BuildPolygonAt(a, ax, ay, ar, polyA); }
+            int face = 0;
+            float separation = -1e30f;
+            for (int i = 0; i < polyA.count; i++) {
+                float s = Physics_Dot(polyA.nx[i], polyA.ny[i], cx - polyA.x[i], cy - polyA.y[i]);
+                if (s > separation) { separation = s; face = i; }
+            }
+            nx = polyA.nx[face];
+            ny = polyA.ny[face];
+            if (separation > 0) {
+                // Past the face's end the nearest point is its vertex
+                int v1 = face, v2 = (face + 1) % polyA.count;
+                int vertex = -1;
+                if (Physics_Dot(cx - polyA.x[v1], cy - polyA.y[v1], polyA.x[v2] - polyA.x[v1], polyA.y[v2] - polyA.y[v1]) <= 0) vertex = v1;
+                else if (Physics_Dot(cx - polyA.x[v2], cy - polyA.y[v2], polyA.x[v1] - polyA.x[v2], polyA.y[v1] - polyA.y[v2]) <= 0) vertex = v2;
+                if (vertex >= 0) {
+                    separation = Physics_Length(cx - polyA.x[vertex], cy - polyA.y[vertex]);
+                    if (separation > 0.0001f) { nx = (cx - polyA.x[vertex]) / separation; ny = (cy - polyA.y[vertex]) / separation; }
+                }
+            }
+            // Measured from the polygon towards the circle
+            if (circleA) { nx = -nx; ny = -ny; }
+            return separation - circle.shapeRadius;
+        }
+
+        Physics_BuildPolygonAt(a, ax, ay, ar, polyA);
+        Physics_BuildPolygonAt(b, bx, by, br, polyB);
+        int edgeA, edgeB;
+        float separationA = Physics_MaxSeparation(polyA, polyB, edgeA);
+        float separationB = Physics_MaxSeparation(polyB, polyA, edgeB);
+        if (separationA >= separationB) { nx = polyA.nx[edgeA]; ny = polyA.ny[edgeA]; return separationA; }
+        nx = -polyB.nx[edgeB];
+        ny = -polyB.ny[edgeB];
+        return separationB;
+    }
+
+    // First fraction of the step at which the pair comes within 'target' of touching, or 1
+    // when it never does. Pairs already that close at the start belong to the contact solver
+    static float Physics_TimeOfImpact(const PhysicsBody& a, const PhysicsBody& b, float target, float tolerance) {
+        float dax = 0, day = 0, dar = 0, dbx = 0, dby = 0, dbr = 0;
+        if (Physics_IsAwakeMover(a)) { dax = a.X() - a.SweepX(); day = a.Y() - a.SweepY(); dar = a.rotation - a.sweepRotation; }
+        if (Physics_IsAwakeMover(b)) { dbx = b.X() - b.SweepX(); dby = b.Y() - b.SweepY(); dbr = b.rotation - b.sweepRotation; }
+        float rx = dax - dbx, ry = day - dby;
+        float swing = fabsf(dar) * Physics_ShapeExtent(a) + fabsf(dbr) * Physics_ShapeExtent(b);
+        if (Physics_Length(rx, ry) + swing <= 0.0001f) return 1.0f;
+
+        float t = 0;
+        for (int iter = 0; iter < 30; iter++) {
+            float nx, ny;
+            float separation = Physics_SweepSeparation(a, b, t, nx, ny);
+            if (separation <= target + tolerance) return iter == 0 ? 1.0f : t;
+            // Closing speed bound per unit of t: relative translation along the separating axis
+            // plus each shape's swing. Translation alone cannot close a gap it moves away from
+            float bound = Physics_Dot(rx, ry, nx, ny) + swing;
+            if (bound <= 0.0001f) return 1.0f;
+            t += (separation - target) / bound;
+            if (t >= 1.0f) return 1.0f;
+        }
+        return 1.0f;  // Never got within reach: no hit rather than a stop short of contact
+    }
+
+    static void Physics_SolveContinuous() {
+        g_physicsContinuousHits = 0;
+        float target = 0.5f * g_contactLinearSlop;
+        float tolerance = 0.25f * g_contactLinearSlop;
+        std::vector<int>& candidates = g_physicsContinuousCandidates;
+
+        // A body stopped early is a target for the sweeps after it, so the order matters
+        std::vector<std::pair<int, PhysicsBody*>>& movers = g_physicsContinuousBodies;
+        movers.clear();
+        for (auto& kv : g_physicsBodies) {
+            PhysicsBody& body = kv.second;
+            if (body.ccdMode == PHYSICS_CCD_NONE || body.type != BODY_DYNAMIC || body.isTrigger || !Physics_IsAwakeMover(body)) continue;
+            float motion = Physics_Length(body.X() - body.SweepX(), body.Y() - body.SweepY()) +
+                fabsf(body.rotation - body.sweepRotation) * Physics_ShapeExtent(body);
+            if (motion >= 0.5f * Physics_ShapeCore(body)) movers.push_back({ kv.first, &body });
+        }
+        if (g_physicsDeterministic) std::sort(movers.begin(), movers.end());
+
+        for (const auto& mover : movers) {
+            PhysicsBody& body = *mover.second;
+            float extent = Physics_ShapeExtent(body);
+
+            // Everything the sweep could touch: end box plus the reach around the start pose
+            PhysicsAABB swept = Physics_BodyAABB(body);
+            swept = PhysicsAABB::Combine(swept, { body.SweepX() - extent, body.SweepY() - extent, body.SweepX() + extent, body.SweepY() + extent });
+            candidates.clear();
+            Physics_QueryTree().Query(swept, candidates);
+
+            float toi = 1.0f;
+            for (int handle : candidates) {
+                if (handle == mover.first) continue;
+                const PhysicsBody& other = g_physicsBodies.find(handle)->second;
+                if (!other.valid || other.isTrigger) continue;
+                if (!(body.layer & other.mask) || !(other.layer & body.mask)) continue;
+                if (other.type == BODY_DYNAMIC && body.ccdMode != PHYSICS_CCD_DYNAMIC) continue;
+                toi = fminf(toi, Physics_TimeOfImpact(body, other, target, tolerance));
+            }
+            if (toi >= 1.0f) continue;
+
+            // The rest of the step's motion is dropped; the velocity stays for the contact solver
+            Physics_SweepPose(body, toi, body.X(), body.Y(), body.rotation);
+            g_physicsContinuousHits++;
+        }
+    }
+
     // World settings
     void Framework_Physics_SetGravity(float gx, float gy) {
         g_gravityX = gx;
@@ -8194,18 +12684,21 @@ extern "C" {
         if (bodyType < BODY_STATIC || bodyType > BODY_KINEMATIC) {
             return -1;
         }
-        PhysicsBody body;
-        body.handle = g_physicsNextHandle++;
+        int handle = g_physicsNextHandle++;
+        PhysicsBody& body = g_physicsBodies[handle];
+        body.handle = handle;
         body.type = bodyType;
-        body.x = x;
-        body.y = y;
+        Physics_AttachSlot(body);
+        body.X() = x;
+        body.Y() = y;
 
         if (bodyType == BODY_STATIC) {
-            body.invMass = 0;
+            body.InvMass() = 0;
             body.invInertia = 0;
         }
 
-        g_physicsBodies[body.handle] = body;
+        g_physicsBroadphase.queryDirty = true;
+        g_physicsMoversDirty = true;
         return body.handle;
     }
 
@@ -8215,7 +12708,12 @@ extern "C" {
             if (it->second.boundEntity >= 0) {
                 g_entityToBody.erase(it->second.boundEntity);
             }
+            Physics_WakeBody(it->second);
+            Physics_WakeNeighbors(it->second);  // Whatever rested on it has to fall
+            Physics_RemoveProxy(it->second);
+            Physics_DetachSlot(it->second);
             g_physicsBodies.erase(it);
+            g_physicsMoversDirty = true;
         }
     }
 
@@ -8225,23 +12723,32 @@ extern "C" {
     }
 
     void Framework_Physics_DestroyAllBodies() {
+        Physics_ResetBroadphase();
         g_physicsBodies.clear();
+        Physics_ClearSlots();
+        g_sleepingIslands.clear();
+        g_physicsContactEdges.clear();
+        g_physicsManifolds.clear();
         g_entityToBody.clear();
         g_activeCollisions.clear();
         g_prevCollisions.clear();
+        g_physicsSyncQueue.clear();
+        g_physicsMoversDirty = true;
     }
 
     // Body type
     void Framework_Physics_SetBodyType(int bodyHandle, int bodyType) {
         auto it = g_physicsBodies.find(bodyHandle);
         if (it == g_physicsBodies.end()) return;
+        Physics_WakeBody(it->second);
         it->second.type = bodyType;
+        g_physicsMoversDirty = true;
         if (bodyType == BODY_STATIC) {
-            it->second.invMass = 0;
+            it->second.InvMass() = 0;
             it->second.invInertia = 0;
-            it->second.vx = it->second.vy = 0;
+            it->second.VX() = it->second.VY() = 0;
         } else {
-            it->second.invMass = 1.0f / it->second.mass;
+            it->second.InvMass() = 1.0f / it->second.mass;
             it->second.invInertia = 1.0f / it->second.inertia;
         }
     }
@@ -8254,20 +12761,35 @@ extern "C" {
     // Body transform
     void Framework_Physics_SetBodyPosition(int bodyHandle, float x, float y) {
         auto it = g_physicsBodies.find(bodyHandle);
-        if (it != g_physicsBodies.end()) { it->second.x = x; it->second.y = y; }
+        if (it != g_physicsBodies.end()) {
+            Physics_WakeNeighbors(it->second);
+            it->second.X() = x;
+            it->second.Y() = y;
+            Physics_WakeBody(it->second);
+            Physics_QueueSync(it->second);
+            g_physicsBroadphase.queryDirty = true;
+            Physics_WakeNeighbors(it->second);
+        }
     }
 
     void Framework_Physics_GetBodyPosition(int bodyHandle, float* x, float* y) {
         auto it = g_physicsBodies.find(bodyHandle);
         if (it != g_physicsBodies.end()) {
-            if (x) *x = it->second.x;
-            if (y) *y = it->second.y;
+            if (x) *x = it->second.X();
+            if (y) *y = it->second.Y();
         }
     }
 
     void Framework_Physics_SetBodyRotation(int bodyHandle, float radians) {
         auto it = g_physicsBodies.find(bodyHandle);
-        if (it != g_physicsBodies.end()) { it->second.rotation = radians; }
+        if (it != g_physicsBodies.end()) {
+            Physics_WakeNeighbors(it->second);
+            it->second.rotation = radians;
+            Physics_WakeBody(it->second);
+            Physics_QueueSync(it->second);
+            g_physicsBroadphase.queryDirty = true;
+            Physics_WakeNeighbors(it->second);
+        }
     }
 
     float Framework_Physics_GetBodyRotation(int bodyHandle) {
@@ -8278,20 +12800,20 @@ extern "C" {
     // Body dynamics
     void Framework_Physics_SetBodyVelocity(int bodyHandle, float vx, float vy) {
         auto it = g_physicsBodies.find(bodyHandle);
-        if (it != g_physicsBodies.end()) { it->second.vx = vx; it->second.vy = vy; }
+        if (it != g_physicsBodies.end()) { it->second.VX() = vx; it->second.VY() = vy; Physics_WakeBody(it->second); }
     }
 
     void Framework_Physics_GetBodyVelocity(int bodyHandle, float* vx, float* vy) {
         auto it = g_physicsBodies.find(bodyHandle);
         if (it != g_physicsBodies.end()) {
-            if (vx) *vx = it->second.vx;
-            if (vy) *vy = it->second.vy;
+            if (vx) *vx = it->second.VX();
+            if (vy) *vy = it->second.VY();
         }
     }
 
     void Framework_Physics_SetBodyAngularVelocity(int bodyHandle, float omega) {
         auto it = g_physicsBodies.find(bodyHandle);
-        if (it != g_physicsBodies.end()) { it->second.angularVelocity = omega; }
+        if (it != g_physicsBodies.end()) { it->second.angularVelocity = omega; Physics_WakeBody(it->second); }
     }
 
     float Framework_Physics_GetBodyAngularVelocity(int bodyHandle) {
@@ -8302,30 +12824,30 @@ extern "C" {
     void Framework_Physics_ApplyForce(int bodyHandle, float fx, float fy) {
         auto it = g_physicsBodies.find(bodyHandle);
         if (it != g_physicsBodies.end() && it->second.type != BODY_STATIC) {
-            it->second.forceX += fx;
-            it->second.forceY += fy;
-            it->second.awake = true;
+            it->second.ForceX() += fx;
+            it->second.ForceY() += fy;
+            Physics_WakeBody(it->second);
         }
     }
 
     void Framework_Physics_ApplyForceAtPoint(int bodyHandle, float fx, float fy, float px, float py) {
         auto it = g_physicsBodies.find(bodyHandle);
         if (it == g_physicsBodies.end() || it->second.type == BODY_STATIC) return;
-        it->second.forceX += fx;
-        it->second.forceY += fy;
+        it->second.ForceX() += fx;
+        it->second.ForceY() += fy;
         // Calculate torque from force at point
-        float rx = px - it->second.x;
-        float ry = py - it->second.y;
+        float rx = px - it->second.X();
+        float ry = py - it->second.Y();
         it->second.torque += Physics_Cross(rx, ry, fx, fy);
-        it->second.awake = true;
+        Physics_WakeBody(it->second);
     }
 
     void Framework_Physics_ApplyImpulse(int bodyHandle, float ix, float iy) {
         auto it = g_physicsBodies.find(bodyHandle);
         if (it != g_physicsBodies.end() && it->second.type != BODY_STATIC) {
-            it->second.vx += ix * it->second.invMass;
-            it->second.vy += iy * it->second.invMass;
-            it->second.awake = true;
+            it->second.VX() += ix * it->second.InvMass();
+            it->second.VY() += iy * it->second.InvMass();
+            Physics_WakeBody(it->second);
         }
     }
 
@@ -8333,7 +12855,7 @@ extern "C" {
         auto it = g_physicsBodies.find(bodyHandle);
         if (it != g_physicsBodies.end() && it->second.type != BODY_STATIC) {
             it->second.torque += torque;
-            it->second.awake = true;
+            Physics_WakeBody(it->second);
         }
     }
 
@@ -8341,9 +12863,12 @@ extern "C" {
     void Framework_Physics_SetBodyMass(int bodyHandle, float mass) {
         auto it = g_physicsBodies.find(bodyHandle);
         if (it != g_physicsBodies.end()) {
+            float oldMass = it->second.mass;
             it->second.mass = mass > 0.0001f ? mass : 0.0001f;
+            it->second.inertia *= it->second.mass / oldMass;  // Shapes set inertia for the mass they saw
             if (it->second.type != BODY_STATIC) {
-                it->second.invMass = 1.0f / it->second.mass;
+                it->second.InvMass() = 1.0f / it->second.mass;
+                it->second.invInertia = 1.0f / it->second.inertia;
             }
         }
     }
@@ -8375,17 +12900,17 @@ extern "C" {
 
     void Framework_Physics_SetBodyGravityScale(int bodyHandle, float scale) {
         auto it = g_physicsBodies.find(bodyHandle);
-        if (it != g_physicsBodies.end()) { it->second.gravityScale = scale; }
+        if (it != g_physicsBodies.end()) { it->second.GravityScale() = scale; }
     }
 
     float Framework_Physics_GetBodyGravityScale(int bodyHandle) {
         auto it = g_physicsBodies.find(bodyHandle);
-        return (it != g_physicsBodies.end()) ? it->second.gravityScale : 1.0f;
+        return (it != g_physicsBodies.end()) ? it->second.GravityScale() : 1.0f;
     }
 
     void Framework_Physics_SetBodyLinearDamping(int bodyHandle, float damping) {
         auto it = g_physicsBodies.find(bodyHandle);
-        if (it != g_physicsBodies.end()) { it->second.linearDamping = fmaxf(0, damping); }
+        if (it != g_physicsBodies.end()) { it->second.LinearDamping() = fmaxf(0, damping); }
     }
 
     void Framework_Physics_SetBodyAngularDamping(int bodyHandle, float damping) {
@@ -8405,12 +12930,15 @@ extern "C" {
 
     void Framework_Physics_SetBodySleepingAllowed(int bodyHandle, bool allowed) {
         auto it = g_physicsBodies.find(bodyHandle);
-        if (it != g_physicsBodies.end()) { it->second.sleepingAllowed = allowed; }
+        if (it != g_physicsBodies.end()) {
+            it->second.sleepingAllowed = allowed;
+            if (!allowed) Physics_WakeBody(it->second);
+        }
     }
 
     void Framework_Physics_WakeBody(int bodyHandle) {
         auto it = g_physicsBodies.find(bodyHandle);
-        if (it != g_physicsBodies.end()) { it->second.awake = true; }
+        if (it != g_physicsBodies.end()) { Physics_WakeBody(it->second); }
     }
 
     bool Framework_Physics_IsBodyAwake(int bodyHandle) {
@@ -8430,6 +12958,7 @@ extern "C" {
         it->second.shapeRadius = radius;
         it->second.shapeOffsetX = offsetX;
         it->second.shapeOffsetY = offsetY;
+        g_physicsBroadphase.queryDirty = true;
         // Update inertia for circle: I = 0.5 * m * r^2
         it->second.inertia = 0.5f * it->second.mass * radius * radius;
         if (it->second.type != BODY_STATIC) {
@@ -8449,6 +12978,7 @@ extern "C" {
         it->second.shapeHeight = height;
         it->second.shapeOffsetX = offsetX;
         it->second.shapeOffsetY = offsetY;
+        g_physicsBroadphase.queryDirty = true;
         // Update inertia for box: I = (1/12) * m * (w^2 + h^2)
         it->second.inertia = (1.0f / 12.0f) * it->second.mass * (width * width + height * height);
         if (it->second.type != BODY_STATIC) {
@@ -8456,25 +12986,66 @@ extern "C" {
         }
     }
 
+    // Vertices are body-local; the collision shape is their convex hull
     void Framework_Physics_SetBodyPolygon(int bodyHandle, const float* vertices, int vertexCount) {
         auto it = g_physicsBodies.find(bodyHandle);
         // Validate inputs: need at least 3 vertices, max 64 to prevent excessive memory
-        constexpr int MAX_POLYGON_VERTS = 64;
-        if (it == g_physicsBodies.end() || !vertices || vertexCount < 3 || vertexCount > MAX_POLYGON_VERTS) return;
-        it->second.shapeType = SHAPE_POLYGON;
-        it->second.polygonVerts.clear();
-        it->second.polygonVerts.assign(vertices, vertices + vertexCount * 2);
-        // Calculate bounding box for AABB approximation
-        float minX = vertices[0], maxX = vertices[0];
-        float minY = vertices[1], maxY = vertices[1];
-        for (int i = 1; i < vertexCount; i++) {
-            minX = fminf(minX, vertices[i * 2]);
-            maxX = fmaxf(maxX, vertices[i * 2]);
-            minY = fminf(minY, vertices[i * 2 + 1]);
-            maxY = fmaxf(maxY, vertices[i * 2 + 1]);
-        }
-        it->second.shapeWidth = maxX - minX;
-        it->second.shapeHeight = maxY - minY;
+        if (it == g_physicsBodies.end() || !vertices || vertexCount < 3 || vertexCount > PHYSICS_MAX_POLYGON_VERTS) return;
+
+        // Monotone chain hull, wound for a positive signed area
+        std::vector<std::pair<float, float>> pts(vertexCount);
+        for (int i = 0; i < vertexCount; i++) pts[i] = { vertices[i * 2], vertices[i * 2 + 1] };
+        std::sort(pts.begin(), pts.end());
+        pts.erase(std::unique(pts.begin(), pts.end()), pts.end());
+        auto turn = [](const std::pair<float, float>& o, const std::pair<float, float>& a, const std::pair<float, float>& b) {
+            return Physics_Cross(a.first - o.first, a.second - o.second, b.first - o.first, b.second - o.second);
+        };
+        std::vector<std::pair<float, float>> hull(pts.size() * 2);
+        int k = 0;
+        for (size_t i = 0; i < pts.size(); i++) {
+            while (k >= 2 && turn(hull[k - 2], hull[k - 1], pts[i]) <= 0) k--;
+            hull[k++] = pts[i];
+        }
+        for (int i = (int)pts.size() - 2, lower = k + 1; i >= 0; i--) {
+            while (k >= lower && turn(hull[k - 2], hull[k - 1], pts[i]) <= 0) k--;
+            hull[k++] = pts[i];
+        }
+        k--;
+        if (k < 3) return;  // Degenerate
+
+        PhysicsBody& body = it->second;
+        body.shapeType = SHAPE_POLYGON;
+        body.polygonVerts.clear();
+        float minX = hull[0].first, maxX = hull[0].first;
+        float minY = hull[0].second, maxY = hull[0].second;
+        float area = 0, inertia = 0;
+        for (int i = 0; i < k; i++) {
+            const auto& p = hull[i];
+            const auto& q = hull[(i + 1) % k];
+            body.polygonVerts.push_back(p.first);
+            body.polygonVerts.push_back(p.second);
+            minX = fminf(minX, p.first); maxX = fmaxf(maxX, p.first);
+            minY = fminf(minY, p.second); maxY = fmaxf(maxY, p.second);
+            float cross = Physics_Cross(p.first, p.second, q.first, q.second);
+            area += cross;
+            inertia += cross * (Physics_Dot(p.first, p.second, p.first, p.second) +
+                Physics_Dot(p.first, p.second, q.first, q.second) + Physics_Dot(q.first, q.second, q.first, q.second));
+        }
+        body.shapeWidth = maxX - minX;
+        body.shapeHeight = maxY - minY;
+        g_physicsBroadphase.queryDirty = true;
+
+        // Inertia about the body origin for uniform density: I = m * sum(cross * (p.p + p.q + q.q)) / (6 * sum(cross))
+        if (area > 0.0001f) body.inertia = body.mass * inertia / (6.0f * area);
+        if (body.type != BODY_STATIC) {
+            body.invInertia = 1.0f / body.inertia;
+        }
+    }
+
+    int Framework_Physics_GetBodyPolygonVertexCount(int bodyHandle) {
+        auto it = g_physicsBodies.find(bodyHandle);
+        if (it == g_physicsBodies.end() || it->second.shapeType != SHAPE_POLYGON) return 0;
+        return (int)it->second.polygonVerts.size() / 2;
     }
 
     int Framework_Physics_GetBodyShapeType(int bodyHandle) {
@@ -8516,7 +13087,9 @@ extern "C" {
         it->second.boundEntity = entityId;
         if (entityId >= 0) {
             g_entityToBody[entityId] = bodyHandle;
+            Physics_QueueSync(it->second);
         }
+        g_physicsMoversDirty = true;  // Bound movers are listed apart
     }
 
     int Framework_Physics_GetBoundEntity(int bodyHandle) {
@@ -8547,283 +13120,477 @@ extern "C" {
     void Framework_Physics_SetTriggerEnterCallback(PhysicsCollisionCallback callback) { g_onTriggerEnter = callback; }
     void Framework_Physics_SetTriggerExitCallback(PhysicsCollisionCallback callback) { g_onTriggerExit = callback; }
 
-    // Physics queries
-    int Framework_Physics_RaycastFirst(float startX, float startY, float dirX, float dirY, float maxDist,
-        float* hitX, float* hitY, float* hitNormalX, float* hitNormalY) {
-        Physics_Normalize(dirX, dirY);
-        float closestT = maxDist;
-        int closestBody = -1;
-        float closestNX = 0, closestNY = 0;
-
-        for (auto& kv : g_physicsBodies) {
-            const PhysicsBody& body = kv.second;
-            if (!body.valid) continue;
-
-            // Simple ray-AABB intersection for now
-            float minX, minY, maxX, maxY;
-            Physics_GetAABB(body, minX, minY, maxX, maxY);
+    // Physics queries: the tree culls by fat box, then each candidate gets an exact shape test
+    namespace {
+        int Physics_RaycastClosest(float startX, float startY, float dirX, float dirY, float maxDist,
+            float& hitT, float& hitNX, float& hitNY) {
+            Physics_Normalize(dirX, dirY);
+            int closest = -1;
+            Physics_QueryTree().RayCast(startX, startY, dirX, dirY, maxDist, [&](int handle, float maxT) {
+                const PhysicsBody& body = g_physicsBodies.find(handle)->second;
+                float t, nx, ny;
+                if (!body.valid || !Physics_RayCastBody(body, startX, startY, dirX, dirY, maxT, t, nx, ny)) return maxT;
+                if (closest >= 0 && t == maxT && handle > closest) return maxT;  // Ties go to the lower handle
+                closest = handle;
+                hitT = t; hitNX = nx; hitNY = ny;
+                return t;
+            });
+            return closest;
+        }
+
+        // Every body the ray crosses, nearest first, in g_physicsBroadphase.rayHits
+        void Physics_RaycastEvery(float startX, float startY, float dirX, float dirY, float maxDist) {
+            std::vector<std::pair<float, int>>& hits = g_physicsBroadphase.rayHits;
+            hits.clear();
+            Physics_Normalize(dirX, dirY);
+            Physics_QueryTree().RayCast(startX, startY, dirX, dirY, maxDist, [&](int handle, float maxT) {
+                const PhysicsBody& body = g_physicsBodies.find(handle)->second;
+                float t, nx, ny;
+                if (body.valid && Physics_RayCastBody(body, startX, startY, dirX, dirY, maxT, t, nx, ny)) hits.push_back({ t, handle });
+                return maxT;
+            });
+            std::sort(hits.begin(), hits.end());
+        }
 
-            float tmin = 0, tmax = maxDist;
-            float nx = 0, ny = 0;
+        // Writes the bodies overlapping 'probe' (layers ignored) and returns how many fit
+        int Physics_QueryShape(const PhysicsBody& probe, int* bodyBuffer, int bufferSize) {
+            if (!bodyBuffer || bufferSize <= 0) return 0;
+            std::vector<int>& candidates = g_physicsBroadphase.hits;
+            candidates.clear();
+            Physics_QueryTree().Query(Physics_BodyAABB(probe), candidates);
+            std::sort(candidates.begin(), candidates.end());
+            int count = 0;
+            PhysicsManifold m;
+            for (int handle : candidates) {
+                if (count >= bufferSize) break;
+                const PhysicsBody& body = g_physicsBodies.find(handle)->second;
+                if (body.valid && Physics_CollideShapes(probe, body, m, 0.0f)) bodyBuffer[count++] = handle;
+            }
+            return count;
+        }
 
-            // X slab
-            if (fabsf(dirX) > 0.0001f) {
-                float t1 = (minX - startX) / dirX;
-                float t2 = (maxX - startX) / dirX;
-                if (t1 > t2) { float tmp = t1; t1 = t2; t2 = tmp; }
-                if (t1 > tmin) { tmin = t1; nx = -dirX / fabsf(dirX); ny = 0; }
-                if (t2 < tmax) tmax = t2;
-            } else if (startX < minX || startX > maxX) continue;
+        PhysicsBody Physics_CircleProbe(float x, float y, float radius) {
+            PhysicsBody probe;
+            probe.X() = x; probe.Y() = y;
+            probe.shapeType = SHAPE_CIRCLE;
+            probe.shapeRadius = fmaxf(radius, 0.0f);
+            return probe;
+        }
 
-            // Y slab
-            if (fabsf(dirY) > 0.0001f) {
-                float t1 = (minY - startY) / dirY;
-                float t2 = (maxY - startY) / dirY;
-                if (t1 > t2) { float tmp = t1; t1 = t2; t2 = tmp; }
-                if (t1 > tmin) { tmin = t1; nx = 0; ny = -dirY / fabsf(dirY); }
-                if (t2 < tmax) tmax = t2;
-            } else if (startY < minY || startY > maxY) continue;
+        PhysicsBody Physics_BoxProbe(float x, float y, float width, float height) {
+            PhysicsBody probe;
+            probe.X() = x; probe.Y() = y;
+            probe.shapeType = SHAPE_BOX;
+            probe.shapeWidth = fmaxf(width, 0.0f);
+            probe.shapeHeight = fmaxf(height, 0.0f);
+            return probe;
+        }
 
-            if (tmin <= tmax && tmin > 0 && tmin < closestT) {
-                closestT = tmin;
-                closestBody = kv.first;
-                closestNX = nx;
-                closestNY = ny;
+        // Batched shape queries pack each query's hits after the previous one's
+        int Physics_QueryBatch(const float* shapes, int stride, int shapeCount, int* bodyBuffer, int bufferSize, int* resultCounts,
+            PhysicsBody (*makeProbe)(const float*)) {
+            if (!shapes || shapeCount <= 0) return 0;
+            int written = 0;
+            for (int i = 0; i < shapeCount; i++) {
+                int n = Physics_QueryShape(makeProbe(shapes + i * stride), bodyBuffer ? bodyBuffer + written : nullptr, bufferSize - written);
+                if (resultCounts) resultCounts[i] = n;
+                written += n;
             }
+            return written;
         }
+    }
 
+    int Framework_Physics_RaycastFirst(float startX, float startY, float dirX, float dirY, float maxDist,
+        float* hitX, float* hitY, float* hitNormalX, float* hitNormalY) {
+        float t = 0, nx = 0, ny = 0;
+        int closestBody = Physics_RaycastClosest(startX, startY, dirX, dirY, maxDist, t, nx, ny);
         if (closestBody >= 0) {
-            if (hitX) *hitX = startX + dirX * closestT;
-            if (hitY) *hitY = startY + dirY * closestT;
-            if (hitNormalX) *hitNormalX = closestNX;
-            if (hitNormalY) *hitNormalY = closestNY;
+            Physics_Normalize(dirX, dirY);
+            if (hitX) *hitX = startX + dirX * t;
+            if (hitY) *hitY = startY + dirY * t;
+            if (hitNormalX) *hitNormalX = nx;
+            if (hitNormalY) *hitNormalY = ny;
         }
         return closestBody;
     }
 
+    // Hits come back nearest first
     int Framework_Physics_RaycastAll(float startX, float startY, float dirX, float dirY, float maxDist,
         int* bodyBuffer, int bufferSize) {
         if (!bodyBuffer || bufferSize <= 0) return 0;
-        Physics_Normalize(dirX, dirY);
+        Physics_RaycastEvery(startX, startY, dirX, dirY, maxDist);
         int count = 0;
-
-        for (auto& kv : g_physicsBodies) {
+        for (const auto& hit : g_physicsBroadphase.rayHits) {
             if (count >= bufferSize) break;
-            const PhysicsBody& body = kv.second;
-            if (!body.valid) continue;
+            bodyBuffer[count++] = hit.second;
+        }
+        return count;
+    }
+
+    int Framework_Physics_QueryCircle(float x, float y, float radius, int* bodyBuffer, int bufferSize) {
+        return Physics_QueryShape(Physics_CircleProbe(x, y, radius), bodyBuffer, bufferSize);
+    }
 
-            float minX, minY, maxX, maxY;
-            Physics_GetAABB(body, minX, minY, maxX, maxY);
+    int Framework_Physics_QueryBox(float x, float y, float width, float height, int* bodyBuffer, int bufferSize) {
+        return Physics_QueryShape(Physics_BoxProbe(x, y, width, height), bodyBuffer, bufferSize);
+    }
+
+    // rays: startX, startY, dirX, dirY, maxDist per ray. hitBodies gets the first body or -1,
+    // hitData (optional) hitX, hitY, normalX, normalY, distance; returns the number of rays that hit
+    int Framework_Physics_RaycastBatch(const float* rays, int rayCount, int* hitBodies, float* hitData) {
+        if (!rays || !hitBodies || rayCount <= 0) return 0;
+        int hitCount = 0;
+        for (int i = 0; i < rayCount; i++) {
+            const float* r = rays + i * 5;
+            float* out = hitData ? hitData + i * 5 : nullptr;
+            float t = 0, nx = 0, ny = 0;
+            int body = Physics_RaycastClosest(r[0], r[1], r[2], r[3], r[4], t, nx, ny);
+            hitBodies[i] = body;
+            if (body < 0) {
+                if (out) { out[0] = out[1] = out[2] = out[3] = out[4] = 0.0f; }
+                continue;
+            }
+            hitCount++;
+            if (out) {
+                float dx = r[2], dy = r[3];
+                Physics_Normalize(dx, dy);
+                out[0] = r[0] + dx * t;
+                out[1] = r[1] + dy * t;
+                out[2] = nx;
+                out[3] = ny;
+                out[4] = t;
+            }
+        }
+        return hitCount;
+    }
+
+    // circles: x, y, radius per query. Results are packed into bodyBuffer one query after
+    // another, with resultCounts[i] bodies for query i; returns the total written
+    int Framework_Physics_QueryCircleBatch(const float* circles, int circleCount, int* bodyBuffer, int bufferSize, int* resultCounts) {
+        return Physics_QueryBatch(circles, 3, circleCount, bodyBuffer, bufferSize, resultCounts,
+            [](const float* c) { return Physics_CircleProbe(c[0], c[1], c[2]); });
+    }
 
-            // Ray-AABB test
-            float tmin = 0, tmax = maxDist;
-            if (fabsf(dirX) > 0.0001f) {
-                float t1 = (minX - startX) / dirX;
-                float t2 = (maxX - startX) / dirX;
-                if (t1 > t2) { float tmp = t1; t1 = t2; t2 = tmp; }
-                tmin = fmaxf(tmin, t1);
-                tmax = fminf(tmax, t2);
-            } else if (startX < minX || startX > maxX) continue;
+    // boxes: centerX, centerY, width, height per query, packed like QueryCircleBatch
+    int Framework_Physics_QueryBoxBatch(const float* boxes, int boxCount, int* bodyBuffer, int bufferSize, int* resultCounts) {
+        return Physics_QueryBatch(boxes, 4, boxCount, bodyBuffer, bufferSize, resultCounts,
+            [](const float* b) { return Physics_BoxProbe(b[0], b[1], b[2], b[3]); });
+    }
 
-            if (fabsf(dirY) > 0.0001f) {
-                float t1 = (minY - startY) / dirY;
-                float t2 = (maxY - startY) / dirY;
-                if (t1 > t2) { float tmp = t1; t1 = t2; t2 = tmp; }
-                tmin = fmaxf(tmin, t1);
-                tmax = fminf(tmax, t2);
-            } else if (startY < minY || startY > maxY) continue;
+    bool Framework_Physics_TestOverlap(int bodyA, int bodyB) {
+        auto itA = g_physicsBodies.find(bodyA);
+        auto itB = g_physicsBodies.find(bodyB);
+        if (itA == g_physicsBodies.end() || itB == g_physicsBodies.end()) return false;
 
-            if (tmin <= tmax && tmin > 0) {
-                bodyBuffer[count++] = kv.first;
-            }
-        }
-        return count;
+        float nx, ny, depth;
+        return Physics_TestCollision(itA->second, itB->second, nx, ny, depth);
     }
 
-    int Framework_Physics_QueryCircle(float x, float y, float radius, int* bodyBuffer, int bufferSize) {
-        if (!bodyBuffer || bufferSize <= 0) return 0;
-        int count = 0;
+    // Simulation: one fixed step of length h
+    static void Physics_StepOnce(float h) {
+        if (!g_physicsEnabled || h <= 0) return;
+        g_physicsStepCount++;
 
-        for (auto& kv : g_physicsBodies) {
-            if (count >= bufferSize) break;
-            const PhysicsBody& body = kv.second;
-            if (!body.valid) continue;
+        // Integrate forces for dynamic bodies
+        if (g_physicsMoversDirty) Physics_GatherMovers();
+        Physics_IntegrateForces(h);
 
-            float minX, minY, maxX, maxY;
-            Physics_GetAABB(body, minX, minY, maxX, maxY);
+        // Candidate pairs from the broadphase
+        Physics_FindPairs();
 
-            // Expand AABB by radius and check point
-            if (x >= minX - radius && x <= maxX + radius && y >= minY - radius && y <= maxY + radius) {
-                bodyBuffer[count++] = kv.first;
+        // Build this step's manifolds on the workers, then merge them and fire callbacks here in
+        // candidate order, which is the same at any thread count
+        g_activeCollisions.clear();
+        g_physicsStepStamp++;
+        Physics_Narrowphase(g_contactLinearSlop);
+
+        for (size_t i = 0; i < g_physicsBroadphase.pairs.size(); i++) {
+            if (!g_physicsNarrowResults[i].touching) continue;
+            const auto& candidate = g_physicsBroadphase.pairs[i];
+            int hA = std::min(candidate.first, candidate.second);
+            int hB = std::max(candidate.first, candidate.second);
+            auto itA = g_physicsBodies.find(hA);
+            auto itB = g_physicsBodies.find(hB);
+            if (itA == g_physicsBodies.end() || itB == g_physicsBodies.end()) continue;  // Destroyed by a callback
+            PhysicsBody& a = itA->second;
+            PhysicsBody& b = itB->second;
+
+            PhysicsManifold& fresh = g_physicsNarrowResults[i].manifold;
+            fresh.bodyA = hA;
+            fresh.bodyB = hB;
+            fresh.solid = !a.isTrigger && !b.isTrigger;
+            fresh.friction = sqrtf(a.friction * b.friction);
+            fresh.restitution = fminf(a.restitution, b.restitution);
+            fresh.startAX = a.X(); fresh.startAY = a.Y();
+            fresh.startBX = b.X(); fresh.startBY = b.Y();
+            fresh.startRotA = a.rotation; fresh.startRotB = b.rotation;
+            fresh.stamp = g_physicsStepStamp;
+
+            PhysicsManifold& m = g_physicsManifolds[Physics_PairKey(hA, hB)];
+            Physics_MatchManifold(fresh, m);
+            m = fresh;
+
+            // Touching an awake body wakes a sleeper's whole island; solid contacts
+            // between movers link their islands
+            if (fresh.solid) {
+                if (a.type != BODY_STATIC && !a.awake) Physics_WakeBody(a);
+                if (b.type != BODY_STATIC && !b.awake) Physics_WakeBody(b);
+                if (a.type != BODY_STATIC && b.type != BODY_STATIC) g_physicsContactEdges.push_back({ hA, hB });
+            }
+
+            // Speculative manifolds (all points still apart) only feed the solver; the
+            // pair is not colliding until it actually touches
+            float normalX = m.normalX, normalY = m.normalY, depth = m.MaxDepth();
+            if (depth < 0) continue;
+            CollisionPair pair = {hA, hB};
+            g_activeCollisions.insert(pair);
+            bool wasColliding = g_prevCollisions.count(pair) > 0;
+
+            if (!fresh.solid) {
+                if (!wasColliding && g_onTriggerEnter) {
+                    g_onTriggerEnter(hA, hB, normalX, normalY, depth);
+                }
+            } else {
+                if (!wasColliding && g_onCollisionEnter) {
+                    g_onCollisionEnter(hA, hB, normalX, normalY, depth);
+                } else if (wasColliding && g_onCollisionStay) {
+                    g_onCollisionStay(hA, hB, normalX, normalY, depth);
+                }
             }
         }
-        return count;
-    }
 
-    int Framework_Physics_QueryBox(float x, float y, float width, float height, int* bodyBuffer, int bufferSize) {
-        if (!bodyBuffer || bufferSize <= 0) return 0;
-        int count = 0;
+        Physics_PruneManifolds();
+
+        // Gather solid contacts once callbacks can no longer add or remove bodies
+        g_physicsSolverContacts.clear();
+        g_physicsContactPointCount = 0;
+        for (auto& kv : g_physicsManifolds) {
+            PhysicsManifold& m = kv.second;
+            if (m.stamp != g_physicsStepStamp || !m.solid) continue;
+            auto itA = g_physicsBodies.find(m.bodyA);
+            auto itB = g_physicsBodies.find(m.bodyB);
+            if (itA == g_physicsBodies.end() || itB == g_physicsBodies.end()) continue;
+            PhysicsSolverContact c;
+            c.m = &m;
+            c.a = &itA->second;
+            c.b = &itB->second;
+            c.invMassA = Physics_SolverInvMass(*c.a);
+            c.invMassB = Physics_SolverInvMass(*c.b);
+            c.invInertiaA = Physics_SolverInvInertia(*c.a);
+            c.invInertiaB = Physics_SolverInvInertia(*c.b);
+            if (c.invMassA + c.invMassB + c.invInertiaA + c.invInertiaB <= 0) continue;
+            g_physicsSolverContacts.push_back(c);
+            g_physicsContactPointCount += m.pointCount;
+        }
+        if (g_physicsDeterministic) {
+            std::sort(g_physicsSolverContacts.begin(), g_physicsSolverContacts.end(),
+                [](const PhysicsSolverContact& x, const PhysicsSolverContact& y) {
+                    return x.m->bodyA != y.m->bodyA ? x.m->bodyA < y.m->bodyA : x.m->bodyB < y.m->bodyB;
+                });
+        }
+
+        // Solve velocities from the warm-started impulses, islands in parallel
+        Physics_BuildSolverIslands();
+        Physics_ForEachSolverIsland([h](PhysicsSolverContact* contacts, int count) {
+            Physics_PrepareContacts(contacts, count, h);
+            for (int iter = 0; iter < g_velocityIterations; iter++) {
+                Physics_SolveContactVelocities(contacts, count);
+            }
+        });
 
-        float qMinX = x - width / 2, qMinY = y - height / 2;
-        float qMaxX = x + width / 2, qMaxY = y + height / 2;
+        // Integrate velocity; contacts and callbacks may have woken or removed bodies
+        if (g_physicsMoversDirty) Physics_GatherMovers();
+        Physics_IntegratePositions(h);
+        g_physicsBroadphase.queryDirty = true;
 
-        for (auto& kv : g_physicsBodies) {
-            if (count >= bufferSize) break;
-            const PhysicsBody& body = kv.second;
-            if (!body.valid) continue;
+        // Stop opted-in fast bodies where their sweep first touches something
+        Physics_SolveContinuous();
 
-            float minX, minY, maxX, maxY;
-            Physics_GetAABB(body, minX, minY, maxX, maxY);
+        // Apply joint constraints
+        ApplyJointConstraints(h);
 
-            if (qMaxX >= minX && qMinX <= maxX && qMaxY >= minY && qMinY <= maxY) {
-                bodyBuffer[count++] = kv.first;
+        // Push out the remaining overlap
+        Physics_ForEachSolverIsland([](PhysicsSolverContact* contacts, int count) {
+            for (int iter = 0; iter < g_positionIterations; iter++) {
+                Physics_SolveContactPositions(contacts, count);
+            }
+        });
+        g_physicsSolverContacts.clear();
+        g_physicsBroadphase.queryDirty = true;
+        Physics_QueueMovedBodies();
+
+        // Fire exit callbacks
+        for (const auto& pair : g_prevCollisions) {
+            if (g_activeCollisions.count(pair) == 0) {
+                auto itA = g_physicsBodies.find(pair.bodyA);
+                auto itB = g_physicsBodies.find(pair.bodyB);
+                if (itA != g_physicsBodies.end() && itB != g_physicsBodies.end()) {
+                    // Pairs resting asleep are not tested but still touch
+                    if (!Physics_IsAwakeMover(itA->second) && !Physics_IsAwakeMover(itB->second)) {
+                        g_activeCollisions.insert(pair);
+                        continue;
+                    }
+                    if (itA->second.isTrigger || itB->second.isTrigger) {
+                        if (g_onTriggerExit) g_onTriggerExit(pair.bodyA, pair.bodyB, 0, 0, 0);
+                    } else {
+                        if (g_onCollisionExit) g_onCollisionExit(pair.bodyA, pair.bodyB, 0, 0, 0);
+                    }
+                }
             }
         }
-        return count;
-    }
 
-    bool Framework_Physics_TestOverlap(int bodyA, int bodyB) {
-        auto itA = g_physicsBodies.find(bodyA);
-        auto itB = g_physicsBodies.find(bodyB);
-        if (itA == g_physicsBodies.end() || itB == g_physicsBodies.end()) return false;
+        g_prevCollisions = g_activeCollisions;
 
-        float nx, ny, depth;
-        return Physics_TestCollision(itA->second, itB->second, nx, ny, depth);
+        Physics_UpdateSleep(h);
     }
 
-    // Simulation
+    // Manual stepping keeps its own accumulator but runs at the engine's fixed rate
+    // under the same max-steps guard; skip it when FIXED_SYSTEM_PHYSICS is set
     void Framework_Physics_Step(float dt) {
         if (!g_physicsEnabled || dt <= 0) return;
-
-        // Use substeps for more stable simulation
-        const float fixedStep = 1.0f / 120.0f;  // 120 Hz physics
-        static float accumulator = 0.0f;
+        static double accumulator = 0.0;
         accumulator += dt;
 
-        // Limit accumulator to prevent spiral of death
-        if (accumulator > 0.1f) accumulator = 0.1f;
+        int steps = 0;
+        while (accumulator >= g_fixedStep && steps < g_fixedMaxSteps) {
+            accumulator -= g_fixedStep;
+            Physics_StepOnce((float)g_fixedStep);
+            steps++;
+        }
+        if (accumulator >= g_fixedStep) accumulator = fmod(accumulator, g_fixedStep);
+    }
 
-        while (accumulator >= fixedStep) {
-            accumulator -= fixedStep;
+    // Exactly 'steps' fixed steps, independent of frame time, for lockstep ticks and replays
+    void Framework_Physics_StepFixed(int steps) {
+        for (int i = 0; i < steps && g_physicsEnabled; i++) Physics_StepOnce((float)g_fixedStep);
+    }
 
-            // Integrate forces for dynamic bodies
-            for (auto& kv : g_physicsBodies) {
-                PhysicsBody& body = kv.second;
-                if (!body.valid || body.type == BODY_STATIC || !body.awake) continue;
+    // Deterministic mode
+    void Framework_Physics_SetDeterministic(bool enabled) { g_physicsDeterministic = enabled; }
+    bool Framework_Physics_IsDeterministic() { return g_physicsDeterministic; }
+    long long Framework_Physics_GetStepCount() { return g_physicsStepCount; }
 
-                if (body.type == BODY_DYNAMIC) {
-                    // Apply gravity
-                    body.vx += g_gravityX * body.gravityScale * fixedStep;
-                    body.vy += g_gravityY * body.gravityScale * fixedStep;
+    // FNV-1a over every body's simulated state in handle order; two worlds that have not
+    // diverged return the same value after the same step. Handles only contribute their rank,
+    // so a world rebuilt later in the same process still compares equal
+    unsigned long long Framework_Physics_GetStateChecksum() {
+        std::vector<std::pair<int, const PhysicsBody*>> bodies;
+        bodies.reserve(g_physicsBodies.size());
+        for (const auto& kv : g_physicsBodies) bodies.push_back({ kv.first, &kv.second });
+        std::sort(bodies.begin(), bodies.end());
 
-                    // Apply accumulated forces
-                    body.vx += body.forceX * body.invMass * fixedStep;
-                    body.vy += body.forceY * body.invMass * fixedStep;
-                    body.forceX = body.forceY = 0;
+        uint64_t h = 1469598103934665603ull;
+        auto mix = [&h](const void* data, size_t n) {
+            const unsigned char* b = (const unsigned char*)data;
+            for (size_t i = 0; i < n; i++) { h ^= b[i]; h *= 1099511628211ull; }
+        };
+        for (size_t rank = 0; rank < bodies.size(); rank++) {
+            const PhysicsBody& b = *bodies[rank].second;
+            unsigned char awake = b.awake ? 1 : 0;
+            uint32_t index = (uint32_t)rank;
+            mix(&index, sizeof(index));
+            mix(&b.type, sizeof(b.type));
+            mix(&b.X(), sizeof(b.X()));
+            mix(&b.Y(), sizeof(b.Y()));
+            mix(&b.rotation, sizeof(b.rotation));
+            mix(&b.VX(), sizeof(b.VX()));
+            mix(&b.VY(), sizeof(b.VY()));
+            mix(&b.angularVelocity, sizeof(b.angularVelocity));
+            mix(&b.sleepTime, sizeof(b.sleepTime));
+            mix(&awake, sizeof(awake));
+        }
+        return h;
+    }
 
-                    // Apply torque
-                    if (!body.fixedRotation) {
-                        body.angularVelocity += body.torque * body.invInertia * fixedStep;
-                        body.torque = 0;
-                    }
+    // Broadphase
+    void Framework_Physics_SetBroadphase(int mode) {
+        if (mode < PHYSICS_BROADPHASE_TREE || mode > PHYSICS_BROADPHASE_BRUTE_FORCE) return;
+        if (mode == g_physicsBroadphase.mode) return;
+        Physics_ResetBroadphase();
+        g_physicsBroadphase.mode = mode;
+    }
 
-                    // Apply damping
-                    body.vx *= 1.0f / (1.0f + body.linearDamping * fixedStep);
-                    body.vy *= 1.0f / (1.0f + body.linearDamping * fixedStep);
-                    body.angularVelocity *= 1.0f / (1.0f + body.angularDamping * fixedStep);
-                }
+    int Framework_Physics_GetBroadphase() { return g_physicsBroadphase.mode; }
 
-                // Integrate velocity
-                body.x += body.vx * fixedStep;
-                body.y += body.vy * fixedStep;
-                if (!body.fixedRotation) {
-                    body.rotation += body.angularVelocity * fixedStep;
-                }
-            }
+    // Takes effect as leaves are reinserted; existing fat boxes keep their old padding
+    void Framework_Physics_SetAABBMargin(float margin) { g_physicsBroadphase.margin = fmaxf(0.0f, margin); }
+    float Framework_Physics_GetAABBMargin() { return g_physicsBroadphase.margin; }
 
-            // Apply joint constraints
-            ApplyJointConstraints(fixedStep);
+    int Framework_Physics_GetCandidatePairCount() { return (int)g_physicsBroadphase.pairs.size(); }
+    int Framework_Physics_GetBroadphaseTreeHeight() { return g_physicsBroadphase.tree.GetHeight(); }
+    int Framework_Physics_GetBroadphaseReinserts() { return g_physicsBroadphase.reinserted; }
+    float Framework_Physics_GetBroadphaseMs() { return (float)g_physicsBroadphase.lastMs; }
 
-            // Collect active bodies
-            std::vector<int> bodies;
-            for (auto& kv : g_physicsBodies) {
-                if (kv.second.valid) bodies.push_back(kv.first);
-            }
+    // Contact solver
+    void Framework_Physics_SetWarmStarting(bool enabled) { g_physicsWarmStarting = enabled; }
+    bool Framework_Physics_IsWarmStartingEnabled() { return g_physicsWarmStarting; }
 
-            // Detect and resolve collisions
-            g_activeCollisions.clear();
+    void Framework_Physics_SetContactSettings(float baumgarte, float linearSlop, float restitutionThreshold) {
+        g_contactBaumgarte = fmaxf(0.0f, fminf(baumgarte, 1.0f));
+        g_contactLinearSlop = fmaxf(0.0f, linearSlop);
+        g_restitutionThreshold = fmaxf(0.0f, restitutionThreshold);
+    }
 
-            for (int iter = 0; iter < g_positionIterations; iter++) {
-                for (size_t i = 0; i < bodies.size(); i++) {
-                    for (size_t j = i + 1; j < bodies.size(); j++) {
-                        int hA = bodies[i], hB = bodies[j];
-                        PhysicsBody& a = g_physicsBodies[hA];
-                        PhysicsBody& b = g_physicsBodies[hB];
-
-                        // Skip if both are static
-                        if (a.type == BODY_STATIC && b.type == BODY_STATIC) continue;
-
-                        float normalX, normalY, depth;
-                        if (Physics_TestCollision(a, b, normalX, normalY, depth)) {
-                            CollisionPair pair = {hA, hB};
-                            g_activeCollisions.insert(pair);
-
-                            // Fire callbacks on first detection (iter == 0)
-                            if (iter == 0) {
-                                bool wasColliding = g_prevCollisions.count(pair) > 0;
-
-                                if (a.isTrigger || b.isTrigger) {
-                                    if (!wasColliding && g_onTriggerEnter) {
-                                        g_onTriggerEnter(hA, hB, normalX, normalY, depth);
-                                    }
-                                } else {
-                                    if (!wasColliding && g_onCollisionEnter) {
-                                        g_onCollisionEnter(hA, hB, normalX, normalY, depth);
-                                    } else if (wasColliding && g_onCollisionStay) {
-                                        g_onCollisionStay(hA, hB, normalX, normalY, depth);
-                                    }
-                                }
-                            }
+    int Framework_Physics_GetManifoldCount() { return (int)g_physicsManifolds.size(); }
+    int Framework_Physics_GetContactPointCount() { return g_physicsContactPointCount; }
 
-                            // Resolve collision
-                            Physics_ResolveCollision(a, b, normalX, normalY, depth);
-                        }
-                    }
-                }
-            }
+    // Threads for narrowphase and island solving, counting the caller; 0 = one per core
+    void Framework_Physics_SetThreadCount(int threads) {
+        if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+        threads = std::min(threads, 64);
+        if (threads == g_physicsThreadCount) return;
+        Physics_StopWorkers();
+        g_physicsThreadCount = threads;
+        for (int i = 1; i < threads; i++) {
+            g_physicsWorkers.threads.emplace_back(Physics_WorkerMain, g_physicsWorkers.generation);
+        }
+    }
 
-            // Fire exit callbacks
-            for (const auto& pair : g_prevCollisions) {
-                if (g_activeCollisions.count(pair) == 0) {
-                    auto itA = g_physicsBodies.find(pair.bodyA);
-                    auto itB = g_physicsBodies.find(pair.bodyB);
-                    if (itA != g_physicsBodies.end() && itB != g_physicsBodies.end()) {
-                        if (itA->second.isTrigger || itB->second.isTrigger) {
-                            if (g_onTriggerExit) g_onTriggerExit(pair.bodyA, pair.bodyB, 0, 0, 0);
-                        } else {
-                            if (g_onCollisionExit) g_onCollisionExit(pair.bodyA, pair.bodyB, 0, 0, 0);
-                        }
-                    }
-                }
-            }
+    int Framework_Physics_GetThreadCount() { return g_physicsThreadCount; }
+    int Framework_Physics_GetSolverIslandCount() { return std::max(0, (int)g_solverIslandStart.size() - 1); }
+
+    // Sum of the normal impulses holding the pair apart; stays with the manifold while it sleeps
+    float Framework_Physics_GetContactImpulse(int bodyA, int bodyB) {
+        auto it = g_physicsManifolds.find(Physics_PairKey(std::min(bodyA, bodyB), std::max(bodyA, bodyB)));
+        if (it == g_physicsManifolds.end() || !it->second.solid) return 0.0f;
+        float total = 0;
+        for (int i = 0; i < it->second.pointCount; i++) total += it->second.points[i].normalImpulse;
+        return total;
+    }
 
-            g_prevCollisions = g_activeCollisions;
-        }  // End while (accumulator >= fixedStep)
+    // Continuous collision
+    void Framework_Physics_SetBodyContinuous(int bodyHandle, int mode) {
+        if (mode < PHYSICS_CCD_NONE || mode > PHYSICS_CCD_DYNAMIC) return;
+        auto it = g_physicsBodies.find(bodyHandle);
+        if (it != g_physicsBodies.end()) it->second.ccdMode = mode;
+    }
+
+    int Framework_Physics_GetBodyContinuous(int bodyHandle) {
+        auto it = g_physicsBodies.find(bodyHandle);
+        return it != g_physicsBodies.end() ? it->second.ccdMode : PHYSICS_CCD_NONE;
     }
 
+    int Framework_Physics_GetContinuousHitCount() { return g_physicsContinuousHits; }
+
+    // Copies only bodies queued since the last call: movers whose pose changed in a step and
+    // bodies placed through SetBodyPosition/SetBodyRotation or just bound
     void Framework_Physics_SyncToEntities() {
-        for (auto& kv : g_physicsBodies) {
-            PhysicsBody& body = kv.second;
+        for (int handle : g_physicsSyncQueue) {
+            auto it = g_physicsBodies.find(handle);
+            if (it == g_physicsBodies.end()) continue;
+            PhysicsBody& body = it->second;
+            body.syncQueued = false;
             if (!body.valid || body.boundEntity < 0) continue;
 
             // Update entity transform from physics body
             auto trIt = g_transform2D.find(body.boundEntity);
             if (trIt != g_transform2D.end()) {
-                trIt->second.position.x = body.x;
-                trIt->second.position.y = body.y;
+                trIt->second.position.x = body.X();
+                trIt->second.position.y = body.Y();
                 trIt->second.rotation = body.rotation * RAD2DEG;
             }
         }
+        g_physicsSyncQueue.clear();
     }
 
     // Debug rendering
@@ -8831,7 +13598,9 @@ extern "C" {
     bool Framework_Physics_IsDebugDrawEnabled() { return g_physicsDebugDraw; }
 
     void Framework_Physics_DrawDebug() {
+        if (g_headless) return;
         if (!g_physicsDebugDraw) return;
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_DEBUG);
 
         for (auto& kv : g_physicsBodies) {
             const PhysicsBody& body = kv.second;
@@ -8847,26 +13616,30 @@ extern "C" {
 
             if (body.isTrigger) {
                 color = { 0, 150, 255, 100 };
+            } else if (body.type != BODY_STATIC && !body.awake) {
+                color = { 90, 110, 160, 200 };  // Sleeping
             }
 
             if (body.shapeType == SHAPE_CIRCLE) {
-                DrawCircleLines(
-                    (int)(body.x + body.shapeOffsetX),
-                    (int)(body.y + body.shapeOffsetY),
-                    body.shapeRadius, color);
+                float cx, cy;
+                Physics_ShapeCenter(body, cx, cy);
+                RenderStats_Shape(RL_LINES, RSTAT_CIRCLE_SEGMENTS * 2, 0);
+                DrawCircleLines((int)cx, (int)cy, body.shapeRadius, color);
             } else {
-                float hw = body.shapeWidth / 2;
-                float hh = body.shapeHeight / 2;
-                DrawRectangleLines(
-                    (int)(body.x + body.shapeOffsetX - hw),
-                    (int)(body.y + body.shapeOffsetY - hh),
-                    (int)body.shapeWidth, (int)body.shapeHeight, color);
+                PhysicsPolygon poly;
+                Physics_BuildPolygon(body, poly);
+                RenderStats_Shape(RL_LINES, poly.count * 2, 0);
+                for (int i = 0; i < poly.count; i++) {
+                    int j = (i + 1) % poly.count;
+                    DrawLineV({ poly.x[i], poly.y[i] }, { poly.x[j], poly.y[j] }, color);
+                }
             }
 
             // Draw velocity vector
-            if (body.type == BODY_DYNAMIC && (fabsf(body.vx) > 1 || fabsf(body.vy) > 1)) {
-                DrawLine((int)body.x, (int)body.y,
-                    (int)(body.x + body.vx * 0.1f), (int)(body.y + body.vy * 0.1f),
+            if (body.type == BODY_DYNAMIC && (fabsf(body.VX()) > 1 || fabsf(body.VY()) > 1)) {
+                RenderStats_Shape(RL_LINES, 2, 0);
+                DrawLine((int)body.X(), (int)body.Y(),
+                    (int)(body.X() + body.VX() * 0.1f), (int)(body.Y() + body.VY() * 0.1f),
                     RED);
             }
         }
@@ -8932,15 +13705,30 @@ extern "C" {
     static bool GetJointBodyPosition(int bodyHandle, float& x, float& y) {
         auto it = g_physicsBodies.find(bodyHandle);
         if (it == g_physicsBodies.end() || !it->second.valid) return false;
-        x = it->second.x;
-        y = it->second.y;
+        x = it->second.X();
+        y = it->second.Y();
         return true;
     }
 
+    // Joint edits change the forces on both ends, so their islands must simulate again
+    static void Physics_WakeJoint(const PhysicsJoint& joint) {
+        auto itA = g_physicsBodies.find(joint.bodyA);
+        auto itB = g_physicsBodies.find(joint.bodyB);
+        if (itA != g_physicsBodies.end() && itA->second.type != BODY_STATIC) Physics_WakeBody(itA->second);
+        if (itB != g_physicsBodies.end() && itB->second.type != BODY_STATIC) Physics_WakeBody(itB->second);
+    }
+
     // Apply joint constraints during physics step
+    static std::vector<std::pair<int, PhysicsJoint*>> g_physicsJointOrder;
+
     static void ApplyJointConstraints(float dt) {
-        for (auto& kv : g_physicsJoints) {
-            PhysicsJoint& joint = kv.second;
+        // Each joint sees the positions the previous one left, so deterministic mode fixes the order
+        g_physicsJointOrder.clear();
+        for (auto& kv : g_physicsJoints) g_physicsJointOrder.push_back({ kv.first, &kv.second });
+        if (g_physicsDeterministic) std::sort(g_physicsJointOrder.begin(), g_physicsJointOrder.end());
+
+        for (const auto& entry : g_physicsJointOrder) {
+            PhysicsJoint& joint = *entry.second;
             if (!joint.valid) continue;
 
             auto itA = g_physicsBodies.find(joint.bodyA);
@@ -8950,12 +13738,13 @@ extern "C" {
 
             PhysicsBody& bodyA = itA->second;
             PhysicsBody& bodyB = itB->second;
+            if (!Physics_IsAwakeMover(bodyA) && !Physics_IsAwakeMover(bodyB)) continue;  // Asleep with its island
 
             // World anchor positions
-            float worldAX = bodyA.x + joint.anchorAX;
-            float worldAY = bodyA.y + joint.anchorAY;
-            float worldBX = bodyB.x + joint.anchorBX;
-            float worldBY = bodyB.y + joint.anchorBY;
+            float worldAX = bodyA.X() + joint.anchorAX;
+            float worldAY = bodyA.Y() + joint.anchorAY;
+            float worldBX = bodyB.X() + joint.anchorBX;
+            float worldBY = bodyB.Y() + joint.anchorBY;
 
             switch (joint.type) {
                 case JOINT_TYPE_DISTANCE: {
@@ -8976,8 +13765,8 @@ extern "C" {
                     float force = error * joint.stiffness;
 
                     // Apply damping
-                    float relVelX = bodyB.vx - bodyA.vx;
-                    float relVelY = bodyB.vy - bodyA.vy;
+                    float relVelX = bodyB.VX() - bodyA.VX();
+                    float relVelY = bodyB.VY() - bodyA.VY();
                     float relVelN = relVelX * nx + relVelY * ny;
                     force += relVelN * joint.damping;
 
@@ -8988,12 +13777,12 @@ extern "C" {
                         float ratioB = bodyA.mass / massSum;
 
                         if (bodyA.type == BODY_DYNAMIC) {
-                            bodyA.vx += force * nx * ratioA * dt;
-                            bodyA.vy += force * ny * ratioA * dt;
+                            bodyA.VX() += force * nx * ratioA * dt;
+                            bodyA.VY() += force * ny * ratioA * dt;
                         }
                         if (bodyB.type == BODY_DYNAMIC) {
-                            bodyB.vx -= force * nx * ratioB * dt;
-                            bodyB.vy -= force * ny * ratioB * dt;
+                            bodyB.VX() -= force * nx * ratioB * dt;
+                            bodyB.VY() -= force * ny * ratioB * dt;
                         }
                     }
 
@@ -9014,12 +13803,12 @@ extern "C" {
                         float correction = dist * 0.5f;
 
                         if (bodyA.type == BODY_DYNAMIC) {
-                            bodyA.x += nx * correction;
-                            bodyA.y += ny * correction;
+                            bodyA.X() += nx * correction;
+                            bodyA.Y() += ny * correction;
                         }
                         if (bodyB.type == BODY_DYNAMIC) {
-                            bodyB.x -= nx * correction;
-                            bodyB.y -= ny * correction;
+                            bodyB.X() -= nx * correction;
+                            bodyB.Y() -= ny * correction;
                         }
                     }
 
@@ -9060,13 +13849,13 @@ extern "C" {
 
                 case JOINT_TYPE_PRISMATIC: {
                     // Project positions onto axis
-                    float dx = bodyB.x - bodyA.x;
-                    float dy = bodyB.y - bodyA.y;
+                    float dx = bodyB.X() - bodyA.X();
+                    float dy = bodyB.Y() - bodyA.Y();
                     joint.currentTranslation = dx * joint.axisX + dy * joint.axisY;
 
                     // Velocity along axis
-                    float relVelX = bodyB.vx - bodyA.vx;
-                    float relVelY = bodyB.vy - bodyA.vy;
+                    float relVelX = bodyB.VX() - bodyA.VX();
+                    float relVelY = bodyB.VY() - bodyA.VY();
                     joint.currentSpeed = relVelX * joint.axisX + relVelY * joint.axisY;
 
                     // Constrain perpendicular movement
@@ -9077,12 +13866,12 @@ extern "C" {
                     if (fabsf(perpDist) > 0.5f) {
                         float correction = perpDist * 0.5f;
                         if (bodyA.type == BODY_DYNAMIC) {
-                            bodyA.x += perpX * correction;
-                            bodyA.y += perpY * correction;
+                            bodyA.X() += perpX * correction;
+                            bodyA.Y() += perpY * correction;
                         }
                         if (bodyB.type == BODY_DYNAMIC) {
-                            bodyB.x -= perpX * correction;
-                            bodyB.y -= perpY * correction;
+                            bodyB.X() -= perpX * correction;
+                            bodyB.Y() -= perpY * correction;
                         }
                     }
 
@@ -9091,14 +13880,14 @@ extern "C" {
                         if (joint.currentTranslation < joint.lowerTranslation) {
                             float error = joint.lowerTranslation - joint.currentTranslation;
                             if (bodyB.type == BODY_DYNAMIC) {
-                                bodyB.vx += joint.axisX * error * 5.0f * dt;
-                                bodyB.vy += joint.axisY * error * 5.0f * dt;
+                                bodyB.VX() += joint.axisX * error * 5.0f * dt;
+                                bodyB.VY() += joint.axisY * error * 5.0f * dt;
                             }
                         } else if (joint.currentTranslation > joint.upperTranslation) {
                             float error = joint.currentTranslation - joint.upperTranslation;
                             if (bodyB.type == BODY_DYNAMIC) {
-                                bodyB.vx -= joint.axisX * error * 5.0f * dt;
-                                bodyB.vy -= joint.axisY * error * 5.0f * dt;
+                                bodyB.VX() -= joint.axisX * error * 5.0f * dt;
+                                bodyB.VY() -= joint.axisY * error * 5.0f * dt;
                             }
                         }
                     }
@@ -9111,8 +13900,8 @@ extern "C" {
                             force = (force > 0 ? 1 : -1) * joint.motorForce * dt;
                         }
                         if (bodyB.type == BODY_DYNAMIC) {
-                            bodyB.vx += joint.axisX * force / bodyB.mass;
-                            bodyB.vy += joint.axisY * force / bodyB.mass;
+                            bodyB.VX() += joint.axisX * force / bodyB.mass;
+                            bodyB.VY() += joint.axisY * force / bodyB.mass;
                         }
                     }
                     break;
@@ -9124,17 +13913,17 @@ extern "C" {
                     float dy = worldBY - worldAY;
 
                     if (bodyB.type == BODY_DYNAMIC) {
-                        bodyB.x -= dx * 0.9f;
-                        bodyB.y -= dy * 0.9f;
-                        bodyB.vx = bodyA.vx;
-                        bodyB.vy = bodyA.vy;
+                        bodyB.X() -= dx * 0.9f;
+                        bodyB.Y() -= dy * 0.9f;
+                        bodyB.VX() = bodyA.VX();
+                        bodyB.VY() = bodyA.VY();
                         bodyB.rotation = bodyA.rotation + joint.currentAngle;
                         bodyB.angularVelocity = bodyA.angularVelocity;
                     } else if (bodyA.type == BODY_DYNAMIC) {
-                        bodyA.x += dx * 0.9f;
-                        bodyA.y += dy * 0.9f;
-                        bodyA.vx = bodyB.vx;
-                        bodyA.vy = bodyB.vy;
+                        bodyA.X() += dx * 0.9f;
+                        bodyA.Y() += dy * 0.9f;
+                        bodyA.VX() = bodyB.VX();
+                        bodyA.VY() = bodyB.VY();
                     }
                     break;
                 }
@@ -9152,16 +13941,16 @@ extern "C" {
 
                         if (bodyA.type == BODY_DYNAMIC && bodyB.type == BODY_DYNAMIC) {
                             float half = excess * 0.5f;
-                            bodyA.x += nx * half;
-                            bodyA.y += ny * half;
-                            bodyB.x -= nx * half;
-                            bodyB.y -= ny * half;
+                            bodyA.X() += nx * half;
+                            bodyA.Y() += ny * half;
+                            bodyB.X() -= nx * half;
+                            bodyB.Y() -= ny * half;
                         } else if (bodyA.type == BODY_DYNAMIC) {
-                            bodyA.x += nx * excess;
-                            bodyA.y += ny * excess;
+                            bodyA.X() += nx * excess;
+                            bodyA.Y() += ny * excess;
                         } else if (bodyB.type == BODY_DYNAMIC) {
-                            bodyB.x -= nx * excess;
-                            bodyB.y -= ny * excess;
+                            bodyB.X() -= nx * excess;
+                            bodyB.Y() -= ny * excess;
                         }
                     }
                     break;
@@ -9169,17 +13958,17 @@ extern "C" {
 
                 case JOINT_TYPE_MOTOR: {
                     // Move body B toward target relative to body A
-                    float targetWorldX = bodyA.x + joint.targetX;
-                    float targetWorldY = bodyA.y + joint.targetY;
+                    float targetWorldX = bodyA.X() + joint.targetX;
+                    float targetWorldY = bodyA.Y() + joint.targetY;
 
-                    float dx = targetWorldX - bodyB.x;
-                    float dy = targetWorldY - bodyB.y;
+                    float dx = targetWorldX - bodyB.X();
+                    float dy = targetWorldY - bodyB.Y();
                     float dist = sqrtf(dx * dx + dy * dy);
 
                     if (dist > 0.5f && bodyB.type == BODY_DYNAMIC) {
                         float force = fminf(dist * joint.correctionFactor, joint.maxForce) * dt;
-                        bodyB.vx += (dx / dist) * force / bodyB.mass;
-                        bodyB.vy += (dy / dist) * force / bodyB.mass;
+                        bodyB.VX() += (dx / dist) * force / bodyB.mass;
+                        bodyB.VY() += (dy / dist) * force / bodyB.mass;
                     }
 
                     // Rotate toward target angle
@@ -9199,8 +13988,8 @@ extern "C" {
 
                 case JOINT_TYPE_WHEEL: {
                     // Suspension along axis, free rotation
-                    float dx = bodyB.x - (bodyA.x + joint.anchorAX);
-                    float dy = bodyB.y - (bodyA.y + joint.anchorAY);
+                    float dx = bodyB.X() - (bodyA.X() + joint.anchorAX);
+                    float dy = bodyB.Y() - (bodyA.Y() + joint.anchorAY);
 
                     // Project onto axis
                     float axisProj = dx * joint.axisX + dy * joint.axisY;
@@ -9208,19 +13997,19 @@ extern "C" {
 
                     // Spring force along axis
                     float springForce = -axisProj * joint.stiffness;
-                    float relVel = (bodyB.vx - bodyA.vx) * joint.axisX + (bodyB.vy - bodyA.vy) * joint.axisY;
+                    float relVel = (bodyB.VX() - bodyA.VX()) * joint.axisX + (bodyB.VY() - bodyA.VY()) * joint.axisY;
                     springForce -= relVel * joint.damping;
 
                     if (bodyB.type == BODY_DYNAMIC) {
-                        bodyB.vx += joint.axisX * springForce * dt / bodyB.mass;
-                        bodyB.vy += joint.axisY * springForce * dt / bodyB.mass;
+                        bodyB.VX() += joint.axisX * springForce * dt / bodyB.mass;
+                        bodyB.VY() += joint.axisY * springForce * dt / bodyB.mass;
                     }
 
                     // Constrain perpendicular
                     if (fabsf(perpProj) > 0.1f) {
                         if (bodyB.type == BODY_DYNAMIC) {
-                            bodyB.x -= (-joint.axisY) * perpProj * 0.5f;
-                            bodyB.y -= joint.axisX * perpProj * 0.5f;
+                            bodyB.X() -= (-joint.axisY) * perpProj * 0.5f;
+                            bodyB.Y() -= joint.axisX * perpProj * 0.5f;
                         }
                     }
 
@@ -9256,12 +14045,12 @@ extern "C" {
                         float correction = error * 0.3f;
 
                         if (lenA > 0.001f && bodyA.type == BODY_DYNAMIC) {
-                            bodyA.vx -= (dxA / lenA) * correction * dt * 50;
-                            bodyA.vy -= (dyA / lenA) * correction * dt * 50;
+                            bodyA.VX() -= (dxA / lenA) * correction * dt * 50;
+                            bodyA.VY() -= (dyA / lenA) * correction * dt * 50;
                         }
                         if (lenB > 0.001f && bodyB.type == BODY_DYNAMIC) {
-                            bodyB.vx -= (dxB / lenB) * correction * joint.ratio * dt * 50;
-                            bodyB.vy -= (dyB / lenB) * correction * joint.ratio * dt * 50;
+                            bodyB.VX() -= (dxB / lenB) * correction * joint.ratio * dt * 50;
+                            bodyB.VY() -= (dyB / lenB) * correction * joint.ratio * dt * 50;
                         }
                     }
                     break;
@@ -9286,10 +14075,10 @@ extern "C" {
         // Calculate local anchors
         PhysicsBody& bA = g_physicsBodies[bodyA];
         PhysicsBody& bB = g_physicsBodies[bodyB];
-        joint.anchorAX = anchorX - bA.x;
-        joint.anchorAY = anchorY - bA.y;
-        joint.anchorBX = anchorX - bB.x;
-        joint.anchorBY = anchorY - bB.y;
+        joint.anchorAX = anchorX - bA.X();
+        joint.anchorAY = anchorY - bA.Y();
+        joint.anchorBX = anchorX - bB.X();
+        joint.anchorBY = anchorY - bB.Y();
 
         joint.lowerAngle = -PI;
         joint.upperAngle = PI;
@@ -9300,6 +14089,7 @@ extern "C" {
         joint.collideConnected = false;
         joint.userData = 0;
         joint.valid = true;
+        Physics_WakeJoint(joint);
 
         return handle;
     }
@@ -9318,10 +14108,10 @@ extern "C" {
 
         PhysicsBody& bA = g_physicsBodies[bodyA];
         PhysicsBody& bB = g_physicsBodies[bodyB];
-        joint.anchorAX = anchorAX - bA.x;
-        joint.anchorAY = anchorAY - bA.y;
-        joint.anchorBX = anchorBX - bB.x;
-        joint.anchorBY = anchorBY - bB.y;
+        joint.anchorAX = anchorAX - bA.X();
+        joint.anchorAY = anchorAY - bA.Y();
+        joint.anchorBX = anchorBX - bB.X();
+        joint.anchorBY = anchorBY - bB.Y();
 
         // Calculate initial length
         float dx = anchorBX - anchorAX;
@@ -9334,6 +14124,7 @@ extern "C" {
         joint.collideConnected = false;
         joint.userData = 0;
         joint.valid = true;
+        Physics_WakeJoint(joint);
 
         return handle;
     }
@@ -9352,10 +14143,10 @@ extern "C" {
 
         PhysicsBody& bA = g_physicsBodies[bodyA];
         PhysicsBody& bB = g_physicsBodies[bodyB];
-        joint.anchorAX = anchorX - bA.x;
-        joint.anchorAY = anchorY - bA.y;
-        joint.anchorBX = anchorX - bB.x;
-        joint.anchorBY = anchorY - bB.y;
+        joint.anchorAX = anchorX - bA.X();
+        joint.anchorAY = anchorY - bA.Y();
+        joint.anchorBX = anchorX - bB.X();
+        joint.anchorBY = anchorY - bB.Y();
 
         // Normalize axis
         float len = sqrtf(axisX * axisX + axisY * axisY);
@@ -9371,6 +14162,7 @@ extern "C" {
         joint.collideConnected = false;
         joint.userData = 0;
         joint.valid = true;
+        Physics_WakeJoint(joint);
 
         return handle;
     }
@@ -9390,10 +14182,10 @@ extern "C" {
 
         PhysicsBody& bA = g_physicsBodies[bodyA];
         PhysicsBody& bB = g_physicsBodies[bodyB];
-        joint.anchorAX = anchorAX - bA.x;
-        joint.anchorAY = anchorAY - bA.y;
-        joint.anchorBX = anchorBX - bB.x;
-        joint.anchorBY = anchorBY - bB.y;
+        joint.anchorAX = anchorAX - bA.X();
+        joint.anchorAY = anchorAY - bA.Y();
+        joint.anchorBX = anchorBX - bB.X();
+        joint.anchorBY = anchorBY - bB.Y();
 
         joint.groundAX = groundAX;
         joint.groundAY = groundAY;
@@ -9412,6 +14204,7 @@ extern "C" {
         joint.collideConnected = true;
         joint.userData = 0;
         joint.valid = true;
+        Physics_WakeJoint(joint);
 
         return handle;
     }
@@ -9430,15 +14223,16 @@ extern "C" {
 
         PhysicsBody& bA = g_physicsBodies[bodyA];
         PhysicsBody& bB = g_physicsBodies[bodyB];
-        joint.anchorAX = anchorX - bA.x;
-        joint.anchorAY = anchorY - bA.y;
-        joint.anchorBX = anchorX - bB.x;
-        joint.anchorBY = anchorY - bB.y;
+        joint.anchorAX = anchorX - bA.X();
+        joint.anchorAY = anchorY - bA.Y();
+        joint.anchorBX = anchorX - bB.X();
+        joint.anchorBY = anchorY - bB.Y();
         joint.currentAngle = bB.rotation - bA.rotation;
 
         joint.collideConnected = false;
         joint.userData = 0;
         joint.valid = true;
+        Physics_WakeJoint(joint);
 
         return handle;
     }
@@ -9457,8 +14251,8 @@ extern "C" {
 
         PhysicsBody& bA = g_physicsBodies[bodyA];
         PhysicsBody& bB = g_physicsBodies[bodyB];
-        joint.targetX = bB.x - bA.x;
-        joint.targetY = bB.y - bA.y;
+        joint.targetX = bB.X() - bA.X();
+        joint.targetY = bB.Y() - bA.Y();
         joint.targetAngle = bB.rotation - bA.rotation;
         joint.maxForce = 100;
         joint.maxTorque = 50;
@@ -9467,6 +14261,7 @@ extern "C" {
         joint.collideConnected = true;
         joint.userData = 0;
         joint.valid = true;
+        Physics_WakeJoint(joint);
 
         return handle;
     }
@@ -9484,8 +14279,8 @@ extern "C" {
         joint.bodyB = bodyB;
 
         PhysicsBody& bA = g_physicsBodies[bodyA];
-        joint.anchorAX = anchorX - bA.x;
-        joint.anchorAY = anchorY - bA.y;
+        joint.anchorAX = anchorX - bA.X();
+        joint.anchorAY = anchorY - bA.Y();
         joint.anchorBX = 0;
         joint.anchorBY = 0;
 
@@ -9503,6 +14298,7 @@ extern "C" {
         joint.collideConnected = false;
         joint.userData = 0;
         joint.valid = true;
+        Physics_WakeJoint(joint);
 
         return handle;
     }
@@ -9521,15 +14317,16 @@ extern "C" {
 
         PhysicsBody& bA = g_physicsBodies[bodyA];
         PhysicsBody& bB = g_physicsBodies[bodyB];
-        joint.anchorAX = anchorAX - bA.x;
-        joint.anchorAY = anchorAY - bA.y;
-        joint.anchorBX = anchorBX - bB.x;
-        joint.anchorBY = anchorBY - bB.y;
+        joint.anchorAX = anchorAX - bA.X();
+        joint.anchorAY = anchorAY - bA.Y();
+        joint.anchorBX = anchorBX - bB.X();
+        joint.anchorBY = anchorBY - bB.Y();
         joint.maxLength = maxLength;
 
         joint.collideConnected = true;
         joint.userData = 0;
         joint.valid = true;
+        Physics_WakeJoint(joint);
 
         return handle;
     }
@@ -9538,11 +14335,13 @@ extern "C" {
     void Framework_Joint_Destroy(int jointHandle) {
         auto it = g_physicsJoints.find(jointHandle);
         if (it != g_physicsJoints.end()) {
+            Physics_WakeJoint(it->second);
             g_physicsJoints.erase(it);
         }
     }
 
     void Framework_Joint_DestroyAll() {
+        for (auto& kv : g_physicsJoints) Physics_WakeJoint(kv.second);
         g_physicsJoints.clear();
     }
 
@@ -9578,8 +14377,8 @@ extern "C" {
         auto bodyIt = g_physicsBodies.find(joint.bodyA);
         if (bodyIt == g_physicsBodies.end()) { if (x) *x = 0; if (y) *y = 0; return; }
 
-        if (x) *x = bodyIt->second.x + joint.anchorAX;
-        if (y) *y = bodyIt->second.y + joint.anchorAY;
+        if (x) *x = bodyIt->second.X() + joint.anchorAX;
+        if (y) *y = bodyIt->second.Y() + joint.anchorAY;
     }
 
     void Framework_Joint_GetAnchorB(int jointHandle, float* x, float* y) {
@@ -9590,8 +14389,8 @@ extern "C" {
         auto bodyIt = g_physicsBodies.find(joint.bodyB);
         if (bodyIt == g_physicsBodies.end()) { if (x) *x = 0; if (y) *y = 0; return; }
 
-        if (x) *x = bodyIt->second.x + joint.anchorBX;
-        if (y) *y = bodyIt->second.y + joint.anchorBY;
+        if (x) *x = bodyIt->second.X() + joint.anchorBX;
+        if (y) *y = bodyIt->second.Y() + joint.anchorBY;
     }
 
     void Framework_Joint_GetReactionForce(int jointHandle, float* fx, float* fy) {
@@ -9613,6 +14412,7 @@ extern "C" {
         if (it == g_physicsJoints.end() || it->second.type != JOINT_TYPE_REVOLUTE) return;
         it->second.lowerAngle = lowerAngle;
         it->second.upperAngle = upperAngle;
+        Physics_WakeJoint(it->second);
     }
 
     void Framework_Joint_GetRevoluteLimits(int jointHandle, float* lowerAngle, float* upperAngle) {
@@ -9626,6 +14426,7 @@ extern "C" {
         auto it = g_physicsJoints.find(jointHandle);
         if (it == g_physicsJoints.end() || it->second.type != JOINT_TYPE_REVOLUTE) return;
         it->second.enableLimits = enable;
+        Physics_WakeJoint(it->second);
     }
 
     bool Framework_Joint_AreRevoluteLimitsEnabled(int jointHandle) {
@@ -9639,12 +14440,14 @@ extern "C" {
         if (it == g_physicsJoints.end()) return;
         it->second.motorSpeed = speed;
         it->second.maxMotorTorque = maxTorque;
+        Physics_WakeJoint(it->second);
     }
 
     void Framework_Joint_EnableRevoluteMotor(int jointHandle, bool enable) {
         auto it = g_physicsJoints.find(jointHandle);
         if (it == g_physicsJoints.end()) return;
         it->second.enableMotor = enable;
+        Physics_WakeJoint(it->second);
     }
 
     bool Framework_Joint_IsRevoluteMotorEnabled(int jointHandle) {
@@ -9670,6 +14473,7 @@ extern "C" {
         auto it = g_physicsJoints.find(jointHandle);
         if (it == g_physicsJoints.end()) return;
         it->second.length = length;
+        Physics_WakeJoint(it->second);
     }
 
     float Framework_Joint_GetDistanceLength(int jointHandle) {
@@ -9683,12 +14487,14 @@ extern "C" {
         if (it == g_physicsJoints.end()) return;
         it->second.minLength = minLength;
         it->second.maxLength = maxLength;
+        Physics_WakeJoint(it->second);
     }
 
     void Framework_Joint_SetDistanceStiffness(int jointHandle, float stiffness) {
         auto it = g_physicsJoints.find(jointHandle);
         if (it == g_physicsJoints.end()) return;
         it->second.stiffness = stiffness;
+        Physics_WakeJoint(it->second);
     }
 
     float Framework_Joint_GetDistanceStiffness(int jointHandle) {
@@ -9701,6 +14507,7 @@ extern "C" {
         auto it = g_physicsJoints.find(jointHandle);
         if (it == g_physicsJoints.end()) return;
         it->second.damping = damping;
+        Physics_WakeJoint(it->second);
     }
 
     float Framework_Joint_GetDistanceDamping(int jointHandle) {
@@ -9715,6 +14522,7 @@ extern "C" {
         if (it == g_physicsJoints.end()) return;
         it->second.lowerTranslation = lowerTranslation;
         it->second.upperTranslation = upperTranslation;
+        Physics_WakeJoint(it->second);
     }
 
     void Framework_Joint_GetPrismaticLimits(int jointHandle, float* lower, float* upper) {
@@ -9728,6 +14536,7 @@ extern "C" {
         auto it = g_physicsJoints.find(jointHandle);
         if (it == g_physicsJoints.end()) return;
         it->second.enableLimits = enable;
+        Physics_WakeJoint(it->second);
     }
 
     bool Framework_Joint_ArePrismaticLimitsEnabled(int jointHandle) {
@@ -9741,12 +14550,14 @@ extern "C" {
         if (it == g_physicsJoints.end()) return;
         it->second.motorSpeed = speed;
         it->second.motorForce = maxForce;
+        Physics_WakeJoint(it->second);
     }
 
     void Framework_Joint_EnablePrismaticMotor(int jointHandle, bool enable) {
         auto it = g_physicsJoints.find(jointHandle);
         if (it == g_physicsJoints.end()) return;
         it->second.enableMotor = enable;
+        Physics_WakeJoint(it->second);
     }
 
     bool Framework_Joint_IsPrismaticMotorEnabled(int jointHandle) {
@@ -9774,24 +14585,28 @@ extern "C" {
         it->second.targetX = targetX;
         it->second.targetY = targetY;
         it->second.targetAngle = targetAngle;
+        Physics_WakeJoint(it->second);
     }
 
     void Framework_Joint_SetMotorMaxForce(int jointHandle, float maxForce) {
         auto it = g_physicsJoints.find(jointHandle);
         if (it == g_physicsJoints.end()) return;
         it->second.maxForce = maxForce;
+        Physics_WakeJoint(it->second);
     }
 
     void Framework_Joint_SetMotorMaxTorque(int jointHandle, float maxTorque) {
         auto it = g_physicsJoints.find(jointHandle);
         if (it == g_physicsJoints.end()) return;
         it->second.maxTorque = maxTorque;
+        Physics_WakeJoint(it->second);
     }
 
     void Framework_Joint_SetMotorCorrectionFactor(int jointHandle, float factor) {
         auto it = g_physicsJoints.find(jointHandle);
         if (it == g_physicsJoints.end()) return;
         it->second.correctionFactor = factor;
+        Physics_WakeJoint(it->second);
     }
 
     // Wheel joint configuration
@@ -9800,12 +14615,14 @@ extern "C" {
         if (it == g_physicsJoints.end()) return;
         it->second.motorSpeed = speed;
         it->second.maxMotorTorque = maxTorque;
+        Physics_WakeJoint(it->second);
     }
 
     void Framework_Joint_EnableWheelMotor(int jointHandle, bool enable) {
         auto it = g_physicsJoints.find(jointHandle);
         if (it == g_physicsJoints.end()) return;
         it->second.enableMotor = enable;
+        Physics_WakeJoint(it->second);
     }
 
     bool Framework_Joint_IsWheelMotorEnabled(int jointHandle) {
@@ -9818,12 +14635,14 @@ extern "C" {
         auto it = g_physicsJoints.find(jointHandle);
         if (it == g_physicsJoints.end()) return;
         it->second.stiffness = stiffness;
+        Physics_WakeJoint(it->second);
     }
 
     void Framework_Joint_SetWheelDamping(int jointHandle, float damping) {
         auto it = g_physicsJoints.find(jointHandle);
         if (it == g_physicsJoints.end()) return;
         it->second.damping = damping;
+        Physics_WakeJoint(it->second);
     }
 
     // Rope joint configuration
@@ -9831,6 +14650,7 @@ extern "C" {
         auto it = g_physicsJoints.find(jointHandle);
         if (it == g_physicsJoints.end()) return;
         it->second.maxLength = maxLength;
+        Physics_WakeJoint(it->second);
     }
 
     float Framework_Joint_GetRopeMaxLength(int jointHandle) {
@@ -9844,6 +14664,7 @@ extern "C" {
         auto it = g_physicsJoints.find(jointHandle);
         if (it == g_physicsJoints.end()) return;
         it->second.collideConnected = collide;
+        Physics_WakeJoint(it->second);
     }
 
     bool Framework_Joint_GetCollideConnected(int jointHandle) {
@@ -9876,6 +14697,8 @@ extern "C" {
     }
 
     void Framework_Joint_DrawDebug() {
+        if (g_headless) return;
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_DEBUG);
         for (auto& kv : g_physicsJoints) {
             PhysicsJoint& joint = kv.second;
             if (!joint.valid) continue;
@@ -9895,34 +14718,246 @@ extern "C" {
             }
 
             // Draw line between anchors
+            RenderStats_Shape(RL_LINES, 2, 0);
             DrawLine((int)ax, (int)ay, (int)bx, (int)by, color);
 
             // Draw anchor points
+            RenderStats_Circle();
             DrawCircle((int)ax, (int)ay, 4, color);
+            RenderStats_Circle();
             DrawCircle((int)bx, (int)by, 4, color);
 
             // Draw special indicators
             if (joint.type == JOINT_TYPE_REVOLUTE) {
+                RenderStats_Shape(RL_LINES, RSTAT_CIRCLE_SEGMENTS * 2, 0);
                 DrawCircleLines((int)ax, (int)ay, 10, color);
             } else if (joint.type == JOINT_TYPE_PRISMATIC) {
                 // Draw axis indicator
                 auto bodyIt = g_physicsBodies.find(joint.bodyA);
                 if (bodyIt != g_physicsBodies.end()) {
-                    float cx = bodyIt->second.x;
-                    float cy = bodyIt->second.y;
+                    float cx = bodyIt->second.X();
+                    float cy = bodyIt->second.Y();
+                    RenderStats_Shape(RL_LINES, 2, 0);
                     DrawLine((int)(cx - joint.axisX * 30), (int)(cy - joint.axisY * 30),
                              (int)(cx + joint.axisX * 30), (int)(cy + joint.axisY * 30), color);
                 }
             } else if (joint.type == JOINT_TYPE_PULLEY) {
                 // Draw ground anchors
+                RenderStats_Circle();
                 DrawCircle((int)joint.groundAX, (int)joint.groundAY, 6, { 150, 150, 150, 200 });
+                RenderStats_Circle();
                 DrawCircle((int)joint.groundBX, (int)joint.groundBY, 6, { 150, 150, 150, 200 });
+                RenderStats_Shape(RL_LINES, 2, 0);
                 DrawLine((int)joint.groundAX, (int)joint.groundAY, (int)ax, (int)ay, color);
+                RenderStats_Shape(RL_LINES, 2, 0);
                 DrawLine((int)joint.groundBX, (int)joint.groundBY, (int)bx, (int)by, color);
             }
         }
     }
 
+    // ========================================================================
+    // PHYSICS ISLANDS
+    // ========================================================================
+    // After each step the awake movers are grouped by union-find over this step's solid
+    // contacts and over joints. An island sleeps when every body in it has been still for
+    // g_timeToSleep, and wakes as a whole when any member is touched, pushed or re-jointed.
+    static std::vector<PhysicsBody*> g_islandBodies;   // Indexed by PhysicsBody::islandIndex
+    static std::vector<int> g_islandHandles;
+    static std::vector<int> g_islandParent;
+    static std::vector<float> g_islandMinSleep;
+    static std::vector<int> g_islandSleepId;
+    static int g_islandCount = 0;
+
+    static int Physics_IslandFind(int i) {
+        while (g_islandParent[i] != i) {
+            g_islandParent[i] = g_islandParent[g_islandParent[i]];
+            i = g_islandParent[i];
+        }
+        return i;
+    }
+
+    static void Physics_IslandUnion(const PhysicsBody& a, const PhysicsBody& b) {
+        if (a.islandIndex < 0 || b.islandIndex < 0) return;
+        int ra = Physics_IslandFind(a.islandIndex), rb = Physics_IslandFind(b.islandIndex);
+        if (ra != rb) g_islandParent[std::max(ra, rb)] = std::min(ra, rb);
+    }
+
+    static void Physics_UpdateSleep(float h) {
+        g_islandCount = 0;
+        if (!g_physicsSleepEnabled) { g_physicsContactEdges.clear(); return; }
+
+        // A joint to an awake mover keeps the other end awake too
+        for (auto& kv : g_physicsJoints) {
+            if (!kv.second.valid) continue;
+            auto itA = g_physicsBodies.find(kv.second.bodyA);
+            auto itB = g_physicsBodies.find(kv.second.bodyB);
+            if (itA == g_physicsBodies.end() || itB == g_physicsBodies.end()) continue;
+            PhysicsBody& a = itA->second;
+            PhysicsBody& b = itB->second;
+            if (Physics_IsAwakeMover(a) && b.type != BODY_STATIC && !b.awake) Physics_WakeBody(b);
+            if (Physics_IsAwakeMover(b) && a.type != BODY_STATIC && !a.awake) Physics_WakeBody(a);
+        }
+
+        g_islandBodies.clear();
+        g_islandHandles.clear();
+        float linTol2 = g_sleepLinearTolerance * g_sleepLinearTolerance;
+        float angTol2 = g_sleepAngularTolerance * g_sleepAngularTolerance;
+        if (g_physicsMoversDirty) Physics_GatherMovers();  // The joints above may have woken bodies
+        for (int slot = 1; slot < g_physicsStore.moverEnd; slot++) {
+            PhysicsBody& body = *g_physicsStore.owner[slot];
+            bool still = body.sleepingAllowed &&
+                body.VX() * body.VX() + body.VY() * body.VY() <= linTol2 &&
+                body.angularVelocity * body.angularVelocity <= angTol2;
+            body.sleepTime = still ? body.sleepTime + h : 0.0f;
+            body.islandIndex = (int)g_islandBodies.size();
+            g_islandBodies.push_back(&body);
+            g_islandHandles.push_back(body.handle);
+        }
+
+        int n = (int)g_islandBodies.size();
+        g_islandParent.resize(n);
+        for (int i = 0; i < n; i++) g_islandParent[i] = i;
+        for (const auto& edge : g_physicsContactEdges) {
+            auto itA = g_physicsBodies.find(edge.first);
+            auto itB = g_physicsBodies.find(edge.second);
+            if (itA != g_physicsBodies.end() && itB != g_physicsBodies.end()) Physics_IslandUnion(itA->second, itB->second);
+        }
+        g_physicsContactEdges.clear();
+        for (auto& kv : g_physicsJoints) {
+            if (!kv.second.valid) continue;
+            auto itA = g_physicsBodies.find(kv.second.bodyA);
+            auto itB = g_physicsBodies.find(kv.second.bodyB);
+            if (itA != g_physicsBodies.end() && itB != g_physicsBodies.end()) Physics_IslandUnion(itA->second, itB->second);
+        }
+
+        g_islandMinSleep.assign(n, 1e30f);
+        for (int i = 0; i < n; i++) {
+            int root = Physics_IslandFind(i);
+            if (root == i) g_islandCount++;
+            g_islandMinSleep[root] = fminf(g_islandMinSleep[root], g_islandBodies[i]->sleepTime);
+        }
+
+        g_islandSleepId.assign(n, -1);
+        for (int i = 0; i < n; i++) {
+            int root = Physics_IslandFind(i);
+            if (g_islandMinSleep[root] < g_timeToSleep) continue;
+            if (g_islandSleepId[root] < 0) g_islandSleepId[root] = g_nextSleepIslandId++;
+            PhysicsBody& body = *g_islandBodies[i];
+            body.awake = false;
+            g_physicsMoversDirty = true;
+            body.sleepTime = 0;
+            body.VX() = body.VY() = 0;
+            body.angularVelocity = 0;
+            body.ForceX() = body.ForceY() = 0;
+            body.torque = 0;
+            body.sleepIsland = g_islandSleepId[root];
+            g_sleepingIslands[body.sleepIsland].push_back(g_islandHandles[i]);
+        }
+        for (PhysicsBody* body : g_islandBodies) body->islandIndex = -1;
+    }
+
+    // Sleep settings
+    void Framework_Physics_SetSleepingEnabled(bool enabled) {
+        g_physicsSleepEnabled = enabled;
+        if (!enabled) {
+            for (auto& kv : g_physicsBodies) if (kv.second.type != BODY_STATIC) Physics_WakeBody(kv.second);
+        }
+    }
+
+    bool Framework_Physics_IsSleepingEnabled() { return g_physicsSleepEnabled; }
+
+    void Framework_Physics_SetSleepThresholds(float linearSpeed, float angularSpeed) {
+        g_sleepLinearTolerance = fmaxf(0.0f, linearSpeed);
+        g_sleepAngularTolerance = fmaxf(0.0f, angularSpeed);
+    }
+
+    void Framework_Physics_SetTimeToSleep(float seconds) { g_timeToSleep = fmaxf(0.0f, seconds); }
+    float Framework_Physics_GetTimeToSleep() { return g_timeToSleep; }
+
+    int Framework_Physics_GetAwakeBodyCount() {
+        int count = 0;
+        for (auto& kv : g_physicsBodies) if (Physics_IsAwakeMover(kv.second)) count++;
+        return count;
+    }
+
+    int Framework_Physics_GetIslandCount() { return g_islandCount; }
+    int Framework_Physics_GetSleepingIslandCount() { return (int)g_sleepingIslands.size(); }
+
+    // ========================================================================
+    // PHYSICS BENCHMARK
+    // ========================================================================
+    // Runs a throwaway world of mixed boxes and circles at constant density with the given
+    // broadphase and returns the average milliseconds per step. The live world, joints and
+    // callbacks are swapped out for the duration and restored untouched.
+    float Framework_Physics_Benchmark(int bodyCount, int broadphase, int steps) {
+        if (bodyCount <= 0 || steps <= 0) return 0.0f;
+        bodyCount = std::min(bodyCount, MAX_PHYSICS_BODIES);
+
+        std::unordered_map<int, PhysicsBody> savedBodies;
+        std::unordered_map<int, PhysicsJoint> savedJoints;
+        std::unordered_set<CollisionPair, CollisionPairHash> savedActive, savedPrev;
+        std::unordered_map<int, std::vector<int>> savedIslands;
+        std::unordered_map<long long, PhysicsManifold> savedManifolds;
+        PhysicsBroadphaseState savedBroadphase;
+        PhysicsBodyStore savedStore;
+        savedBodies.swap(g_physicsBodies);
+        std::swap(savedStore, g_physicsStore);
+        savedManifolds.swap(g_physicsManifolds);
+        savedIslands.swap(g_sleepingIslands);
+        savedJoints.swap(g_physicsJoints);
+        savedActive.swap(g_activeCollisions);
+        savedPrev.swap(g_prevCollisions);
+        std::swap(savedBroadphase, g_physicsBroadphase);
+        int savedNextHandle = g_physicsNextHandle;
+        long long savedStepCount = g_physicsStepCount;
+        bool savedEnabled = g_physicsEnabled;
+        PhysicsCollisionCallback savedCallbacks[5] = { g_onCollisionEnter, g_onCollisionStay, g_onCollisionExit, g_onTriggerEnter, g_onTriggerExit };
+        g_onCollisionEnter = g_onCollisionStay = g_onCollisionExit = g_onTriggerEnter = g_onTriggerExit = nullptr;
+        g_physicsEnabled = true;
+        g_physicsNextHandle = 1;
+        g_physicsBroadphase.mode = broadphase;
+        g_physicsBroadphase.margin = savedBroadphase.margin;
+
+        // About 48x48 pixels of room per body; one in ten is static
+        unsigned int seed = 12345u;
+        auto rnd = [&seed]() { seed = seed * 1664525u + 1013904223u; return (seed >> 8) / 16777216.0f; };
+        float side = sqrtf((float)bodyCount) * 48.0f;
+        for (int i = 0; i < bodyCount; i++) {
+            int type = (i % 10 == 0) ? BODY_STATIC : BODY_DYNAMIC;
+            int h = Framework_Physics_CreateBody(type, rnd() * side, rnd() * side);
+            if (i % 2) Framework_Physics_SetBodyCircle(h, 4.0f + rnd() * 8.0f);
+            else Framework_Physics_SetBodyBox(h, 8.0f + rnd() * 16.0f, 8.0f + rnd() * 16.0f);
+            Framework_Physics_SetBodyVelocity(h, (rnd() - 0.5f) * 100.0f, (rnd() - 0.5f) * 100.0f);
+        }
+
+        double start = WallTime_Internal();
+        for (int i = 0; i < steps; i++) Physics_StepOnce(1.0f / 60.0f);
+        double elapsed = WallTime_Internal() - start;
+
+        g_physicsBodies.swap(savedBodies);
+        std::swap(g_physicsStore, savedStore);
+        g_physicsManifolds.swap(savedManifolds);
+        g_sleepingIslands.swap(savedIslands);
+        g_physicsJoints.swap(savedJoints);
+        g_activeCollisions.swap(savedActive);
+        g_prevCollisions.swap(savedPrev);
+        std::swap(g_physicsBroadphase, savedBroadphase);
+        g_physicsMoversDirty = true;
+        g_physicsNextHandle = savedNextHandle;
+        g_physicsStepCount = savedStepCount;
+        g_physicsEnabled = savedEnabled;
+        g_onCollisionEnter = savedCallbacks[0];
+        g_onCollisionStay = savedCallbacks[1];
+        g_onCollisionExit = savedCallbacks[2];
+        g_onTriggerEnter = savedCallbacks[3];
+        g_onTriggerExit = savedCallbacks[4];
+        return (float)(elapsed * 1000.0 / steps);
+    }
+
+#if defined(_MSC_VER)
+#pragma float_control(pop)
+#endif
+
     // ========================================================================
     // BEHAVIOR TREES - AI Decision Making System
     // ========================================================================
@@ -11730,7 +16765,7 @@ extern "C" {
         }
 
         // Pan based on x position (-1 to 1, then convert to 0-1)
-        float screenWidth = (float)GetScreenWidth();
+        float screenWidth = (float)ScreenWidth_Internal();
         if (screenWidth > 0 && distance > 0.01f) {
             float normalizedX = dx / fmaxf(distance, g_spatialMaxDist);
             outPan = 0.5f + normalizedX * 0.5f;
@@ -13384,7 +18419,7 @@ extern "C" {
 
     // Input system update
     void Framework_Input_Update() {
-        float dt = GetFrameTime();
+        float dt = Framework_GetFrameTime();
 
         // Handle rebinding mode
         if (g_isListening) {
@@ -16136,6 +21171,283 @@ extern "C" {
         }
     }
 
+    // ========================================================================
+    // WORLD SNAPSHOTS - In-memory save and restore for rollback
+    // ========================================================================
+    // A snapshot holds the simulation state as bytes: entities and every ECS component,
+    // physics bodies, joints, contacts and sleep state, timers, tweens and the framework RNG.
+    // Buffers are kept between captures, so a ring of snapshots captured every frame stops
+    // allocating once it has seen the largest world. A delta snapshot stores only the byte
+    // runs that differ from its base; restoring it expands the base chain first.
+    // Not covered: raylib's GetRandomValue state, C rand(), particles of non-ECS emitters,
+    // and subsystems outside the list above (FSMs, AI, audio, UI).
+
+    #define WORLD_SNAPSHOT_MAGIC 0x54534757  // 'WGST'
+
+    struct WorldSnapshot {
+        std::vector<uint8_t> data;       // Full state, or runs against 'base' for a delta
+        int base = 0;                    // Snapshot this one is a delta of; 0 = full
+        unsigned int baseGeneration = 0; // Base's capture count when the delta was taken
+        unsigned int generation = 0;     // Bumped by every capture
+        size_t fullSize = 0;             // Bytes of the expanded state
+        double captureMs = 0.0;
+        double restoreMs = 0.0;
+    };
+    static std::unordered_map<int, WorldSnapshot> g_worldSnapshots;
+    static int g_nextWorldSnapshotId = 1;
+    static std::vector<uint8_t> g_snapshotScratch;      // Expanded state of the snapshot in use
+    static std::vector<uint8_t> g_snapshotScratchBase;  // Expanded base while encoding a delta
+
+    static void Snapshot_Body(SnapshotArchive& ar, PhysicsBody& b) {
+        ar.Io(b.handle); ar.Io(b.type); ar.Io(b.valid);
+        if (ar.Loading()) Physics_AttachSlot(b);
+        ar.Io(b.X()); ar.Io(b.Y()); ar.Io(b.rotation);
+        ar.Io(b.VX()); ar.Io(b.VY()); ar.Io(b.angularVelocity);
+        ar.Io(b.ForceX()); ar.Io(b.ForceY()); ar.Io(b.torque);
+        ar.Io(b.mass); ar.Io(b.InvMass()); ar.Io(b.inertia); ar.Io(b.invInertia);
+        ar.Io(b.restitution); ar.Io(b.friction); ar.Io(b.GravityScale());
+        ar.Io(b.LinearDamping()); ar.Io(b.angularDamping);
+        ar.Io(b.fixedRotation); ar.Io(b.sleepingAllowed); ar.Io(b.awake);
+        ar.Io(b.shapeType); ar.Io(b.shapeRadius); ar.Io(b.shapeWidth); ar.Io(b.shapeHeight);
+        ar.Io(b.shapeOffsetX); ar.Io(b.shapeOffsetY); ar.Io(b.polygonVerts);
+        ar.Io(b.layer); ar.Io(b.mask); ar.Io(b.isTrigger);
+        ar.Io(b.boundEntity); ar.Io(b.userData);
+        ar.Io(b.sleepTime); ar.Io(b.sleepIsland);
+        ar.Io(b.ccdMode);
+        // Broadphase membership, island scratch, the sync flag and the CCD sweep are rebuilt by the next step
+    }
+
+    static void Snapshot_Emitter(SnapshotArchive& ar, ParticleEmitterComponent& c) {
+        ar.Io(c.textureHandle); ar.Io(c.sourceRect);
+        ar.Io(c.emissionRate); ar.Io(c.emissionAccum); ar.Io(c.maxParticles);
+        ar.Io(c.lifetimeMin); ar.Io(c.lifetimeMax);
+        ar.Io(c.velocityMinX); ar.Io(c.velocityMinY); ar.Io(c.velocityMaxX); ar.Io(c.velocityMaxY);
+        ar.Io(c.colorStart); ar.Io(c.colorEnd); ar.Io(c.sizeStart); ar.Io(c.sizeEnd);
+        ar.Io(c.gravityX); ar.Io(c.gravityY); ar.Io(c.spreadAngle); ar.Io(c.directionX); ar.Io(c.directionY);
+        ar.Io(c.shape); ar.Io(c.shapeRadius); ar.Io(c.shapeWidth); ar.Io(c.shapeHeight);
+        ar.Io(c.shapeInnerRadius); ar.Io(c.shapeLine); ar.Io(c.edgeEmission);
+        ar.Io(c.rotationMin); ar.Io(c.rotationMax); ar.Io(c.spinMin); ar.Io(c.spinMax);
+        ar.Io(c.blendMode); ar.Io(c.colorStopCount); ar.Io(c.colorStops);
+        ar.Io(c.sizeCurve); ar.Io(c.useSizeCurve);
+        ar.Io(c.drag); ar.Io(c.accelX); ar.Io(c.accelY); ar.Io(c.radialAccel); ar.Io(c.tangentialAccel);
+        ar.Io(c.noiseStrength); ar.Io(c.noiseFrequency); ar.Io(c.noiseScrollSpeed); ar.Io(c.noiseOffset);
+        ar.Io(c.subEmitterOnDeath); ar.Io(c.subEmitterOnBirth);
+        ar.Io(c.trailEnabled); ar.Io(c.trailLength); ar.Io(c.trailWidth); ar.Io(c.trailColor);
+        ar.Io(c.collisionEnabled); ar.Io(c.collisionBounce); ar.Io(c.collisionFriction);
+        ar.Io(c.collisionLifetimeLoss); ar.Io(c.collisionKill);
+        ar.Io(c.animColumns); ar.Io(c.animRows); ar.Io(c.animFPS); ar.Io(c.animRandomStart);
+        ar.Io(c.randomTexture); ar.Io(c.sortMode);
+        ar.Io(c.active); ar.Io(c.particles);
+    }
+
+    // Every Io call runs in the same order for capture and restore
+    static bool Snapshot_Archive(SnapshotArchive& ar) {
+        uint32_t magic = WORLD_SNAPSHOT_MAGIC;
+        ar.Io(magic);
+        if (magic != WORLD_SNAPSHOT_MAGIC) return false;
+
+        // ECS
+        ar.Io(g_nextEntityId);
+        ar.Io(g_entities);
+        ar.Io(g_transform2D);
+        ar.Io(g_transformPrev);
+        ar.Io(g_sprite2D);
+        ar.Io(g_name);
+        ar.Io(g_tag);
+        ar.Io(g_hierarchy);
+        ar.Io(g_velocity2D);
+        ar.Io(g_boxCollider2D);
+        ar.Io(g_enabled);
+        ar.IoMap(g_tilemap, [](SnapshotArchive& a, TilemapComponent& t) {
+            a.Io(t.tilesetHandle); a.Io(t.mapWidth); a.Io(t.mapHeight); a.Io(t.tiles); a.Io(t.solidTiles);
+        });
+        ar.Io(g_animator);
+        ar.IoMap(g_particleEmitter, Snapshot_Emitter);
+
+        // Physics
+        ar.Io(g_physicsNextHandle);
+        if (ar.Loading()) Physics_ClearSlots();
+        ar.IoMap(g_physicsBodies, Snapshot_Body);
+        ar.Io(g_entityToBody);
+        ar.Io(g_physicsManifolds);
+        ar.Io(g_sleepingIslands);
+        ar.Io(g_nextSleepIslandId);
+        ar.Io(g_activeCollisions);
+        ar.Io(g_prevCollisions);
+        ar.Io(g_physicsStepStamp);
+        ar.Io(g_physicsStepCount);
+        ar.Io(g_physicsJoints);
+        ar.Io(g_nextJointHandle);
+
+        // Timers and tweens
+        ar.Io(g_timers);
+        ar.IoMap(g_timerSequences, [](SnapshotArchive& a, TimerSequence& s) {
+            a.Io(s.id); a.Io(s.entries); a.Io(s.elapsed); a.Io(s.duration); a.Io(s.state); a.Io(s.loop);
+        });
+        ar.Io(g_nextTimerId);
+        ar.Io(g_nextTimerSeqId);
+        ar.Io(g_timersPaused);
+        ar.Io(g_globalTimerTimeScale);
+        ar.Io(g_tweens);
+        ar.IoMap(g_sequences, [](SnapshotArchive& a, TweenSequence& s) {
+            a.Io(s.id); a.Io(s.entries); a.Io(s.duration); a.Io(s.elapsed); a.Io(s.state); a.Io(s.autoKill);
+        });
+        ar.Io(g_nextTweenId);
+        ar.Io(g_nextSequenceId);
+        ar.Io(g_globalTweenTimeScale);
+        ar.Io(g_tweensPaused);
+
+        // Random state
+        ar.Io(g_rng);
+        return ar.Ok();
+    }
+
+    // Delta format: full size, then (offset, length, bytes) for each run that differs from the
+    // base. Runs absorb equal gaps shorter than a run header so they don't fragment
+    static void Snapshot_EncodeDelta(const std::vector<uint8_t>& base, const std::vector<uint8_t>& full, std::vector<uint8_t>& out) {
+        out.clear();
+        auto put = [&out](uint32_t v) { const uint8_t* p = (const uint8_t*)&v; out.insert(out.end(), p, p + 4); };
+        put((uint32_t)full.size());
+        size_t n = full.size(), common = std::min(base.size(), n);
+        size_t i = 0;
+        while (i < n) {
+            if (i + 8 <= common && memcmp(&full[i], &base[i], 8) == 0) { i += 8; continue; }
+            if (i < common && full[i] == base[i]) { i++; continue; }
+            size_t start = i, last = i;
+            for (size_t j = i + 1; j < n && j - last <= 8; j++) {
+                if (j >= common || full[j] != base[j]) last = j;
+            }
+            put((uint32_t)start);
+            put((uint32_t)(last - start + 1));
+            out.insert(out.end(), full.begin() + start, full.begin() + last + 1);
+            i = last + 1;
+        }
+    }
+
+    static bool Snapshot_ApplyDelta(const std::vector<uint8_t>& delta, std::vector<uint8_t>& state) {
+        size_t pos = 0;
+        auto get = [&](uint32_t& v) {
+            if (delta.size() - pos < 4) return false;
+            memcpy(&v, &delta[pos], 4);
+            pos += 4;
+            return true;
+        };
+        uint32_t size;
+        if (!get(size)) return false;
+        state.resize(size);
+        while (pos < delta.size()) {
+            uint32_t offset, length;
+            if (!get(offset) || !get(length)) return false;
+            if ((size_t)offset + length > size || delta.size() - pos < length) return false;
+            memcpy(&state[offset], &delta[pos], length);
+            pos += length;
+        }
+        return true;
+    }
+
+    // Full bytes of a snapshot, following its chain of bases
+    static bool Snapshot_Expand(int id, std::vector<uint8_t>& out, int depth) {
+        auto it = g_worldSnapshots.find(id);
+        if (it == g_worldSnapshots.end() || it->second.generation == 0 || depth > 256) return false;
+        const WorldSnapshot& snap = it->second;
+        if (snap.base == 0) { out = snap.data; return true; }
+        auto baseIt = g_worldSnapshots.find(snap.base);
+        if (baseIt == g_worldSnapshots.end() || baseIt->second.generation != snap.baseGeneration) return false;  // Base recaptured
+        return Snapshot_Expand(snap.base, out, depth + 1) && Snapshot_ApplyDelta(snap.data, out);
+    }
+
+    int Framework_Snapshot_Create(int reserveBytes) {
+        int id = g_nextWorldSnapshotId++;
+        WorldSnapshot& snap = g_worldSnapshots[id];
+        if (reserveBytes > 0) snap.data.reserve((size_t)reserveBytes);
+        return id;
+    }
+
+    void Framework_Snapshot_Destroy(int snapshotId) { g_worldSnapshots.erase(snapshotId); }
+
+    bool Framework_Snapshot_Capture(int snapshotId) {
+        auto it = g_worldSnapshots.find(snapshotId);
+        if (it == g_worldSnapshots.end()) return false;
+        WorldSnapshot& snap = it->second;
+        double start = WallTime_Internal();
+        SnapshotArchive ar(snap.data, false);
+        Snapshot_Archive(ar);
+        snap.base = 0;
+        snap.generation++;
+        snap.fullSize = snap.data.size();
+        snap.captureMs = (WallTime_Internal() - start) * 1000.0;
+        return true;
+    }
+
+    // Typically the previous frame's snapshot; the base must stay alive and unrecaptured
+    // for as long as this delta may be restored
+    bool Framework_Snapshot_CaptureDelta(int snapshotId, int baseSnapshotId) {
+        auto it = g_worldSnapshots.find(snapshotId);
+        if (it == g_worldSnapshots.end() || snapshotId == baseSnapshotId) return false;
+        auto baseIt = g_worldSnapshots.find(baseSnapshotId);
+        if (baseIt == g_worldSnapshots.end()) return false;
+        double start = WallTime_Internal();
+        if (!Snapshot_Expand(baseSnapshotId, g_snapshotScratchBase, 0)) return false;
+        SnapshotArchive ar(g_snapshotScratch, false);
+        Snapshot_Archive(ar);
+
+        WorldSnapshot& snap = it->second;
+        Snapshot_EncodeDelta(g_snapshotScratchBase, g_snapshotScratch, snap.data);
+        snap.base = baseSnapshotId;
+        snap.baseGeneration = baseIt->second.generation;
+        snap.generation++;
+        snap.fullSize = g_snapshotScratch.size();
+        snap.captureMs = (WallTime_Internal() - start) * 1000.0;
+        return true;
+    }
+
+    bool Framework_Snapshot_Restore(int snapshotId) {
+        auto it = g_worldSnapshots.find(snapshotId);
+        if (it == g_worldSnapshots.end() || it->second.generation == 0) return false;
+        double start = WallTime_Internal();
+        std::vector<uint8_t>* bytes = &it->second.data;
+        if (it->second.base != 0) {
+            if (!Snapshot_Expand(snapshotId, g_snapshotScratch, 0)) return false;
+            bytes = &g_snapshotScratch;
+        }
+        SnapshotArchive ar(*bytes, true);
+        bool ok = Snapshot_Archive(ar) && ar.AtEnd();
+
+        // Derived physics state is rebuilt against the restored bodies
+        Physics_ResetBroadphase();
+        g_physicsContactEdges.clear();
+        g_physicsSolverContacts.clear();
+        g_physicsSyncQueue.clear();
+        g_physicsMoversDirty = true;
+        it->second.restoreMs = (WallTime_Internal() - start) * 1000.0;
+        return ok;
+    }
+
+    bool Framework_Snapshot_IsValid(int snapshotId) {
+        auto it = g_worldSnapshots.find(snapshotId);
+        return it != g_worldSnapshots.end() && it->second.generation > 0;
+    }
+    bool Framework_Snapshot_IsDelta(int snapshotId) {
+        auto it = g_worldSnapshots.find(snapshotId);
+        return it != g_worldSnapshots.end() && it->second.base != 0;
+    }
+    int Framework_Snapshot_GetSize(int snapshotId) {
+        auto it = g_worldSnapshots.find(snapshotId);
+        return it != g_worldSnapshots.end() ? (int)it->second.data.size() : 0;
+    }
+    int Framework_Snapshot_GetFullSize(int snapshotId) {
+        auto it = g_worldSnapshots.find(snapshotId);
+        return it != g_worldSnapshots.end() ? (int)it->second.fullSize : 0;
+    }
+    float Framework_Snapshot_GetCaptureMs(int snapshotId) {
+        auto it = g_worldSnapshots.find(snapshotId);
+        return it != g_worldSnapshots.end() ? (float)it->second.captureMs : 0.0f;
+    }
+    float Framework_Snapshot_GetRestoreMs(int snapshotId) {
+        auto it = g_worldSnapshots.find(snapshotId);
+        return it != g_worldSnapshots.end() ? (float)it->second.restoreMs : 0.0f;
+    }
+
     // ========================================================================
     // OBJECT POOLING - Efficient object reuse
     // ========================================================================
@@ -18147,6 +23459,7 @@ extern "C" {
 
     // Debug visualization
     void Framework_NavGrid_DrawDebug(int gridId) {
+        if (g_headless) return;
         auto* grid = GetNavGrid(gridId);
         if (!grid) return;
 
@@ -18161,6 +23474,7 @@ extern "C" {
     }
 
     void Framework_Path_DrawDebug(int pathId, unsigned char r, unsigned char g, unsigned char b) {
+        if (g_headless) return;
         auto* path = GetNavPath(pathId);
         if (!path || path->waypoints.size() < 2) return;
 
@@ -18176,6 +23490,7 @@ extern "C" {
     }
 
     void Framework_Steer_DrawDebug(int agentId) {
+        if (g_headless) return;
         auto* agent = GetSteerAgent(agentId);
         if (!agent || !agent->debugEnabled) return;
 
@@ -21373,6 +26688,7 @@ extern "C" {
                 float falloffFactor = powf(1.0f - t, light.falloff);
                 unsigned char alpha = (unsigned char)(255 * effectiveIntensity * falloffFactor);
                 Color c = { light.r, light.g, light.b, alpha };
+                RenderStats_Circle();
                 DrawCircle((int)light.x, (int)light.y, r, c);
             }
         }
@@ -21397,6 +26713,7 @@ extern "C" {
                     Vector2 p2 = { light.x + cosf(a2) * r, light.y + sinf(a2) * r };
                     Vector2 center = { light.x, light.y };
 
+                    RenderStats_Shape(RL_QUADS, 3, 1);
                     DrawTriangle(center, p1, p2, c);
                 }
             }
@@ -21413,8 +26730,8 @@ extern "C" {
             UnloadRenderTexture(g_lighting.sceneBuffer);
         }
 
-        g_lighting.lightMap = LoadRenderTexture(width, height);
-        g_lighting.sceneBuffer = LoadRenderTexture(width, height);
+        g_lighting.lightMap = LoadRenderTexture_Internal(width, height);
+        g_lighting.sceneBuffer = LoadRenderTexture_Internal(width, height);
         g_lighting.hasRenderTargets = true;
         g_lighting.initialized = true;
     }
@@ -21820,21 +27137,30 @@ extern "C" {
 
     // ---- Rendering ----
     void Framework_Lighting_BeginLightPass() {
+        if (g_headless) return;
         if (!g_lighting.initialized || !g_lighting.hasRenderTargets) return;
 
+        RenderList_Flush();
+        RenderStats_Target(g_lighting.sceneBuffer.id);
         BeginTextureMode(g_lighting.sceneBuffer);
         ClearBackground(BLACK);
     }
 
     void Framework_Lighting_EndLightPass() {
+        if (g_headless) return;
         if (!g_lighting.initialized || !g_lighting.hasRenderTargets) return;
-        EndTextureMode();
+        Canvas_EndTextureMode();
     }
 
     void Framework_Lighting_RenderToScreen() {
+        if (g_headless) return;
         if (!g_lighting.initialized || !g_lighting.hasRenderTargets || !g_lighting.enabled) return;
 
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_EFFECTS);
+        RenderList_Flush();
+
         // Render light map
+        RenderStats_Target(g_lighting.lightMap.id);
         BeginTextureMode(g_lighting.lightMap);
 
         // Start with ambient color
@@ -21867,6 +27193,7 @@ extern "C" {
         ClearBackground({ (unsigned char)(ambR * ambInt), (unsigned char)(ambG * ambInt), (unsigned char)(ambB * ambInt), 255 });
 
         // Draw all lights with additive blending
+        RenderStats_Flush();
         BeginBlendMode(BLEND_ADDITIVE);
 
         for (auto& kv : g_lights) {
@@ -21889,10 +27216,12 @@ extern "C" {
             DrawLight2D(light, effectiveIntensity);
         }
 
+        RenderStats_Flush();
         EndBlendMode();
-        EndTextureMode();
+        Canvas_EndTextureMode();
 
         // Draw scene with lighting applied
+        RenderStats_Quad(g_lighting.sceneBuffer.texture.id);
         DrawTextureRec(
             g_lighting.sceneBuffer.texture,
             { 0, 0, (float)g_lighting.width, -(float)g_lighting.height },
@@ -21901,13 +27230,16 @@ extern "C" {
         );
 
         // Apply light map with multiply blend
+        RenderStats_Flush();
         BeginBlendMode(BLEND_MULTIPLIED);
+        RenderStats_Quad(g_lighting.lightMap.texture.id);
         DrawTextureRec(
             g_lighting.lightMap.texture,
             { 0, 0, (float)g_lighting.width, -(float)g_lighting.height },
             { 0, 0 },
             WHITE
         );
+        RenderStats_Flush();
         EndBlendMode();
     }
 
@@ -22176,8 +27508,8 @@ extern "C" {
             UnloadRenderTexture(g_effects.effectBuffer);
         }
 
-        g_effects.sceneBuffer = LoadRenderTexture(width, height);
-        g_effects.effectBuffer = LoadRenderTexture(width, height);
+        g_effects.sceneBuffer = LoadRenderTexture_Internal(width, height);
+        g_effects.effectBuffer = LoadRenderTexture_Internal(width, height);
         g_effects.hasRenderTargets = true;
         g_effects.initialized = true;
     }
@@ -22357,19 +27689,25 @@ extern "C" {
 
     // ---- Rendering ----
     void Framework_Effects_BeginCapture() {
+        if (g_headless) return;
         if (!g_effects.initialized || !g_effects.hasRenderTargets) return;
         g_effects.isCapturing = true;
+        RenderList_Flush();
+        RenderStats_Target(g_effects.sceneBuffer.id);
         BeginTextureMode(g_effects.sceneBuffer);
         ClearBackground(BLACK);
     }
 
     void Framework_Effects_EndCapture() {
+        if (g_headless) return;
         if (!g_effects.initialized || !g_effects.hasRenderTargets || !g_effects.isCapturing) return;
-        EndTextureMode();
+        Canvas_EndTextureMode();
         g_effects.isCapturing = false;
     }
 
     void Framework_Effects_Apply() {
+        if (g_headless) return;
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_EFFECTS);
         // Only draw from buffer if we actually captured to it
         bool shouldDrawBuffer = g_effects.initialized && g_effects.hasRenderTargets && !g_effects.isCapturing;
 
@@ -22396,16 +27734,19 @@ extern "C" {
                 tint.b = 200;
             }
 
+            RenderStats_Quad(g_effects.sceneBuffer.texture.id);
             DrawTextureRec(g_effects.sceneBuffer.texture, srcRect, pos, tint);
         } else {
             // Debug: show red if capture system failed
+            RenderStats_Shape(RL_QUADS, 4, 2);
             DrawRectangle(0, 0, 100, 30, RED);
+            RenderStats_Text(GetFontDefault().texture.id, "CAPTURE FAILED");
             DrawText("CAPTURE FAILED", 5, 5, 10, WHITE);
         }
 
         // Get screen dimensions for overlays
-        int screenW = g_effects.initialized ? g_effects.width : GetScreenWidth();
-        int screenH = g_effects.initialized ? g_effects.height : GetScreenHeight();
+        int screenW = g_effects.initialized ? g_effects.width : ScreenWidth_Internal();
+        int screenH = g_effects.initialized ? g_effects.height : ScreenHeight_Internal();
 
         // Apply scanlines (overlay effect)
         if (g_effects.enabled && g_effects.scanlinesEnabled) {
@@ -22413,6 +27754,7 @@ extern "C" {
             for (int i = 0; i < g_effects.scanlinesCount; i++) {
                 float y = i * lineHeight + g_effects.scanlinesOffset;
                 while (y >= screenH) y -= screenH;
+                RenderStats_Shape(RL_QUADS, 4, 2);
                 DrawRectangle(0, (int)y, screenW, (int)(lineHeight * 0.5f),
                     { 0, 0, 0, (unsigned char)(255 * g_effects.scanlinesIntensity) });
             }
@@ -22435,6 +27777,7 @@ extern "C" {
 
                     if (vignette < 1.0f) {
                         unsigned char alpha = (unsigned char)((1.0f - vignette) * 255);
+                        RenderStats_Shape(RL_QUADS, 4, 2);
                         DrawRectangle(x, y, 4, 4, { g_effects.vignetteR, g_effects.vignetteG, g_effects.vignetteB, alpha });
                     }
                 }
@@ -22448,6 +27791,7 @@ extern "C" {
                     float noise = (float)(rand() % 1000) / 1000.0f - 0.5f;
                     int gray = (int)(128 + noise * 255 * g_effects.filmGrainIntensity);
                     gray = gray < 0 ? 0 : (gray > 255 ? 255 : gray);
+                    RenderStats_Shape(RL_QUADS, 4, 2);
                     DrawRectangle(x, y, 2, 2, { (unsigned char)gray, (unsigned char)gray, (unsigned char)gray, 30 });
                 }
             }
@@ -22456,23 +27800,28 @@ extern "C" {
         // Apply flash overlay (always works, no initialization needed)
         if (g_effects.flashActive && g_effects.flashTimer > 0) {
             float alpha = g_effects.flashTimer / g_effects.flashDuration;
+            RenderStats_Shape(RL_QUADS, 4, 2);
             DrawRectangle(0, 0, screenW, screenH,
                 { g_effects.flashR, g_effects.flashG, g_effects.flashB, (unsigned char)(alpha * 200) });
         }
 
         // Apply fade overlay (always works, no initialization needed)
         if (g_effects.fadeAmount > 0) {
+            RenderStats_Shape(RL_QUADS, 4, 2);
             DrawRectangle(0, 0, screenW, screenH,
                 { g_effects.fadeR, g_effects.fadeG, g_effects.fadeB, (unsigned char)(g_effects.fadeAmount * 255) });
         }
 
         // Apply tint (overlay effect)
         if (g_effects.enabled && g_effects.tintEnabled) {
+            RenderStats_Flush();
             BeginBlendMode(BLEND_MULTIPLIED);
             unsigned char tr = (unsigned char)(255 - (255 - g_effects.tintR) * g_effects.tintAmount);
             unsigned char tg = (unsigned char)(255 - (255 - g_effects.tintG) * g_effects.tintAmount);
             unsigned char tb = (unsigned char)(255 - (255 - g_effects.tintB) * g_effects.tintAmount);
+            RenderStats_Shape(RL_QUADS, 4, 2);
             DrawRectangle(0, 0, screenW, screenH, { tr, tg, tb, 255 });
+            RenderStats_Flush();
             EndBlendMode();
         }
     }
@@ -22480,12 +27829,15 @@ extern "C" {
     // Draw overlay effects without requiring render texture initialization
     // Call this at the end of your OnDraw to add flash, fade, shake overlays
     void Framework_Effects_DrawOverlays(int screenWidth, int screenHeight) {
+        if (g_headless) return;
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_EFFECTS);
         // Apply scanlines
         if (g_effects.scanlinesEnabled) {
             float lineHeight = (float)screenHeight / g_effects.scanlinesCount;
             for (int i = 0; i < g_effects.scanlinesCount; i++) {
                 float y = i * lineHeight + g_effects.scanlinesOffset;
                 while (y >= screenHeight) y -= screenHeight;
+                RenderStats_Shape(RL_QUADS, 4, 2);
                 DrawRectangle(0, (int)y, screenWidth, (int)(lineHeight * 0.5f),
                     { 0, 0, 0, (unsigned char)(255 * g_effects.scanlinesIntensity) });
             }
@@ -22508,6 +27860,7 @@ extern "C" {
 
                     if (vignette < 1.0f) {
                         unsigned char alpha = (unsigned char)((1.0f - vignette) * 255);
+                        RenderStats_Shape(RL_QUADS, 4, 2);
                         DrawRectangle(x, y, 4, 4, { g_effects.vignetteR, g_effects.vignetteG, g_effects.vignetteB, alpha });
                     }
                 }
@@ -22517,12 +27870,14 @@ extern "C" {
         // Apply flash overlay
         if (g_effects.flashActive && g_effects.flashTimer > 0) {
             float alpha = g_effects.flashTimer / g_effects.flashDuration;
+            RenderStats_Shape(RL_QUADS, 4, 2);
             DrawRectangle(0, 0, screenWidth, screenHeight,
                 { g_effects.flashR, g_effects.flashG, g_effects.flashB, (unsigned char)(alpha * 200) });
         }
 
         // Apply fade overlay
         if (g_effects.fadeAmount > 0) {
+            RenderStats_Shape(RL_QUADS, 4, 2);
             DrawRectangle(0, 0, screenWidth, screenHeight,
                 { g_effects.fadeR, g_effects.fadeG, g_effects.fadeB, (unsigned char)(g_effects.fadeAmount * 255) });
         }
@@ -22664,10 +28019,15 @@ extern "C" {
         }
         g_texByHandle.clear();
         g_handleByTexPath.clear();
+        if (g_particleCircleTex.id != 0) {
+            UnloadTexture(g_particleCircleTex);
+            g_particleCircleTex = Texture2D{};
+        }
 
         // Fonts
+        TextLayout_Clear();
         for (auto& kv : g_fontByHandle) {
-            if (kv.second.valid) UnloadFont(kv.second.font);
+            if (kv.second.valid) UnloadFont_Internal(kv.second.font);
         }
         g_fontByHandle.clear();
         g_handleByFontKey.clear();
@@ -23029,7 +28389,7 @@ extern "C" {
         auto it = g_achievements.achievements.find(achievementId);
         if (it != g_achievements.achievements.end() && !it->second.unlocked) {
             it->second.unlocked = true;
-            it->second.unlockTime = (float)GetTime();
+            it->second.unlockTime = (float)Framework_GetTime();
 
             // Add notification
             if (g_achievements.notificationsEnabled) {
@@ -23148,6 +28508,7 @@ extern "C" {
     }
 
     void Framework_Achievement_DrawNotifications() {
+        if (g_headless) return;
         int y = g_achievements.notificationY;
         for (const auto& notif : g_achievements.notifications) {
             auto it = g_achievements.achievements.find(notif.achievementId);
@@ -23670,6 +29031,7 @@ extern "C" {
     }
 
     void Framework_Cutscene_DrawDialogue() {
+        if (g_headless) return;
         if (g_cutscene.activeCutscene == 0) return;
 
         Cutscene* cs = GetCutscene(g_cutscene.activeCutscene);
@@ -24195,20 +29557,29 @@ extern "C" {
     }
 
     void Framework_Batch_Draw(int batchId) {
+        if (g_headless) return;
         auto* batch = GetBatch(batchId);
         if (!batch) return;
 
+        // rlgl starts a new draw call whenever the bound texture changes
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_SPRITE_BATCH);
+        RenderListOrderedScope orderedScope;
         batch->lastDrawCalls = 0;
+        int currentTex = -1;
         for (auto& sprite : batch->sprites) {
             auto texIt = g_texByHandle.find(sprite.textureHandle);
             if (texIt == g_texByHandle.end() || !texIt->second.valid) continue;
 
-            DrawTexturePro(texIt->second.tex, sprite.src, sprite.dest, sprite.origin, sprite.rotation, sprite.tint);
-            batch->lastDrawCalls++;
+            if (sprite.textureHandle != currentTex) {
+                currentTex = sprite.textureHandle;
+                batch->lastDrawCalls++;
+            }
+            DrawTextureQuad(texIt->second.tex, sprite.src, sprite.dest, sprite.origin, sprite.rotation, sprite.tint);
         }
     }
 
     void Framework_Batch_DrawSorted(int batchId) {
+        if (g_headless) return;
         auto* batch = GetBatch(batchId);
         if (!batch) return;
 
@@ -24217,6 +29588,7 @@ extern "C" {
                 return a.textureHandle < b.textureHandle;
             });
 
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_SPRITE_BATCH);
         batch->lastDrawCalls = 0;
         int currentTex = -1;
         for (auto& sprite : batch->sprites) {
@@ -24227,7 +29599,7 @@ extern "C" {
                 currentTex = sprite.textureHandle;
                 batch->lastDrawCalls++;
             }
-            DrawTexturePro(texIt->second.tex, sprite.src, sprite.dest, sprite.origin, sprite.rotation, sprite.tint);
+            DrawTextureQuad(texIt->second.tex, sprite.src, sprite.dest, sprite.origin, sprite.rotation, sprite.tint);
         }
     }
 
@@ -24351,7 +29723,8 @@ extern "C" {
         auto texIt = g_texByHandle.find(textureHandle);
         if (texIt == g_texByHandle.end() || !texIt->second.valid) return -1;
 
-        Image img = LoadImageFromTexture(texIt->second.tex);
+        // Headless textures have no GPU copy to read back, so re-decode the source
+        Image img = g_headless ? LoadImage(texIt->second.path.c_str()) : LoadImageFromTexture(texIt->second.tex);
         Image region = ImageFromImage(img, { (float)srcX, (float)srcY, (float)srcW, (float)srcH });
         UnloadImage(img);
 
@@ -24388,7 +29761,7 @@ extern "C" {
         auto* atlas = GetAtlas(atlasId);
         if (!atlas || atlas->packed) return false;
 
-        Texture2D tex = LoadTextureFromImage(atlas->atlasImage);
+        Texture2D tex = LoadTextureFromImage_Internal(atlas->atlasImage);
         atlas->textureHandle = g_nextTexHandle++;
         TexEntry entry;
         entry.tex = tex;
@@ -24438,6 +29811,7 @@ extern "C" {
 
     void Framework_Atlas_DrawSprite(int atlasId, int spriteIndex, float x, float y,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         auto* atlas = GetAtlas(atlasId);
         if (!atlas || !atlas->packed || spriteIndex < 0 || spriteIndex >= (int)atlas->sprites.size()) return;
 
@@ -24450,6 +29824,7 @@ extern "C" {
 
     void Framework_Atlas_DrawSpriteEx(int atlasId, int spriteIndex, float x, float y,
         float rotation, float scale, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         auto* atlas = GetAtlas(atlasId);
         if (!atlas || !atlas->packed || spriteIndex < 0 || spriteIndex >= (int)atlas->sprites.size()) return;
 
@@ -24464,6 +29839,7 @@ extern "C" {
     void Framework_Atlas_DrawSpritePro(int atlasId, int spriteIndex,
         float destX, float destY, float destW, float destH, float originX, float originY, float rotation,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         auto* atlas = GetAtlas(atlasId);
         if (!atlas || !atlas->packed || spriteIndex < 0 || spriteIndex >= (int)atlas->sprites.size()) return;
 
@@ -24486,7 +29862,7 @@ extern "C" {
         atlas.height = img.height;
         atlas.atlasImage = img;
 
-        Texture2D tex = LoadTextureFromImage(img);
+        Texture2D tex = LoadTextureFromImage_Internal(img);
         atlas.textureHandle = g_nextTexHandle++;
         TexEntry entry;
         entry.tex = tex;
@@ -24845,6 +30221,7 @@ extern "C" {
     }
 
     void Framework_Level_Draw(int levelId, int tilesetHandle, int tilesPerRow) {
+        if (g_headless) return;
         auto* level = GetLevel(levelId);
         if (!level) return;
         ClearBackground(level->bgColor);
@@ -24853,21 +30230,25 @@ extern "C" {
     }
 
     void Framework_Level_DrawLayer(int levelId, int layerIndex, int tilesetHandle, int tilesPerRow) {
+        if (g_headless) return;
         auto* level = GetLevel(levelId);
         if (!level || layerIndex < 0 || layerIndex >= (int)level->layers.size()) return;
         if (!level->layers[layerIndex].visible) return;
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_TILEMAPS);
 
         auto texIt = g_texByHandle.find(tilesetHandle);
         if (texIt == g_texByHandle.end() || !texIt->second.valid) return;
 
         int tw = level->tileWidth, th = level->tileHeight;
-        for (auto& kv : level->layers[layerIndex].tiles) {
+        const auto& tiles = level->layers[layerIndex].tiles;
+        QuadStream qs(texIt->second.tex.id, (int)tiles.size());
+        for (auto& kv : tiles) {
             int x = kv.first % level->widthTiles, y = kv.first / level->widthTiles;
             int tileId = kv.second;
             if (tileId < 0) continue;
             Rectangle src = { (float)((tileId % tilesPerRow) * tw), (float)((tileId / tilesPerRow) * th), (float)tw, (float)th };
             Rectangle dest = { (float)(x * tw), (float)(y * th), (float)tw, (float)th };
-            DrawTexturePro(texIt->second.tex, src, dest, { 0, 0 }, 0, WHITE);
+            StreamTextureQuad(qs, texIt->second.tex, src, dest, { 0, 0 }, 0, WHITE);
         }
     }
 
@@ -25838,7 +31219,7 @@ extern "C" {
     }
 
     int Framework_Shader_Load(const char* vsPath, const char* fsPath) {
-        Shader s = LoadShader(vsPath, fsPath);
+        Shader s = LoadShader_Internal(vsPath, fsPath);
         if (s.id == 0) return 0;
         ManagedShader ms;
         ms.id = g_nextShaderId++;
@@ -25849,7 +31230,7 @@ extern "C" {
     }
 
     int Framework_Shader_LoadFromMemory(const char* vsCode, const char* fsCode) {
-        Shader s = LoadShaderFromMemory(vsCode, fsCode);
+        Shader s = LoadShaderFromMemory_Internal(vsCode, fsCode);
         if (s.id == 0) return 0;
         ManagedShader ms;
         ms.id = g_nextShaderId++;
@@ -25873,14 +31254,20 @@ extern "C" {
     }
 
     void Framework_Shader_Begin(int shaderId) {
+        if (g_headless) return;
         auto* ms = GetShader(shaderId);
         if (ms && ms->valid) {
+            RenderList_Flush();
+            RenderStats_Shader(ms->shader.id);
             BeginShaderMode(ms->shader);
             g_activeShader = shaderId;
         }
     }
 
     void Framework_Shader_End() {
+        if (g_headless) return;
+        RenderList_Flush();
+        RenderStats_Shader(0);
         EndShaderMode();
         g_activeShader = 0;
     }
@@ -25904,16 +31291,19 @@ extern "C" {
     }
 
     void Framework_Shader_SetInt(int shaderId, int loc, int value) {
+        if (g_headless) return;
         auto* ms = GetShader(shaderId);
         if (ms && ms->valid && loc >= 0) SetShaderValue(ms->shader, loc, &value, SHADER_UNIFORM_INT);
     }
 
     void Framework_Shader_SetFloat(int shaderId, int loc, float value) {
+        if (g_headless) return;
         auto* ms = GetShader(shaderId);
         if (ms && ms->valid && loc >= 0) SetShaderValue(ms->shader, loc, &value, SHADER_UNIFORM_FLOAT);
     }
 
     void Framework_Shader_SetVec2(int shaderId, int loc, float x, float y) {
+        if (g_headless) return;
         auto* ms = GetShader(shaderId);
         if (ms && ms->valid && loc >= 0) {
             float v[2] = { x, y };
@@ -25922,6 +31312,7 @@ extern "C" {
     }
 
     void Framework_Shader_SetVec3(int shaderId, int loc, float x, float y, float z) {
+        if (g_headless) return;
         auto* ms = GetShader(shaderId);
         if (ms && ms->valid && loc >= 0) {
             float v[3] = { x, y, z };
@@ -25930,6 +31321,7 @@ extern "C" {
     }
 
     void Framework_Shader_SetVec4(int shaderId, int loc, float x, float y, float z, float w) {
+        if (g_headless) return;
         auto* ms = GetShader(shaderId);
         if (ms && ms->valid && loc >= 0) {
             float v[4] = { x, y, z, w };
@@ -25938,6 +31330,7 @@ extern "C" {
     }
 
     void Framework_Shader_SetMat4(int shaderId, int loc, const float* matrix) {
+        if (g_headless) return;
         auto* ms = GetShader(shaderId);
         if (ms && ms->valid && loc >= 0 && matrix) {
             SetShaderValueMatrix(ms->shader, loc, *(Matrix*)matrix);
@@ -25945,6 +31338,7 @@ extern "C" {
     }
 
     void Framework_Shader_SetTexture(int shaderId, int loc, int textureHandle) {
+        if (g_headless) return;
         auto* ms = GetShader(shaderId);
         auto* tex = GetTextureH_Internal(textureHandle);
         if (ms && ms->valid && loc >= 0 && tex) {
@@ -26412,11 +31806,6 @@ extern "C" {
                 bone.worldRotation = parent.worldRotation + bone.localRotation;
             }
         }
-
-        float LerpAngle(float a, float b, float t) {
-            float diff = fmodf(b - a + 540.0f, 360.0f) - 180.0f;
-            return a + diff * t;
-        }
     }
 
     int Framework_Skeleton_Create(const char* name) {
@@ -26779,8 +32168,11 @@ extern "C" {
     }
 
     void Framework_Skeleton_Draw(int skeletonId, float x, float y, float scale, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         auto* skel = GetSkeleton(skeletonId);
         if (!skel) return;
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_SKELETONS);
+        RenderListOrderedScope orderedScope;
         for (auto& bone : skel->bones) {
             if (bone.sprite.textureHandle < 0) continue;
             auto* tex = GetTextureH_Internal(bone.sprite.textureHandle);
@@ -26791,20 +32183,24 @@ extern "C" {
             if (!bone.sprite.hasRegion) { src.width = (float)tex->width; src.height = (float)tex->height; }
             Rectangle dest = { bx + bone.sprite.offsetX * scale, by + bone.sprite.offsetY * scale, src.width * scale * bone.localScaleX, src.height * scale * bone.localScaleY };
             Vector2 origin = { dest.width / 2, dest.height / 2 };
-            DrawTexturePro(*tex, src, dest, origin, bone.worldRotation, { r, g, b, a });
+            DrawTextureQuad(*tex, src, dest, origin, bone.worldRotation, { r, g, b, a });
         }
     }
 
     void Framework_Skeleton_DrawDebug(int skeletonId, float x, float y, float scale) {
+        if (g_headless) return;
         auto* skel = GetSkeleton(skeletonId);
         if (!skel) return;
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_DEBUG);
         for (auto& bone : skel->bones) {
             float bx = x + bone.worldX * scale;
             float by = y + bone.worldY * scale;
             float rad = bone.worldRotation * DEG2RAD;
             float ex = bx + cosf(rad) * bone.length * scale;
             float ey = by + sinf(rad) * bone.length * scale;
+            RenderStats_Shape(RL_TRIANGLES, 4, 2);
             DrawLineEx({ bx, by }, { ex, ey }, 2, YELLOW);
+            RenderStats_Circle();
             DrawCircle((int)bx, (int)by, 4, RED);
         }
     }
@@ -27048,21 +32444,29 @@ extern "C" {
     }
 
     void Framework_Cmd_Draw() {
+        if (g_headless) return;
         if (!g_cmdVisible) return;
-        int screenW = GetScreenWidth(), screenH = GetScreenHeight();
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_DEBUG);
+        int screenW = ScreenWidth_Internal(), screenH = ScreenHeight_Internal();
         int consoleH = screenH / 2;
 
+        RenderStats_Shape(RL_QUADS, 4, 2);
         DrawRectangle(0, 0, screenW, consoleH, g_cmdBgColor);
+        RenderStats_Shape(RL_QUADS, 4, 2);
         DrawRectangle(0, consoleH - 2, screenW, 2, WHITE);
 
         int y = consoleH - 30;
         for (int i = (int)g_cmdLines.size() - 1; i >= 0 && y > 5; i--) {
+            RenderStats_Text(GetFontDefault().texture.id, g_cmdLines[i].text.c_str());
             DrawText(g_cmdLines[i].text.c_str(), 10, y, g_cmdFontSize, g_cmdLines[i].color);
             y -= g_cmdFontSize + 2;
         }
 
+        RenderStats_Shape(RL_QUADS, 4, 2);
         DrawRectangle(5, consoleH - 25, screenW - 10, 20, { 30, 30, 40, 255 });
-        DrawText(("> " + g_cmdInput + "_").c_str(), 10, consoleH - 23, g_cmdFontSize, GREEN);
+        std::string prompt = "> " + g_cmdInput + "_";
+        RenderStats_Text(GetFontDefault().texture.id, prompt.c_str());
+        DrawText(prompt.c_str(), 10, consoleH - 23, g_cmdFontSize, GREEN);
     }
 
     void Framework_Cmd_HandleInput() {
@@ -27684,13 +33088,20 @@ extern "C" {
     }
 
     bool Framework_Asset_GenerateBitmapFont(const char* ttfPath, const char* outputPath, int fontSize, const char* characters) {
-        Font font = LoadFontEx(ttfPath, fontSize, nullptr, 0);
-        if (font.texture.id == 0) return false;
-
-        Image atlas = LoadImageFromTexture(font.texture);
+        Font font = LoadFontEx_Internal(ttfPath, fontSize, nullptr, 0);
+        if (!FontLoaded_Internal(font)) return false;
+
+        Image atlas;
+        if (g_headless) {
+            Rectangle* recs = nullptr;
+            atlas = GenImageFontAtlas(font.glyphs, &recs, font.glyphCount, fontSize, font.glyphPadding, 0);
+            MemFree(recs);
+        } else {
+            atlas = LoadImageFromTexture(font.texture);
+        }
         bool result = ExportImage(atlas, outputPath);
         UnloadImage(atlas);
-        UnloadFont(font);
+        UnloadFont_Internal(font);
         return result;
     }
 
@@ -27705,12 +33116,12 @@ extern "C" {
             }
             UnloadImage(img);
         } else {
-            Font font = LoadFontEx(fontPath, 20, nullptr, 0);
-            if (font.texture.id == 0) {
+            Font font = LoadFontEx_Internal(fontPath, 20, nullptr, 0);
+            if (!FontLoaded_Internal(font)) {
                 g_assetPipeline.validationErrors.push_back("Failed to load TTF font");
                 return false;
             }
-            UnloadFont(font);
+            UnloadFont_Internal(font);
         }
         return true;
     }
@@ -27834,6 +33245,7 @@ extern "C" {
 
     void Framework_DrawBezierQuad(float x0, float y0, float cx, float cy, float x1, float y1,
         float thick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         Color col = { r, g, b, a };
         const int segments = 24;
         Vector2 prev = { x0, y0 };
@@ -27850,6 +33262,7 @@ extern "C" {
 
     void Framework_DrawBezierCubic(float x0, float y0, float cx0, float cy0, float cx1, float cy1, float x1, float y1,
         float thick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         Color col = { r, g, b, a };
         const int segments = 24;
         Vector2 prev = { x0, y0 };
@@ -27904,6 +33317,7 @@ extern "C" {
 
     void Framework_DrawSpline(const float* points, int pointCount, float thick,
         unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         if (!points || pointCount < 2) return;
         Color col = { r, g, b, a };
         const int segments = 20;
@@ -27960,12 +33374,14 @@ extern "C" {
     void Framework_DrawGradientRectH(int x, int y, int width, int height,
         unsigned char r1, unsigned char g1, unsigned char b1, unsigned char a1,
         unsigned char r2, unsigned char g2, unsigned char b2, unsigned char a2) {
+        if (g_headless) return;
         DrawRectangleGradientH(x, y, width, height, Color{ r1, g1, b1, a1 }, Color{ r2, g2, b2, a2 });
     }
 
     void Framework_DrawGradientRectV(int x, int y, int width, int height,
         unsigned char r1, unsigned char g1, unsigned char b1, unsigned char a1,
         unsigned char r2, unsigned char g2, unsigned char b2, unsigned char a2) {
+        if (g_headless) return;
         DrawRectangleGradientV(x, y, width, height, Color{ r1, g1, b1, a1 }, Color{ r2, g2, b2, a2 });
     }
 
@@ -27974,6 +33390,7 @@ extern "C" {
         unsigned char trR, unsigned char trG, unsigned char trB, unsigned char trA,
         unsigned char blR, unsigned char blG, unsigned char blB, unsigned char blA,
         unsigned char brR, unsigned char brG, unsigned char brB, unsigned char brA) {
+        if (g_headless) return;
         DrawRectangleGradientEx(
             Rectangle{ (float)x, (float)y, (float)width, (float)height },
             Color{ tlR, tlG, tlB, tlA },
@@ -27985,6 +33402,7 @@ extern "C" {
     void Framework_DrawGradientCircle(int centerX, int centerY, float radius, int segments,
         unsigned char r1, unsigned char g1, unsigned char b1, unsigned char a1,
         unsigned char r2, unsigned char g2, unsigned char b2, unsigned char a2) {
+        if (g_headless) return;
         if (segments < 3) segments = 36;
         Color centerCol = { r1, g1, b1, a1 };
         Color edgeCol = { r2, g2, b2, a2 };
@@ -28012,6 +33430,7 @@ extern "C" {
     void Framework_DrawGradientLine(float x0, float y0, float x1, float y1, float thick,
         unsigned char r1, unsigned char g1, unsigned char b1, unsigned char a1,
         unsigned char r2, unsigned char g2, unsigned char b2, unsigned char a2) {
+        if (g_headless) return;
         // Build a quad along the line direction
         float dx = x1 - x0;
         float dy = y1 - y0;
@@ -28060,6 +33479,8 @@ extern "C" {
     };
 
     static std::vector<ParallaxLayer> g_parallaxLayers;
+    static std::vector<int> g_parallaxOrder;      // Active layers by zOrder, re-sorted only when dirty
+    static bool g_parallaxOrderDirty = true;
 
     static int FindFreeParallaxSlot() {
         for (size_t i = 0; i < g_parallaxLayers.size(); i++) {
@@ -28077,12 +33498,14 @@ extern "C" {
         layer.textureHandle = textureHandle;
         layer.scrollSpeedX = scrollSpeedX;
         layer.scrollSpeedY = scrollSpeedY;
+        g_parallaxOrderDirty = true;
         return id;
     }
 
     void Framework_Parallax_DestroyLayer(int layerId) {
         if (layerId < 0 || layerId >= (int)g_parallaxLayers.size()) return;
         g_parallaxLayers[layerId].active = false;
+        g_parallaxOrderDirty = true;
     }
 
     bool Framework_Parallax_IsValid(int layerId) {
@@ -28143,6 +33566,7 @@ extern "C" {
     void Framework_Parallax_SetZOrder(int layerId, int zOrder) {
         if (!Framework_Parallax_IsValid(layerId)) return;
         g_parallaxLayers[layerId].zOrder = zOrder;
+        g_parallaxOrderDirty = true;
     }
 
     int Framework_Parallax_GetZOrder(int layerId) {
@@ -28167,8 +33591,11 @@ extern "C" {
         *velY = g_parallaxLayers[layerId].autoScrollVelY;
     }
 
-    // Helper: draw a single parallax layer
-    static void DrawParallaxLayerInternal(ParallaxLayer& layer, float cameraX, float cameraY) {
+    // Helper: draw a single parallax layer as one batched QuadStream run. Each visible tile is a
+    // quad clipped to the screen, so the vertex count grows with the tiles on screen rather than
+    // the layer's size. The texture's wrap mode is left alone so sprites and tilemaps sharing it
+    // keep their edge sampling. Consecutive layers on one texture share a draw call.
+    static void DrawParallaxLayerInternal(const ParallaxLayer& layer, float cameraX, float cameraY) {
         if (!layer.active || !layer.visible || layer.textureHandle < 0) return;
         auto it = g_texByHandle.find(layer.textureHandle);
         if (it == g_texByHandle.end() || !it->second.valid) return;
@@ -28183,55 +33610,64 @@ extern "C" {
         float px = -cameraX * layer.scrollSpeedX + layer.offsetX + layer.autoScrollAccumX;
         float py = -cameraY * layer.scrollSpeedY + layer.offsetY + layer.autoScrollAccumY;
 
-        int screenW = GetScreenWidth();
-        int screenH = GetScreenHeight();
-
-        if (layer.repeatX || layer.repeatY) {
-            // Wrap the offset
-            if (layer.repeatX) {
-                px = fmodf(px, texW);
-                if (px > 0) px -= texW;
-            }
-            if (layer.repeatY) {
-                py = fmodf(py, texH);
-                if (py > 0) py -= texH;
-            }
-
-            // Tile the texture across the screen
-            int tilesX = layer.repeatX ? (int)(screenW / texW) + 2 : 1;
-            int tilesY = layer.repeatY ? (int)(screenH / texH) + 2 : 1;
-
-            for (int ty = 0; ty < tilesY; ty++) {
-                for (int tx = 0; tx < tilesX; tx++) {
-                    Rectangle src = { 0, 0, (float)tex.width, (float)tex.height };
-                    Rectangle dst = { px + tx * texW, py + ty * texH, texW, texH };
-                    DrawTexturePro(tex, src, dst, Vector2{ 0, 0 }, 0.0f, layer.tint);
-                }
+        float screenW = (float)ScreenWidth_Internal();
+        float screenH = (float)ScreenHeight_Internal();
+
+        // Repeating axes are tiled with one quad per copy, starting a tile before the wrapped
+        // offset so the screen edge is covered. Switching the texture to repeat wrapping instead
+        // would change edge sampling for every sprite and tilemap sharing it.
+        if (layer.repeatX) px = fmodf(px, texW);
+        if (layer.repeatY) py = fmodf(py, texH);
+        float startX = (layer.repeatX && px > 0.0f) ? px - texW : px;
+        float startY = (layer.repeatY && py > 0.0f) ? py - texH : py;
+        float endX = layer.repeatX ? screenW : px + texW;
+        float endY = layer.repeatY ? screenH : py + texH;
+        if (endX <= 0.0f || endY <= 0.0f || startX >= screenW || startY >= screenH) return;  // Entirely off screen
+        int tilesX = std::max(1, (int)ceilf((endX - startX) / texW));
+        int tilesY = std::max(1, (int)ceilf((endY - startY) / texH));
+
+        QuadStream qs(tex.id, tilesX * tilesY);
+        for (int ty = 0; ty < tilesY; ty++) {
+            float tileY = startY + ty * texH;
+            float y0 = fmaxf(tileY, 0.0f), y1 = fminf(tileY + texH, screenH);
+            if (y1 <= y0) continue;
+            float v0 = (y0 - tileY) / texH, v1 = (y1 - tileY) / texH;
+            for (int tx = 0; tx < tilesX; tx++) {
+                float tileX = startX + tx * texW;
+                float x0 = fmaxf(tileX, 0.0f), x1 = fminf(tileX + texW, screenW);
+                if (x1 <= x0) continue;
+                qs.Quad(x0, y0, x1, y1, (x0 - tileX) / texW, v0, (x1 - tileX) / texW, v1, layer.tint);
             }
-        } else {
-            Rectangle src = { 0, 0, (float)tex.width, (float)tex.height };
-            Rectangle dst = { px, py, texW, texH };
-            DrawTexturePro(tex, src, dst, Vector2{ 0, 0 }, 0.0f, layer.tint);
         }
     }
 
     void Framework_Parallax_Draw(float cameraX, float cameraY) {
-        // Collect active layer indices and sort by zOrder
-        std::vector<int> indices;
-        for (size_t i = 0; i < g_parallaxLayers.size(); i++) {
-            if (g_parallaxLayers[i].active) indices.push_back((int)i);
+        if (g_headless) return;
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_PARALLAX);
+        if (g_parallaxOrderDirty) {
+            // Collect active layer indices and sort by zOrder
+            g_parallaxOrder.clear();
+            for (size_t i = 0; i < g_parallaxLayers.size(); i++) {
+                if (g_parallaxLayers[i].active) g_parallaxOrder.push_back((int)i);
+            }
+            std::stable_sort(g_parallaxOrder.begin(), g_parallaxOrder.end(), [](int a, int b) {
+                return g_parallaxLayers[a].zOrder < g_parallaxLayers[b].zOrder;
+            });
+            g_parallaxOrderDirty = false;
         }
-        std::sort(indices.begin(), indices.end(), [](int a, int b) {
-            return g_parallaxLayers[a].zOrder < g_parallaxLayers[b].zOrder;
-        });
-        for (int idx : indices) {
+        RenderListOrderedScope orderedScope;
+        for (int idx : g_parallaxOrder) {
             DrawParallaxLayerInternal(g_parallaxLayers[idx], cameraX, cameraY);
         }
+        rlSetTexture(0);
     }
 
     void Framework_Parallax_DrawLayer(int layerId, float cameraX, float cameraY) {
+        if (g_headless) return;
         if (!Framework_Parallax_IsValid(layerId)) return;
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_PARALLAX);
         DrawParallaxLayerInternal(g_parallaxLayers[layerId], cameraX, cameraY);
+        rlSetTexture(0);
     }
 
     void Framework_Parallax_Update(float dt) {
@@ -28250,6 +33686,8 @@ extern "C" {
 
     void Framework_Parallax_DestroyAll() {
         g_parallaxLayers.clear();
+        g_parallaxOrder.clear();
+        g_parallaxOrderDirty = true;
     }
 
     // ========================================================================
@@ -28258,7 +33696,7 @@ extern "C" {
 
     struct TrailPoint {
         float x, y;
-        float timeAlive;
+        float birth;  // Trail clock when the point was added
     };
 
     struct TrailRenderer {
@@ -28274,11 +33712,29 @@ extern "C" {
         int textureHandle = -1;
         bool smoothing = false;
         int attachedEntity = -1;
+        float clock = 0.0f;
+        // Fixed-capacity ring of maxPoints slots; index 0 is the oldest (tail) point
         std::vector<TrailPoint> points;
+        int head = 0;
+        int count = 0;
     };
 
     static std::vector<TrailRenderer> g_trails;
 
+    static const TrailPoint& TrailPointAt(const TrailRenderer& trail, int i) {
+        return trail.points[(trail.head + i) % trail.maxPoints];
+    }
+
+    // Append at the head; a full ring overwrites the oldest point instead of shifting
+    static void TrailPushPoint(TrailRenderer& trail, const TrailPoint& tp) {
+        if (trail.count == trail.maxPoints) {
+            trail.head = (trail.head + 1) % trail.maxPoints;
+            trail.count--;
+        }
+        trail.points[(trail.head + trail.count) % trail.maxPoints] = tp;
+        trail.count++;
+    }
+
     static int FindFreeTrailSlot() {
         for (size_t i = 0; i < g_trails.size(); i++) {
             if (!g_trails[i].active) return (int)i;
@@ -28295,6 +33751,7 @@ extern "C" {
         trail.maxPoints = (maxPoints > 0) ? maxPoints : 50;
         trail.startWidth = width;
         trail.endWidth = width * 0.1f;
+        trail.points.resize(trail.maxPoints);
         return id;
     }
 
@@ -28302,6 +33759,8 @@ extern "C" {
         if (trailId < 0 || trailId >= (int)g_trails.size()) return;
         g_trails[trailId].active = false;
         g_trails[trailId].points.clear();
+        g_trails[trailId].head = 0;
+        g_trails[trailId].count = 0;
     }
 
     bool Framework_Trail_IsValid(int trailId) {
@@ -28314,8 +33773,8 @@ extern "C" {
         if (!trail.enabled) return;
 
         // Check minimum distance from last point
-        if (!trail.points.empty()) {
-            auto& last = trail.points.back();
+        if (trail.count > 0) {
+            const TrailPoint& last = TrailPointAt(trail, trail.count - 1);
             float dx = x - last.x;
             float dy = y - last.y;
             if (dx * dx + dy * dy < trail.minDistance * trail.minDistance) return;
@@ -28324,13 +33783,8 @@ extern "C" {
         TrailPoint tp;
         tp.x = x;
         tp.y = y;
-        tp.timeAlive = 0.0f;
-        trail.points.push_back(tp);
-
-        // Trim excess points
-        while ((int)trail.points.size() > trail.maxPoints) {
-            trail.points.erase(trail.points.begin());
-        }
+        tp.birth = trail.clock;
+        TrailPushPoint(trail, tp);
     }
 
     void Framework_Trail_SetWidth(int trailId, float startWidth, float endWidth) {
@@ -28379,12 +33833,13 @@ extern "C" {
 
     void Framework_Trail_Clear(int trailId) {
         if (!Framework_Trail_IsValid(trailId)) return;
-        g_trails[trailId].points.clear();
+        g_trails[trailId].head = 0;
+        g_trails[trailId].count = 0;
     }
 
     int Framework_Trail_GetPointCount(int trailId) {
         if (!Framework_Trail_IsValid(trailId)) return 0;
-        return (int)g_trails[trailId].points.size();
+        return g_trails[trailId].count;
     }
 
     static Color LerpColor(Color a, Color b, float t) {
@@ -28396,73 +33851,132 @@ extern "C" {
         };
     }
 
-    void Framework_Trail_Draw(int trailId) {
-        if (!Framework_Trail_IsValid(trailId)) return;
-        auto& trail = g_trails[trailId];
-        int count = (int)trail.points.size();
-        if (count < 2) return;
-
-        for (int i = 0; i < count - 1; i++) {
-            float t1 = (float)i / (float)(count - 1);
-            float t2 = (float)(i + 1) / (float)(count - 1);
-
-            // Older points are at lower indices, newer at higher
-            // t=0 is oldest (tail), t=1 is newest (head)
-            float w1 = trail.endWidth + (trail.startWidth - trail.endWidth) * t1;
-            float w2 = trail.endWidth + (trail.startWidth - trail.endWidth) * t2;
-            Color c1 = LerpColor(trail.endColor, trail.startColor, t1);
-            Color c2 = LerpColor(trail.endColor, trail.startColor, t2);
+    // Strip vertices for one trail: one left/right pair per sample, shared by neighbouring quads
+    struct TrailStripVertex { float lx, ly, rx, ry, u; Color color; };
+    static std::vector<TrailStripVertex> g_trailStrip;
+    static constexpr int TRAIL_SMOOTH_STEPS = 4;
+
+    static unsigned int TrailTextureId(const TrailRenderer& trail) {
+        if (trail.textureHandle >= 0) {
+            auto it = g_texByHandle.find(trail.textureHandle);
+            if (it != g_texByHandle.end() && it->second.valid && it->second.tex.id != 0) return it->second.tex.id;
+        }
+        return rlGetTextureIdDefault();
+    }
+
+    // Build the strip for a trail into g_trailStrip. t runs 0 (oldest, tail) to 1 (newest, head);
+    // smoothing inserts Catmull-Rom samples between stored points.
+    static void BuildTrailStrip(const TrailRenderer& trail) {
+        g_trailStrip.clear();
+        int count = trail.count;
+        int steps = trail.smoothing ? TRAIL_SMOOTH_STEPS : 1;
+        int samples = (count - 1) * steps + 1;
+
+        auto sampleAt = [&](int s, float& x, float& y, float& birth) {
+            int i = std::min(s / steps, count - 1);
+            float f = (float)(s - i * steps) / (float)steps;
+            const TrailPoint& p1 = TrailPointAt(trail, i);
+            if (f <= 0.0f) { x = p1.x; y = p1.y; birth = p1.birth; return; }
+            const TrailPoint& p0 = TrailPointAt(trail, std::max(i - 1, 0));
+            const TrailPoint& p2 = TrailPointAt(trail, i + 1);
+            const TrailPoint& p3 = TrailPointAt(trail, std::min(i + 2, count - 1));
+            float f2 = f * f, f3 = f2 * f;
+            x = 0.5f * (2 * p1.x + (-p0.x + p2.x) * f + (2 * p0.x - 5 * p1.x + 4 * p2.x - p3.x) * f2 + (-p0.x + 3 * p1.x - 3 * p2.x + p3.x) * f3);
+            y = 0.5f * (2 * p1.y + (-p0.y + p2.y) * f + (2 * p0.y - 5 * p1.y + 4 * p2.y - p3.y) * f2 + (-p0.y + 3 * p1.y - 3 * p2.y + p3.y) * f3);
+            birth = p1.birth + (p2.birth - p1.birth) * f;
+        };
 
-            // Apply lifetime fade
+        float prevX = 0, prevY = 0, curX, curY, curBirth, nextX = 0, nextY = 0, nextBirth = 0;
+        sampleAt(0, curX, curY, curBirth);
+        if (samples > 1) sampleAt(1, nextX, nextY, nextBirth);
+        for (int s = 0; s < samples; s++) {
+            // Normal from the neighbouring samples so adjacent quads share an edge
+            float dx = (s + 1 < samples ? nextX : curX) - (s > 0 ? prevX : curX);
+            float dy = (s + 1 < samples ? nextY : curY) - (s > 0 ? prevY : curY);
+            float len = sqrtf(dx * dx + dy * dy);
+            float nx = 0.0f, ny = 0.0f;
+            if (len >= 0.001f) { nx = -dy / len; ny = dx / len; }
+            else if (!g_trailStrip.empty()) {
+                // Stationary sample: reuse the previous direction
+                const TrailStripVertex& pv = g_trailStrip.back();
+                float hx = (pv.rx - pv.lx), hy = (pv.ry - pv.ly);
+                float hl = sqrtf(hx * hx + hy * hy);
+                if (hl > 0.0f) { nx = hx / hl; ny = hy / hl; }
+            }
+
+            float t = (samples > 1) ? (float)s / (float)(samples - 1) : 1.0f;
+            float hw = (trail.endWidth + (trail.startWidth - trail.endWidth) * t) * 0.5f;
+            Color c = LerpColor(trail.endColor, trail.startColor, t);
             if (trail.lifetime > 0.0f) {
-                float fade1 = 1.0f - (trail.points[i].timeAlive / trail.lifetime);
-                float fade2 = 1.0f - (trail.points[i + 1].timeAlive / trail.lifetime);
-                if (fade1 < 0.0f) fade1 = 0.0f;
-                if (fade2 < 0.0f) fade2 = 0.0f;
-                c1.a = (unsigned char)(c1.a * fade1);
-                c2.a = (unsigned char)(c2.a * fade2);
+                float fade = 1.0f - ((trail.clock - curBirth) / trail.lifetime);
+                if (fade < 0.0f) fade = 0.0f;
+                c.a = (unsigned char)(c.a * fade);
             }
+            g_trailStrip.push_back({ curX - nx * hw, curY - ny * hw, curX + nx * hw, curY + ny * hw, t, c });
 
-            // Build quad segment
-            float dx = trail.points[i + 1].x - trail.points[i].x;
-            float dy = trail.points[i + 1].y - trail.points[i].y;
-            float len = sqrtf(dx * dx + dy * dy);
-            if (len < 0.001f) continue;
-            float nx = -dy / len;
-            float ny = dx / len;
-
-            rlBegin(RL_QUADS);
-                rlColor4ub(c1.r, c1.g, c1.b, c1.a);
-                rlVertex2f(trail.points[i].x + nx * w1 * 0.5f, trail.points[i].y + ny * w1 * 0.5f);
-                rlColor4ub(c1.r, c1.g, c1.b, c1.a);
-                rlVertex2f(trail.points[i].x - nx * w1 * 0.5f, trail.points[i].y - ny * w1 * 0.5f);
-                rlColor4ub(c2.r, c2.g, c2.b, c2.a);
-                rlVertex2f(trail.points[i + 1].x - nx * w2 * 0.5f, trail.points[i + 1].y - ny * w2 * 0.5f);
-                rlColor4ub(c2.r, c2.g, c2.b, c2.a);
-                rlVertex2f(trail.points[i + 1].x + nx * w2 * 0.5f, trail.points[i + 1].y + ny * w2 * 0.5f);
-            rlEnd();
+            prevX = curX; prevY = curY;
+            curX = nextX; curY = nextY; curBirth = nextBirth;
+            if (s + 2 < samples) sampleAt(s + 2, nextX, nextY, nextBirth);
+        }
+    }
+
+    // Emit g_trailStrip as quads between consecutive pairs (counter-clockwise, texture u along the trail)
+    static void StreamTrailStrip(unsigned int texId) {
+        int quads = (int)g_trailStrip.size() - 1;
+        QuadStream qs(texId, quads);
+        for (int i = 0; i < quads; i++) {
+            const TrailStripVertex& a = g_trailStrip[i];
+            const TrailStripVertex& b = g_trailStrip[i + 1];
+            qs.Vertex(a.lx, a.ly, a.u, 0.0f, a.color);
+            qs.Vertex(a.rx, a.ry, a.u, 1.0f, a.color);
+            qs.Vertex(b.rx, b.ry, b.u, 1.0f, b.color);
+            qs.Vertex(b.lx, b.ly, b.u, 0.0f, b.color);
         }
     }
 
+    void Framework_Trail_Draw(int trailId) {
+        if (g_headless) return;
+        if (!Framework_Trail_IsValid(trailId)) return;
+        auto& trail = g_trails[trailId];
+        if (trail.count < 2) return;
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_TRAILS);
+
+        BuildTrailStrip(trail);
+        StreamTrailStrip(TrailTextureId(trail));
+        rlSetTexture(0);
+    }
+
+    // All trails grouped by texture, so each texture goes out as one uninterrupted batch
     void Framework_Trail_DrawAll() {
+        if (g_headless) return;
+        static std::vector<std::pair<unsigned int, int>> order;  // (texture id, trail index)
+        order.clear();
         for (size_t i = 0; i < g_trails.size(); i++) {
-            if (g_trails[i].active) Framework_Trail_Draw((int)i);
+            if (g_trails[i].active && g_trails[i].count >= 2) order.push_back({ TrailTextureId(g_trails[i]), (int)i });
+        }
+        if (order.empty()) return;
+        std::sort(order.begin(), order.end());
+
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_TRAILS);
+        for (const auto& [texId, index] : order) {
+            BuildTrailStrip(g_trails[index]);
+            StreamTrailStrip(texId);
         }
+        rlSetTexture(0);
     }
 
     void Framework_Trail_Update(float dt) {
         for (auto& trail : g_trails) {
             if (!trail.active) continue;
 
-            // Update time alive for each point
-            for (auto& pt : trail.points) {
-                pt.timeAlive += dt;
-            }
+            // Points store their birth time, so ageing is a single clock step
+            trail.clock += dt;
 
-            // Remove expired points
+            // Remove expired points from the tail of the ring
             if (trail.lifetime > 0.0f) {
-                while (!trail.points.empty() && trail.points.front().timeAlive >= trail.lifetime) {
-                    trail.points.erase(trail.points.begin());
+                while (trail.count > 0 && trail.clock - TrailPointAt(trail, 0).birth >= trail.lifetime) {
+                    trail.head = (trail.head + 1) % trail.maxPoints;
+                    trail.count--;
                 }
             }
 
@@ -28588,42 +34102,52 @@ extern "C" {
     // ========================================================================
 
     void Framework_DrawEllipse(int cx, int cy, float radiusH, float radiusV, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawEllipse(cx, cy, radiusH, radiusV, {r, g, b, a});
     }
 
     void Framework_DrawEllipseLines(int cx, int cy, float radiusH, float radiusV, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawEllipseLines(cx, cy, radiusH, radiusV, {r, g, b, a});
     }
 
     void Framework_DrawRing(float cx, float cy, float innerRadius, float outerRadius, float startAngle, float endAngle, int segments, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawRing({cx, cy}, innerRadius, outerRadius, startAngle, endAngle, segments, {r, g, b, a});
     }
 
     void Framework_DrawRingLines(float cx, float cy, float innerRadius, float outerRadius, float startAngle, float endAngle, int segments, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawRingLines({cx, cy}, innerRadius, outerRadius, startAngle, endAngle, segments, {r, g, b, a});
     }
 
     void Framework_DrawRectangleRounded(float x, float y, float w, float h, float roundness, int segments, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawRectangleRounded({x, y, w, h}, roundness, segments, {r, g, b, a});
     }
 
     void Framework_DrawRectangleRoundedLines(float x, float y, float w, float h, float roundness, int segments, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawRectangleRoundedLines({x, y, w, h}, roundness, segments, {r, g, b, a});
     }
 
     void Framework_DrawPoly(float cx, float cy, int sides, float radius, float rotation, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawPoly({cx, cy}, sides, radius, rotation, {r, g, b, a});
     }
 
     void Framework_DrawPolyLines(float cx, float cy, int sides, float radius, float rotation, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawPolyLinesEx({cx, cy}, sides, radius, rotation, 1.0f, {r, g, b, a});
     }
 
     void Framework_DrawCircleSector(float cx, float cy, float radius, float startAngle, float endAngle, int segments, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawCircleSector({cx, cy}, radius, startAngle, endAngle, segments, {r, g, b, a});
     }
 
     void Framework_DrawCircleSectorLines(float cx, float cy, float radius, float startAngle, float endAngle, int segments, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawCircleSectorLines({cx, cy}, radius, startAngle, endAngle, segments, {r, g, b, a});
     }
 
@@ -28632,119 +34156,148 @@ extern "C" {
     // ========================================================================
     // --- Group A: simple draws ---
     void Framework_DrawPixelV(Vector2 position, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawPixelV(position, Color{r, g, b, a});
     }
 
     void Framework_DrawLineV(Vector2 startPos, Vector2 endPos, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawLineV(startPos, endPos, Color{r, g, b, a});
     }
 
     void Framework_DrawLineEx(Vector2 startPos, Vector2 endPos, float thick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawLineEx(startPos, endPos, thick, Color{r, g, b, a});
     }
 
     void Framework_DrawLineBezier(Vector2 startPos, Vector2 endPos, float thick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawLineBezier(startPos, endPos, thick, Color{r, g, b, a});
     }
 
     void Framework_DrawCircleGradient(int centerX, int centerY, float radius, unsigned char innerR, unsigned char innerG, unsigned char innerB, unsigned char innerA, unsigned char outerR, unsigned char outerG, unsigned char outerB, unsigned char outerA) {
+        if (g_headless) return;
         DrawCircleGradient(centerX, centerY, radius, Color{innerR, innerG, innerB, innerA}, Color{outerR, outerG, outerB, outerA});
     }
 
     void Framework_DrawCircleV(Vector2 center, float radius, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawCircleV(center, radius, Color{r, g, b, a});
     }
 
     void Framework_DrawCircleLinesV(Vector2 center, float radius, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawCircleLinesV(center, radius, Color{r, g, b, a});
     }
 
     void Framework_DrawRectangleV(Vector2 position, Vector2 size, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawRectangleV(position, size, Color{r, g, b, a});
     }
 
     void Framework_DrawRectangleRec(Rectangle rec, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawRectangleRec(rec, Color{r, g, b, a});
     }
 
     void Framework_DrawRectanglePro(Rectangle rec, Vector2 origin, float rotation, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawRectanglePro(rec, origin, rotation, Color{r, g, b, a});
     }
 
     void Framework_DrawRectangleGradientV(int posX, int posY, int width, int height, unsigned char topR, unsigned char topG, unsigned char topB, unsigned char topA, unsigned char botR, unsigned char botG, unsigned char botB, unsigned char botA) {
+        if (g_headless) return;
         DrawRectangleGradientV(posX, posY, width, height, Color{topR, topG, topB, topA}, Color{botR, botG, botB, botA});
     }
 
     void Framework_DrawRectangleGradientH(int posX, int posY, int width, int height, unsigned char leftR, unsigned char leftG, unsigned char leftB, unsigned char leftA, unsigned char rightR, unsigned char rightG, unsigned char rightB, unsigned char rightA) {
+        if (g_headless) return;
         DrawRectangleGradientH(posX, posY, width, height, Color{leftR, leftG, leftB, leftA}, Color{rightR, rightG, rightB, rightA});
     }
 
     void Framework_DrawRectangleGradientEx(Rectangle rec, unsigned char tlR, unsigned char tlG, unsigned char tlB, unsigned char tlA, unsigned char blR, unsigned char blG, unsigned char blB, unsigned char blA, unsigned char trR, unsigned char trG, unsigned char trB, unsigned char trA, unsigned char brR, unsigned char brG, unsigned char brB, unsigned char brA) {
+        if (g_headless) return;
         DrawRectangleGradientEx(rec, Color{tlR, tlG, tlB, tlA}, Color{blR, blG, blB, blA}, Color{trR, trG, trB, trA}, Color{brR, brG, brB, brA});
     }
 
     void Framework_DrawRectangleLinesEx(Rectangle rec, float lineThick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawRectangleLinesEx(rec, lineThick, Color{r, g, b, a});
     }
 
     void Framework_DrawRectangleRoundedLinesEx(Rectangle rec, float roundness, int segments, float lineThick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawRectangleRoundedLinesEx(rec, roundness, segments, lineThick, Color{r, g, b, a});
     }
 
     void Framework_DrawPolyLinesEx(Vector2 center, int sides, float radius, float rotation, float lineThick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawPolyLinesEx(center, sides, radius, rotation, lineThick, Color{r, g, b, a});
     }
 
     void Framework_DrawSplineSegmentLinear(Vector2 p1, Vector2 p2, float thick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawSplineSegmentLinear(p1, p2, thick, Color{r, g, b, a});
     }
 
     void Framework_DrawSplineSegmentBasis(Vector2 p1, Vector2 p2, Vector2 p3, Vector2 p4, float thick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawSplineSegmentBasis(p1, p2, p3, p4, thick, Color{r, g, b, a});
     }
 
     void Framework_DrawSplineSegmentCatmullRom(Vector2 p1, Vector2 p2, Vector2 p3, Vector2 p4, float thick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawSplineSegmentCatmullRom(p1, p2, p3, p4, thick, Color{r, g, b, a});
     }
 
     void Framework_DrawSplineSegmentBezierQuadratic(Vector2 p1, Vector2 c2, Vector2 p3, float thick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawSplineSegmentBezierQuadratic(p1, c2, p3, thick, Color{r, g, b, a});
     }
 
     void Framework_DrawSplineSegmentBezierCubic(Vector2 p1, Vector2 c2, Vector2 c3, Vector2 p4, float thick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawSplineSegmentBezierCubic(p1, c2, c3, p4, thick, Color{r, g, b, a});
     }
 
     // --- Group B: Vector2[] draws ---
     void Framework_DrawLineStrip(const Vector2 *points, int pointCount, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawLineStrip(points, pointCount, Color{r, g, b, a});
     }
 
     void Framework_DrawTriangleFan(const Vector2 *points, int pointCount, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawTriangleFan(points, pointCount, Color{r, g, b, a});
     }
 
     void Framework_DrawTriangleStrip(const Vector2 *points, int pointCount, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawTriangleStrip(points, pointCount, Color{r, g, b, a});
     }
 
     void Framework_DrawSplineLinear(const Vector2 *points, int pointCount, float thick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawSplineLinear(points, pointCount, thick, Color{r, g, b, a});
     }
 
     void Framework_DrawSplineBasis(const Vector2 *points, int pointCount, float thick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawSplineBasis(points, pointCount, thick, Color{r, g, b, a});
     }
 
     void Framework_DrawSplineCatmullRom(const Vector2 *points, int pointCount, float thick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawSplineCatmullRom(points, pointCount, thick, Color{r, g, b, a});
     }
 
     void Framework_DrawSplineBezierQuadratic(const Vector2 *points, int pointCount, float thick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawSplineBezierQuadratic(points, pointCount, thick, Color{r, g, b, a});
     }
 
     void Framework_DrawSplineBezierCubic(const Vector2 *points, int pointCount, float thick, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawSplineBezierCubic(points, pointCount, thick, Color{r, g, b, a});
     }
 
@@ -28811,14 +34364,17 @@ extern "C" {
     }
 
     void Framework_DrawTextPro(Font font, const char* text, Vector2 position, Vector2 origin, float rotation, float fontSize, float spacing, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawTextPro(font, text, position, origin, rotation, fontSize, spacing, { r, g, b, a });
     }
 
     void Framework_DrawTextCodepoint(Font font, int codepoint, Vector2 position, float fontSize, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawTextCodepoint(font, codepoint, position, fontSize, { r, g, b, a });
     }
 
     void Framework_DrawTextCodepoints(Font font, const int* codepoints, int count, Vector2 position, float fontSize, float spacing, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         DrawTextCodepoints(font, codepoints, count, position, fontSize, spacing, { r, g, b, a });
     }
 
@@ -28905,7 +34461,7 @@ extern "C" {
 
     // --- Faithful MeasureTextEx (Vector2 return; handle-based Framework_MeasureTextEx retained) ---
     Vector2 Framework_MeasureTextExV(Font font, const char* text, float fontSize, float spacing) {
-        return MeasureTextEx(font, text, fontSize, spacing);
+        return MeasureTextEx_Internal(font, text, fontSize, spacing);
     }
 
     // --- Malloc-return string wrappers (copy raylib's malloc'd result to an engine static
@@ -28989,23 +34545,63 @@ extern "C" {
     // ========================================================================
 
     int Framework_MeasureText(const char* text, int fontSize) {
-        return MeasureText(text, fontSize);
+        return MeasureText_Internal(text, fontSize);
     }
 
     void Framework_MeasureTextEx(int fontHandle, const char* text, float fontSize, float spacing, float* outWidth, float* outHeight) {
         if (!outWidth || !outHeight) return;
         Font font = UI_GetFontByHandle(fontHandle);
-        Vector2 size = MeasureTextEx(font, text, fontSize, spacing);
-        *outWidth = size.x;
-        *outHeight = size.y;
+        const TextLayout& layout = GetTextLayout(font, text, fontSize, spacing, 0);
+        *outWidth = layout.width;
+        *outHeight = layout.height;
+    }
+
+    void Framework_MeasureTextWrapped(int fontHandle, const char* text, float fontSize, float spacing, float wrapWidth,
+                                      float* outWidth, float* outHeight, int* outLines) {
+        Font font = UI_GetFontByHandle(fontHandle);
+        const TextLayout& layout = GetTextLayout(font, text, fontSize, spacing, wrapWidth);
+        if (outWidth) *outWidth = layout.width;
+        if (outHeight) *outHeight = layout.height;
+        if (outLines) *outLines = (int)layout.lineWidths.size();
+    }
+
+    int Framework_TextLayout_GetLineStart(int fontHandle, const char* text, float fontSize, float spacing, float wrapWidth, int line) {
+        Font font = UI_GetFontByHandle(fontHandle);
+        const TextLayout& layout = GetTextLayout(font, text, fontSize, spacing, wrapWidth);
+        if (line < 0 || line >= (int)layout.lineStarts.size()) return -1;
+        return layout.lineStarts[line];
+    }
+
+    void Framework_DrawTextWrapped(int fontHandle, const char* text, float x, float y, float fontSize, float spacing, float wrapWidth,
+                                   unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
+        Font font = UI_GetFontByHandle(fontHandle);
+        const TextLayout& layout = GetTextLayout(font, text, fontSize, spacing, wrapWidth);
+        DrawTextLayout(layout, font, Vector2{ x, y }, Color{ r, g, b, a });
+    }
+
+    void Framework_TextCache_SetCapacity(int maxLayouts) {
+        g_textLayoutCapacity = maxLayouts > 0 ? maxLayouts : 1;
+        while ((int)g_textLayouts.size() > g_textLayoutCapacity) {
+            g_textLayouts.erase(g_textLayoutLru.back());
+            g_textLayoutLru.pop_back();
+        }
     }
 
+    int Framework_TextCache_GetCapacity() { return g_textLayoutCapacity; }
+    int Framework_TextCache_GetCount() { return (int)g_textLayouts.size(); }
+    void Framework_TextCache_Clear() { TextLayout_Clear(); }
+    unsigned long long Framework_TextCache_GetHits() { return g_textLayoutHits; }
+    unsigned long long Framework_TextCache_GetMisses() { return g_textLayoutMisses; }
+
     void Framework_DrawTextCentered(const char* text, int centerX, int centerY, int fontSize, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         int w = MeasureText(text, fontSize);
         DrawText(text, centerX - w / 2, centerY - fontSize / 2, fontSize, {r, g, b, a});
     }
 
     void Framework_DrawTextRight(const char* text, int rightX, int y, int fontSize, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+        if (g_headless) return;
         int w = MeasureText(text, fontSize);
         DrawText(text, rightX - w, y, fontSize, {r, g, b, a});
     }
@@ -29128,31 +34724,40 @@ extern "C" {
     // ========================================================================
 
     void Framework_ToggleFullscreen() {
+        if (g_headless) return;
         ToggleFullscreen();
     }
 
     void Framework_ToggleBorderlessWindowed() {
+        if (g_headless) return;
         ToggleBorderlessWindowed();
     }
 
     void Framework_SetWindowSize(int width, int height) {
+        if (g_headless) {
+            g_headlessWidth = width;
+            g_headlessHeight = height;
+            return;
+        }
         SetWindowSize(width, height);
     }
 
     void Framework_SetWindowMinSize(int width, int height) {
+        if (g_headless) return;
         SetWindowMinSize(width, height);
     }
 
     void Framework_SetWindowTitle(const char* title) {
+        if (g_headless) return;
         SetWindowTitle(title);
     }
 
     int Framework_GetScreenWidth() {
-        return GetScreenWidth();
+        return ScreenWidth_Internal();
     }
 
     int Framework_GetScreenHeight() {
-        return GetScreenHeight();
+        return ScreenHeight_Internal();
     }
 
     int Framework_GetMonitorWidth(int monitor) {
@@ -29279,10 +34884,182 @@ namespace {
 // ============================================================================
 // RECORDING STATE
 // ============================================================================
+// Frames are read back on the main thread at the recording rate and handed to a
+// worker thread that encodes and writes them, so the main thread never waits on
+// disk or compression. At most maxInFlight frames are outstanding (two by
+// default: one being written while the next is captured); when the worker falls
+// behind, new frames are dropped and counted instead of queueing without bound.
+//
+// Container formats (.vgsr) start with a 28-byte header: "VGSR", version,
+// width, height, fps, codec (0 raw RGBA8, 1 RLE) and frame count. Each frame is
+// a slot index (uint32, gaps mark dropped frames), a keyframe flag (uint8), a
+// payload size (uint32) and the payload. RLE payloads encode the XOR against
+// the previous stored frame (keyframes: against zero) as packets: a header byte
+// with the high bit set repeats the next pixel (low 7 bits + 1) times,
+// otherwise (value + 1) literal pixels follow.
 namespace {
-    bool g_isRecording = false;
-    std::string g_recordingFilename;
-    int g_recordingFps = 30;
+    struct RecordFrame {
+        unsigned char* pixels = nullptr;   // RGBA8, top row first; owned until written
+        int slot = 0;                      // Timeline slot at the recording fps
+    };
+
+    struct RecordingState {
+        bool active = false;
+        int format = RECORD_FORMAT_PNG_SEQUENCE;
+        std::string path;                  // Container file, or sequence path without extension
+        int fps = 30;
+        int width = 0, height = 0;
+        int maxInFlight = 2;
+        double startTime = 0.0;
+        int nextSlot = 0;
+
+        std::thread worker;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<RecordFrame> queue;
+        int inFlight = 0;                  // Queued + being written (guarded by mutex)
+        bool stopping = false;
+
+        // Worker-owned
+        std::ofstream file;
+        std::vector<unsigned char> prevFrame;
+        std::vector<unsigned char> payload;
+        int storedFrames = 0;
+
+        int captured = 0;
+        std::atomic<int> written{ 0 };
+        std::atomic<int> dropped{ 0 };
+        float lastCaptureMs = 0.0f;
+    };
+    RecordingState g_recording;
+
+    constexpr int RECORD_HEADER_SIZE = 28;
+
+    void Recording_Put32(std::vector<unsigned char>& out, uint32_t v) {
+        out.push_back((unsigned char)(v & 0xFF));
+        out.push_back((unsigned char)((v >> 8) & 0xFF));
+        out.push_back((unsigned char)((v >> 16) & 0xFF));
+        out.push_back((unsigned char)((v >> 24) & 0xFF));
+    }
+
+    void Recording_EncodeRle(const uint32_t* cur, const uint32_t* prev, int count, std::vector<unsigned char>& out) {
+        auto px = [cur, prev](int k) { return prev ? (cur[k] ^ prev[k]) : cur[k]; };
+        int i = 0;
+        while (i < count) {
+            uint32_t v = px(i);
+            int run = 1;
+            while (i + run < count && run < 128 && px(i + run) == v) run++;
+            if (run >= 2) {
+                out.push_back((unsigned char)(0x80 | (run - 1)));
+                Recording_Put32(out, v);
+                i += run;
+                continue;
+            }
+            int start = i, literal = 0;
+            while (i < count && literal < 128) {
+                if (i + 1 < count && px(i) == px(i + 1)) break;
+                i++;
+                literal++;
+            }
+            out.push_back((unsigned char)(literal - 1));
+            for (int k = start; k < start + literal; k++) Recording_Put32(out, px(k));
+        }
+    }
+
+    void Recording_WriteHeader(RecordingState& r, int frameCount) {
+        std::vector<unsigned char> h;
+        h.insert(h.end(), { 'V', 'G', 'S', 'R' });
+        Recording_Put32(h, 1);
+        Recording_Put32(h, (uint32_t)r.width);
+        Recording_Put32(h, (uint32_t)r.height);
+        Recording_Put32(h, (uint32_t)r.fps);
+        Recording_Put32(h, r.format == RECORD_FORMAT_RLE ? 1u : 0u);
+        Recording_Put32(h, (uint32_t)frameCount);
+        r.file.seekp(0);
+        r.file.write((const char*)h.data(), (std::streamsize)h.size());
+    }
+
+    bool Recording_WriteFrame(RecordingState& r, const RecordFrame& f) {
+        if (r.format == RECORD_FORMAT_PNG_SEQUENCE) {
+            char name[FW_PATH_MAX];
+            snprintf(name, sizeof(name), "%s_%05d.png", r.path.c_str(), f.slot);
+            Image img{ f.pixels, r.width, r.height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+            return ExportImage(img, name);
+        }
+
+        size_t frameBytes = (size_t)r.width * r.height * 4;
+        bool keyframe = r.format == RECORD_FORMAT_RAW || r.storedFrames % std::max(r.fps, 1) == 0;
+        r.payload.clear();
+        if (r.format == RECORD_FORMAT_RLE) {
+            const uint32_t* prev = keyframe ? nullptr : (const uint32_t*)r.prevFrame.data();
+            Recording_EncodeRle((const uint32_t*)f.pixels, prev, r.width * r.height, r.payload);
+            r.prevFrame.assign(f.pixels, f.pixels + frameBytes);
+        }
+        const unsigned char* data = r.format == RECORD_FORMAT_RLE ? r.payload.data() : f.pixels;
+        uint32_t size = r.format == RECORD_FORMAT_RLE ? (uint32_t)r.payload.size() : (uint32_t)frameBytes;
+
+        std::vector<unsigned char> head;
+        Recording_Put32(head, (uint32_t)f.slot);
+        head.push_back(keyframe ? 1 : 0);
+        Recording_Put32(head, size);
+        r.file.write((const char*)head.data(), (std::streamsize)head.size());
+        r.file.write((const char*)data, size);
+        if (!r.file) return false;
+        r.storedFrames++;
+        return true;
+    }
+
+    void Recording_WorkerMain() {
+        RecordingState& r = g_recording;
+        for (;;) {
+            RecordFrame f;
+            {
+                std::unique_lock<std::mutex> lock(r.mutex);
+                r.wake.wait(lock, [&r] { return r.stopping || !r.queue.empty(); });
+                if (r.queue.empty()) return;   // Stopping and drained
+                f = r.queue.front();
+                r.queue.pop_front();
+            }
+            bool ok = Recording_WriteFrame(r, f);
+            MemFree(f.pixels);
+            if (ok) r.written++;
+            else r.dropped++;
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.inFlight--;
+        }
+    }
+
+    // Called once per frame after the final composite, before the buffer swap
+    void Recording_CaptureFrame() {
+        RecordingState& r = g_recording;
+        if (!r.active) return;
+
+        // Slots follow wall time at the recording fps; slots that pass without a
+        // capture (slow frames) count as dropped
+        double now = GetTime();
+        int slot = (int)((now - r.startTime) * r.fps);
+        if (slot < r.nextSlot) return;
+        if (slot > r.nextSlot) r.dropped += slot - r.nextSlot;
+        r.nextSlot = slot + 1;
+
+        if (GetRenderWidth() != r.width || GetRenderHeight() != r.height) { r.dropped++; return; }
+        {
+            std::lock_guard<std::mutex> lock(r.mutex);
+            if (r.inFlight >= r.maxInFlight) { r.dropped++; return; }
+            r.inFlight++;
+        }
+
+        double t0 = GetTime();
+        rlDrawRenderBatchActive();
+        unsigned char* pixels = rlReadScreenPixels(r.width, r.height);
+        r.lastCaptureMs = (float)((GetTime() - t0) * 1000.0);
+        r.captured++;
+        {
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.queue.push_back(RecordFrame{ pixels, slot });
+        }
+        r.wake.notify_one();
+    }
 }
 
 // ============================================================================
@@ -29405,6 +35182,7 @@ extern "C" {
     }
 
     void Framework_AnimPlayerDraw(int handle, float x, float y, float width, float height) {
+        if (g_headless) return;
         auto it = g_animPlayers.find(handle);
         if (it == g_animPlayers.end()) return;
         auto& player = it->second;
@@ -29533,10 +35311,12 @@ extern "C" {
     }
 
     void Framework_TilemapDraw(int handle, int textureHandle, float offsetX, float offsetY) {
+        if (g_headless) return;
         auto it = g_tilemaps.find(handle);
         if (it == g_tilemaps.end()) return;
         auto& tm = it->second;
         if (!tm.visible) return;
+        RenderStatsScope statsScope(RENDER_SUBSYSTEM_TILEMAPS);
 
         const Texture2D* tex = GetTextureH_Internal(textureHandle);
         if (!tex) return;
@@ -29555,6 +35335,7 @@ extern "C" {
                 Rectangle src = { (float)srcX, (float)srcY, (float)tm.tileWidth, (float)tm.tileHeight };
                 Rectangle dst = { offsetX + x * tm.tileWidth, offsetY + y * tm.tileHeight,
                                   (float)tm.tileWidth, (float)tm.tileHeight };
+                RenderStats_Quad(tex->id);
                 DrawTexturePro(*tex, src, dst, {0, 0}, 0.0f, WHITE);
             }
         }
@@ -29579,6 +35360,7 @@ extern "C" {
 
     void Framework_DrawNineSlice(int textureHandle, float x, float y, float w, float h,
                                   int left, int top, int right, int bottom) {
+        if (g_headless) return;
         const Texture2D* tex = GetTextureH_Internal(textureHandle);
         DrawNineSliceInternal(tex, x, y, w, h, left, top, right, bottom, WHITE);
     }
@@ -29586,6 +35368,7 @@ extern "C" {
     void Framework_DrawNineSliceTinted(int textureHandle, float x, float y, float w, float h,
                                         int left, int top, int right, int bottom,
                                         int r, int g, int b, int a) {
+        if (g_headless) return;
         const Texture2D* tex = GetTextureH_Internal(textureHandle);
         Color tint = { (unsigned char)r, (unsigned char)g, (unsigned char)b, (unsigned char)a };
         DrawNineSliceInternal(tex, x, y, w, h, left, top, right, bottom, tint);
@@ -29604,6 +35387,7 @@ extern "C" {
     }
 
     void Framework_DrawNineSliceEx(int textureHandle, int nineSliceHandle, float x, float y, float w, float h) {
+        if (g_headless) return;
         auto cfgIt = g_nineSliceConfigs.find(nineSliceHandle);
         if (cfgIt == g_nineSliceConfigs.end()) return;
         const Texture2D* tex = GetTextureH_Internal(textureHandle);
@@ -29684,25 +35468,84 @@ extern "C" {
     // ========================================================================
 
     void Framework_TakeScreenshot(const char* filename) {
+        if (g_headless) return;
         if (!filename) return;
         TakeScreenshot(filename);
     }
 
+    void Framework_BeginRecordingEx(const char* filename, int fps, int format) {
+        RecordingState& r = g_recording;
+        if (g_headless || !filename || !*filename) return;
+        if (format < RECORD_FORMAT_PNG_SEQUENCE || format > RECORD_FORMAT_RLE) return;
+        if (r.active) Framework_EndRecording();
+
+        r.format = format;
+        r.fps = fps > 0 ? fps : 30;
+        r.width = GetRenderWidth();
+        r.height = GetRenderHeight();
+        r.path = filename;
+        if (format == RECORD_FORMAT_PNG_SEQUENCE) {
+            size_t dot = r.path.find_last_of('.');
+            size_t slash = r.path.find_last_of("/\\");
+            if (dot != std::string::npos && (slash == std::string::npos || dot > slash)) r.path.erase(dot);
+        } else {
+            r.file.open(filename, std::ios::binary | std::ios::trunc);
+            if (!r.file) return;
+            Recording_WriteHeader(r, 0);
+        }
+
+        r.prevFrame.clear();
+        r.storedFrames = 0;
+        r.captured = 0;
+        r.written = 0;
+        r.dropped = 0;
+        r.lastCaptureMs = 0.0f;
+        r.nextSlot = 0;
+        r.startTime = GetTime();
+        r.stopping = false;
+        r.inFlight = 0;
+        r.worker = std::thread(Recording_WorkerMain);
+        r.active = true;
+    }
+
+    // Format from the extension: .png -> image sequence, .rle -> RLE container, anything else raw
     void Framework_BeginRecording(const char* filename, int fps) {
-        // Stub implementation - store state for future GIF/video recording
         if (!filename) return;
-        g_isRecording = true;
-        g_recordingFilename = filename;
-        g_recordingFps = fps;
+        std::string name = filename;
+        size_t dot = name.find_last_of('.');
+        std::string ext = dot == std::string::npos ? "" : name.substr(dot);
+        for (char& ch : ext) ch = (char)tolower((unsigned char)ch);
+        int format = ext == ".png" ? RECORD_FORMAT_PNG_SEQUENCE : (ext == ".rle" ? RECORD_FORMAT_RLE : RECORD_FORMAT_RAW);
+        Framework_BeginRecordingEx(filename, fps, format);
     }
 
+    // Waits for the frames still in flight (at most maxInFlight) to be written
     void Framework_EndRecording() {
-        g_isRecording = false;
-        g_recordingFilename.clear();
+        RecordingState& r = g_recording;
+        if (!r.active) return;
+        r.active = false;
+        {
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.stopping = true;
+        }
+        r.wake.notify_one();
+        if (r.worker.joinable()) r.worker.join();
+        if (r.file.is_open()) {
+            Recording_WriteHeader(r, r.storedFrames);
+            r.file.close();
+        }
+        r.prevFrame.clear();
+        r.prevFrame.shrink_to_fit();
     }
 
     bool Framework_IsRecording() {
-        return g_isRecording;
+        return g_recording.active;
     }
 
+    void Framework_Recording_SetMaxInFlight(int frames) { g_recording.maxInFlight = frames < 1 ? 1 : frames; }
+    int Framework_Recording_GetCapturedFrames() { return g_recording.captured; }
+    int Framework_Recording_GetWrittenFrames() { return g_recording.written; }
+    int Framework_Recording_GetDroppedFrames() { return g_recording.dropped; }
+    float Framework_Recording_GetLastCaptureMs() { return g_recording.lastCaptureMs; }
+
 } // extern "C" (new features)
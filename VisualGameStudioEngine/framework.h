@@ -66,8 +66,8 @@ enum PhysicsBodyType {
 // ============================================================================
 enum CollisionShapeType {
     SHAPE_CIRCLE = 0,
-    SHAPE_BOX = 1,       // AABB
-    SHAPE_POLYGON = 2
+    SHAPE_BOX = 1,       // Turns with the body
+    SHAPE_POLYGON = 2    // Convex hull of the given vertices
 };
 
 // ============================================================================
@@ -122,6 +122,23 @@ enum UIState {
     UI_STATE_FOCUSED = 4
 };
 
+// ============================================================================
+// UI CONTAINER LAYOUT
+// ============================================================================
+enum UILayoutMode {
+    UI_LAYOUT_NONE = 0,        // Children use their own x/y and anchor
+    UI_LAYOUT_HORIZONTAL = 1,  // Left to right stack
+    UI_LAYOUT_VERTICAL = 2,    // Top to bottom stack
+    UI_LAYOUT_GRID = 3,        // Uniform cells, row-major
+    UI_LAYOUT_WRAP = 4         // Left to right, wrapping at the container width
+};
+
+enum UILayoutAlign {
+    UI_LAYOUT_ALIGN_START = 0,  // Cross-axis alignment inside a stack row/column or grid cell
+    UI_LAYOUT_ALIGN_CENTER = 1,
+    UI_LAYOUT_ALIGN_END = 2
+};
+
 // ============================================================================
 // SCENE TRANSITION TYPES
 // ============================================================================
@@ -289,6 +306,12 @@ extern "C" {
     __declspec(dllexport) void  Framework_Quit();              // Request graceful shutdown
     __declspec(dllexport) bool  Framework_IsPaused();
 
+    // Headless mode - no window, GL context or drawing; call before Framework_Initialize.
+    // Textures/fonts load as CPU metadata and time advances a fixed step per Framework_Update.
+    __declspec(dllexport) void  Framework_SetHeadless(bool headless);
+    __declspec(dllexport) bool  Framework_IsHeadless();
+    __declspec(dllexport) void  Framework_SetHeadlessFrameTime(float seconds);  // Simulated dt (default 1/60)
+
     // ========================================================================
     // DRAW CONTROL
     // ========================================================================
@@ -299,6 +322,33 @@ extern "C" {
     __declspec(dllexport) void  Framework_DrawText(const char* text, int x, int y, int fontSize, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
     __declspec(dllexport) void  Framework_DrawRectangle(int x, int y, int width, int height, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
 
+    // ========================================================================
+    // INTERNAL CANVAS
+    // ========================================================================
+    // Draws each frame into an offscreen target (logical size x scale) and upscales it to the
+    // window at EndDrawing. Screen size queries report the logical size and mouse input is
+    // remapped to it while the canvas is on (the canvas owns raylib's mouse offset/scale).
+    enum CanvasUpscale {
+        CANVAS_UPSCALE_INTEGER = 0,   // Pixel-perfect whole multiples, letterboxed
+        CANVAS_UPSCALE_NEAREST = 1,   // Aspect fit, point filtered
+        CANVAS_UPSCALE_LINEAR = 2     // Aspect fit, bilinear filtered
+    };
+    __declspec(dllexport) void  Framework_Canvas_Enable(bool enabled);
+    __declspec(dllexport) bool  Framework_Canvas_IsEnabled();
+    __declspec(dllexport) void  Framework_Canvas_SetResolution(int width, int height);   // Virtual resolution; 0,0 = follow the window
+    __declspec(dllexport) void  Framework_Canvas_SetScale(float scale);                  // Rendered pixels per logical pixel (0.1-4)
+    __declspec(dllexport) float Framework_Canvas_GetScale();
+    __declspec(dllexport) void  Framework_Canvas_SetUpscale(int mode);                   // CANVAS_UPSCALE_*
+    __declspec(dllexport) int   Framework_Canvas_GetUpscale();
+    __declspec(dllexport) void  Framework_Canvas_SetLetterboxColor(unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+    __declspec(dllexport) void  Framework_Canvas_SetDynamic(bool enabled, float budgetMs, float minScale, float maxScale);  // Adjust scale to hold a frame budget
+    __declspec(dllexport) bool  Framework_Canvas_IsDynamic();
+    __declspec(dllexport) int   Framework_Canvas_GetWidth();          // Logical size
+    __declspec(dllexport) int   Framework_Canvas_GetHeight();
+    __declspec(dllexport) int   Framework_Canvas_GetPixelWidth();     // Pixels rendered this frame
+    __declspec(dllexport) int   Framework_Canvas_GetPixelHeight();
+    __declspec(dllexport) Vector2 Framework_Canvas_WindowToCanvas(float x, float y);
+
     // ========================================================================
     // TIMING
     // ========================================================================
@@ -314,11 +364,27 @@ extern "C" {
     __declspec(dllexport) float   Framework_GetTimeScale();
 
     // Fixed timestep
+    // Once a fixed update callback or any FIXED_SYSTEM_* is set, Framework_Update runs the fixed
+    // steps itself before drawing; otherwise poll Framework_StepFixed after Framework_Update.
+    enum FixedSystem {
+        FIXED_SYSTEM_PHYSICS = 1,          // Physics step + sync to bound entities
+        FIXED_SYSTEM_ECS_VELOCITIES = 2    // Velocity2D integration
+    };
     __declspec(dllexport) void    Framework_SetFixedStep(double seconds);
     __declspec(dllexport) void    Framework_ResetFixedClock();
     __declspec(dllexport) bool    Framework_StepFixed();
     __declspec(dllexport) double  Framework_GetFixedStep();
     __declspec(dllexport) double  Framework_GetAccumulator();
+    __declspec(dllexport) void    Framework_SetFixedMaxSteps(int maxSteps);   // Per frame, default 8
+    __declspec(dllexport) int     Framework_GetFixedMaxSteps();
+    __declspec(dllexport) int     Framework_GetFixedStepsThisFrame();
+    __declspec(dllexport) double  Framework_GetFixedDroppedTime();            // Seconds discarded by the max-steps guard
+    __declspec(dllexport) void    Framework_SetFixedSystems(int systems);     // FIXED_SYSTEM_* flags
+    __declspec(dllexport) int     Framework_GetFixedSystems();
+    __declspec(dllexport) void    Framework_SetFixedUpdateCallback(SceneUpdateFixedFn callback);
+    __declspec(dllexport) void    Framework_SetInterpolation(bool enabled);   // Sprites draw blended transforms
+    __declspec(dllexport) bool    Framework_IsInterpolationEnabled();
+    __declspec(dllexport) float   Framework_GetFixedAlpha();                  // 0-1 between last and next fixed step
 
     // ========================================================================
     // INPUT - KEYBOARD
@@ -1305,6 +1371,29 @@ extern "C" {
     __declspec(dllexport) bool  Framework_IsFontValidH(int handle);
     __declspec(dllexport) void  Framework_DrawTextExH(int handle, const char* text, Vector2 pos, float fontSize, float spacing, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
 
+    // ========================================================================
+    // PACKED COMMAND BUFFER
+    // ========================================================================
+    // Commands are { uint16 opcode, uint16 size } + arguments, little-endian, where size
+    // includes the 4-byte header. Floats and ints are 4 bytes, colors are r,g,b,a bytes.
+    enum DrawCommandOp {
+        CMD_CLEAR = 1,          // rgba
+        CMD_RECT = 2,           // x, y, w, h, rgba
+        CMD_RECT_LINES = 3,     // x, y, w, h, thick, rgba
+        CMD_LINE = 4,           // x1, y1, x2, y2, thick, rgba
+        CMD_CIRCLE = 5,         // x, y, radius, rgba
+        CMD_TEXTURE = 6,        // int handle, src xywh, dst xywh, origin xy, rotation, rgba
+        CMD_TEXT = 7,           // int font handle (-1 = default), x, y, size, spacing, rgba, UTF-8 to end of command
+        CMD_SET_LAYER = 8,      // int layer, int order (render list)
+        CMD_BLEND = 9,          // int blend mode, -1 = end blend mode; reset when the buffer ends
+        CMD_BEGIN_2D = 10,      // offset xy, target xy, rotation, zoom
+        CMD_END_2D = 11,
+        CMD_SCISSOR = 12,       // int x, y, w, h
+        CMD_END_SCISSOR = 13
+    };
+    __declspec(dllexport) int   Framework_SubmitCommands(const unsigned char* buffer, int byteCount);  // Returns commands executed
+    __declspec(dllexport) int   Framework_GetCommandError();                 // Byte offset of the malformed command that stopped the last submit, -1 if none
+
     // ========================================================================
     // SCENE SYSTEM
     // ========================================================================
@@ -1423,6 +1512,9 @@ extern "C" {
     __declspec(dllexport) Vector2 Framework_Ecs_GetWorldPosition(int entity);           // World (hierarchical)
     __declspec(dllexport) float   Framework_Ecs_GetWorldRotation(int entity);
     __declspec(dllexport) Vector2 Framework_Ecs_GetWorldScale(int entity);
+    __declspec(dllexport) Vector2 Framework_Ecs_GetRenderPosition(int entity);          // World, interpolated
+    __declspec(dllexport) float   Framework_Ecs_GetRenderRotation(int entity);
+    __declspec(dllexport) void    Framework_Ecs_ResetInterpolation(int entity);         // After teleports; -1 = all
 
     // ========================================================================
     // ECS - VELOCITY2D COMPONENT
@@ -1532,6 +1624,49 @@ extern "C" {
     __declspec(dllexport) int   Framework_Perf_GetTriangleCount();
     __declspec(dllexport) void  Framework_Perf_ResetDrawStats();         // Call at frame start
 
+    // Render statistics - measured at the engine's rlgl submission points.
+    // All getters report the last completed frame (frames end at EndDrawing).
+    enum RenderSubsystem {
+        RENDER_SUBSYSTEM_USER = 0,       // Framework_Draw* passthroughs and user callbacks
+        RENDER_SUBSYSTEM_SPRITES = 1,    // ECS Sprite2D
+        RENDER_SUBSYSTEM_TILEMAPS = 2,   // ECS tilemaps, levels, standalone tilemaps
+        RENDER_SUBSYSTEM_PARTICLES = 3,
+        RENDER_SUBSYSTEM_TRAILS = 4,
+        RENDER_SUBSYSTEM_PARALLAX = 5,
+        RENDER_SUBSYSTEM_SKELETONS = 6,
+        RENDER_SUBSYSTEM_SPRITE_BATCH = 7,
+        RENDER_SUBSYSTEM_UI = 8,
+        RENDER_SUBSYSTEM_DEBUG = 9,      // Debug draw, physics/joint debug, overlays, console
+        RENDER_SUBSYSTEM_EFFECTS = 10,   // Lighting and screen effects
+        RENDER_SUBSYSTEM_COUNT
+    };
+    __declspec(dllexport) int   Framework_RenderStats_GetDrawCalls();
+    __declspec(dllexport) int   Framework_RenderStats_GetBatchFlushes();
+    __declspec(dllexport) int   Framework_RenderStats_GetTextureSwaps();
+    __declspec(dllexport) int   Framework_RenderStats_GetShaderSwitches();
+    __declspec(dllexport) int   Framework_RenderStats_GetTargetSwitches();
+    __declspec(dllexport) int   Framework_RenderStats_GetVertexCount();
+    __declspec(dllexport) int   Framework_RenderStats_GetQuadCount();
+    __declspec(dllexport) int   Framework_RenderStats_GetSubsystemDrawCalls(int subsystem);
+    __declspec(dllexport) int   Framework_RenderStats_GetSubsystemVertices(int subsystem);
+    __declspec(dllexport) int   Framework_RenderStats_GetSubsystemTextureSwaps(int subsystem);
+    __declspec(dllexport) int   Framework_RenderStats_GetLayerCount();               // Layers that drew anything
+    __declspec(dllexport) int   Framework_RenderStats_GetLayerId(int index);         // Sorted ascending
+    __declspec(dllexport) int   Framework_RenderStats_GetLayerDrawCalls(int layer);
+    __declspec(dllexport) int   Framework_RenderStats_GetLayerVertices(int layer);
+    __declspec(dllexport) int   Framework_RenderStats_GetLayerTextureSwaps(int layer);
+
+    // Frame render list: between Begin and End, sprite, tilemap, level, particle, trail, parallax,
+    // skeleton, sprite batch, text layout and UI draws are deferred, sorted once by
+    // (layer, order, material) and submitted with as few batch breaks as possible.
+    // Immediate Framework_Draw* shape/texture calls still draw when called.
+    __declspec(dllexport) void  Framework_RenderList_Begin();
+    __declspec(dllexport) void  Framework_RenderList_End();                      // Sort and submit (also done by EndDrawing)
+    __declspec(dllexport) void  Framework_RenderList_SetLayer(int layer, int order);  // Key for draws without a layer of their own
+    __declspec(dllexport) bool  Framework_RenderList_IsCapturing();
+    __declspec(dllexport) int   Framework_RenderList_GetLastItemCount();         // Keyed items submitted by the last End
+    __declspec(dllexport) int   Framework_RenderList_GetLastRunCount();          // Material runs (texture/blend changes) in the last End
+
     // Memory tracking
     __declspec(dllexport) int   Framework_Perf_GetEntityCount();
     __declspec(dllexport) int   Framework_Perf_GetTextureCount();
@@ -1588,7 +1723,29 @@ extern "C" {
     __declspec(dllexport) bool  Framework_DebugDraw_IsEnabled();
     __declspec(dllexport) void  Framework_DebugDraw_SetPersistent(bool persistent);  // Shapes persist across frames
     __declspec(dllexport) void  Framework_DebugDraw_Clear();             // Clear all debug shapes
-    __declspec(dllexport) void  Framework_DebugDraw_Flush();             // Render and clear
+    __declspec(dllexport) void  Framework_DebugDraw_Flush();             // Render, then drop shapes whose duration ended
+
+    // Debug draw categories, lifetime and capacity. Primitives take the current category
+    // and duration when submitted; storage is fixed-size and full arrays drop new shapes.
+    enum DebugDrawCategory {
+        DEBUG_CATEGORY_GENERAL = 0,
+        DEBUG_CATEGORY_PHYSICS = 1,
+        DEBUG_CATEGORY_NAVIGATION = 2,
+        DEBUG_CATEGORY_GRID = 3,
+        DEBUG_CATEGORY_UI = 4,
+        DEBUG_CATEGORY_USER = 8             // First of the free categories (up to 31)
+    };
+    __declspec(dllexport) void  Framework_DebugDraw_SetCategory(int category);
+    __declspec(dllexport) int   Framework_DebugDraw_GetCategory();
+    __declspec(dllexport) void  Framework_DebugDraw_SetCategoryEnabled(int category, bool enabled);  // Hidden categories are kept, not drawn
+    __declspec(dllexport) bool  Framework_DebugDraw_IsCategoryEnabled(int category);
+    __declspec(dllexport) void  Framework_DebugDraw_SetDuration(float seconds);    // 0 = next flush only, < 0 = until Clear
+    __declspec(dllexport) float Framework_DebugDraw_GetDuration();
+    __declspec(dllexport) void  Framework_DebugDraw_SetCapacity(int lines, int triangles, int texts, int textBytes);  // Clears
+    __declspec(dllexport) int   Framework_DebugDraw_GetLineCount();
+    __declspec(dllexport) int   Framework_DebugDraw_GetTriangleCount();
+    __declspec(dllexport) int   Framework_DebugDraw_GetTextCount();
+    __declspec(dllexport) int   Framework_DebugDraw_GetDroppedCount();        // Shapes rejected by full arrays since the last Clear
 
     // System overlays
     __declspec(dllexport) void  Framework_Debug_SetShowFPS(bool show);
@@ -1974,8 +2131,13 @@ extern "C" {
     __declspec(dllexport) void  Framework_Ecs_SetEmitterTextureSheet(int entity, int textureHandle, int columns, int rows);
     __declspec(dllexport) void  Framework_Ecs_SetEmitterRandomTexture(int entity, bool randomize);  // Pick random frame
 
-    // Sorting
-    __declspec(dllexport) void  Framework_Ecs_SetEmitterSortMode(int entity, int sortMode);  // 0=none, 1=age, 2=distance
+    // Sorting (only sorted emitters pay for a per-frame radix sort)
+    enum ParticleSortMode {
+        PARTICLE_SORT_NONE = 0,       // Pool order
+        PARTICLE_SORT_AGE = 1,        // Oldest drawn first, newest on top
+        PARTICLE_SORT_DISTANCE = 2    // Farthest from the emitter drawn first
+    };
+    __declspec(dllexport) void  Framework_Ecs_SetEmitterSortMode(int entity, int sortMode);  // ParticleSortMode
 
     // Pre-warming (simulate particles before game starts)
     __declspec(dllexport) void  Framework_Ecs_EmitterPrewarm(int entity, float simulateTime);
@@ -2065,14 +2227,28 @@ extern "C" {
     __declspec(dllexport) void  Framework_UI_Update();       // Process input, update states
     __declspec(dllexport) void  Framework_UI_Draw();         // Draw all visible UI elements
     __declspec(dllexport) int   Framework_UI_GetHovered();   // Returns element under mouse, -1 if none
+    __declspec(dllexport) int   Framework_UI_GetElementAt(float x, float y);  // Topmost visible, enabled element at a point, -1 if none
     __declspec(dllexport) int   Framework_UI_GetFocused();   // Returns focused element, -1 if none
     __declspec(dllexport) void  Framework_UI_SetFocus(int elementId);  // -1 to clear focus
     __declspec(dllexport) bool  Framework_UI_HasFocus();     // True if any UI element has focus
+    __declspec(dllexport) void  Framework_UI_InvalidateCache();    // Force every cached UI root to rebuild next draw
+    __declspec(dllexport) int   Framework_UI_GetCacheRebuilds();   // Root rebuilds since startup (profiling)
 
     // UI Layout helpers
     __declspec(dllexport) void  Framework_UI_LayoutVertical(int parentId, float spacing, float paddingX, float paddingY);
     __declspec(dllexport) void  Framework_UI_LayoutHorizontal(int parentId, float spacing, float paddingX, float paddingY);
 
+    // UI Container layout (children are arranged automatically; only dirty containers re-run)
+    __declspec(dllexport) void  Framework_UI_SetLayout(int elementId, int mode, float spacing);  // UILayoutMode
+    __declspec(dllexport) void  Framework_UI_SetLayoutAlign(int elementId, int align);           // UILayoutAlign
+    __declspec(dllexport) void  Framework_UI_SetLayoutColumns(int elementId, int columns);       // Grid, 0 = fit width
+    __declspec(dllexport) void  Framework_UI_SetLayoutCellSize(int elementId, float width, float height);  // Grid, 0 = largest child
+    __declspec(dllexport) void  Framework_UI_SetLayoutFit(int elementId, bool fit);              // Resize container to content
+    __declspec(dllexport) int   Framework_UI_GetLayoutMode(int elementId);
+    __declspec(dllexport) float Framework_UI_GetContentWidth(int elementId);
+    __declspec(dllexport) float Framework_UI_GetContentHeight(int elementId);
+    __declspec(dllexport) int   Framework_UI_GetLayoutPasses();  // Containers arranged since startup (profiling)
+
     // ========================================================================
     // PHYSICS SYSTEM - 2D Rigid Body Physics
     // ========================================================================
@@ -2083,6 +2259,53 @@ extern "C" {
     __declspec(dllexport) void  Framework_Physics_SetEnabled(bool enabled);
     __declspec(dllexport) bool  Framework_Physics_IsEnabled();
 
+    // Deterministic mode: pairs, contacts, joints and CCD sweeps are processed in handle order,
+    // so identical worlds stepped alike stay bit-identical (same build, x64)
+    __declspec(dllexport) void  Framework_Physics_SetDeterministic(bool enabled);
+    __declspec(dllexport) bool  Framework_Physics_IsDeterministic();
+    __declspec(dllexport) long long Framework_Physics_GetStepCount();
+    __declspec(dllexport) unsigned long long Framework_Physics_GetStateChecksum();  // Hash of all body state
+
+    // Broadphase: candidate pairs come from a dynamic AABB tree (default), an incremental
+    // sweep-and-prune list, or the old all-pairs loop
+    enum PhysicsBroadphaseMode {
+        PHYSICS_BROADPHASE_TREE = 0,
+        PHYSICS_BROADPHASE_SAP = 1,
+        PHYSICS_BROADPHASE_BRUTE_FORCE = 2
+    };
+    __declspec(dllexport) void  Framework_Physics_SetBroadphase(int mode);
+    __declspec(dllexport) int   Framework_Physics_GetBroadphase();
+    __declspec(dllexport) void  Framework_Physics_SetAABBMargin(float margin);  // Fat AABB padding in pixels (default 4)
+    __declspec(dllexport) float Framework_Physics_GetAABBMargin();
+    __declspec(dllexport) int   Framework_Physics_GetCandidatePairCount();      // Pairs handed to the narrowphase last step
+    __declspec(dllexport) int   Framework_Physics_GetBroadphaseTreeHeight();
+    __declspec(dllexport) int   Framework_Physics_GetBroadphaseReinserts();     // Leaves that left their fat box last step
+    __declspec(dllexport) float Framework_Physics_GetBroadphaseMs();
+
+    // Contact solver: persistent manifolds with warm-started sequential impulses, followed by
+    // a position pass; SetIterations sets how many of each run per step
+    __declspec(dllexport) void  Framework_Physics_SetWarmStarting(bool enabled);      // Default on
+    __declspec(dllexport) bool  Framework_Physics_IsWarmStartingEnabled();
+    __declspec(dllexport) void  Framework_Physics_SetContactSettings(float baumgarte, float linearSlop, float restitutionThreshold);  // 0.2, 0.5 px, 100 px/s
+    __declspec(dllexport) int   Framework_Physics_GetManifoldCount();
+    __declspec(dllexport) int   Framework_Physics_GetContactPointCount();         // Points solved last step
+    __declspec(dllexport) void  Framework_Physics_SetThreadCount(int threads);    // Narrowphase/island workers incl. caller; 0 = per core
+    __declspec(dllexport) int   Framework_Physics_GetThreadCount();
+    __declspec(dllexport) int   Framework_Physics_GetSolverIslandCount();         // Islands solved concurrently last step
+    __declspec(dllexport) float Framework_Physics_GetContactImpulse(int bodyA, int bodyB);  // Normal impulse last step
+    __declspec(dllexport) float Framework_Physics_Benchmark(int bodyCount, int broadphase, int steps);  // Average ms per step in a scratch world
+
+    // Continuous collision: opted-in bodies sweep their motion each step and stop at the
+    // first time of impact instead of passing through thin geometry
+    enum PhysicsContinuousMode {
+        PHYSICS_CCD_NONE = 0,       // Discrete contacts only (default)
+        PHYSICS_CCD_STATIC = 1,     // Swept against static and kinematic bodies
+        PHYSICS_CCD_DYNAMIC = 2     // Also against other dynamic bodies
+    };
+    __declspec(dllexport) void  Framework_Physics_SetBodyContinuous(int bodyHandle, int mode);
+    __declspec(dllexport) int   Framework_Physics_GetBodyContinuous(int bodyHandle);
+    __declspec(dllexport) int   Framework_Physics_GetContinuousHitCount();        // Bodies stopped at a time of impact last step
+
     // Physics body creation/destruction
     __declspec(dllexport) int   Framework_Physics_CreateBody(int bodyType, float x, float y);  // Returns body handle
     __declspec(dllexport) void  Framework_Physics_DestroyBody(int bodyHandle);
@@ -2126,12 +2349,24 @@ extern "C" {
     __declspec(dllexport) void  Framework_Physics_WakeBody(int bodyHandle);
     __declspec(dllexport) bool  Framework_Physics_IsBodyAwake(int bodyHandle);
 
+    // Sleeping: bodies below both speed thresholds for the sleep time go to sleep with
+    // their contact/joint island and wake together on contact, force or joint changes
+    __declspec(dllexport) void  Framework_Physics_SetSleepingEnabled(bool enabled);   // Disabling wakes everything
+    __declspec(dllexport) bool  Framework_Physics_IsSleepingEnabled();
+    __declspec(dllexport) void  Framework_Physics_SetSleepThresholds(float linearSpeed, float angularSpeed);  // px/s, rad/s
+    __declspec(dllexport) void  Framework_Physics_SetTimeToSleep(float seconds);      // Default 0.5
+    __declspec(dllexport) float Framework_Physics_GetTimeToSleep();
+    __declspec(dllexport) int   Framework_Physics_GetAwakeBodyCount();
+    __declspec(dllexport) int   Framework_Physics_GetIslandCount();                   // Awake islands built last step
+    __declspec(dllexport) int   Framework_Physics_GetSleepingIslandCount();
+
     // Collision shapes - attach to body
     __declspec(dllexport) void  Framework_Physics_SetBodyCircle(int bodyHandle, float radius);
     __declspec(dllexport) void  Framework_Physics_SetBodyCircleOffset(int bodyHandle, float radius, float offsetX, float offsetY);
     __declspec(dllexport) void  Framework_Physics_SetBodyBox(int bodyHandle, float width, float height);
     __declspec(dllexport) void  Framework_Physics_SetBodyBoxOffset(int bodyHandle, float width, float height, float offsetX, float offsetY);
     __declspec(dllexport) void  Framework_Physics_SetBodyPolygon(int bodyHandle, const float* vertices, int vertexCount);  // pairs of x,y
+    __declspec(dllexport) int   Framework_Physics_GetBodyPolygonVertexCount(int bodyHandle);  // Hull vertices kept
     __declspec(dllexport) int   Framework_Physics_GetBodyShapeType(int bodyHandle);  // CollisionShapeType enum
 
     // Collision filtering
@@ -2163,11 +2398,17 @@ extern "C" {
                                                               int* bodyBuffer, int bufferSize);  // Returns count
     __declspec(dllexport) int   Framework_Physics_QueryCircle(float x, float y, float radius, int* bodyBuffer, int bufferSize);
     __declspec(dllexport) int   Framework_Physics_QueryBox(float x, float y, float width, float height, int* bodyBuffer, int bufferSize);
+    // Batches: one call for many rays/shapes. rays = startX, startY, dirX, dirY, maxDist each;
+    // hitData (optional) = hitX, hitY, normalX, normalY, distance each; shape hits are packed per query
+    __declspec(dllexport) int   Framework_Physics_RaycastBatch(const float* rays, int rayCount, int* hitBodies, float* hitData);  // Returns rays that hit
+    __declspec(dllexport) int   Framework_Physics_QueryCircleBatch(const float* circles, int circleCount, int* bodyBuffer, int bufferSize, int* resultCounts);  // x, y, radius each
+    __declspec(dllexport) int   Framework_Physics_QueryBoxBatch(const float* boxes, int boxCount, int* bodyBuffer, int bufferSize, int* resultCounts);  // x, y, w, h each
     __declspec(dllexport) bool  Framework_Physics_TestOverlap(int bodyA, int bodyB);
 
     // Simulation
     __declspec(dllexport) void  Framework_Physics_Step(float dt);  // Advance physics simulation
-    __declspec(dllexport) void  Framework_Physics_SyncToEntities();  // Copy body positions to bound entities
+    __declspec(dllexport) void  Framework_Physics_StepFixed(int steps);  // Exactly this many fixed steps, ignoring frame time
+    __declspec(dllexport) void  Framework_Physics_SyncToEntities();  // Copy bound bodies moved since the last sync to their entities
 
     // Debug rendering
     __declspec(dllexport) void  Framework_Physics_SetDebugDraw(bool enabled);
@@ -2966,6 +3207,24 @@ extern "C" {
     // Utility functions
     __declspec(dllexport) void  Framework_Timer_ClearCompleted();  // Remove finished one-shot timers
 
+    // ========================================================================
+    // WORLD SNAPSHOTS - In-memory save/restore for rollback and retry
+    // ========================================================================
+    // Covers entities and ECS components, physics bodies/joints/contacts, timers, tweens and
+    // the framework RNG. Buffers are reused across captures; a delta stores only the bytes
+    // that changed since its base snapshot, which must outlive it unrecaptured
+    __declspec(dllexport) int   Framework_Snapshot_Create(int reserveBytes);  // Returns snapshot id; reserveBytes preallocates
+    __declspec(dllexport) void  Framework_Snapshot_Destroy(int snapshotId);
+    __declspec(dllexport) bool  Framework_Snapshot_Capture(int snapshotId);
+    __declspec(dllexport) bool  Framework_Snapshot_CaptureDelta(int snapshotId, int baseSnapshotId);
+    __declspec(dllexport) bool  Framework_Snapshot_Restore(int snapshotId);
+    __declspec(dllexport) bool  Framework_Snapshot_IsValid(int snapshotId);  // Captured and still exists
+    __declspec(dllexport) bool  Framework_Snapshot_IsDelta(int snapshotId);
+    __declspec(dllexport) int   Framework_Snapshot_GetSize(int snapshotId);      // Bytes stored
+    __declspec(dllexport) int   Framework_Snapshot_GetFullSize(int snapshotId);  // Bytes of the expanded state
+    __declspec(dllexport) float Framework_Snapshot_GetCaptureMs(int snapshotId);
+    __declspec(dllexport) float Framework_Snapshot_GetRestoreMs(int snapshotId);
+
     // ========================================================================
     // OBJECT POOLING - Efficient object reuse
     // ========================================================================
@@ -4896,6 +5155,18 @@ extern "C" {
     __declspec(dllexport) void  Framework_DrawTextCentered(const char* text, int centerX, int centerY, int fontSize, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
     __declspec(dllexport) void  Framework_DrawTextRight(const char* text, int rightX, int y, int fontSize, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
 
+    // Cached text layout - keyed by (font, size, spacing, wrap width, text), LRU-evicted.
+    // wrapWidth <= 0 disables wrapping; lines break at spaces, or mid-word when a word is too long.
+    __declspec(dllexport) void  Framework_MeasureTextWrapped(int fontHandle, const char* text, float fontSize, float spacing, float wrapWidth, float* outWidth, float* outHeight, int* outLines);
+    __declspec(dllexport) int   Framework_TextLayout_GetLineStart(int fontHandle, const char* text, float fontSize, float spacing, float wrapWidth, int line);  // Byte offset, -1 if out of range
+    __declspec(dllexport) void  Framework_DrawTextWrapped(int fontHandle, const char* text, float x, float y, float fontSize, float spacing, float wrapWidth, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+    __declspec(dllexport) void  Framework_TextCache_SetCapacity(int maxLayouts);   // Default 256
+    __declspec(dllexport) int   Framework_TextCache_GetCapacity();
+    __declspec(dllexport) int   Framework_TextCache_GetCount();
+    __declspec(dllexport) void  Framework_TextCache_Clear();
+    __declspec(dllexport) unsigned long long Framework_TextCache_GetHits();
+    __declspec(dllexport) unsigned long long Framework_TextCache_GetMisses();
+
     // ========================================================================
     // GAMEPAD INPUT
     // ========================================================================
@@ -5016,10 +5287,23 @@ extern "C" {
     // ========================================================================
     // SCREENSHOT / RECORDING
     // ========================================================================
+    // Recording reads frames back at the recording fps and writes them on a worker thread;
+    // frames the worker cannot take in time are dropped and counted, never waited on.
+    enum RecordFormat {
+        RECORD_FORMAT_PNG_SEQUENCE = 0,   // name_00000.png, name_00001.png, ...
+        RECORD_FORMAT_RAW = 1,            // .vgsr container, raw RGBA8 frames
+        RECORD_FORMAT_RLE = 2             // .vgsr container, RLE of the XOR against the previous frame
+    };
     __declspec(dllexport) void  Framework_TakeScreenshot(const char* filename);
-    __declspec(dllexport) void  Framework_BeginRecording(const char* filename, int fps);
-    __declspec(dllexport) void  Framework_EndRecording();
+    __declspec(dllexport) void  Framework_BeginRecording(const char* filename, int fps);   // Format from extension: .png, .rle, else raw
+    __declspec(dllexport) void  Framework_BeginRecordingEx(const char* filename, int fps, int format);
+    __declspec(dllexport) void  Framework_EndRecording();                                 // Flushes frames still in flight
     __declspec(dllexport) bool  Framework_IsRecording();
+    __declspec(dllexport) void  Framework_Recording_SetMaxInFlight(int frames);           // Captured but unwritten frames allowed (default 2)
+    __declspec(dllexport) int   Framework_Recording_GetCapturedFrames();
+    __declspec(dllexport) int   Framework_Recording_GetWrittenFrames();
+    __declspec(dllexport) int   Framework_Recording_GetDroppedFrames();
+    __declspec(dllexport) float Framework_Recording_GetLastCaptureMs();                   // Main-thread readback cost
 
     // ========================================================================
     // CLEANUP